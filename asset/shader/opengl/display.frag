@@ -5,9 +5,31 @@ in vec2 vert_texcoord;
 out vec4 frag_color;
 
 uniform sampler2D Display;
+// 0 bilinear, 1 edge aware (sharpen less where the contrast is high).
+uniform int upscale_filter;
+
+vec3 EdgeAwareUpscale(vec2 uv)
+{
+	vec2 texel = 1.0 / vec2(textureSize(Display, 0));
+	vec3 center = texture(Display, uv).rgb;
+	vec3 left = texture(Display, uv - vec2(texel.x, 0.0)).rgb;
+	vec3 right = texture(Display, uv + vec2(texel.x, 0.0)).rgb;
+	vec3 down = texture(Display, uv - vec2(0.0, texel.y)).rgb;
+	vec3 up = texture(Display, uv + vec2(0.0, texel.y)).rgb;
+	vec3 min_rgb = min(center, min(min(left, right), min(down, up)));
+	vec3 max_rgb = max(center, max(max(left, right), max(down, up)));
+	// Sharpen the flat areas to get back the detail lost by the bilinear,
+	// leave the edges alone so they don't ring.
+	vec3 contrast = max_rgb - min_rgb;
+	vec3 amount = 0.25 * (1.0 - clamp(contrast * 2.0, 0.0, 1.0));
+	vec3 rgb = center + amount * (4.0 * center - left - right - down - up);
+	return clamp(rgb, min_rgb, max_rgb);
+}
 
 void main()
 {
-	vec3 rgb = texture(Display, vert_texcoord).rgb;
+	vec3 rgb = (upscale_filter == 1) ?
+		EdgeAwareUpscale(vert_texcoord) :
+		texture(Display, vert_texcoord).rgb;
 	frag_color = vec4(rgb, 1.0);
 }
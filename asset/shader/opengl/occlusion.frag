@@ -0,0 +1,9 @@
+#version 330 core
+
+out vec4 frag_color;
+
+void main()
+{
+	// Only the depth test matter (color and depth writes are off).
+	frag_color = vec4(1.0);
+}
@@ -3,6 +3,8 @@
 layout(location = 0) in vec3 in_position;
 layout(location = 1) in vec3 in_normal;
 layout(location = 2) in vec2 in_texcoord;
+// Per instance model (identity when not drawn instanced).
+layout(location = 8) in mat4 instance_model;
 
 out vec3 vert_normal;
 out vec3 vert_position;
@@ -14,9 +16,10 @@ uniform mat4 model;
 
 void main()
 {
-	vert_normal = normalize(vec3(model * vec4(in_normal, 1.0)));
+	mat4 world = model * instance_model;
+	vert_normal = normalize(vec3(world * vec4(in_normal, 1.0)));
 	vert_texcoord = in_texcoord;
-	mat4 pvm = projection * view * model;
+	mat4 pvm = projection * view * world;
 	vert_position = (pvm * vec4(in_position, 1.0)).xyz;
 	gl_Position = pvm * vec4(in_position, 1.0);
 }
@@ -27,10 +27,15 @@ int main(int ac, char** av)
 try
 {
 #endif
-    frame::common::Application app(frame::CreateNewWindow(
+    auto win = frame::CreateNewWindow(
         frame::DrawingTargetEnum::WINDOW,
         frame::RenderingAPIEnum::OPENGL,
-        {1280, 720}));
+        {1280, 720});
+    // Fill rate bound, scale the render to keep 60 frames per second.
+    auto& dynamic_resolution = win->GetDevice().GetDynamicResolution();
+    dynamic_resolution.SetEnabled(true);
+    dynamic_resolution.SetUpscaleFilter(frame::UpscaleFilterEnum::EDGE_AWARE);
+    frame::common::Application app(std::move(win));
     app.Startup(frame::file::FindFile("asset/json/ray_marching.json"));
     app.Run();
     return 0;
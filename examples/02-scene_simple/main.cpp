@@ -13,6 +13,8 @@
 #include "frame/file/file_system.h"
 #include "frame/file/image_stb.h"
 #include "frame/gui/draw_gui_factory.h"
+#include "frame/gui/window_allocation.h"
+#include "frame/gui/window_dynamic_resolution.h"
 #include "frame/gui/window_logger.h"
 #include "frame/gui/window_resolution.h"
 #include "frame/window_factory.h"
@@ -47,15 +49,21 @@ try
     ptr_window_resolution = gui_resolution.get();
     gui_window->AddWindow(std::move(gui_resolution));
     gui_window->AddWindow(std::make_unique<frame::gui::WindowLogger>("Logger"));
+    gui_window->AddWindow(
+        std::make_unique<frame::gui::WindowAllocation>("Allocation"));
+    gui_window->AddWindow(
+        std::make_unique<frame::gui::WindowDynamicResolution>(
+            "Dynamic resolution", device.GetDynamicResolution()));
     // Set the main window in full.
     // gui_window->SetVisible(false);
     gui_window->AddModalWindow(
         std::make_unique<ModalInfo>("Info", "This is a test modal window."));
     win->GetDevice().AddPlugin(std::move(gui_window));
     frame::common::Application app(std::move(win));
+    // The level is kept across resolution changes (resized in place).
+    app.Startup(frame::file::FindFile("asset/json/scene_simple.json"));
     do
     {
-        app.Startup(frame::file::FindFile("asset/json/scene_simple.json"));
         app.Run();
         app.Resize(
             ptr_window_resolution->GetSize(),
@@ -0,0 +1,75 @@
+#include <absl/flags/flag.h>
+#include <absl/flags/parse.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "frame/opengl/batch_renderer.h"
+#include "frame/window_factory.h"
+
+ABSL_FLAG(std::uint32_t, width, 640, "Width of the images.");
+ABSL_FLAG(std::uint32_t, height, 480, "Height of the images.");
+ABSL_FLAG(std::uint32_t, workers, 2, "Number of encoding threads.");
+
+namespace
+{
+
+void RenderFile(
+    frame::opengl::BatchRenderer& batch_renderer,
+    const std::filesystem::path& job_file)
+{
+    batch_renderer.RenderFile(job_file);
+    batch_renderer.Finish();
+    const auto stats = batch_renderer.GetStats();
+    // The counters are the ones since the start.
+    std::cout << job_file.string() << ": " << stats.written << " written, "
+              << stats.failed << " failed, " << stats.level_loaded
+              << " level loaded, " << stats.GetImagesPerSecond()
+              << " images/s" << std::endl;
+}
+
+} // End anonymous namespace.
+
+// Render the job files given as arguments, or without arguments serve the
+// job files whose paths are read (a line each) from the standard input, the
+// levels stay loaded between the files.
+int main(int ac, char** av)
+try
+{
+    const auto args = absl::ParseCommandLine(ac, av);
+    const glm::uvec2 size = {
+        absl::GetFlag(FLAGS_width), absl::GetFlag(FLAGS_height)};
+    frame::opengl::BatchRenderer batch_renderer(
+        frame::CreateNewWindow(
+            frame::DrawingTargetEnum::NONE,
+            frame::RenderingAPIEnum::OPENGL,
+            size),
+        absl::GetFlag(FLAGS_workers));
+    if (args.size() > 1)
+    {
+        for (std::size_t i = 1; i < args.size(); ++i)
+            RenderFile(batch_renderer, args[i]);
+        return 0;
+    }
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        if (line.empty())
+            continue;
+        try
+        {
+            RenderFile(batch_renderer, line);
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "Error: " << ex.what() << std::endl;
+        }
+    }
+    return 0;
+}
+catch (const std::exception& ex)
+{
+    std::cerr << "Error: " << ex.what() << std::endl;
+    return -2;
+}
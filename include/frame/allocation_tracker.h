@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace frame
+{
+
+/**
+ * @class AllocationStats
+ * @brief Number of heap allocations and allocated bytes.
+ */
+struct AllocationStats
+{
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+};
+
+/**
+ * @class AllocationTracker
+ * @brief Count the heap allocations done through the global operator new.
+ *
+ * This is an opt-in mode, the counting is only done in case the
+ * FrameAllocationHook library (that replace the global operator new) is
+ * linked (see the FRAME_ALLOCATION_TRACKING cmake option). Otherwise all the
+ * stats stay at 0 and IsEnabled return false.
+ */
+class AllocationTracker
+{
+  private:
+    AllocationTracker() = default;
+
+  public:
+    //! @brief Get the instance of the tracker.
+    static AllocationTracker& GetInstance();
+    /**
+     * @brief Record an allocation, called from the operator new hook so this
+     *        should never allocate.
+     * @param size: Size of the allocation in bytes.
+     */
+    static void Record(std::size_t size) noexcept;
+
+  public:
+    /**
+     * @brief Check if allocations are tracked (hook linked).
+     * @return True if allocations are counted.
+     */
+    bool IsEnabled() const;
+    /**
+     * @brief Get the allocations since the start of the program.
+     * @return The total allocation stats.
+     */
+    AllocationStats GetTotalStats() const;
+    //! @brief Start counting the allocations of a frame.
+    void BeginFrame();
+    //! @brief Stop counting the allocations of a frame.
+    void EndFrame();
+    /**
+     * @brief Get the allocations of the last frame (between the last call to
+     *        BeginFrame and EndFrame).
+     * @return The allocation stats of the last frame.
+     */
+    AllocationStats GetFrameStats() const
+    {
+        return frame_stats_;
+    }
+
+  private:
+    AllocationStats frame_begin_stats_ = {};
+    AllocationStats frame_stats_ = {};
+};
+
+} // End namespace frame.
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+#include <span>
+
+namespace frame
+{
+
+/**
+ * @class AxisAlignedBoundingBox
+ * @brief Box aligned on the axis that contain a mesh (in local or in world
+ *        space). The default box is empty (min bigger than max).
+ */
+struct AxisAlignedBoundingBox
+{
+    /**
+     * @brief Check if the box is empty (nothing was added to it).
+     * @return True if empty.
+     */
+    bool IsEmpty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+    /**
+     * @brief Grow the box so it contain the point.
+     * @param point: The point to be added.
+     */
+    void Extend(glm::vec3 point);
+    /**
+     * @brief Compute the box that contain this box transformed by a matrix
+     *        (local to world space).
+     * @param matrix: The transform (affine).
+     * @return The transformed box (empty in case this one is).
+     */
+    AxisAlignedBoundingBox Transform(const glm::mat4& matrix) const;
+
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+};
+
+/**
+ * @brief Compute the bounding box of a point buffer.
+ * @param points: The point buffer (as it is sent to the GPU).
+ * @param point_size: Number of floats per point (should be 3).
+ * @return The bounding box of the points (empty if no point).
+ */
+AxisAlignedBoundingBox ComputeBoundingBox(
+    std::span<const float> points, std::uint32_t point_size = 3);
+
+} // End namespace frame.
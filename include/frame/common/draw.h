@@ -130,6 +130,7 @@ class Draw : public frame::PluginInterface
     frame::DeviceInterface& device_;
     std::string name_;
     double dt_ = 0.0;
+    bool started_ = false;
 };
 
 } // End namespace frame::common.
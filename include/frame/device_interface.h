@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <string>
 
 #include "frame/api.h"
 #include "frame/buffer_interface.h"
+#include "frame/dynamic_resolution.h"
 #include "frame/level_interface.h"
 #include "frame/plugin_interface.h"
 #include "frame/texture_interface.h"
@@ -12,6 +15,18 @@
 namespace frame
 {
 
+/**
+ * @class CaptureStats
+ * @brief Frames of a capture, the dropped ones are the frames that were not
+ *        written as the encoders were behind.
+ */
+struct CaptureStats
+{
+    std::uint64_t captured = 0;
+    std::uint64_t written = 0;
+    std::uint64_t dropped = 0;
+};
+
 /**
  * @class DeviceInterface
  * @brief This is the interface for the device, all the function should be
@@ -40,9 +55,10 @@ class DeviceInterface
         std::unique_ptr<PluginInterface>&& plugin_interface) = 0;
     /**
      * @brief Get a list of plugin.
-     * @return A list of pointer to plugin.
+     * @return A list of pointer to plugin, invalidated by AddPlugin and
+     *         RemovePluginByName.
      */
-    virtual std::vector<PluginInterface*> GetPluginPtrs() = 0;
+    virtual const std::vector<PluginInterface*>& GetPluginPtrs() = 0;
     /**
      * @brief Get name and id of plugin.
      * @return A map containing names and id of plugin.
@@ -85,6 +101,31 @@ class DeviceInterface
      * @param file: File name to write the screenshot to (*.png).
      */
     virtual void ScreenShot(const std::string& file) const = 0;
+    /**
+     * @brief Make a screenshot of current frame without waiting for the
+     *        GPU, the file is written by a later display.
+     * @param file: File name to write the screenshot to (*.png).
+     */
+    virtual void ScreenShotAsync(const std::string& file) = 0;
+    /**
+     * @brief Start capturing the frames to a numbered image sequence
+     *        (prefix_000000.png...), the frames are read back without
+     *        waiting and written by a pool of threads.
+     * @param prefix: Path and start of the file names.
+     * @param frame_interval: Capture one frame every frame_interval.
+     * @param duration_s: Duration of the capture in seconds (0 until
+     *        stopped).
+     */
+    virtual void StartCapture(
+        const std::filesystem::path& prefix,
+        std::uint32_t frame_interval = 1,
+        double duration_s = 0.0) = 0;
+    //! @brief Stop the capture (wait for the frames in flight).
+    virtual void StopCapture() = 0;
+    //! @brief Check if the frames are captured.
+    virtual bool IsCapturing() const = 0;
+    //! @brief Get the frames of the current (or last) capture.
+    virtual CaptureStats GetCaptureStats() const = 0;
     /**
      * @brief Set the stereo mode (by default this is NONE), interocular
      *        distance and focus point.
@@ -120,6 +161,11 @@ class DeviceInterface
      * @return Return the focus point.
      */
     virtual glm::vec3 GetFocusPoint() const = 0;
+    /**
+     * @brief Get the dynamic resolution controller (disabled by default).
+     * @return The controller of the scale of the render.
+     */
+    virtual DynamicResolution& GetDynamicResolution() = 0;
     /**
      * @brief Create a point buffer from a vector of floats.
      * @param device: A pointer to a device.
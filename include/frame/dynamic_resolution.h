@@ -0,0 +1,110 @@
+#pragma once
+
+namespace frame
+{
+
+enum class UpscaleFilterEnum
+{
+    BILINEAR = 0,
+    EDGE_AWARE = 1
+};
+
+/**
+ * @class DynamicResolution
+ * @brief Scale the internal resolution of the window relative textures to
+ *        keep the GPU time of a frame under a budget.
+ *
+ * The time measured is smoothed, the scale only move by steps (to avoid
+ * rebuilding the textures every frame) and a change is followed by a few
+ * measures without change (the measure is a few frames late).
+ */
+class DynamicResolution
+{
+  public:
+    /**
+     * @brief Update the scale from the GPU time of a frame, called once per
+     *        new measure (the frames are measured a few frames late).
+     * @param gpu_time_ms: GPU time of the frame (0 if not measured).
+     * @return True if the scale changed.
+     */
+    bool Update(double gpu_time_ms);
+    /**
+     * @brief Enable or disable the scaling, disabled the scale is reset to
+     *        the max scale.
+     * @param enabled: Enable the scaling.
+     */
+    void SetEnabled(bool enabled);
+    //! @brief Check if the scaling is enabled.
+    bool IsEnabled() const
+    {
+        return enabled_;
+    }
+    /**
+     * @brief Set the frame time budget.
+     * @param target_frame_time_ms: Target time in milliseconds (positive).
+     */
+    void SetTargetFrameTime(double target_frame_time_ms);
+    //! @brief Get the frame time budget (in milliseconds).
+    double GetTargetFrameTime() const
+    {
+        return target_frame_time_ms_;
+    }
+    /**
+     * @brief Set the bounds of the scale (the current scale is clamped).
+     * @param min_scale: Minimum scale (in ]0, max_scale]).
+     * @param max_scale: Maximum scale (in [min_scale, 1]).
+     */
+    void SetScaleBounds(float min_scale, float max_scale);
+    //! @brief Get the minimum scale.
+    float GetMinScale() const
+    {
+        return min_scale_;
+    }
+    //! @brief Get the maximum scale.
+    float GetMaxScale() const
+    {
+        return max_scale_;
+    }
+    //! @brief Get the current scale (of each axis).
+    float GetScale() const
+    {
+        return scale_;
+    }
+    //! @brief Get the smoothed GPU time (in milliseconds).
+    double GetGpuTime() const
+    {
+        return gpu_time_ms_;
+    }
+    /**
+     * @brief Set the filter used to upscale in the display pass.
+     * @param upscale_filter: The filter.
+     */
+    void SetUpscaleFilter(UpscaleFilterEnum upscale_filter)
+    {
+        upscale_filter_ = upscale_filter;
+    }
+    //! @brief Get the filter used to upscale in the display pass.
+    UpscaleFilterEnum GetUpscaleFilter() const
+    {
+        return upscale_filter_;
+    }
+
+  public:
+    // Smallest change of the scale.
+    static constexpr float scale_step = 0.05f;
+    // Measures without change after a change (more than the frames in
+    // flight, so the measures of the previous scale are skipped).
+    static constexpr int cooldown_frames = 4;
+
+  private:
+    bool enabled_ = false;
+    double target_frame_time_ms_ = 1000.0 / 60.0;
+    float min_scale_ = 0.5f;
+    float max_scale_ = 1.0f;
+    float scale_ = 1.0f;
+    double gpu_time_ms_ = 0.0;
+    int cooldown_ = 0;
+    UpscaleFilterEnum upscale_filter_ = UpscaleFilterEnum::BILINEAR;
+};
+
+} // End namespace frame.
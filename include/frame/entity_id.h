@@ -25,6 +25,10 @@ enum class EntityTypeEnum : std::uint8_t
  * @brief This is used by the code to have an abstraction from pointer to
  *        structure see data based programming. All object are represented
  *        by Id that are stored in the level structure.
+ *
+ * The id is packed as: [type: 8 bits][generation: 24 bits][index: 32 bits].
+ * The index is the slot inside the per type storage, the generation is
+ * increased every time a slot is reused so stale ids can be detected.
  */
 using EntityId = std::int64_t;
 /**
@@ -33,4 +37,52 @@ using EntityId = std::int64_t;
  */
 constexpr EntityId NullId = 0;
 
+//! @brief Mask for the generation part of an entity id.
+constexpr std::uint32_t EntityGenerationMask = 0x00ffffff;
+
+/**
+ * @brief Pack a type, a generation and a slot index into an entity id.
+ * @param type: Type of the entity.
+ * @param generation: Generation of the slot (only 24 bits are kept).
+ * @param index: Index of the slot in the storage.
+ * @return The packed entity id.
+ */
+constexpr EntityId MakeEntityId(
+    EntityTypeEnum type, std::uint32_t generation, std::uint32_t index)
+{
+    return (static_cast<EntityId>(type) << 56) |
+           (static_cast<EntityId>(generation & EntityGenerationMask) << 32) |
+           static_cast<EntityId>(index);
+}
+
+/**
+ * @brief Get the type part of an entity id.
+ * @param id: Entity id.
+ * @return The type stored in the id.
+ */
+constexpr EntityTypeEnum GetEntityTypeFromId(EntityId id)
+{
+    return static_cast<EntityTypeEnum>((id >> 56) & 0xff);
+}
+
+/**
+ * @brief Get the generation part of an entity id.
+ * @param id: Entity id.
+ * @return The generation stored in the id.
+ */
+constexpr std::uint32_t GetEntityGenerationFromId(EntityId id)
+{
+    return static_cast<std::uint32_t>(id >> 32) & EntityGenerationMask;
+}
+
+/**
+ * @brief Get the slot index part of an entity id.
+ * @param id: Entity id.
+ * @return The slot index stored in the id.
+ */
+constexpr std::uint32_t GetEntityIndexFromId(EntityId id)
+{
+    return static_cast<std::uint32_t>(id & 0xffffffff);
+}
+
 } // End namespace frame.
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+
+#include "frame/bounding_box.h"
+
+namespace frame
+{
+
+/**
+ * @class Frustum
+ * @brief The 6 planes of the volume seen by a projection and a view matrix,
+ *        used to skip the meshes that are not on screen.
+ *
+ * The planes are stored by component (all the x, then all the y...) so that
+ * a box is tested against 4 planes at a time (SSE in case it is available).
+ */
+class Frustum
+{
+  public:
+    /**
+     * @brief Extract the planes from a projection and a view matrix.
+     * @param projection: Projection matrix.
+     * @param view: View matrix.
+     */
+    Frustum(const glm::mat4& projection, const glm::mat4& view);
+
+  public:
+    /**
+     * @brief Check if a box (in world space) is in the frustum, this is
+     *        conservative: a box near a corner can be visible and still be
+     *        outside.
+     * @param box: Bounding box in world space (not empty).
+     * @return True if the box is (maybe) visible.
+     */
+    bool IsVisible(const AxisAlignedBoundingBox& box) const;
+    /**
+     * @brief Check a list of boxes (in world space).
+     * @param boxes: Bounding boxes in world space (not empty).
+     * @param visibility: Set to 1 if the box is visible 0 otherwise (same
+     *        size as boxes).
+     * @return Number of visible boxes.
+     */
+    std::uint32_t CullBoxes(
+        std::span<const AxisAlignedBoundingBox> boxes,
+        std::span<std::uint8_t> visibility) const;
+
+  private:
+    // 6 planes and 2 that contain everything to have 2 groups of 4.
+    static constexpr std::size_t plane_count_ = 8;
+    alignas(16) std::array<float, plane_count_> x_ = {};
+    alignas(16) std::array<float, plane_count_> y_ = {};
+    alignas(16) std::array<float, plane_count_> z_ = {};
+    alignas(16) std::array<float, plane_count_> w_ = {};
+};
+
+} // End namespace frame.
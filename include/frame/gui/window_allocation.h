@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+
+#include "frame/allocation_tracker.h"
+#include "frame/api.h"
+#include "frame/gui/draw_gui_interface.h"
+
+namespace frame::gui
+{
+
+/**
+ * @class WindowAllocation
+ * @brief Display the heap allocations of the last frame (need the allocation
+ *        tracking to be enabled).
+ */
+class WindowAllocation : public GuiWindowInterface
+{
+  public:
+    WindowAllocation(const std::string& name);
+    virtual ~WindowAllocation() = default;
+
+  public:
+    //! @brief Draw callback setting.
+    bool DrawCallback() override;
+    /**
+     * @brief Get the name of the window.
+     * @return The name of the window.
+     */
+    std::string GetName() const override;
+    /**
+     * @brief Set the name of the window.
+     * @param name: The name of the window.
+     */
+    void SetName(const std::string& name) override;
+    /**
+     * @brief Check if this is the end of the software.
+     * @return True if this is the end false if not.
+     */
+    bool End() const override;
+
+  private:
+    frame::AllocationTracker& allocation_tracker_ =
+        frame::AllocationTracker::GetInstance();
+    std::string name_;
+};
+
+} // namespace frame::gui
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "frame/api.h"
+#include "frame/dynamic_resolution.h"
+#include "frame/gui/draw_gui_interface.h"
+
+namespace frame::gui
+{
+
+/**
+ * @class WindowDynamicResolution
+ * @brief Display the current scale of the render and edit the frame time
+ *        budget, the scale bounds and the upscale filter.
+ */
+class WindowDynamicResolution : public GuiWindowInterface
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param name: The name of the window.
+     * @param dynamic_resolution: The controller (from the device).
+     */
+    WindowDynamicResolution(
+        const std::string& name, DynamicResolution& dynamic_resolution);
+    virtual ~WindowDynamicResolution() = default;
+
+  public:
+    //! @brief Draw callback setting.
+    bool DrawCallback() override;
+    /**
+     * @brief Get the name of the window.
+     * @return The name of the window.
+     */
+    std::string GetName() const override;
+    /**
+     * @brief Set the name of the window.
+     * @param name: The name of the window.
+     */
+    void SetName(const std::string& name) override;
+    /**
+     * @brief Check if this is the end of the software.
+     * @return True if this is the end false if not.
+     */
+    bool End() const override;
+
+  private:
+    DynamicResolution& dynamic_resolution_;
+    // Has to correspond to the order of UpscaleFilterEnum.
+    const std::vector<std::string> upscale_filter_items_ = {
+        "Bilinear",
+        "Edge aware",
+    };
+    std::string name_;
+};
+
+} // End namespace frame::gui.
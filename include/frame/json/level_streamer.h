@@ -0,0 +1,157 @@
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame/json/proto.h"
+#include "frame/level_interface.h"
+#include "frame/logger.h"
+#include "frame/opengl/file/load_static_mesh.h"
+
+namespace frame::proto
+{
+
+/**
+ * @brief State of a level fragment in the streamer.
+ */
+enum class FragmentStateEnum
+{
+    UNKNOWN = 0,
+    LOADING = 1,
+    COMMITTING = 2,
+    LOADED = 3,
+    FAILED = 4,
+};
+
+/**
+ * @class LevelStreamer
+ * @brief Stream level fragments in a level that is already rendering.
+ *
+ * A fragment is a JSON file in the level format (textures, programs,
+ * materials and scene tree), it can use elements of the level (or of
+ * fragments loaded before it) by name. Files are read, parsed, their
+ * images decoded and their mesh files parsed on a background thread, the
+ * OpenGL objects are then created by Update (on the rendering thread) one
+ * element at a time until the frame budget is used.
+ */
+class LevelStreamer
+{
+  public:
+    /**
+     * @brief Constructor, start the background thread.
+     * @param level: The level the fragments are added to.
+     * @param size: Screen size (for textures with a relative size).
+     */
+    LevelStreamer(LevelInterface& level, glm::uvec2 size);
+    //! @brief Destructor, stop the background thread.
+    ~LevelStreamer();
+
+  public:
+    /**
+     * @brief Start loading a fragment in the background.
+     * @param name: Name of the fragment (used to unload it).
+     * @param path: Path to the JSON file of the fragment.
+     */
+    void LoadFragment(
+        const std::string& name, const std::filesystem::path& path);
+    /**
+     * @brief Remove everything a fragment added to the level, a fragment
+     *        that is still loading is cancelled.
+     * @param name: Name of the fragment.
+     */
+    void UnloadFragment(const std::string& name);
+    /**
+     * @brief Add the loaded fragments to the level, this should be called
+     *        once per frame from the rendering thread.
+     * @param budget: Time that can be spent this frame (at least one element
+     *        is added per call).
+     */
+    void Update(std::chrono::microseconds budget);
+    /**
+     * @brief Get the state of a fragment.
+     * @param name: Name of the fragment.
+     * @return The state (UNKNOWN if never loaded or unloaded).
+     */
+    FragmentStateEnum GetFragmentState(const std::string& name) const;
+    /**
+     * @brief Check if there is nothing to load or add to the level.
+     * @return True if all the fragments are loaded (or failed).
+     */
+    bool IsIdle() const;
+
+  protected:
+    //! @brief A request to the background thread.
+    struct LoadRequest
+    {
+        std::string name;
+        std::filesystem::path path;
+        std::uint64_t serial = 0;
+    };
+    //! @brief Mesh files of the static meshes (by index in the scene tree).
+    using StaticMeshFiles =
+        std::vector<std::optional<opengl::file::StaticMeshFile>>;
+    //! @brief A fragment parsed by the background thread.
+    struct LoadResult
+    {
+        std::string name;
+        std::uint64_t serial = 0;
+        proto::Level proto_level;
+        StaticMeshFiles static_mesh_files;
+        std::string error;
+    };
+    //! @brief A fragment as seen from the rendering thread.
+    struct Fragment
+    {
+        FragmentStateEnum state = FragmentStateEnum::LOADING;
+        std::uint64_t serial = 0;
+        proto::Level proto_level;
+        StaticMeshFiles static_mesh_files = {};
+        std::size_t step = 0;
+        std::size_t step_count = 0;
+        std::chrono::microseconds commit_time{0};
+        // Entities added to the level (in order).
+        std::vector<EntityId> entity_ids = {};
+    };
+
+  protected:
+    //! @brief Background thread loop.
+    void WorkerLoop();
+    /**
+     * @brief Add the next element of a fragment to the level.
+     * @param fragment: The fragment being committed.
+     */
+    void CommitStep(Fragment& fragment);
+    /**
+     * @brief Remove the entities a fragment added to the level.
+     * @param fragment: The fragment to be removed.
+     */
+    void RemoveEntities(Fragment& fragment);
+
+  protected:
+    LevelInterface& level_;
+    glm::uvec2 size_;
+    Logger& logger_ = Logger::GetInstance();
+    std::uint64_t next_serial_ = 1;
+    // Only used from the rendering thread.
+    absl::flat_hash_map<std::string, Fragment> fragment_map_ = {};
+    std::deque<std::string> commit_queue_ = {};
+    std::vector<LoadResult> received_results_ = {};
+    // Shared with the background thread (protected by the mutex).
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<LoadRequest> requests_ = {};
+    std::vector<LoadResult> results_ = {};
+    bool stop_ = false;
+    std::thread worker_;
+};
+
+} // End namespace frame::proto.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include "frame/json/proto.h"
 
 namespace frame::proto
@@ -69,5 +71,11 @@ PixelStructure PixelStructure_BGR_ALPHA();
  * @return Are they equal or not?
  */
 bool operator==(const PixelStructure& l, const PixelStructure& r);
+/**
+ * @brief Get the number of components (channels) of a pixel structure.
+ * @param pixel_structure: The pixel structure (BGR is 3 and BGR_ALPHA 4).
+ * @return The number of components (throw in case of INVALID).
+ */
+std::size_t GetComponentCount(PixelStructure::Enum pixel_structure);
 
 } // End namespace frame::proto.
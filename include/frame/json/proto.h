@@ -14,6 +14,7 @@
 #include "frame/proto/pixel.pb.h"
 #include "frame/proto/plugin.pb.h"
 #include "frame/proto/program.pb.h"
+#include "frame/proto/render_job.pb.h"
 #include "frame/proto/scene.pb.h"
 #include "frame/proto/size.pb.h"
 #include "frame/proto/texture.pb.h"
@@ -1,12 +1,23 @@
 #pragma once
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/container/node_hash_map.h>
+#include <algorithm>
 #include <cinttypes>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "frame/device_interface.h"
 #include "frame/level_interface.h"
 #include "frame/logger.h"
+#include "frame/slot_map.h"
 
 namespace frame
 {
@@ -50,7 +61,7 @@ class Level : public LevelInterface
      */
     NodeInterface& GetSceneNodeFromId(EntityId id) const override
     {
-        return *id_scene_node_map_.at(id).get();
+        return scene_node_map_.At(Handle<NodeInterface>(id));
     }
     /**
      * @brief Will get the texture from an id.
@@ -59,7 +70,7 @@ class Level : public LevelInterface
      */
     TextureInterface& GetTextureFromId(EntityId id) const override
     {
-        return *id_texture_map_.at(id).get();
+        return texture_map_.At(Handle<TextureInterface>(id));
     }
     /**
      * @brief Will get the program from an id.
@@ -68,7 +79,7 @@ class Level : public LevelInterface
      */
     ProgramInterface& GetProgramFromId(EntityId id) const override
     {
-        return *id_program_map_.at(id).get();
+        return program_map_.At(Handle<ProgramInterface>(id));
     }
     /**
      * @brief Will get a material from an id.
@@ -77,7 +88,7 @@ class Level : public LevelInterface
      */
     MaterialInterface& GetMaterialFromId(EntityId id) const override
     {
-        return *id_material_map_.at(id).get();
+        return material_map_.At(Handle<MaterialInterface>(id));
     }
     /**
      * @brief Will get a buffer from an id.
@@ -86,7 +97,7 @@ class Level : public LevelInterface
      */
     BufferInterface& GetBufferFromId(EntityId id) const override
     {
-        return *id_buffer_map_.at(id).get();
+        return buffer_map_.At(Handle<BufferInterface>(id));
     }
     /**
      * @brief Will get a static mesh from an id.
@@ -95,16 +106,16 @@ class Level : public LevelInterface
      */
     StaticMeshInterface& GetStaticMeshFromId(EntityId id) const override
     {
-        return *id_static_mesh_map_.at(id).get();
+        return static_mesh_map_.At(Handle<StaticMeshInterface>(id));
     }
     /**
      * @brief Get a vector of static mesh id and corresponding material id.
      * @return Vector of static mesh id and corresponding material id and
      * RenderTimeEnum.
      */
-    std::vector<std::pair<
+    const std::vector<std::pair<
         EntityId,
-        std::tuple<EntityId, proto::SceneStaticMesh::RenderTimeEnum>>>
+        std::tuple<EntityId, proto::SceneStaticMesh::RenderTimeEnum>>>&
     GetStaticMeshMaterialIds() const override
     {
         return mesh_material_ids_;
@@ -134,6 +145,23 @@ class Level : public LevelInterface
     {
         default_texture_name_ = name;
     }
+    /**
+     * @brief Enable or disable the occlusion culling of the meshes (the
+     *        meshes then share the depth buffer).
+     * @param enable: Enable or disable.
+     */
+    void SetOcclusionCulling(bool enable) override
+    {
+        occlusion_culling_ = enable;
+    }
+    /**
+     * @brief Check if the meshes are occlusion culled.
+     * @return True if enabled.
+     */
+    bool IsOcclusionCulling() const override
+    {
+        return occlusion_culling_;
+    }
     /**
      * @brief Get default root scene node id (this is the root of the scene
      *        tree).
@@ -175,16 +203,14 @@ class Level : public LevelInterface
     {
         mesh_material_ids_.push_back(
             {node_id, {material_id, render_time_enum}});
+        ++version_;
     }
     /**
      * @brief Get enum type from Id.
      * @param id: Id to be returned.
      * @return An enum type.
      */
-    EntityTypeEnum GetEnumTypeFromId(EntityId id) const override
-    {
-        return id_enum_map_.at(id);
-    }
+    EntityTypeEnum GetEnumTypeFromId(EntityId id) const override;
     /**
      * @brief Get name.
      * @return Name.
@@ -219,6 +245,13 @@ class Level : public LevelInterface
      * @return Id of the element or error.
      */
     EntityId GetIdFromName(const std::string& name) const override;
+    /**
+     * @brief Try to get the id of an element from a name string (no log).
+     * @param name: The name string of the element.
+     * @return Id of the element or nullopt.
+     */
+    std::optional<EntityId> TryGetIdFromName(
+        std::string_view name) const override;
     /**
      * @brief Get the name of an element given an id.
      * @param id: Id of the element to get the name.
@@ -261,6 +294,50 @@ class Level : public LevelInterface
      * @param buffer: The buffer id to be removed.
      */
     void RemoveBuffer(EntityId buffer) override;
+    /**
+     * @brief Remove a scene node and its children (the whole subtree) from
+     *        the level, they are not rendered anymore.
+     * @param id: The scene node id to be removed.
+     */
+    void RemoveSceneNode(EntityId id) override;
+    /**
+     * @brief Remove a scene node from the level but not its children, they
+     *        wait for a node with the same name to be added again (used to
+     *        swap a node, as the level streamer does with fragments).
+     * @param id: The scene node id to be removed.
+     */
+    void RemoveSceneNodeKeepChildren(EntityId id) override;
+    /**
+     * @brief Remove a texture from the level, it is also removed from the
+     *        materials and programs that use it.
+     * @param id: The texture id to be removed.
+     */
+    void RemoveTexture(EntityId id) override;
+    /**
+     * @brief Remove a program from the level, the meshes using a material
+     *        with this program are not rendered anymore.
+     * @param id: The program id to be removed.
+     */
+    void RemoveProgram(EntityId id) override;
+    /**
+     * @brief Remove a material from the level, the meshes using it are not
+     *        rendered anymore.
+     * @param id: The material id to be removed.
+     */
+    void RemoveMaterial(EntityId id) override;
+    /**
+     * @brief Remove a static mesh from the level (its buffers are removed
+     *        with it), the nodes using it are not rendered anymore.
+     * @param id: The static mesh id to be removed.
+     */
+    void RemoveStaticMesh(EntityId id) override;
+    /**
+     * @brief Destroy the entities removed (or replaced) since the last
+     *        call, this should be called once the frame is done with them
+     *        (removed entities stay alive until then, so removing in the
+     *        middle of a frame is safe). Removed ids can be reused.
+     */
+    void DestroyRemovedEntities() override;
     /**
      * @brief Add a static mesh to the level.
      * @param static_mesh: Move a buffer in the level.
@@ -281,6 +358,74 @@ class Level : public LevelInterface
      * @return Parent node id.
      */
     EntityId GetParentId(EntityId id) const override;
+    /**
+     * @brief Change the parent of a node already in the level.
+     * @param id: The node to be reparented.
+     * @param parent_name: Name of the new parent (can be added later).
+     */
+    void SetParentName(EntityId id, const std::string& parent_name) override;
+    /**
+     * @brief Recompute the world transforms of dirty nodes (and their
+     *        subtrees), cost scale with the number of changed nodes.
+     * @param dt: Delta time from the beginning of the software in seconds.
+     */
+    void UpdateTransforms(double dt) override;
+    /**
+     * @brief Get the cached world transform of a node.
+     * @param id: The node id.
+     * @return The world transform of the node.
+     */
+    const glm::mat4& GetWorldTransform(EntityId id) const override;
+    /**
+     * @brief Fill the back scene state and swap it with the front one, the
+     *        back state is reused when no reader hold it anymore.
+     * @param dt: Delta time from the beginning of the software in seconds.
+     */
+    void PublishSceneState(double dt) override;
+    /**
+     * @brief Get the last published scene state (thread safe).
+     * @return The last snapshot or null if nothing was published yet.
+     */
+    std::shared_ptr<const SceneState> GetSceneState() const override;
+    /**
+     * @brief Set a float uniform of a program (for the next publish).
+     * @param program_id: The program id.
+     * @param name: Name of the uniform.
+     * @param values: Values of the uniform.
+     * @param size: Size of the value.
+     */
+    void SetProgramUniform(
+        EntityId program_id,
+        const std::string& name,
+        const std::vector<float>& values,
+        glm::uvec2 size = {1, 1}) override;
+    /**
+     * @brief Set an int uniform of a program (for the next publish).
+     * @param program_id: The program id.
+     * @param name: Name of the uniform.
+     * @param values: Values of the uniform.
+     * @param size: Size of the value.
+     */
+    void SetProgramUniform(
+        EntityId program_id,
+        const std::string& name,
+        const std::vector<std::int32_t>& values,
+        glm::uvec2 size = {1, 1}) override;
+    /**
+     * @brief Stop setting a uniform of a program.
+     * @param program_id: The program id.
+     * @param name: Name of the uniform.
+     */
+    void RemoveProgramUniform(
+        EntityId program_id, const std::string& name) override;
+    /**
+     * @brief Get the version of the level.
+     * @return The current version.
+     */
+    std::uint64_t GetVersion() const override
+    {
+        return version_;
+    }
     /**
      * @brief Get all texture from the level.
      * @return A vector of texture ids.
@@ -322,81 +467,158 @@ class Level : public LevelInterface
 
   protected:
     /**
-     * @brief Increase the internal counter and return the value.
-     * @return Current counter + 1.
+     * @brief Register the name of a newly added element.
+     * @param id: Id of the element.
+     * @param name: Name of the element (stored once).
      */
-    EntityId GetTextureNewId() const
-    {
-        return ++next_id_maker_;
-    }
+    void InsertName(EntityId id, const std::string& name);
     /**
-     * @brief Increase the internal counter and return the value.
-     * @return Current counter + 1.
+     * @brief Remove the name of an element.
+     * @param id: Id of the element.
      */
-    EntityId GetProgramNewId() const
-    {
-        return ++next_id_maker_;
-    }
+    void EraseName(EntityId id);
     /**
-     * @brief Increase the internal counter and return the value.
-     * @return Current counter + 1.
+     * @brief Check that a name is not used yet.
+     * @param name: Name to be checked.
      */
-    EntityId GetMaterialNewId() const
-    {
-        return ++next_id_maker_;
-    }
+    void CheckNameIsFree(const std::string& name) const;
     /**
-     * @brief Increase the internal counter and return the value.
-     * @return Current counter + 1.
+     * @brief Erase an element from its storage and its name.
+     * @param slot_map: Storage of the element.
+     * @param id: Id of the element.
      */
-    EntityId GetBufferNewId() const
+    template <typename T>
+    void EraseEntity(SlotMap<T>& slot_map, EntityId id)
     {
-        return ++next_id_maker_;
+        Handle<T> handle(id);
+        if (!slot_map.Contains(handle))
+        {
+            throw std::runtime_error(
+                fmt::format("No entity with id #{}.", id));
+        }
+        // Destroyed later (see DestroyRemovedEntities).
+        removed_entities_.push_back(slot_map.Extract(handle));
+        EraseName(id);
+        ++version_;
     }
     /**
-     * @brief Increase the internal counter and return the value.
-     * @return Current counter + 1.
+     * @brief Stop rendering the mesh nodes that match a predicate.
+     * @param predicate: Called with (node id, material id).
      */
-    EntityId GetStaticMeshNewId() const
+    template <typename Predicate>
+    void EraseMeshMaterialIds(Predicate&& predicate)
     {
-        return ++next_id_maker_;
+        std::erase_if(mesh_material_ids_, [&predicate](const auto& pair) {
+            return predicate(pair.first, std::get<0>(pair.second));
+        });
     }
     /**
-     * @brief Increase the internal counter and return the value.
-     * @return Current counter + 1.
+     * @brief Insert a node in the parent/children index, in case the parent
+     *        is not in the level yet the node wait for it.
+     * @param id: The node to be linked to its parent.
      */
-    EntityId GetSceneNodeNewId() const
-    {
-        return ++next_id_maker_;
-    }
+    void LinkSceneNode(EntityId id);
+    /**
+     * @brief Remove a node from the parent/children index (as a child).
+     * @param id: The node to be unlinked from its parent.
+     */
+    void UnlinkSceneNode(EntityId id);
+    /**
+     * @brief Mark the transform of a node (and so its subtree) dirty.
+     * @param id: The node id.
+     */
+    void MarkTransformDirty(EntityId id);
+    /**
+     * @brief Check if one of the ancestors of a node is dirty (in this case
+     *        it will recompute the node as part of its subtree).
+     * @param id: The node id.
+     * @return True if an ancestor is dirty.
+     */
+    bool HasDirtyAncestor(EntityId id) const;
+    /**
+     * @brief Get the uniform of a program to be set (added if needed).
+     * @param program_id: The program id (has to be in the level).
+     * @param name: Name of the uniform.
+     * @param size: Size of the value.
+     * @return The uniform (its values have to be set).
+     */
+    SceneUniform& GetProgramUniform(
+        EntityId program_id, const std::string& name, glm::uvec2 size);
 
   protected:
     Logger& logger_ = Logger::GetInstance();
-    mutable EntityId next_id_maker_ = NullId;
+    std::uint64_t version_ = 0;
     EntityId quad_id_ = 0;
     EntityId cube_id_ = 0;
     std::string name_;
     std::string default_texture_name_;
     std::string default_root_scene_node_name_;
     std::string default_camera_name_;
-    // These are storage so unique ptr interface.
-    std::map<EntityId, std::unique_ptr<NodeInterface>> id_scene_node_map_ = {};
-    std::map<EntityId, std::unique_ptr<TextureInterface>> id_texture_map_ = {};
-    std::map<EntityId, std::unique_ptr<ProgramInterface>> id_program_map_ = {};
-    std::map<EntityId, std::unique_ptr<MaterialInterface>> id_material_map_ =
-        {};
-    std::map<EntityId, std::unique_ptr<BufferInterface>> id_buffer_map_ = {};
-    std::map<EntityId, std::unique_ptr<StaticMeshInterface>>
-        id_static_mesh_map_ = {};
-    // These are storage specifiers.
-    std::set<std::string> string_set_ = {};
-    std::map<std::string, EntityId> name_id_map_ = {};
-    std::map<EntityId, std::string> id_name_map_ = {};
-    std::map<EntityId, EntityTypeEnum> id_enum_map_ = {};
+    bool occlusion_culling_ = false;
+    // These are storage so unique ptr interface (O(1) access by handle).
+    SlotMap<NodeInterface> scene_node_map_{EntityTypeEnum::NODE};
+    SlotMap<TextureInterface> texture_map_{EntityTypeEnum::TEXTURE};
+    SlotMap<ProgramInterface> program_map_{EntityTypeEnum::PROGRAM};
+    SlotMap<MaterialInterface> material_map_{EntityTypeEnum::MATERIAL};
+    SlotMap<BufferInterface> buffer_map_{EntityTypeEnum::BUFFER};
+    SlotMap<StaticMeshInterface> static_mesh_map_{EntityTypeEnum::STATIC_MESH};
+    // These are storage specifiers, names are interned in the id to name
+    // map (node map so the string addresses are stable) and the name to id
+    // map only hold views on them.
+    absl::node_hash_map<EntityId, std::string> id_name_map_ = {};
+    absl::flat_hash_map<std::string_view, EntityId> name_id_map_ = {};
     std::vector<std::pair<
         EntityId,
         std::tuple<EntityId, proto::SceneStaticMesh::RenderTimeEnum>>>
         mesh_material_ids_ = {};
+    // Scene tree index (parent -> children and child -> parent), nodes
+    // which parent is not loaded yet wait in the pending map (by name).
+    absl::flat_hash_map<EntityId, std::vector<EntityId>> children_map_ = {};
+    absl::flat_hash_map<EntityId, EntityId> parent_map_ = {};
+    absl::flat_hash_map<std::string, std::vector<EntityId>>
+        pending_children_map_ = {};
+    //! @brief Cached transforms of a scene node.
+    struct TransformCache
+    {
+        glm::mat4 local = glm::mat4(1.0f);
+        glm::mat4 world = glm::mat4(1.0f);
+        bool dirty = false;
+    };
+    absl::flat_hash_map<EntityId, TransformCache> transform_map_ = {};
+    std::vector<EntityId> dirty_transforms_ = {};
+    absl::flat_hash_set<EntityId> time_dependent_nodes_ = {};
+    std::optional<double> last_transform_dt_ = std::nullopt;
+    // Kept to avoid an allocation per frame.
+    std::vector<EntityId> transform_stack_ = {};
+    // Entities removed from the level that are still alive until the end of
+    // the frame (so GPU objects are not deleted while in use).
+    std::vector<std::unique_ptr<NameInterface>> removed_entities_ = {};
+    std::vector<std::unique_ptr<NameInterface>> destroyed_entities_ = {};
+    //! @brief Order by program id then name (with string view lookup).
+    struct ProgramUniformLess
+    {
+        using is_transparent = void;
+        template <typename Left, typename Right>
+        bool operator()(const Left& left, const Right& right) const
+        {
+            if (left.first != right.first)
+                return left.first < right.first;
+            return std::string_view(left.second) <
+                   std::string_view(right.second);
+        }
+    };
+    // Uniforms set to the programs by (program id, name), published with
+    // the scene state.
+    std::map<std::pair<EntityId, std::string>, SceneUniform, ProgramUniformLess>
+        program_uniforms_ = {};
+    // Scene state snapshots, readers get the front one (under the mutex)
+    // and the states are filled once no reader hold them (see
+    // SceneStatePool).
+    mutable std::mutex scene_state_mutex_;
+    std::shared_ptr<SceneStatePool> scene_state_pool_ =
+        std::make_shared<SceneStatePool>();
+    std::shared_ptr<SceneState> front_scene_state_ = nullptr;
+    std::uint64_t scene_state_frame_ = 0;
 };
 
 } // End namespace frame.
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <optional>
+#include <string_view>
 #include <unordered_map>
 
 #include "frame/buffer_interface.h"
@@ -10,6 +11,7 @@
 #include "frame/material_interface.h"
 #include "frame/node_interface.h"
 #include "frame/program_interface.h"
+#include "frame/scene_state.h"
 #include "frame/static_mesh_interface.h"
 #include "frame/texture_interface.h"
 
@@ -69,9 +71,9 @@ class LevelInterface : public NameInterface
      * @brief Get a vector of static mesh id and corresponding material id.
      * @return Vector of static mesh id and corresponding material id.
      */
-    virtual std::vector<std::pair<
+    virtual const std::vector<std::pair<
         EntityId,
-        std::tuple<EntityId, proto::SceneStaticMesh::RenderTimeEnum>>>
+        std::tuple<EntityId, proto::SceneStaticMesh::RenderTimeEnum>>>&
     GetStaticMeshMaterialIds() const = 0;
     /**
      * @brief Get the id of an element from a name string.
@@ -79,6 +81,14 @@ class LevelInterface : public NameInterface
      * @return Id of the element or error.
      */
     virtual EntityId GetIdFromName(const std::string& name) const = 0;
+    /**
+     * @brief Try to get the id of an element from a name string, this
+     *        doesn't log anything in case the name is not found.
+     * @param name: The name string of the element.
+     * @return Id of the element or nullopt.
+     */
+    virtual std::optional<EntityId> TryGetIdFromName(
+        std::string_view name) const = 0;
     /**
      * @brief Get the name of an element given an id.
      * @param id: Id of the element to get the name.
@@ -113,6 +123,17 @@ class LevelInterface : public NameInterface
      * @param name: Name of the scene root.
      */
     virtual void SetDefaultTextureName(const std::string& name) = 0;
+    /**
+     * @brief Enable or disable the occlusion culling of the meshes (the
+     *        meshes then share the depth buffer).
+     * @param enable: Enable or disable.
+     */
+    virtual void SetOcclusionCulling(bool enable) = 0;
+    /**
+     * @brief Check if the meshes are occlusion culled.
+     * @return True if enabled.
+     */
+    virtual bool IsOcclusionCulling() const = 0;
     /**
      * @brief Get the default camera id, using the name that was stored
      *        during loading.
@@ -132,6 +153,85 @@ class LevelInterface : public NameInterface
      * @return Parent node id.
      */
     virtual EntityId GetParentId(EntityId id) const = 0;
+    /**
+     * @brief Change the parent of a node already in the level (this keep
+     *        the parent/children index up to date, prefer it to calling
+     *        NodeInterface::SetParentName directly).
+     * @param id: The node to be reparented.
+     * @param parent_name: Name of the new parent (can be added later).
+     */
+    virtual void SetParentName(
+        EntityId id, const std::string& parent_name) = 0;
+    /**
+     * @brief Recompute the cached world transforms of the nodes that
+     *        changed (or depend on time) since the last call, this should
+     *        be called once per frame before rendering.
+     * @param dt: Delta time from the beginning of the software in seconds.
+     */
+    virtual void UpdateTransforms(double dt) = 0;
+    /**
+     * @brief Get the cached world transform of a node (as computed by the
+     *        last UpdateTransforms call).
+     * @param id: The node id.
+     * @return The world transform of the node.
+     */
+    virtual const glm::mat4& GetWorldTransform(EntityId id) const = 0;
+    /**
+     * @brief Publish a snapshot of the scene state (world transforms and
+     *        default camera), this should be called once per frame after
+     *        UpdateTransforms from the thread that modify the level.
+     * @param dt: Delta time from the beginning of the software in seconds.
+     */
+    virtual void PublishSceneState(double dt) = 0;
+    /**
+     * @brief Get the last published scene state, this can be called from
+     *        any thread and the snapshot stay valid (and unchanged) as long
+     *        as it is held.
+     * @return The last snapshot or null if nothing was published yet.
+     */
+    virtual std::shared_ptr<const SceneState> GetSceneState() const = 0;
+    /**
+     * @brief Set a uniform of a program, it is part of the next published
+     *        scene states and set by the renderer after the per mesh
+     *        uniforms (so the simulation doesn't touch the OpenGL state).
+     * @param program_id: The program id.
+     * @param name: Name of the uniform.
+     * @param values: Values of the uniform.
+     * @param size: Size of the value (as in ProgramInterface::Uniform).
+     */
+    virtual void SetProgramUniform(
+        EntityId program_id,
+        const std::string& name,
+        const std::vector<float>& values,
+        glm::uvec2 size = {1, 1}) = 0;
+    /**
+     * @brief Set a uniform of a program, it is part of the next published
+     *        scene states and set by the renderer after the per mesh
+     *        uniforms (so the simulation doesn't touch the OpenGL state).
+     * @param program_id: The program id.
+     * @param name: Name of the uniform.
+     * @param values: Values of the uniform.
+     * @param size: Size of the value (as in ProgramInterface::Uniform).
+     */
+    virtual void SetProgramUniform(
+        EntityId program_id,
+        const std::string& name,
+        const std::vector<std::int32_t>& values,
+        glm::uvec2 size = {1, 1}) = 0;
+    /**
+     * @brief Stop setting a uniform of a program (it keeps its last value).
+     * @param program_id: The program id.
+     * @param name: Name of the uniform.
+     */
+    virtual void RemoveProgramUniform(
+        EntityId program_id, const std::string& name) = 0;
+    /**
+     * @brief Get the version of the level, it is increased every time an
+     *        entity is added, removed or replaced (used to know when cached
+     *        data like the render queue should be rebuilt).
+     * @return The current version.
+     */
+    virtual std::uint64_t GetVersion() const = 0;
     /**
      * @brief Get the default quad static mesh id.
      * @return The id of the quad static mesh id or error.
@@ -191,6 +291,50 @@ class LevelInterface : public NameInterface
      * @param buffer: The buffer id to be removed.
      */
     virtual void RemoveBuffer(EntityId buffer) = 0;
+    /**
+     * @brief Remove a scene node and its children (the whole subtree) from
+     *        the level, they are not rendered anymore.
+     * @param id: The scene node id to be removed.
+     */
+    virtual void RemoveSceneNode(EntityId id) = 0;
+    /**
+     * @brief Remove a scene node from the level but not its children, they
+     *        wait for a node with the same name to be added again (used to
+     *        swap a node, as the level streamer does with fragments).
+     * @param id: The scene node id to be removed.
+     */
+    virtual void RemoveSceneNodeKeepChildren(EntityId id) = 0;
+    /**
+     * @brief Remove a texture from the level, it is also removed from the
+     *        materials and programs that use it.
+     * @param id: The texture id to be removed.
+     */
+    virtual void RemoveTexture(EntityId id) = 0;
+    /**
+     * @brief Remove a program from the level, the meshes using a material
+     *        with this program are not rendered anymore.
+     * @param id: The program id to be removed.
+     */
+    virtual void RemoveProgram(EntityId id) = 0;
+    /**
+     * @brief Remove a material from the level, the meshes using it are not
+     *        rendered anymore.
+     * @param id: The material id to be removed.
+     */
+    virtual void RemoveMaterial(EntityId id) = 0;
+    /**
+     * @brief Remove a static mesh from the level (its buffers are removed
+     *        with it), the nodes using it are not rendered anymore.
+     * @param id: The static mesh id to be removed.
+     */
+    virtual void RemoveStaticMesh(EntityId id) = 0;
+    /**
+     * @brief Destroy the entities removed (or replaced) since the last
+     *        call, this should be called once the frame is done with them
+     *        (removed entities stay alive until then, so removing in the
+     *        middle of a frame is safe). Removed ids can be reused.
+     */
+    virtual void DestroyRemovedEntities() = 0;
     /**
      * @brief Add a static mesh to the level.
      * @param static_mesh: Move a buffer in the level.
@@ -67,7 +67,13 @@ class MaterialInterface : public NameInterface
      * @brief Get ids of a material.
      * @return Return the list of texture ids.
      */
-    virtual const std::vector<EntityId> GetIds() const = 0;
+    virtual const std::vector<EntityId>& GetIds() const = 0;
+    /**
+     * @brief Get the name of a texture in the shader.
+     * @param id: Texture id (has to be in the material).
+     * @return The associated name.
+     */
+    virtual const std::string& GetInnerName(EntityId id) const = 0;
     /**
      * @brief Enable a texture to be used by the context.
      * @param id: Id of the texture to be enabled.
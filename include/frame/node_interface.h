@@ -40,6 +40,34 @@ struct NodeInterface : public NameInterface
      * @return A mat4 representing the local model matrix.
      */
     virtual glm::mat4 GetLocalModel(double dt) const = 0;
+    /**
+     * @brief Compute the transform of this node relative to its parent
+     *        (used by the level to cache the world transforms).
+     * @param dt: Delta time from the beginning of the software in seconds.
+     * @return A mat4 representing the local transform.
+     */
+    virtual glm::mat4 ComputeLocalTransform(double dt) const
+    {
+        return glm::mat4(1.0f);
+    }
+    /**
+     * @brief Does the local transform change with time (if so the level
+     *        recompute it every frame).
+     * @return True if the local transform depend on time.
+     */
+    virtual bool IsTimeDependent() const
+    {
+        return false;
+    }
+    /**
+     * @brief Set the function called when the local transform change (set
+     *        by the level to mark the node dirty).
+     * @param func: Function to be called.
+     */
+    void SetTransformChangedCallback(std::function<void()> func)
+    {
+        transform_changed_ = func;
+    }
 
   public:
     /**
@@ -73,6 +101,7 @@ struct NodeInterface : public NameInterface
     void SetParentName(const std::string& parent)
     {
         parent_name_ = parent;
+        TransformChanged();
     }
     /**
      * @brief Get name from the name interface.
@@ -91,9 +120,20 @@ struct NodeInterface : public NameInterface
         name_ = name;
     }
 
+  protected:
+    //! @brief Notify that the local transform changed.
+    void TransformChanged() const
+    {
+        if (transform_changed_)
+        {
+            transform_changed_();
+        }
+    }
+
   protected:
     std::function<NodeInterface*(const std::string&)> func_ =
         [](const std::string&) -> NodeInterface* { return nullptr; };
+    std::function<void()> transform_changed_ = nullptr;
     std::string parent_name_;
     std::string name_;
 };
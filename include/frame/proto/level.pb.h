@@ -190,6 +190,7 @@ class Level final :
     kNameFieldNumber = 1,
     kDefaultTextureNameFieldNumber = 2,
     kSceneTreeFieldNumber = 7,
+    kOcclusionCullingFieldNumber = 9,
   };
   // repeated .frame.proto.Texture textures = 5;
   int textures_size() const;
@@ -291,6 +292,15 @@ class Level final :
       ::frame::proto::SceneTree* scene_tree);
   ::frame::proto::SceneTree* unsafe_arena_release_scene_tree();
 
+  // bool occlusion_culling = 9;
+  void clear_occlusion_culling();
+  bool occlusion_culling() const;
+  void set_occlusion_culling(bool value);
+  private:
+  bool _internal_occlusion_culling() const;
+  void _internal_set_occlusion_culling(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:frame.proto.Level)
  private:
   class _Internal;
@@ -305,6 +315,7 @@ class Level final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr default_texture_name_;
     ::frame::proto::SceneTree* scene_tree_;
+    bool occlusion_culling_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -617,6 +628,26 @@ Level::materials() const {
   return _impl_.materials_;
 }
 
+// bool occlusion_culling = 9;
+inline void Level::clear_occlusion_culling() {
+  _impl_.occlusion_culling_ = false;
+}
+inline bool Level::_internal_occlusion_culling() const {
+  return _impl_.occlusion_culling_;
+}
+inline bool Level::occlusion_culling() const {
+  // @@protoc_insertion_point(field_get:frame.proto.Level.occlusion_culling)
+  return _internal_occlusion_culling();
+}
+inline void Level::_internal_set_occlusion_culling(bool value) {
+  
+  _impl_.occlusion_culling_ = value;
+}
+inline void Level::set_occlusion_culling(bool value) {
+  _internal_set_occlusion_culling(value);
+  // @@protoc_insertion_point(field_set:frame.proto.Level.occlusion_culling)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -402,6 +402,8 @@ class Program final :
     kInputSceneRootNameFieldNumber = 5,
     kShaderFieldNumber = 6,
     kInputSceneTypeFieldNumber = 9,
+    kDepthPrepassFieldNumber = 10,
+    kMultiViewFieldNumber = 11,
   };
   // repeated string input_texture_names = 3;
   int input_texture_names_size() const;
@@ -529,6 +531,24 @@ class Program final :
       ::frame::proto::SceneType* input_scene_type);
   ::frame::proto::SceneType* unsafe_arena_release_input_scene_type();
 
+  // bool depth_prepass = 10;
+  void clear_depth_prepass();
+  bool depth_prepass() const;
+  void set_depth_prepass(bool value);
+  private:
+  bool _internal_depth_prepass() const;
+  void _internal_set_depth_prepass(bool value);
+  public:
+
+  // bool multi_view = 11;
+  void clear_multi_view();
+  bool multi_view() const;
+  void set_multi_view(bool value);
+  private:
+  bool _internal_multi_view() const;
+  void _internal_set_multi_view(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:frame.proto.Program)
  private:
   class _Internal;
@@ -544,6 +564,8 @@ class Program final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr input_scene_root_name_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr shader_;
     ::frame::proto::SceneType* input_scene_type_;
+    bool depth_prepass_;
+    bool multi_view_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -1011,6 +1033,46 @@ Program::parameters() const {
   return _impl_.parameters_;
 }
 
+// bool depth_prepass = 10;
+inline void Program::clear_depth_prepass() {
+  _impl_.depth_prepass_ = false;
+}
+inline bool Program::_internal_depth_prepass() const {
+  return _impl_.depth_prepass_;
+}
+inline bool Program::depth_prepass() const {
+  // @@protoc_insertion_point(field_get:frame.proto.Program.depth_prepass)
+  return _internal_depth_prepass();
+}
+inline void Program::_internal_set_depth_prepass(bool value) {
+  
+  _impl_.depth_prepass_ = value;
+}
+inline void Program::set_depth_prepass(bool value) {
+  _internal_set_depth_prepass(value);
+  // @@protoc_insertion_point(field_set:frame.proto.Program.depth_prepass)
+}
+
+// bool multi_view = 11;
+inline void Program::clear_multi_view() {
+  _impl_.multi_view_ = false;
+}
+inline bool Program::_internal_multi_view() const {
+  return _impl_.multi_view_;
+}
+inline bool Program::multi_view() const {
+  // @@protoc_insertion_point(field_get:frame.proto.Program.multi_view)
+  return _internal_multi_view();
+}
+inline void Program::_internal_set_multi_view(bool value) {
+  
+  _impl_.multi_view_ = value;
+}
+inline void Program::set_multi_view(bool value) {
+  _internal_set_multi_view(value);
+  // @@protoc_insertion_point(field_set:frame.proto.Program.multi_view)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
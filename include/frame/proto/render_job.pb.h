@@ -0,0 +1,1027 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: render_job.proto
+
+#ifndef GOOGLE_PROTOBUF_INCLUDED_render_5fjob_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_render_5fjob_2eproto
+
+#include <limits>
+#include <string>
+
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please update
+#error your headers.
+#endif
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/unknown_field_set.h>
+#include "scene.pb.h"
+#include "uniform.pb.h"
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_render_5fjob_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_render_5fjob_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_render_5fjob_2eproto;
+namespace frame {
+namespace proto {
+class ProgramOverride;
+struct ProgramOverrideDefaultTypeInternal;
+extern ProgramOverrideDefaultTypeInternal _ProgramOverride_default_instance_;
+class RenderJob;
+struct RenderJobDefaultTypeInternal;
+extern RenderJobDefaultTypeInternal _RenderJob_default_instance_;
+class RenderJobs;
+struct RenderJobsDefaultTypeInternal;
+extern RenderJobsDefaultTypeInternal _RenderJobs_default_instance_;
+}  // namespace proto
+}  // namespace frame
+PROTOBUF_NAMESPACE_OPEN
+template<> ::frame::proto::ProgramOverride* Arena::CreateMaybeMessage<::frame::proto::ProgramOverride>(Arena*);
+template<> ::frame::proto::RenderJob* Arena::CreateMaybeMessage<::frame::proto::RenderJob>(Arena*);
+template<> ::frame::proto::RenderJobs* Arena::CreateMaybeMessage<::frame::proto::RenderJobs>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace frame {
+namespace proto {
+
+// ===================================================================
+
+class ProgramOverride final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:frame.proto.ProgramOverride) */ {
+ public:
+  inline ProgramOverride() : ProgramOverride(nullptr) {}
+  ~ProgramOverride() override;
+  explicit PROTOBUF_CONSTEXPR ProgramOverride(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ProgramOverride(const ProgramOverride& from);
+  ProgramOverride(ProgramOverride&& from) noexcept
+    : ProgramOverride() {
+    *this = ::std::move(from);
+  }
+
+  inline ProgramOverride& operator=(const ProgramOverride& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ProgramOverride& operator=(ProgramOverride&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ProgramOverride& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ProgramOverride* internal_default_instance() {
+    return reinterpret_cast<const ProgramOverride*>(
+               &_ProgramOverride_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(ProgramOverride& a, ProgramOverride& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ProgramOverride* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ProgramOverride* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ProgramOverride* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ProgramOverride>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const ProgramOverride& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ProgramOverride& from) {
+    ProgramOverride::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ProgramOverride* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "frame.proto.ProgramOverride";
+  }
+  protected:
+  explicit ProgramOverride(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kParametersFieldNumber = 2,
+    kProgramNameFieldNumber = 1,
+  };
+  // repeated .frame.proto.Uniform parameters = 2;
+  int parameters_size() const;
+  private:
+  int _internal_parameters_size() const;
+  public:
+  void clear_parameters();
+  ::frame::proto::Uniform* mutable_parameters(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::Uniform >*
+      mutable_parameters();
+  private:
+  const ::frame::proto::Uniform& _internal_parameters(int index) const;
+  ::frame::proto::Uniform* _internal_add_parameters();
+  public:
+  const ::frame::proto::Uniform& parameters(int index) const;
+  ::frame::proto::Uniform* add_parameters();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::Uniform >&
+      parameters() const;
+
+  // string program_name = 1;
+  void clear_program_name();
+  const std::string& program_name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_program_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_program_name();
+  PROTOBUF_NODISCARD std::string* release_program_name();
+  void set_allocated_program_name(std::string* program_name);
+  private:
+  const std::string& _internal_program_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_program_name(const std::string& value);
+  std::string* _internal_mutable_program_name();
+  public:
+
+  // @@protoc_insertion_point(class_scope:frame.proto.ProgramOverride)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::Uniform > parameters_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr program_name_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_render_5fjob_2eproto;
+};
+// -------------------------------------------------------------------
+
+class RenderJob final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:frame.proto.RenderJob) */ {
+ public:
+  inline RenderJob() : RenderJob(nullptr) {}
+  ~RenderJob() override;
+  explicit PROTOBUF_CONSTEXPR RenderJob(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  RenderJob(const RenderJob& from);
+  RenderJob(RenderJob&& from) noexcept
+    : RenderJob() {
+    *this = ::std::move(from);
+  }
+
+  inline RenderJob& operator=(const RenderJob& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline RenderJob& operator=(RenderJob&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RenderJob& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const RenderJob* internal_default_instance() {
+    return reinterpret_cast<const RenderJob*>(
+               &_RenderJob_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(RenderJob& a, RenderJob& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(RenderJob* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(RenderJob* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  RenderJob* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<RenderJob>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const RenderJob& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const RenderJob& from) {
+    RenderJob::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(RenderJob* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "frame.proto.RenderJob";
+  }
+  protected:
+  explicit RenderJob(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kProgramOverridesFieldNumber = 3,
+    kLevelFileFieldNumber = 1,
+    kOutputFileFieldNumber = 4,
+    kCameraFieldNumber = 2,
+    kTimeSFieldNumber = 5,
+  };
+  // repeated .frame.proto.ProgramOverride program_overrides = 3;
+  int program_overrides_size() const;
+  private:
+  int _internal_program_overrides_size() const;
+  public:
+  void clear_program_overrides();
+  ::frame::proto::ProgramOverride* mutable_program_overrides(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::ProgramOverride >*
+      mutable_program_overrides();
+  private:
+  const ::frame::proto::ProgramOverride& _internal_program_overrides(int index) const;
+  ::frame::proto::ProgramOverride* _internal_add_program_overrides();
+  public:
+  const ::frame::proto::ProgramOverride& program_overrides(int index) const;
+  ::frame::proto::ProgramOverride* add_program_overrides();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::ProgramOverride >&
+      program_overrides() const;
+
+  // string level_file = 1;
+  void clear_level_file();
+  const std::string& level_file() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_level_file(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_level_file();
+  PROTOBUF_NODISCARD std::string* release_level_file();
+  void set_allocated_level_file(std::string* level_file);
+  private:
+  const std::string& _internal_level_file() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_level_file(const std::string& value);
+  std::string* _internal_mutable_level_file();
+  public:
+
+  // string output_file = 4;
+  void clear_output_file();
+  const std::string& output_file() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_output_file(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_output_file();
+  PROTOBUF_NODISCARD std::string* release_output_file();
+  void set_allocated_output_file(std::string* output_file);
+  private:
+  const std::string& _internal_output_file() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_output_file(const std::string& value);
+  std::string* _internal_mutable_output_file();
+  public:
+
+  // .frame.proto.SceneCamera camera = 2;
+  bool has_camera() const;
+  private:
+  bool _internal_has_camera() const;
+  public:
+  void clear_camera();
+  const ::frame::proto::SceneCamera& camera() const;
+  PROTOBUF_NODISCARD ::frame::proto::SceneCamera* release_camera();
+  ::frame::proto::SceneCamera* mutable_camera();
+  void set_allocated_camera(::frame::proto::SceneCamera* camera);
+  private:
+  const ::frame::proto::SceneCamera& _internal_camera() const;
+  ::frame::proto::SceneCamera* _internal_mutable_camera();
+  public:
+  void unsafe_arena_set_allocated_camera(
+      ::frame::proto::SceneCamera* camera);
+  ::frame::proto::SceneCamera* unsafe_arena_release_camera();
+
+  // double time_s = 5;
+  void clear_time_s();
+  double time_s() const;
+  void set_time_s(double value);
+  private:
+  double _internal_time_s() const;
+  void _internal_set_time_s(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:frame.proto.RenderJob)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::ProgramOverride > program_overrides_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr level_file_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr output_file_;
+    ::frame::proto::SceneCamera* camera_;
+    double time_s_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_render_5fjob_2eproto;
+};
+// -------------------------------------------------------------------
+
+class RenderJobs final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:frame.proto.RenderJobs) */ {
+ public:
+  inline RenderJobs() : RenderJobs(nullptr) {}
+  ~RenderJobs() override;
+  explicit PROTOBUF_CONSTEXPR RenderJobs(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  RenderJobs(const RenderJobs& from);
+  RenderJobs(RenderJobs&& from) noexcept
+    : RenderJobs() {
+    *this = ::std::move(from);
+  }
+
+  inline RenderJobs& operator=(const RenderJobs& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline RenderJobs& operator=(RenderJobs&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RenderJobs& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const RenderJobs* internal_default_instance() {
+    return reinterpret_cast<const RenderJobs*>(
+               &_RenderJobs_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(RenderJobs& a, RenderJobs& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(RenderJobs* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(RenderJobs* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  RenderJobs* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<RenderJobs>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const RenderJobs& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const RenderJobs& from) {
+    RenderJobs::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(RenderJobs* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "frame.proto.RenderJobs";
+  }
+  protected:
+  explicit RenderJobs(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kJobsFieldNumber = 1,
+  };
+  // repeated .frame.proto.RenderJob jobs = 1;
+  int jobs_size() const;
+  private:
+  int _internal_jobs_size() const;
+  public:
+  void clear_jobs();
+  ::frame::proto::RenderJob* mutable_jobs(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::RenderJob >*
+      mutable_jobs();
+  private:
+  const ::frame::proto::RenderJob& _internal_jobs(int index) const;
+  ::frame::proto::RenderJob* _internal_add_jobs();
+  public:
+  const ::frame::proto::RenderJob& jobs(int index) const;
+  ::frame::proto::RenderJob* add_jobs();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::RenderJob >&
+      jobs() const;
+
+  // @@protoc_insertion_point(class_scope:frame.proto.RenderJobs)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::RenderJob > jobs_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_render_5fjob_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// ProgramOverride
+
+// string program_name = 1;
+inline void ProgramOverride::clear_program_name() {
+  _impl_.program_name_.ClearToEmpty();
+}
+inline const std::string& ProgramOverride::program_name() const {
+  // @@protoc_insertion_point(field_get:frame.proto.ProgramOverride.program_name)
+  return _internal_program_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void ProgramOverride::set_program_name(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.program_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:frame.proto.ProgramOverride.program_name)
+}
+inline std::string* ProgramOverride::mutable_program_name() {
+  std::string* _s = _internal_mutable_program_name();
+  // @@protoc_insertion_point(field_mutable:frame.proto.ProgramOverride.program_name)
+  return _s;
+}
+inline const std::string& ProgramOverride::_internal_program_name() const {
+  return _impl_.program_name_.Get();
+}
+inline void ProgramOverride::_internal_set_program_name(const std::string& value) {
+  
+  _impl_.program_name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* ProgramOverride::_internal_mutable_program_name() {
+  
+  return _impl_.program_name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* ProgramOverride::release_program_name() {
+  // @@protoc_insertion_point(field_release:frame.proto.ProgramOverride.program_name)
+  return _impl_.program_name_.Release();
+}
+inline void ProgramOverride::set_allocated_program_name(std::string* program_name) {
+  if (program_name != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.program_name_.SetAllocated(program_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.program_name_.IsDefault()) {
+    _impl_.program_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:frame.proto.ProgramOverride.program_name)
+}
+
+// repeated .frame.proto.Uniform parameters = 2;
+inline int ProgramOverride::_internal_parameters_size() const {
+  return _impl_.parameters_.size();
+}
+inline int ProgramOverride::parameters_size() const {
+  return _internal_parameters_size();
+}
+inline ::frame::proto::Uniform* ProgramOverride::mutable_parameters(int index) {
+  // @@protoc_insertion_point(field_mutable:frame.proto.ProgramOverride.parameters)
+  return _impl_.parameters_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::Uniform >*
+ProgramOverride::mutable_parameters() {
+  // @@protoc_insertion_point(field_mutable_list:frame.proto.ProgramOverride.parameters)
+  return &_impl_.parameters_;
+}
+inline const ::frame::proto::Uniform& ProgramOverride::_internal_parameters(int index) const {
+  return _impl_.parameters_.Get(index);
+}
+inline const ::frame::proto::Uniform& ProgramOverride::parameters(int index) const {
+  // @@protoc_insertion_point(field_get:frame.proto.ProgramOverride.parameters)
+  return _internal_parameters(index);
+}
+inline ::frame::proto::Uniform* ProgramOverride::_internal_add_parameters() {
+  return _impl_.parameters_.Add();
+}
+inline ::frame::proto::Uniform* ProgramOverride::add_parameters() {
+  ::frame::proto::Uniform* _add = _internal_add_parameters();
+  // @@protoc_insertion_point(field_add:frame.proto.ProgramOverride.parameters)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::Uniform >&
+ProgramOverride::parameters() const {
+  // @@protoc_insertion_point(field_list:frame.proto.ProgramOverride.parameters)
+  return _impl_.parameters_;
+}
+
+// -------------------------------------------------------------------
+
+// RenderJob
+
+// string level_file = 1;
+inline void RenderJob::clear_level_file() {
+  _impl_.level_file_.ClearToEmpty();
+}
+inline const std::string& RenderJob::level_file() const {
+  // @@protoc_insertion_point(field_get:frame.proto.RenderJob.level_file)
+  return _internal_level_file();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RenderJob::set_level_file(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.level_file_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:frame.proto.RenderJob.level_file)
+}
+inline std::string* RenderJob::mutable_level_file() {
+  std::string* _s = _internal_mutable_level_file();
+  // @@protoc_insertion_point(field_mutable:frame.proto.RenderJob.level_file)
+  return _s;
+}
+inline const std::string& RenderJob::_internal_level_file() const {
+  return _impl_.level_file_.Get();
+}
+inline void RenderJob::_internal_set_level_file(const std::string& value) {
+  
+  _impl_.level_file_.Set(value, GetArenaForAllocation());
+}
+inline std::string* RenderJob::_internal_mutable_level_file() {
+  
+  return _impl_.level_file_.Mutable(GetArenaForAllocation());
+}
+inline std::string* RenderJob::release_level_file() {
+  // @@protoc_insertion_point(field_release:frame.proto.RenderJob.level_file)
+  return _impl_.level_file_.Release();
+}
+inline void RenderJob::set_allocated_level_file(std::string* level_file) {
+  if (level_file != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.level_file_.SetAllocated(level_file, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.level_file_.IsDefault()) {
+    _impl_.level_file_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:frame.proto.RenderJob.level_file)
+}
+
+// .frame.proto.SceneCamera camera = 2;
+inline bool RenderJob::_internal_has_camera() const {
+  return this != internal_default_instance() && _impl_.camera_ != nullptr;
+}
+inline bool RenderJob::has_camera() const {
+  return _internal_has_camera();
+}
+inline const ::frame::proto::SceneCamera& RenderJob::_internal_camera() const {
+  const ::frame::proto::SceneCamera* p = _impl_.camera_;
+  return p != nullptr ? *p : reinterpret_cast<const ::frame::proto::SceneCamera&>(
+      ::frame::proto::_SceneCamera_default_instance_);
+}
+inline const ::frame::proto::SceneCamera& RenderJob::camera() const {
+  // @@protoc_insertion_point(field_get:frame.proto.RenderJob.camera)
+  return _internal_camera();
+}
+inline void RenderJob::unsafe_arena_set_allocated_camera(
+    ::frame::proto::SceneCamera* camera) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.camera_);
+  }
+  _impl_.camera_ = camera;
+  if (camera) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:frame.proto.RenderJob.camera)
+}
+inline ::frame::proto::SceneCamera* RenderJob::release_camera() {
+  
+  ::frame::proto::SceneCamera* temp = _impl_.camera_;
+  _impl_.camera_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::frame::proto::SceneCamera* RenderJob::unsafe_arena_release_camera() {
+  // @@protoc_insertion_point(field_release:frame.proto.RenderJob.camera)
+  
+  ::frame::proto::SceneCamera* temp = _impl_.camera_;
+  _impl_.camera_ = nullptr;
+  return temp;
+}
+inline ::frame::proto::SceneCamera* RenderJob::_internal_mutable_camera() {
+  
+  if (_impl_.camera_ == nullptr) {
+    auto* p = CreateMaybeMessage<::frame::proto::SceneCamera>(GetArenaForAllocation());
+    _impl_.camera_ = p;
+  }
+  return _impl_.camera_;
+}
+inline ::frame::proto::SceneCamera* RenderJob::mutable_camera() {
+  ::frame::proto::SceneCamera* _msg = _internal_mutable_camera();
+  // @@protoc_insertion_point(field_mutable:frame.proto.RenderJob.camera)
+  return _msg;
+}
+inline void RenderJob::set_allocated_camera(::frame::proto::SceneCamera* camera) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete reinterpret_cast< ::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.camera_);
+  }
+  if (camera) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(
+                reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(camera));
+    if (message_arena != submessage_arena) {
+      camera = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, camera, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.camera_ = camera;
+  // @@protoc_insertion_point(field_set_allocated:frame.proto.RenderJob.camera)
+}
+
+// repeated .frame.proto.ProgramOverride program_overrides = 3;
+inline int RenderJob::_internal_program_overrides_size() const {
+  return _impl_.program_overrides_.size();
+}
+inline int RenderJob::program_overrides_size() const {
+  return _internal_program_overrides_size();
+}
+inline void RenderJob::clear_program_overrides() {
+  _impl_.program_overrides_.Clear();
+}
+inline ::frame::proto::ProgramOverride* RenderJob::mutable_program_overrides(int index) {
+  // @@protoc_insertion_point(field_mutable:frame.proto.RenderJob.program_overrides)
+  return _impl_.program_overrides_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::ProgramOverride >*
+RenderJob::mutable_program_overrides() {
+  // @@protoc_insertion_point(field_mutable_list:frame.proto.RenderJob.program_overrides)
+  return &_impl_.program_overrides_;
+}
+inline const ::frame::proto::ProgramOverride& RenderJob::_internal_program_overrides(int index) const {
+  return _impl_.program_overrides_.Get(index);
+}
+inline const ::frame::proto::ProgramOverride& RenderJob::program_overrides(int index) const {
+  // @@protoc_insertion_point(field_get:frame.proto.RenderJob.program_overrides)
+  return _internal_program_overrides(index);
+}
+inline ::frame::proto::ProgramOverride* RenderJob::_internal_add_program_overrides() {
+  return _impl_.program_overrides_.Add();
+}
+inline ::frame::proto::ProgramOverride* RenderJob::add_program_overrides() {
+  ::frame::proto::ProgramOverride* _add = _internal_add_program_overrides();
+  // @@protoc_insertion_point(field_add:frame.proto.RenderJob.program_overrides)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::ProgramOverride >&
+RenderJob::program_overrides() const {
+  // @@protoc_insertion_point(field_list:frame.proto.RenderJob.program_overrides)
+  return _impl_.program_overrides_;
+}
+
+// string output_file = 4;
+inline void RenderJob::clear_output_file() {
+  _impl_.output_file_.ClearToEmpty();
+}
+inline const std::string& RenderJob::output_file() const {
+  // @@protoc_insertion_point(field_get:frame.proto.RenderJob.output_file)
+  return _internal_output_file();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RenderJob::set_output_file(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.output_file_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:frame.proto.RenderJob.output_file)
+}
+inline std::string* RenderJob::mutable_output_file() {
+  std::string* _s = _internal_mutable_output_file();
+  // @@protoc_insertion_point(field_mutable:frame.proto.RenderJob.output_file)
+  return _s;
+}
+inline const std::string& RenderJob::_internal_output_file() const {
+  return _impl_.output_file_.Get();
+}
+inline void RenderJob::_internal_set_output_file(const std::string& value) {
+  
+  _impl_.output_file_.Set(value, GetArenaForAllocation());
+}
+inline std::string* RenderJob::_internal_mutable_output_file() {
+  
+  return _impl_.output_file_.Mutable(GetArenaForAllocation());
+}
+inline std::string* RenderJob::release_output_file() {
+  // @@protoc_insertion_point(field_release:frame.proto.RenderJob.output_file)
+  return _impl_.output_file_.Release();
+}
+inline void RenderJob::set_allocated_output_file(std::string* output_file) {
+  if (output_file != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.output_file_.SetAllocated(output_file, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.output_file_.IsDefault()) {
+    _impl_.output_file_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:frame.proto.RenderJob.output_file)
+}
+
+// double time_s = 5;
+inline void RenderJob::clear_time_s() {
+  _impl_.time_s_ = 0;
+}
+inline double RenderJob::_internal_time_s() const {
+  return _impl_.time_s_;
+}
+inline double RenderJob::time_s() const {
+  // @@protoc_insertion_point(field_get:frame.proto.RenderJob.time_s)
+  return _internal_time_s();
+}
+inline void RenderJob::_internal_set_time_s(double value) {
+  
+  _impl_.time_s_ = value;
+}
+inline void RenderJob::set_time_s(double value) {
+  _internal_set_time_s(value);
+  // @@protoc_insertion_point(field_set:frame.proto.RenderJob.time_s)
+}
+
+// -------------------------------------------------------------------
+
+// RenderJobs
+
+// repeated .frame.proto.RenderJob jobs = 1;
+inline int RenderJobs::_internal_jobs_size() const {
+  return _impl_.jobs_.size();
+}
+inline int RenderJobs::jobs_size() const {
+  return _internal_jobs_size();
+}
+inline void RenderJobs::clear_jobs() {
+  _impl_.jobs_.Clear();
+}
+inline ::frame::proto::RenderJob* RenderJobs::mutable_jobs(int index) {
+  // @@protoc_insertion_point(field_mutable:frame.proto.RenderJobs.jobs)
+  return _impl_.jobs_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::RenderJob >*
+RenderJobs::mutable_jobs() {
+  // @@protoc_insertion_point(field_mutable_list:frame.proto.RenderJobs.jobs)
+  return &_impl_.jobs_;
+}
+inline const ::frame::proto::RenderJob& RenderJobs::_internal_jobs(int index) const {
+  return _impl_.jobs_.Get(index);
+}
+inline const ::frame::proto::RenderJob& RenderJobs::jobs(int index) const {
+  // @@protoc_insertion_point(field_get:frame.proto.RenderJobs.jobs)
+  return _internal_jobs(index);
+}
+inline ::frame::proto::RenderJob* RenderJobs::_internal_add_jobs() {
+  return _impl_.jobs_.Add();
+}
+inline ::frame::proto::RenderJob* RenderJobs::add_jobs() {
+  ::frame::proto::RenderJob* _add = _internal_add_jobs();
+  // @@protoc_insertion_point(field_add:frame.proto.RenderJobs.jobs)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::RenderJob >&
+RenderJobs::jobs() const {
+  // @@protoc_insertion_point(field_list:frame.proto.RenderJobs.jobs)
+  return _impl_.jobs_;
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace proto
+}  // namespace frame
+
+// @@protoc_insertion_point(global_scope)
+
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_render_5fjob_2eproto
@@ -616,16 +616,36 @@ class SceneStaticMesh final :
   // accessors -------------------------------------------------------
 
   enum : int {
+    kInstanceMatricesFieldNumber = 13,
     kNameFieldNumber = 1,
     kParentFieldNumber = 2,
     kMaterialNameFieldNumber = 5,
     kRenderPrimitiveEnumFieldNumber = 8,
     kRenderTimeEnumFieldNumber = 11,
+    kSkipCullingFieldNumber = 12,
     kCleanBufferFieldNumber = 7,
     kMeshEnumFieldNumber = 6,
     kFileNameFieldNumber = 3,
     kMultiPluginFieldNumber = 10,
   };
+  // repeated .frame.proto.UniformMatrix4 instance_matrices = 13;
+  int instance_matrices_size() const;
+  private:
+  int _internal_instance_matrices_size() const;
+  public:
+  void clear_instance_matrices();
+  ::frame::proto::UniformMatrix4* mutable_instance_matrices(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::UniformMatrix4 >*
+      mutable_instance_matrices();
+  private:
+  const ::frame::proto::UniformMatrix4& _internal_instance_matrices(int index) const;
+  ::frame::proto::UniformMatrix4* _internal_add_instance_matrices();
+  public:
+  const ::frame::proto::UniformMatrix4& instance_matrices(int index) const;
+  ::frame::proto::UniformMatrix4* add_instance_matrices();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::UniformMatrix4 >&
+      instance_matrices() const;
+
   // string name = 1;
   void clear_name();
   const std::string& name() const;
@@ -686,6 +706,15 @@ class SceneStaticMesh final :
   void _internal_set_render_time_enum(::frame::proto::SceneStaticMesh_RenderTimeEnum value);
   public:
 
+  // bool skip_culling = 12;
+  void clear_skip_culling();
+  bool skip_culling() const;
+  void set_skip_culling(bool value);
+  private:
+  bool _internal_skip_culling() const;
+  void _internal_set_skip_culling(bool value);
+  public:
+
   // .frame.proto.CleanBuffer clean_buffer = 7;
   bool has_clean_buffer() const;
   private:
@@ -770,11 +799,13 @@ class SceneStaticMesh final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::UniformMatrix4 > instance_matrices_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr parent_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr material_name_;
     int render_primitive_enum_;
     int render_time_enum_;
+    bool skip_culling_;
     union MeshOneofUnion {
       constexpr MeshOneofUnion() : _constinit_{} {}
         ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
@@ -2332,6 +2363,63 @@ inline void SceneStaticMesh::set_render_time_enum(::frame::proto::SceneStaticMes
   // @@protoc_insertion_point(field_set:frame.proto.SceneStaticMesh.render_time_enum)
 }
 
+// bool skip_culling = 12;
+inline void SceneStaticMesh::clear_skip_culling() {
+  _impl_.skip_culling_ = false;
+}
+inline bool SceneStaticMesh::_internal_skip_culling() const {
+  return _impl_.skip_culling_;
+}
+inline bool SceneStaticMesh::skip_culling() const {
+  // @@protoc_insertion_point(field_get:frame.proto.SceneStaticMesh.skip_culling)
+  return _internal_skip_culling();
+}
+inline void SceneStaticMesh::_internal_set_skip_culling(bool value) {
+  
+  _impl_.skip_culling_ = value;
+}
+inline void SceneStaticMesh::set_skip_culling(bool value) {
+  _internal_set_skip_culling(value);
+  // @@protoc_insertion_point(field_set:frame.proto.SceneStaticMesh.skip_culling)
+}
+
+// repeated .frame.proto.UniformMatrix4 instance_matrices = 13;
+inline int SceneStaticMesh::_internal_instance_matrices_size() const {
+  return _impl_.instance_matrices_.size();
+}
+inline int SceneStaticMesh::instance_matrices_size() const {
+  return _internal_instance_matrices_size();
+}
+inline ::frame::proto::UniformMatrix4* SceneStaticMesh::mutable_instance_matrices(int index) {
+  // @@protoc_insertion_point(field_mutable:frame.proto.SceneStaticMesh.instance_matrices)
+  return _impl_.instance_matrices_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::UniformMatrix4 >*
+SceneStaticMesh::mutable_instance_matrices() {
+  // @@protoc_insertion_point(field_mutable_list:frame.proto.SceneStaticMesh.instance_matrices)
+  return &_impl_.instance_matrices_;
+}
+inline const ::frame::proto::UniformMatrix4& SceneStaticMesh::_internal_instance_matrices(int index) const {
+  return _impl_.instance_matrices_.Get(index);
+}
+inline const ::frame::proto::UniformMatrix4& SceneStaticMesh::instance_matrices(int index) const {
+  // @@protoc_insertion_point(field_get:frame.proto.SceneStaticMesh.instance_matrices)
+  return _internal_instance_matrices(index);
+}
+inline ::frame::proto::UniformMatrix4* SceneStaticMesh::_internal_add_instance_matrices() {
+  return _impl_.instance_matrices_.Add();
+}
+inline ::frame::proto::UniformMatrix4* SceneStaticMesh::add_instance_matrices() {
+  ::frame::proto::UniformMatrix4* _add = _internal_add_instance_matrices();
+  // @@protoc_insertion_point(field_add:frame.proto.SceneStaticMesh.instance_matrices)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::frame::proto::UniformMatrix4 >&
+SceneStaticMesh::instance_matrices() const {
+  // @@protoc_insertion_point(field_list:frame.proto.SceneStaticMesh.instance_matrices)
+  return _impl_.instance_matrices_;
+}
+
 inline bool SceneStaticMesh::has_mesh_oneof() const {
   return mesh_oneof_case() != MESH_ONEOF_NOT_SET;
 }
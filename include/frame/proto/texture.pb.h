@@ -900,6 +900,7 @@ class Texture final :
     kClearColorFieldNumber = 16,
     kMipmapFieldNumber = 4,
     kCubemapFieldNumber = 5,
+    kTransientFieldNumber = 18,
     kPixelsFieldNumber = 13,
     kFileNameFieldNumber = 14,
     kPluginFieldNumber = 17,
@@ -1081,6 +1082,15 @@ class Texture final :
   void _internal_set_cubemap(bool value);
   public:
 
+  // bool transient = 18;
+  void clear_transient();
+  bool transient() const;
+  void set_transient(bool value);
+  private:
+  bool _internal_transient() const;
+  void _internal_set_transient(bool value);
+  public:
+
   // bytes pixels = 13;
   bool has_pixels() const;
   private:
@@ -1182,6 +1192,7 @@ class Texture final :
     bool clear_color_;
     bool mipmap_;
     bool cubemap_;
+    bool transient_;
     union TextureOneofUnion {
       constexpr TextureOneofUnion() : _constinit_{} {}
         ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
@@ -2305,6 +2316,26 @@ inline void Texture::set_allocated_wrap_t(::frame::proto::TextureFilter* wrap_t)
   // @@protoc_insertion_point(field_set_allocated:frame.proto.Texture.wrap_t)
 }
 
+// bool transient = 18;
+inline void Texture::clear_transient() {
+  _impl_.transient_ = false;
+}
+inline bool Texture::_internal_transient() const {
+  return _impl_.transient_;
+}
+inline bool Texture::transient() const {
+  // @@protoc_insertion_point(field_get:frame.proto.Texture.transient)
+  return _internal_transient();
+}
+inline void Texture::_internal_set_transient(bool value) {
+  
+  _impl_.transient_ = value;
+}
+inline void Texture::set_transient(bool value) {
+  _internal_set_transient(value);
+  // @@protoc_insertion_point(field_set:frame.proto.Texture.transient)
+}
+
 // bytes pixels = 13;
 inline bool Texture::_internal_has_pixels() const {
   return texture_oneof_case() == kPixels;
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "frame/entity_id.h"
+
+namespace frame
+{
+
+/**
+ * @class RenderPass
+ * @brief A program run by the renderer with the textures it read (from its
+ *        materials) and the textures it write.
+ */
+struct RenderPass
+{
+    EntityId program_id = NullId;
+    std::string name;
+    std::vector<EntityId> inputs = {};
+    std::vector<EntityId> outputs = {};
+    // Passes that write an input of this pass (index in the graph).
+    std::vector<std::uint32_t> dependencies = {};
+    // Pruned passes are not live.
+    bool live = true;
+    // GPU time of the last frame (0 if not measured).
+    double gpu_time_ms = 0.0;
+};
+
+/**
+ * @class RenderGraph
+ * @brief Passes of a level (in execution order) linked by the textures they
+ *        read and write. Passes whose outputs never reach a texture used
+ *        outside of the graph (the display) are pruned.
+ */
+class RenderGraph
+{
+  public:
+    //! @brief Remove all the passes.
+    void Clear();
+    /**
+     * @brief Add a use of a program (in execution order), a program used
+     *        more than once (with different materials) is a single pass
+     *        that read the inputs of every use.
+     * @param program_id: The program id.
+     * @param name: Name of the program.
+     * @param inputs: Textures read.
+     * @param outputs: Textures written.
+     * @return Index of the pass.
+     */
+    std::uint32_t AddPass(
+        EntityId program_id,
+        const std::string& name,
+        std::span<const EntityId> inputs,
+        std::span<const EntityId> outputs);
+    /**
+     * @brief Set the name of a texture (used in the dump).
+     * @param texture_id: The texture id.
+     * @param name: Name of the texture.
+     */
+    void SetTextureName(EntityId texture_id, const std::string& name);
+    /**
+     * @brief Link the passes and prune the ones that are not needed.
+     * @param external_texture_ids: Textures read outside of the graph (the
+     *        display texture), in case empty nothing is pruned.
+     * @return Number of pruned passes.
+     */
+    std::uint32_t Compile(std::span<const EntityId> external_texture_ids);
+    /**
+     * @brief Find the pass of a program.
+     * @param program_id: The program id.
+     * @return The index of the pass (if any).
+     */
+    std::optional<std::uint32_t> FindPass(EntityId program_id) const;
+    /**
+     * @brief Check if the pass of a program is live (programs that are not
+     *        in the graph are).
+     * @param program_id: The program id.
+     * @return True if the program has to run.
+     */
+    bool IsLive(EntityId program_id) const;
+    /**
+     * @brief Set the GPU time of a pass.
+     * @param index: Index of the pass.
+     * @param gpu_time_ms: Time in milliseconds.
+     */
+    void SetPassTime(std::uint32_t index, double gpu_time_ms)
+    {
+        passes_.at(index).gpu_time_ms = gpu_time_ms;
+    }
+    /**
+     * @brief Get the GPU time of the last frame (sum of the live passes).
+     * @return Time in milliseconds (0 if not measured).
+     */
+    double GetGpuTime() const;
+    //! @brief Get the passes (in execution order).
+    const std::vector<RenderPass>& GetPasses() const
+    {
+        return passes_;
+    }
+    /**
+     * @brief Dump the graph in the graphviz dot format, passes are linked to
+     *        the textures they write and textures to the passes that read
+     *        them. Pruned passes are dashed.
+     * @return The graph as a dot string.
+     */
+    std::string ToDot() const;
+
+  private:
+    std::vector<RenderPass> passes_ = {};
+    std::vector<std::pair<EntityId, std::string>> texture_names_ = {};
+};
+
+} // End namespace frame.
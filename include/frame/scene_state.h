@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "frame/camera.h"
+#include "frame/entity_id.h"
+
+namespace frame
+{
+
+/**
+ * @class SceneUniform
+ * @brief Value of a uniform of a program set by the simulation (see
+ *        LevelInterface::SetProgramUniform).
+ */
+struct SceneUniform
+{
+    //! @brief Id of the program.
+    EntityId program_id = NullId;
+    //! @brief Name of the uniform in the program.
+    std::string name = "";
+    //! @brief Size of the value (as in ProgramInterface::Uniform).
+    glm::uvec2 size = {1, 1};
+    //! @brief Values in case of a float uniform.
+    std::vector<float> float_values = {};
+    //! @brief Values in case of an int uniform (no float values).
+    std::vector<std::int32_t> int_values = {};
+};
+
+/**
+ * @class SceneMaterial
+ * @brief Textures of a material (id and name in the shader) in the order of
+ *        their units.
+ */
+struct SceneMaterial
+{
+    //! @brief Id of the material (NullId if no material).
+    EntityId material_id = NullId;
+    //! @brief Texture ids and names.
+    std::vector<std::pair<EntityId, std::string>> textures = {};
+};
+
+/**
+ * @class SceneState
+ * @brief Immutable snapshot of the state of a level for a frame (world
+ *        transforms, camera, program uniforms, material textures and time).
+ *
+ * A snapshot is published by the level once per frame (see
+ * LevelInterface::PublishSceneState) and is never modified afterward, so it
+ * can be read from any thread while the level is updated for the next frame.
+ */
+struct SceneState
+{
+    /**
+     * @brief Find the world transform of a node.
+     * @param id: The node id.
+     * @return A pointer to the world transform or null in case the node was
+     *         not in the level when the snapshot was published.
+     */
+    const glm::mat4* FindWorldTransform(EntityId id) const
+    {
+        const std::uint32_t index = GetEntityIndexFromId(id);
+        if (index >= world_transforms.size() ||
+            world_transforms[index].first != id)
+        {
+            return nullptr;
+        }
+        return &world_transforms[index].second;
+    }
+    /**
+     * @brief Get the world transform of a node.
+     * @param id: The node id.
+     * @return The world transform of the node.
+     * @throw std::out_of_range if the node is not in the snapshot.
+     */
+    const glm::mat4& GetWorldTransform(EntityId id) const;
+    /**
+     * @brief Find the uniforms set to a program.
+     * @param program_id: The program id.
+     * @return The uniforms of the program (empty if none).
+     */
+    std::span<const SceneUniform> FindUniforms(EntityId program_id) const;
+    /**
+     * @brief Find the textures of a material.
+     * @param material_id: The material id.
+     * @return A pointer to the material or null in case it was not in the
+     *         level when the snapshot was published.
+     */
+    const SceneMaterial* FindMaterial(EntityId material_id) const
+    {
+        const std::uint32_t index = GetEntityIndexFromId(material_id);
+        if (index >= materials.size() ||
+            materials[index].material_id != material_id)
+        {
+            return nullptr;
+        }
+        return &materials[index];
+    }
+
+    //! @brief Number of the frame (increased at every publish).
+    std::uint64_t frame = 0;
+    //! @brief Version of the level at the time of the publish.
+    std::uint64_t level_version = 0;
+    //! @brief Delta time from the beginning of the software in seconds.
+    double time = 0.0;
+    //! @brief Id of the default camera node (NullId if none).
+    EntityId camera_id = NullId;
+    //! @brief Default camera in world space.
+    Camera camera = {};
+    //! @brief World transforms indexed by node slot (NullId if no node).
+    std::vector<std::pair<EntityId, glm::mat4>> world_transforms = {};
+    //! @brief Uniforms set to the programs (sorted by program id).
+    std::vector<SceneUniform> uniforms = {};
+    //! @brief Materials indexed by slot (NullId if no material).
+    std::vector<SceneMaterial> materials = {};
+    //! @brief Hash of the textures of the materials (changed if a material
+    //!        changed).
+    std::uint64_t material_hash = 0;
+};
+
+/**
+ * @class SceneStatePool
+ * @brief Recycle the scene states, a state is handed back to the pool (under
+ *        its mutex) by the last of its holders, so that the level only fill
+ *        states that no reader can access anymore.
+ *
+ * The control blocks of the shared pointers are recycled as well so that a
+ * steady publish doesn't allocate. It has to be created by make_shared.
+ */
+class SceneStatePool : public std::enable_shared_from_this<SceneStatePool>
+{
+  public:
+    //! @brief Destructor, free the recycled states and blocks.
+    ~SceneStatePool();
+
+  public:
+    /**
+     * @brief Get a state that nobody hold (recycled or new), it is handed
+     *        back when the last copy of the pointer is released.
+     * @return A state to be filled (with the content of an old frame).
+     */
+    std::shared_ptr<SceneState> Acquire();
+
+  protected:
+    //! @brief Allocator of the control blocks (recycled).
+    template <typename T> struct Allocator;
+    //! @brief Deleter of the states (hand them back).
+    struct Recycler;
+    /**
+     * @brief Hand a state back (called by the last holder).
+     * @param scene_state: The state.
+     */
+    void Release(SceneState* scene_state);
+    /**
+     * @brief Get a memory block (recycled if possible).
+     * @param size: Size of the block in bytes.
+     * @return The block.
+     */
+    void* AllocateBlock(std::size_t size);
+    /**
+     * @brief Hand a memory block back.
+     * @param block: The block.
+     * @param size: Size of the block in bytes.
+     */
+    void DeallocateBlock(void* block, std::size_t size);
+
+  private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<SceneState>> free_states_ = {};
+    std::vector<void*> free_blocks_ = {};
+    std::size_t block_size_ = 0;
+};
+
+} // End namespace frame.
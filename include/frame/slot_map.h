@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cstdint>
+#include <fmt/core.h>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "frame/entity_id.h"
+
+namespace frame
+{
+
+/**
+ * @class Handle
+ * @brief Typed wrapper around an entity id, this prevent using a texture id
+ *        to get a program (for example) at compile time.
+ */
+template <typename T>
+class Handle
+{
+  public:
+    //! @brief Default constructor (null handle).
+    constexpr Handle() = default;
+    /**
+     * @brief Create a handle from an entity id.
+     * @param id: The packed entity id.
+     */
+    constexpr explicit Handle(EntityId id) : id_(id)
+    {
+    }
+
+  public:
+    //! @brief Get the packed entity id.
+    constexpr EntityId GetId() const
+    {
+        return id_;
+    }
+    //! @brief Get the slot index.
+    constexpr std::uint32_t GetIndex() const
+    {
+        return GetEntityIndexFromId(id_);
+    }
+    //! @brief Get the generation of the slot.
+    constexpr std::uint32_t GetGeneration() const
+    {
+        return GetEntityGenerationFromId(id_);
+    }
+    //! @brief Get the type stored in the handle.
+    constexpr EntityTypeEnum GetEntityType() const
+    {
+        return GetEntityTypeFromId(id_);
+    }
+    //! @brief Is this a null handle.
+    constexpr explicit operator bool() const
+    {
+        return id_ != NullId;
+    }
+    //! @brief Comparison operator.
+    constexpr bool operator==(const Handle& other) const = default;
+
+  private:
+    EntityId id_ = NullId;
+};
+
+/**
+ * @class SlotMap
+ * @brief Generational storage, element are stored in a vector of slots and
+ *        accessed in O(1) by a handle (index + generation). Removed slots are
+ *        recycled and their generation increased, so stale handles are
+ *        detected instead of pointing to a new element.
+ */
+template <typename T>
+class SlotMap
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param entity_type: The type that will be stored in the handles.
+     */
+    explicit SlotMap(EntityTypeEnum entity_type) : entity_type_(entity_type)
+    {
+    }
+
+  public:
+    /**
+     * @brief Insert a new element (reuse a free slot if any).
+     * @param value: Element to be moved in the storage.
+     * @return Handle to the new element.
+     */
+    Handle<T> Insert(std::unique_ptr<T>&& value)
+    {
+        std::uint32_t index = 0;
+        if (free_list_.empty())
+        {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        else
+        {
+            index = free_list_.back();
+            free_list_.pop_back();
+        }
+        auto& slot = slots_[index];
+        slot.value = std::move(value);
+        ++size_;
+        return Handle<T>(MakeEntityId(entity_type_, slot.generation, index));
+    }
+    /**
+     * @brief Find an element from a handle.
+     * @param handle: Handle to the element.
+     * @return A pointer to the element or null if the handle is invalid or
+     *         stale.
+     */
+    T* Find(Handle<T> handle) const noexcept
+    {
+        const Slot* slot = FindSlot(handle);
+        return slot ? slot->value.get() : nullptr;
+    }
+    /**
+     * @brief Get an element from a handle.
+     * @param handle: Handle to the element.
+     * @return A reference to the element.
+     * @throw std::out_of_range if the handle is invalid or stale.
+     */
+    T& At(Handle<T> handle) const
+    {
+        T* value = Find(handle);
+        if (!value)
+        {
+            throw std::out_of_range(
+                fmt::format("Invalid or stale handle #{}.", handle.GetId()));
+        }
+        return *value;
+    }
+    /**
+     * @brief Check if a handle point to a live element.
+     * @param handle: Handle to the element.
+     * @return True if the element is present.
+     */
+    bool Contains(Handle<T> handle) const noexcept
+    {
+        return FindSlot(handle) != nullptr;
+    }
+    /**
+     * @brief Replace the element at a given handle, the handle stay valid.
+     * @param handle: Handle to the element.
+     * @param value: New element to be moved in the storage.
+     * @return The element that was stored.
+     * @throw std::out_of_range if the handle is invalid or stale.
+     */
+    std::unique_ptr<T> Replace(Handle<T> handle, std::unique_ptr<T>&& value)
+    {
+        Slot& slot = GetSlot(handle);
+        return std::exchange(slot.value, std::move(value));
+    }
+    /**
+     * @brief Extract (move out) an element, the slot is released.
+     * @param handle: Handle to the element.
+     * @return The element that was stored.
+     * @throw std::out_of_range if the handle is invalid or stale.
+     */
+    std::unique_ptr<T> Extract(Handle<T> handle)
+    {
+        Slot& slot = GetSlot(handle);
+        std::unique_ptr<T> value = std::move(slot.value);
+        Release(handle.GetIndex());
+        return value;
+    }
+    /**
+     * @brief Remove an element, the slot is released.
+     * @param handle: Handle to the element.
+     * @throw std::out_of_range if the handle is invalid or stale.
+     */
+    void Erase(Handle<T> handle)
+    {
+        // Element is destroyed after the slot is released (the destructor
+        // can call back in the level).
+        auto value = Extract(handle);
+    }
+    //! @brief Remove all elements (generations are kept).
+    void Clear()
+    {
+        for (std::uint32_t i = 0; i < slots_.size(); ++i)
+        {
+            if (slots_[i].value)
+            {
+                auto value = std::move(slots_[i].value);
+                Release(i);
+            }
+        }
+    }
+    //! @brief Get the number of live elements.
+    std::size_t Size() const
+    {
+        return size_;
+    }
+    //! @brief Is the storage empty.
+    bool Empty() const
+    {
+        return size_ == 0;
+    }
+    /**
+     * @brief Call a function on every live element in slot order.
+     * @param func: Function taking (Handle<T>, T&).
+     */
+    template <typename Func>
+    void ForEach(Func&& func) const
+    {
+        for (std::uint32_t i = 0; i < slots_.size(); ++i)
+        {
+            const auto& slot = slots_[i];
+            if (slot.value)
+            {
+                func(
+                    Handle<T>(MakeEntityId(entity_type_, slot.generation, i)),
+                    *slot.value);
+            }
+        }
+    }
+
+  protected:
+    //! @brief Internal slot.
+    struct Slot
+    {
+        std::unique_ptr<T> value = nullptr;
+        std::uint32_t generation = 0;
+    };
+    const Slot* FindSlot(Handle<T> handle) const noexcept
+    {
+        if (handle.GetEntityType() != entity_type_)
+        {
+            return nullptr;
+        }
+        const std::uint32_t index = handle.GetIndex();
+        if (index >= slots_.size())
+        {
+            return nullptr;
+        }
+        const Slot& slot = slots_[index];
+        if (!slot.value || slot.generation != handle.GetGeneration())
+        {
+            return nullptr;
+        }
+        return &slot;
+    }
+    Slot& GetSlot(Handle<T> handle)
+    {
+        const Slot* slot = FindSlot(handle);
+        if (!slot)
+        {
+            throw std::out_of_range(
+                fmt::format("Invalid or stale handle #{}.", handle.GetId()));
+        }
+        return const_cast<Slot&>(*slot);
+    }
+    void Release(std::uint32_t index)
+    {
+        auto& slot = slots_[index];
+        slot.generation = (slot.generation + 1) & EntityGenerationMask;
+        free_list_.push_back(index);
+        --size_;
+    }
+
+  protected:
+    EntityTypeEnum entity_type_ = EntityTypeEnum::UNKNOWN;
+    std::vector<Slot> slots_ = {};
+    std::vector<std::uint32_t> free_list_ = {};
+    std::size_t size_ = 0;
+};
+
+} // End namespace frame.
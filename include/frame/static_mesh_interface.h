@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "frame/bounding_box.h"
 #include "frame/entity_id.h"
 #include "frame/json/proto.h"
 #include "frame/name_interface.h"
@@ -51,6 +52,8 @@ struct StaticMeshParameter
     };
     //! @brief The list of generated buffers.
     std::set<StaticMeshParameterEnum> generate_list = {};
+    //! @brief Bounds of the points (empty if unknown, then never culled).
+    AxisAlignedBoundingBox bounding_box = {};
 };
 
 /**
@@ -117,6 +120,11 @@ class StaticMeshInterface : public NameInterface
      */
     virtual proto::SceneStaticMesh::RenderPrimitiveEnum GetRenderPrimitive()
         const = 0;
+    /**
+     * @brief Get the bounding box of the mesh (in local space).
+     * @return The bounding box (empty if unknown).
+     */
+    virtual const AxisAlignedBoundingBox& GetBoundingBox() const = 0;
 };
 
 } // End namespace frame.
@@ -148,6 +148,17 @@ struct TextureInterface : public NameInterface
      * @return In this case this is false.
      */
     virtual bool IsCubeMap() const = 0;
+    /**
+     * @brief Get the hash of the content of the texture (its source or the
+     *        pre render that made it).
+     * @return The content hash (0 if unknown, a render target).
+     */
+    virtual std::uint64_t GetContentHash() const = 0;
+    /**
+     * @brief Set the hash of the content of the texture.
+     * @param content_hash: The content hash (0 if unknown).
+     */
+    virtual void SetContentHash(std::uint64_t content_hash) = 0;
     /**
      * @brief Get a copy of the texture output (8 bit format).
      * @return A vector containing the pixel of the image in 8 bit format.
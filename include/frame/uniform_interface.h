@@ -63,24 +63,25 @@ class UniformInterface
      * @brief Get a list of names for the float uniform plugin.
      * @return The list of names for the float uniform plugin.
      */
-    virtual std::vector<std::string> GetFloatNames() const = 0;
+    virtual const std::vector<std::string>& GetFloatNames() const = 0;
     /**
      * @brief Get a list of names for the int uniform plugin.
      * @return The list of names for the int uniform plugin.
      */
-    virtual std::vector<std::string> GetIntNames() const = 0;
+    virtual const std::vector<std::string>& GetIntNames() const = 0;
     /**
      * @brief Get a value.
      * @param name: Connection name.
      * @return The vector that correspond to the value.
      */
-    virtual std::vector<float> GetValueFloat(const std::string& name) const = 0;
+    virtual const std::vector<float>& GetValueFloat(
+        const std::string& name) const = 0;
     /**
      * @brief Get a value.
      * @param name: Connection name.
      * @return The vector that correspond to the value.
      */
-    virtual std::vector<std::int32_t> GetValueInt(
+    virtual const std::vector<std::int32_t>& GetValueInt(
         const std::string& name) const = 0;
     /**
      * @brief Get the size of a value.
@@ -0,0 +1,162 @@
+// Replacement of the global operator new / delete that count allocations in
+// the allocation tracker, this is only linked in case allocation tracking is
+// wanted (see FrameAllocationHook in CMakeLists.txt).
+
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#include "frame/allocation_tracker.h"
+
+namespace
+{
+
+void* TrackedAllocate(std::size_t size)
+{
+    frame::AllocationTracker::Record(size);
+    // malloc(0) can return null.
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* TrackedAlignedAllocate(std::size_t size, std::align_val_t align)
+{
+    frame::AllocationTracker::Record(size);
+    const auto alignment = static_cast<std::size_t>(align);
+#if defined(_WIN32)
+    void* ptr = _aligned_malloc(size ? size : 1, alignment);
+#else
+    // The size of aligned_alloc has to be a multiple of the alignment.
+    const std::size_t rounded =
+        ((size ? size : 1) + alignment - 1) / alignment * alignment;
+    void* ptr = std::aligned_alloc(alignment, rounded);
+#endif
+    return ptr;
+}
+
+void TrackedAlignedFree(void* ptr)
+{
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return TrackedAllocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return TrackedAllocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    frame::AllocationTracker::Record(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    frame::AllocationTracker::Record(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    void* ptr = TrackedAlignedAllocate(size, align);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    void* ptr = TrackedAlignedAllocate(size, align);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(
+    std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    return TrackedAlignedAllocate(size, align);
+}
+
+void* operator new[](
+    std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    return TrackedAlignedAllocate(size, align);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    TrackedAlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    TrackedAlignedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    TrackedAlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    TrackedAlignedFree(ptr);
+}
+
+void operator delete(
+    void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    TrackedAlignedFree(ptr);
+}
+
+void operator delete[](
+    void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    TrackedAlignedFree(ptr);
+}
@@ -0,0 +1,54 @@
+#include "frame/allocation_tracker.h"
+
+#include <atomic>
+
+namespace frame
+{
+
+namespace
+{
+// Constant initialized so they can be used by operator new before any
+// static constructor was called.
+constinit std::atomic<std::uint64_t> allocation_count{0};
+constinit std::atomic<std::uint64_t> allocation_bytes{0};
+constinit std::atomic<bool> allocation_hooked{false};
+} // namespace
+
+AllocationTracker& AllocationTracker::GetInstance()
+{
+    static AllocationTracker allocation_tracker;
+    return allocation_tracker;
+}
+
+void AllocationTracker::Record(std::size_t size) noexcept
+{
+    allocation_hooked.store(true, std::memory_order_relaxed);
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+bool AllocationTracker::IsEnabled() const
+{
+    return allocation_hooked.load(std::memory_order_relaxed);
+}
+
+AllocationStats AllocationTracker::GetTotalStats() const
+{
+    return {
+        allocation_count.load(std::memory_order_relaxed),
+        allocation_bytes.load(std::memory_order_relaxed)};
+}
+
+void AllocationTracker::BeginFrame()
+{
+    frame_begin_stats_ = GetTotalStats();
+}
+
+void AllocationTracker::EndFrame()
+{
+    const auto total_stats = GetTotalStats();
+    frame_stats_.count = total_stats.count - frame_begin_stats_.count;
+    frame_stats_.bytes = total_stats.bytes - frame_begin_stats_.bytes;
+}
+
+} // End namespace frame.
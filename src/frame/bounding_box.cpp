@@ -0,0 +1,60 @@
+#include "frame/bounding_box.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fmt/core.h>
+#include <stdexcept>
+
+namespace frame
+{
+
+void AxisAlignedBoundingBox::Extend(glm::vec3 point)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        min[i] = std::min(min[i], point[i]);
+        max[i] = std::max(max[i], point[i]);
+    }
+}
+
+AxisAlignedBoundingBox AxisAlignedBoundingBox::Transform(
+    const glm::mat4& matrix) const
+{
+    if (IsEmpty())
+        return {};
+    // Transform the center and the extent (the extent by the absolute value
+    // of the matrix), this is the same as transforming the 8 corners.
+    AxisAlignedBoundingBox result;
+    for (int row = 0; row < 3; ++row)
+    {
+        float center = matrix[3][row];
+        float extent = 0.0f;
+        for (int column = 0; column < 3; ++column)
+        {
+            center += matrix[column][row] * (min[column] + max[column]) * 0.5f;
+            extent += std::abs(matrix[column][row]) *
+                      (max[column] - min[column]) * 0.5f;
+        }
+        result.min[row] = center - extent;
+        result.max[row] = center + extent;
+    }
+    return result;
+}
+
+AxisAlignedBoundingBox ComputeBoundingBox(
+    std::span<const float> points, std::uint32_t point_size /* = 3*/)
+{
+    if (point_size < 3)
+    {
+        throw std::runtime_error(fmt::format(
+            "Point size should be at least 3 (was {}).", point_size));
+    }
+    AxisAlignedBoundingBox result;
+    for (std::size_t i = 0; i + point_size <= points.size(); i += point_size)
+    {
+        result.Extend(glm::vec3(points[i], points[i + 1], points[i + 2]));
+    }
+    return result;
+}
+
+} // End namespace frame.
@@ -11,6 +11,9 @@ namespace frame::common
 // CHECKME(anirul): Why not assign size to size_?
 void Draw::Startup(glm::uvec2 size)
 {
+    // Run again (after a resize) the device already has the level.
+    if (started_)
+        return;
     // Just one case the other one is treated after.
     if (draw_type_based_ == DrawTypeEnum::PATH)
     {
@@ -21,6 +24,7 @@ void Draw::Startup(glm::uvec2 size)
         throw std::runtime_error("No level?");
     device_.Startup(std::move(level_));
     level_ = nullptr;
+    started_ = true;
 }
 
 bool Draw::Update(DeviceInterface& device, double dt)
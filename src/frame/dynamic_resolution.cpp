@@ -0,0 +1,81 @@
+#include "frame/dynamic_resolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace frame
+{
+
+namespace
+{
+
+// Weight of the last frame in the smoothed GPU time.
+constexpr double smoothing = 0.1;
+// No change in case the time is that close to the target (relative).
+constexpr double dead_band = 0.05;
+
+} // End anonymous namespace.
+
+bool DynamicResolution::Update(double gpu_time_ms)
+{
+    if (!enabled_ || gpu_time_ms <= 0.0)
+        return false;
+    if (gpu_time_ms_ <= 0.0)
+        gpu_time_ms_ = gpu_time_ms;
+    else
+        gpu_time_ms_ += smoothing * (gpu_time_ms - gpu_time_ms_);
+    if (cooldown_ > 0)
+    {
+        --cooldown_;
+        return false;
+    }
+    const double ratio = target_frame_time_ms_ / gpu_time_ms_;
+    if (std::abs(1.0 - ratio) < dead_band)
+        return false;
+    // The time is proportional to the pixel count (scale squared).
+    const double desired = scale_ * std::sqrt(ratio);
+    float scale = static_cast<float>(
+        std::floor(desired / scale_step + 1e-3) * scale_step);
+    scale = std::clamp(scale, min_scale_, max_scale_);
+    if (std::abs(scale - scale_) < scale_step * 0.5f)
+        return false;
+    // Expected time at the new scale (until it is measured).
+    gpu_time_ms_ *= (scale * scale) / (scale_ * scale_);
+    scale_ = scale;
+    cooldown_ = cooldown_frames;
+    return true;
+}
+
+void DynamicResolution::SetEnabled(bool enabled)
+{
+    enabled_ = enabled;
+    if (!enabled_)
+    {
+        scale_ = max_scale_;
+        gpu_time_ms_ = 0.0;
+        cooldown_ = 0;
+    }
+}
+
+void DynamicResolution::SetTargetFrameTime(double target_frame_time_ms)
+{
+    if (target_frame_time_ms <= 0.0)
+    {
+        throw std::runtime_error("Target frame time should be positive.");
+    }
+    target_frame_time_ms_ = target_frame_time_ms;
+}
+
+void DynamicResolution::SetScaleBounds(float min_scale, float max_scale)
+{
+    if (min_scale <= 0.0f || min_scale > max_scale || max_scale > 1.0f)
+    {
+        throw std::runtime_error("Invalid scale bounds.");
+    }
+    min_scale_ = min_scale;
+    max_scale_ = max_scale;
+    scale_ = std::clamp(scale_, min_scale_, max_scale_);
+}
+
+} // End namespace frame.
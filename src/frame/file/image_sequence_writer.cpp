@@ -0,0 +1,191 @@
+#include "frame/file/image_sequence_writer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/core.h>
+#include <stdexcept>
+
+#include "frame/file/image.h"
+
+namespace frame::file
+{
+
+namespace
+{
+
+std::vector<std::uint8_t> ConvertToByte(const std::vector<std::uint8_t>& pixels)
+{
+    std::vector<std::uint8_t> result(pixels.size() / sizeof(float));
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        float value = 0.0f;
+        std::memcpy(&value, pixels.data() + i * sizeof(float), sizeof(float));
+        result[i] = static_cast<std::uint8_t>(
+            std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+    return result;
+}
+
+} // End anonymous namespace.
+
+ImageSequenceWriter::ImageSequenceWriter(
+    const std::filesystem::path& prefix,
+    std::size_t worker_count /* = 2*/,
+    std::size_t queue_size /* = 8*/)
+    : prefix_(prefix), queue_size_(queue_size)
+{
+    if (!worker_count || !queue_size)
+    {
+        throw std::runtime_error(
+            "Image sequence writer need a thread and a queue.");
+    }
+    for (std::size_t i = 0; i < worker_count; ++i)
+        workers_.emplace_back([this] { WorkerLoop(); });
+}
+
+ImageSequenceWriter::~ImageSequenceWriter()
+{
+    {
+        std::scoped_lock lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+std::string ImageSequenceWriter::GetFileName(std::uint64_t index) const
+{
+    return fmt::format("{}_{:06}.png", prefix_.string(), index);
+}
+
+bool ImageSequenceWriter::Submit(
+    std::uint64_t index,
+    glm::uvec2 size,
+    proto::PixelElementSize pixel_element_size,
+    proto::PixelStructure pixel_structure,
+    std::vector<std::uint8_t>&& pixels)
+{
+    return Submit(
+        GetFileName(index),
+        size,
+        pixel_element_size,
+        pixel_structure,
+        std::move(pixels));
+}
+
+bool ImageSequenceWriter::Submit(
+    const std::string& file_name,
+    glm::uvec2 size,
+    proto::PixelElementSize pixel_element_size,
+    proto::PixelStructure pixel_structure,
+    std::vector<std::uint8_t>&& pixels)
+{
+    if (pixel_element_size.value() == proto::PixelElementSize::SHORT)
+    {
+        throw std::runtime_error(
+            "Invalid format should be byte or float is : " +
+            proto::PixelElementSize_Enum_Name(pixel_element_size.value()));
+    }
+    {
+        std::scoped_lock lock(mutex_);
+        if (jobs_.size() >= queue_size_)
+        {
+            ++dropped_count_;
+            return false;
+        }
+        jobs_.push_back(
+            {file_name,
+             size,
+             pixel_element_size,
+             pixel_structure,
+             std::move(pixels)});
+    }
+    condition_.notify_one();
+    return true;
+}
+
+bool ImageSequenceWriter::IsFull() const
+{
+    std::scoped_lock lock(mutex_);
+    return jobs_.size() >= queue_size_;
+}
+
+void ImageSequenceWriter::WaitForSlot(std::size_t count /* = 1*/)
+{
+    std::unique_lock lock(mutex_);
+    count = std::min(std::max<std::size_t>(count, 1), queue_size_);
+    // Notified each time an image is written.
+    idle_condition_.wait(
+        lock, [this, count] { return jobs_.size() + count <= queue_size_; });
+}
+
+void ImageSequenceWriter::Wait()
+{
+    std::unique_lock lock(mutex_);
+    idle_condition_.wait(
+        lock, [this] { return jobs_.empty() && !busy_count_; });
+}
+
+std::uint64_t ImageSequenceWriter::GetWrittenCount() const
+{
+    std::scoped_lock lock(mutex_);
+    return written_count_;
+}
+
+std::uint64_t ImageSequenceWriter::GetDroppedCount() const
+{
+    std::scoped_lock lock(mutex_);
+    return dropped_count_;
+}
+
+std::uint64_t ImageSequenceWriter::GetFailedCount() const
+{
+    std::scoped_lock lock(mutex_);
+    return failed_count_;
+}
+
+void ImageSequenceWriter::WorkerLoop()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock lock(mutex_);
+            // The queue is written before stopping.
+            condition_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (jobs_.empty())
+                return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            ++busy_count_;
+        }
+        bool written = true;
+        try
+        {
+            // Float (and half read as float) are clamped to bytes.
+            if (job.pixel_element_size.value() != proto::PixelElementSize::BYTE)
+                job.pixels = ConvertToByte(job.pixels);
+            Image image(
+                job.size, proto::PixelElementSize_BYTE(), job.pixel_structure);
+            image.SetData(job.pixels.data());
+            image.SaveImageToFile(job.file_name);
+        }
+        catch (const std::exception& ex)
+        {
+            written = false;
+            logger_->error("Could not write {}: {}", job.file_name, ex.what());
+        }
+        {
+            std::scoped_lock lock(mutex_);
+            --busy_count_;
+            if (written)
+                ++written_count_;
+            else
+                ++failed_count_;
+        }
+        idle_condition_.notify_all();
+    }
+}
+
+} // End namespace frame::file.
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame/json/parse_pixel.h"
+#include "frame/logger.h"
+
+namespace frame::file
+{
+
+/**
+ * @class ImageSequenceWriter
+ * @brief Encode and write numbered images (prefix_000042.png) on a pool of
+ *        threads, so that the rendering thread only has to hand the pixels
+ *        over.
+ *
+ * The queue is bounded: when the encoders fall behind the images submitted
+ * are dropped (and counted) instead of blocking the rendering thread, unless
+ * the caller wait for a slot before submitting (batch rendering).
+ */
+class ImageSequenceWriter
+{
+  public:
+    /**
+     * @brief Constructor, start the threads.
+     * @param prefix: Path and start of the file names (the directory has to
+     *        exist).
+     * @param worker_count: Number of encoding threads (at least 1).
+     * @param queue_size: Number of images waiting to be encoded (at least
+     *        1).
+     */
+    ImageSequenceWriter(
+        const std::filesystem::path& prefix,
+        std::size_t worker_count = 2,
+        std::size_t queue_size = 8);
+    //! @brief Destructor, write the images in the queue and stop the threads.
+    ~ImageSequenceWriter();
+
+  public:
+    /**
+     * @brief Get the file name of an image.
+     * @param index: Number of the image.
+     * @return The file name (prefix followed by the 6 digits number).
+     */
+    std::string GetFileName(std::uint64_t index) const;
+    /**
+     * @brief Queue an image to be written.
+     * @param index: Number of the image.
+     * @param size: Size of the image.
+     * @param pixel_element_size: Size of the elements (BYTE, or HALF and
+     *        FLOAT read as float, they are clamped to bytes).
+     * @param pixel_structure: Structure of the pixels.
+     * @param pixels: Tightly packed pixels (bottom row first).
+     * @return False if the queue was full (the image is dropped).
+     */
+    bool Submit(
+        std::uint64_t index,
+        glm::uvec2 size,
+        proto::PixelElementSize pixel_element_size,
+        proto::PixelStructure pixel_structure,
+        std::vector<std::uint8_t>&& pixels);
+    /**
+     * @brief Queue an image to be written to a given file.
+     * @param file_name: File to be written (png).
+     * @param size: Size of the image.
+     * @param pixel_element_size: Size of the elements (BYTE, or HALF and
+     *        FLOAT read as float, they are clamped to bytes).
+     * @param pixel_structure: Structure of the pixels.
+     * @param pixels: Tightly packed pixels (bottom row first).
+     * @return False if the queue was full (the image is dropped).
+     */
+    bool Submit(
+        const std::string& file_name,
+        glm::uvec2 size,
+        proto::PixelElementSize pixel_element_size,
+        proto::PixelStructure pixel_structure,
+        std::vector<std::uint8_t>&& pixels);
+    //! @brief Check if the queue is full (the next submit will be dropped).
+    bool IsFull() const;
+    /**
+     * @brief Wait until the queue has room (the next submits are queued).
+     * @param count: Number of submits to make room for (up to the size of
+     *        the queue).
+     */
+    void WaitForSlot(std::size_t count = 1);
+    //! @brief Wait until all the images in the queue are written.
+    void Wait();
+    //! @brief Get the number of images written.
+    std::uint64_t GetWrittenCount() const;
+    //! @brief Get the number of images dropped (queue full).
+    std::uint64_t GetDroppedCount() const;
+    //! @brief Get the number of images that couldn't be written.
+    std::uint64_t GetFailedCount() const;
+
+  protected:
+    //! @brief An image to be written.
+    struct Job
+    {
+        std::string file_name = "";
+        glm::uvec2 size = glm::uvec2(0, 0);
+        proto::PixelElementSize pixel_element_size;
+        proto::PixelStructure pixel_structure;
+        std::vector<std::uint8_t> pixels = {};
+    };
+
+  protected:
+    //! @brief Encoding thread loop.
+    void WorkerLoop();
+
+  protected:
+    const std::filesystem::path prefix_;
+    const std::size_t queue_size_;
+    Logger& logger_ = Logger::GetInstance();
+    // Shared with the threads (protected by the mutex).
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable idle_condition_;
+    std::deque<Job> jobs_ = {};
+    std::size_t busy_count_ = 0;
+    std::uint64_t written_count_ = 0;
+    std::uint64_t dropped_count_ = 0;
+    std::uint64_t failed_count_ = 0;
+    bool stop_ = false;
+    std::vector<std::thread> workers_ = {};
+};
+
+} // End namespace frame::file.
@@ -0,0 +1,115 @@
+#include "frame/frustum.h"
+
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define FRAME_FRUSTUM_SSE
+#endif
+
+namespace frame
+{
+
+Frustum::Frustum(const glm::mat4& projection, const glm::mat4& view)
+{
+    const glm::mat4 matrix = projection * view;
+    // Planes are the sum and difference of the last row and the x, y, z
+    // rows (left, right, bottom, top, near, far).
+    for (int i = 0; i < 6; ++i)
+    {
+        const int row = i / 2;
+        const float sign = (i % 2) ? -1.0f : 1.0f;
+        float x = matrix[0][3] + sign * matrix[0][row];
+        float y = matrix[1][3] + sign * matrix[1][row];
+        float z = matrix[2][3] + sign * matrix[2][row];
+        float w = matrix[3][3] + sign * matrix[3][row];
+        const float length = std::sqrt(x * x + y * y + z * z);
+        if (length > 0.0f)
+        {
+            x /= length;
+            y /= length;
+            z /= length;
+            w /= length;
+        }
+        x_[i] = x;
+        y_[i] = y;
+        z_[i] = z;
+        w_[i] = w;
+    }
+    // Padding planes contain everything.
+    for (std::size_t i = 6; i < plane_count_; ++i)
+    {
+        w_[i] = 1.0f;
+    }
+}
+
+bool Frustum::IsVisible(const AxisAlignedBoundingBox& box) const
+{
+    const float center_x = (box.min.x + box.max.x) * 0.5f;
+    const float center_y = (box.min.y + box.max.y) * 0.5f;
+    const float center_z = (box.min.z + box.max.z) * 0.5f;
+    const float extent_x = (box.max.x - box.min.x) * 0.5f;
+    const float extent_y = (box.max.y - box.min.y) * 0.5f;
+    const float extent_z = (box.max.z - box.min.z) * 0.5f;
+#if defined(FRAME_FRUSTUM_SSE)
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const __m128 cx = _mm_set1_ps(center_x);
+    const __m128 cy = _mm_set1_ps(center_y);
+    const __m128 cz = _mm_set1_ps(center_z);
+    const __m128 ex = _mm_set1_ps(extent_x);
+    const __m128 ey = _mm_set1_ps(extent_y);
+    const __m128 ez = _mm_set1_ps(extent_z);
+    for (std::size_t i = 0; i < plane_count_; i += 4)
+    {
+        const __m128 px = _mm_load_ps(&x_[i]);
+        const __m128 py = _mm_load_ps(&y_[i]);
+        const __m128 pz = _mm_load_ps(&z_[i]);
+        // Signed distance from the center to the plane.
+        __m128 distance = _mm_load_ps(&w_[i]);
+        distance = _mm_add_ps(distance, _mm_mul_ps(px, cx));
+        distance = _mm_add_ps(distance, _mm_mul_ps(py, cy));
+        distance = _mm_add_ps(distance, _mm_mul_ps(pz, cz));
+        // Projection of the extent on the normal of the plane.
+        __m128 radius = _mm_mul_ps(_mm_andnot_ps(sign_mask, px), ex);
+        radius =
+            _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(sign_mask, py), ey));
+        radius =
+            _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(sign_mask, pz), ez));
+        // Outside of any plane is outside of the frustum.
+        const __m128 outside =
+            _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps());
+        if (_mm_movemask_ps(outside))
+            return false;
+    }
+#else
+    for (std::size_t i = 0; i < plane_count_; ++i)
+    {
+        const float distance = w_[i] + x_[i] * center_x +
+                               y_[i] * center_y + z_[i] * center_z;
+        const float radius = std::abs(x_[i]) * extent_x +
+                             std::abs(y_[i]) * extent_y +
+                             std::abs(z_[i]) * extent_z;
+        if (distance + radius < 0.0f)
+            return false;
+    }
+#endif
+    return true;
+}
+
+std::uint32_t Frustum::CullBoxes(
+    std::span<const AxisAlignedBoundingBox> boxes,
+    std::span<std::uint8_t> visibility) const
+{
+    assert(boxes.size() == visibility.size());
+    std::uint32_t visible_count = 0;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        const bool visible = IsVisible(boxes[i]);
+        visibility[i] = visible ? 1 : 0;
+        visible_count += visible ? 1 : 0;
+    }
+    return visible_count;
+}
+
+} // End namespace frame.
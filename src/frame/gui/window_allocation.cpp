@@ -0,0 +1,50 @@
+#include "frame/gui/window_allocation.h"
+
+#include <imgui.h>
+
+namespace frame::gui
+{
+
+WindowAllocation::WindowAllocation(const std::string& name) : name_(name)
+{
+    SetName(name);
+}
+
+bool WindowAllocation::DrawCallback()
+{
+    if (!allocation_tracker_.IsEnabled())
+    {
+        ImGui::TextUnformatted(
+            "Allocation tracking is disabled (FRAME_ALLOCATION_TRACKING).");
+        return true;
+    }
+    // ImGui format into its own buffer (no heap allocation).
+    const auto frame_stats = allocation_tracker_.GetFrameStats();
+    ImGui::Text(
+        "Frame allocations: %llu (%llu bytes)",
+        static_cast<unsigned long long>(frame_stats.count),
+        static_cast<unsigned long long>(frame_stats.bytes));
+    const auto total_stats = allocation_tracker_.GetTotalStats();
+    ImGui::Text(
+        "Total allocations: %llu (%llu bytes)",
+        static_cast<unsigned long long>(total_stats.count),
+        static_cast<unsigned long long>(total_stats.bytes));
+    return true;
+}
+
+std::string WindowAllocation::GetName() const
+{
+    return name_;
+}
+
+void WindowAllocation::SetName(const std::string& name)
+{
+    name_ = name;
+}
+
+bool WindowAllocation::End() const
+{
+    return false;
+}
+
+} // namespace frame::gui.
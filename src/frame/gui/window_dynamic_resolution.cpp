@@ -0,0 +1,80 @@
+#include "frame/gui/window_dynamic_resolution.h"
+
+#include <imgui.h>
+
+namespace frame::gui
+{
+
+WindowDynamicResolution::WindowDynamicResolution(
+    const std::string& name, DynamicResolution& dynamic_resolution)
+    : dynamic_resolution_(dynamic_resolution)
+{
+    SetName(name);
+}
+
+bool WindowDynamicResolution::DrawCallback()
+{
+    ImGui::Text("Scale: %.2f", dynamic_resolution_.GetScale());
+    ImGui::Text("GPU time: %.2f ms", dynamic_resolution_.GetGpuTime());
+    ImGui::Separator();
+    bool enabled = dynamic_resolution_.IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled))
+    {
+        dynamic_resolution_.SetEnabled(enabled);
+    }
+    float target_ms =
+        static_cast<float>(dynamic_resolution_.GetTargetFrameTime());
+    if (ImGui::DragFloat("Target (ms)", &target_ms, 0.1f, 1.0f, 100.0f))
+    {
+        dynamic_resolution_.SetTargetFrameTime(target_ms);
+    }
+    float min_scale = dynamic_resolution_.GetMinScale();
+    float max_scale = dynamic_resolution_.GetMaxScale();
+    bool bounds_changed = ImGui::SliderFloat(
+        "Min scale", &min_scale, DynamicResolution::scale_step, max_scale);
+    bounds_changed |=
+        ImGui::SliderFloat("Max scale", &max_scale, min_scale, 1.0f);
+    if (bounds_changed)
+    {
+        dynamic_resolution_.SetScaleBounds(min_scale, max_scale);
+    }
+    int upscale_filter =
+        static_cast<int>(dynamic_resolution_.GetUpscaleFilter());
+    if (ImGui::BeginCombo(
+            "Upscale filter", upscale_filter_items_[upscale_filter].c_str()))
+    {
+        for (int i = 0; i < upscale_filter_items_.size(); ++i)
+        {
+            const bool is_selected = (upscale_filter == i);
+            if (ImGui::Selectable(
+                    upscale_filter_items_[i].c_str(), is_selected))
+            {
+                dynamic_resolution_.SetUpscaleFilter(
+                    static_cast<UpscaleFilterEnum>(i));
+            }
+            if (is_selected)
+            {
+                ImGui::SetItemDefaultFocus();
+            }
+        }
+        ImGui::EndCombo();
+    }
+    return true;
+}
+
+std::string WindowDynamicResolution::GetName() const
+{
+    return name_;
+}
+
+void WindowDynamicResolution::SetName(const std::string& name)
+{
+    name_ = name;
+}
+
+bool WindowDynamicResolution::End() const
+{
+    return false;
+}
+
+} // End namespace frame::gui.
@@ -0,0 +1,445 @@
+#include "frame/json/level_streamer.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+#include <fstream>
+#include <stdexcept>
+
+#include "frame/file/file_system.h"
+#include "frame/file/image.h"
+#include "frame/json/parse_json.h"
+#include "frame/json/parse_material.h"
+#include "frame/json/parse_pixel.h"
+#include "frame/json/parse_program.h"
+#include "frame/json/parse_scene_tree.h"
+#include "frame/json/parse_texture.h"
+
+namespace frame::proto
+{
+
+namespace
+{
+
+// Size in bytes of a pixel as decoded by file::Image (HALF is decoded as
+// float).
+std::size_t GetDecodedPixelSize(const proto::Texture& proto_texture)
+{
+    std::size_t element_size = 0;
+    switch (proto_texture.pixel_element_size().value())
+    {
+    case PixelElementSize::BYTE:
+        element_size = 1;
+        break;
+    case PixelElementSize::SHORT:
+        element_size = 2;
+        break;
+    case PixelElementSize::HALF:
+        [[fallthrough]];
+    case PixelElementSize::FLOAT:
+        element_size = 4;
+        break;
+    default:
+        throw std::runtime_error(fmt::format(
+            "Invalid pixel element size in texture {}.",
+            proto_texture.name()));
+    }
+    return element_size *
+           GetComponentCount(proto_texture.pixel_structure().value());
+}
+
+// Read a fragment and decode the images of its 2D textures, this does not
+// need an OpenGL context.
+proto::Level ReadFragment(const std::filesystem::path& path)
+{
+    std::ifstream ifs(path.string().c_str());
+    if (!ifs)
+    {
+        throw std::runtime_error(
+            fmt::format("Could not open fragment: {}", path.string()));
+    }
+    std::string content(std::istreambuf_iterator<char>(ifs), {});
+    auto proto_level = LoadProtoFromJson<Level>(content);
+    for (auto& proto_texture : *proto_level.mutable_textures())
+    {
+        if (!proto_texture.has_file_name() || proto_texture.cubemap())
+            continue;
+        file::Image image(
+            file::FindFile(std::filesystem::path(proto_texture.file_name())),
+            proto_texture.pixel_element_size(),
+            proto_texture.pixel_structure());
+        const glm::uvec2 size = image.GetSize();
+        // This replace the file name (same oneof).
+        proto_texture.set_pixels(
+            image.Data(),
+            static_cast<std::size_t>(size.x) * size.y *
+                GetDecodedPixelSize(proto_texture));
+        proto_texture.mutable_size()->set_x(size.x);
+        proto_texture.mutable_size()->set_y(size.y);
+    }
+    return proto_level;
+}
+
+// Read and parse the mesh files of the static meshes, this does not need an
+// OpenGL context either (only the buffers are created when committed).
+std::vector<std::optional<opengl::file::StaticMeshFile>> ReadStaticMeshFiles(
+    const proto::Level& proto_level)
+{
+    std::vector<std::optional<opengl::file::StaticMeshFile>> static_mesh_files;
+    for (const auto& proto_static_mesh :
+         proto_level.scene_tree().scene_static_meshes())
+    {
+        auto& static_mesh_file = static_mesh_files.emplace_back();
+        if (proto_static_mesh.has_file_name())
+        {
+            static_mesh_file.emplace(
+                ReadSceneStaticMeshFile(proto_static_mesh));
+        }
+    }
+    return static_mesh_files;
+}
+
+std::size_t CountSteps(const proto::Level& proto_level)
+{
+    const auto& proto_scene_tree = proto_level.scene_tree();
+    return proto_level.textures_size() + proto_level.programs_size() +
+           proto_level.materials_size() +
+           proto_scene_tree.scene_matrices_size() +
+           proto_scene_tree.scene_static_meshes_size() +
+           proto_scene_tree.scene_cameras_size() +
+           proto_scene_tree.scene_lights_size();
+}
+
+} // End namespace.
+
+LevelStreamer::LevelStreamer(LevelInterface& level, glm::uvec2 size)
+    : level_(level), size_(size)
+{
+    worker_ = std::thread([this] { WorkerLoop(); });
+}
+
+LevelStreamer::~LevelStreamer()
+{
+    {
+        std::scoped_lock lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_all();
+    worker_.join();
+}
+
+void LevelStreamer::LoadFragment(
+    const std::string& name, const std::filesystem::path& path)
+{
+    if (fragment_map_.contains(name))
+    {
+        throw std::runtime_error(
+            fmt::format("Fragment {} is already loaded.", name));
+    }
+    Fragment fragment{};
+    fragment.serial = next_serial_++;
+    {
+        std::scoped_lock lock(mutex_);
+        requests_.push_back({name, path, fragment.serial});
+    }
+    condition_.notify_one();
+    fragment_map_.emplace(name, std::move(fragment));
+    logger_->info("Streaming fragment {} from {}.", name, path.string());
+}
+
+void LevelStreamer::UnloadFragment(const std::string& name)
+{
+    auto it = fragment_map_.find(name);
+    if (it == fragment_map_.end())
+    {
+        throw std::runtime_error(fmt::format("No fragment {}.", name));
+    }
+    // In case it is still loading the result will be ignored (no fragment
+    // with this serial anymore).
+    RemoveEntities(it->second);
+    std::erase(commit_queue_, name);
+    fragment_map_.erase(it);
+    logger_->info("Unloaded fragment {}.", name);
+}
+
+void LevelStreamer::Update(std::chrono::microseconds budget)
+{
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::scoped_lock lock(mutex_);
+        std::swap(received_results_, results_);
+    }
+    for (auto& result : received_results_)
+    {
+        auto it = fragment_map_.find(result.name);
+        if (it == fragment_map_.end() || it->second.serial != result.serial)
+            continue;
+        auto& fragment = it->second;
+        if (!result.error.empty())
+        {
+            fragment.state = FragmentStateEnum::FAILED;
+            logger_->error(
+                "Could not load fragment {}: {}", result.name, result.error);
+            continue;
+        }
+        fragment.proto_level = std::move(result.proto_level);
+        fragment.static_mesh_files = std::move(result.static_mesh_files);
+        fragment.step_count = CountSteps(fragment.proto_level);
+        fragment.state = FragmentStateEnum::COMMITTING;
+        commit_queue_.push_back(result.name);
+    }
+    received_results_.clear();
+    if (commit_queue_.empty())
+        return;
+
+    // At least one element is added per frame so that loading progress even
+    // with a budget too small for the slowest element.
+    auto elapsed = std::chrono::microseconds(0);
+    std::size_t step_count = 0;
+    while (!commit_queue_.empty() && (!step_count || elapsed < budget))
+    {
+        ++step_count;
+        const std::string& fragment_name = commit_queue_.front();
+        auto& fragment = fragment_map_.at(fragment_name);
+        const auto step_start = std::chrono::steady_clock::now();
+        if (fragment.step < fragment.step_count)
+        {
+            try
+            {
+                CommitStep(fragment);
+            }
+            catch (const std::exception& ex)
+            {
+                logger_->error(
+                    "Could not add fragment {} to the level: {}",
+                    fragment_name,
+                    ex.what());
+                RemoveEntities(fragment);
+                fragment.state = FragmentStateEnum::FAILED;
+                fragment.proto_level.Clear();
+                fragment.static_mesh_files.clear();
+                commit_queue_.pop_front();
+                continue;
+            }
+        }
+        const auto now = std::chrono::steady_clock::now();
+        fragment.commit_time +=
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                now - step_start);
+        elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(now - start);
+        if (fragment.step < fragment.step_count)
+            continue;
+        fragment.state = FragmentStateEnum::LOADED;
+        fragment.proto_level.Clear();
+        fragment.static_mesh_files.clear();
+        logger_->info(
+            "Fragment {} loaded: {} elements in {:.2f} ms.",
+            fragment_name,
+            fragment.step_count,
+            fragment.commit_time.count() / 1000.0);
+        commit_queue_.pop_front();
+    }
+    if (!commit_queue_.empty())
+    {
+        const auto& fragment = fragment_map_.at(commit_queue_.front());
+        logger_->debug(
+            "Fragment {}: {}/{} elements.",
+            commit_queue_.front(),
+            fragment.step,
+            fragment.step_count);
+    }
+    logger_->debug(
+        "Level streamer added {} element(s) in {:.2f} ms (budget {:.2f} ms).",
+        step_count,
+        elapsed.count() / 1000.0,
+        budget.count() / 1000.0);
+}
+
+FragmentStateEnum LevelStreamer::GetFragmentState(
+    const std::string& name) const
+{
+    auto it = fragment_map_.find(name);
+    if (it == fragment_map_.end())
+        return FragmentStateEnum::UNKNOWN;
+    return it->second.state;
+}
+
+bool LevelStreamer::IsIdle() const
+{
+    return std::none_of(
+        fragment_map_.begin(), fragment_map_.end(), [](const auto& pair) {
+            return pair.second.state == FragmentStateEnum::LOADING ||
+                   pair.second.state == FragmentStateEnum::COMMITTING;
+        });
+}
+
+void LevelStreamer::WorkerLoop()
+{
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        condition_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+        if (stop_)
+            return;
+        LoadRequest request = std::move(requests_.front());
+        requests_.pop_front();
+        lock.unlock();
+        LoadResult result{};
+        result.name = request.name;
+        result.serial = request.serial;
+        try
+        {
+            result.proto_level = ReadFragment(request.path);
+            result.static_mesh_files = ReadStaticMeshFiles(result.proto_level);
+        }
+        catch (const std::exception& ex)
+        {
+            result.error = ex.what();
+        }
+        lock.lock();
+        results_.push_back(std::move(result));
+    }
+}
+
+void LevelStreamer::CommitStep(Fragment& fragment)
+{
+    const auto& proto_level = fragment.proto_level;
+    const auto& proto_scene_tree = proto_level.scene_tree();
+    int index = static_cast<int>(fragment.step++);
+    if (index < proto_level.textures_size())
+    {
+        const auto& proto_texture = proto_level.textures(index);
+        auto texture = ParseBasicTexture(proto_texture, size_);
+        if (!texture)
+        {
+            throw std::runtime_error(fmt::format(
+                "Could not load texture: {}", proto_texture.name()));
+        }
+        texture->SetName(proto_texture.name());
+        fragment.entity_ids.push_back(level_.AddTexture(std::move(texture)));
+        return;
+    }
+    index -= proto_level.textures_size();
+    if (index < proto_level.programs_size())
+    {
+        const auto& proto_program = proto_level.programs(index);
+        auto program = ParseProgramOpenGL(proto_program, level_);
+        if (!program)
+        {
+            throw std::runtime_error(
+                fmt::format("invalid program: {}", proto_program.name()));
+        }
+        program->SetName(proto_program.name());
+        fragment.entity_ids.push_back(level_.AddProgram(std::move(program)));
+        return;
+    }
+    index -= proto_level.programs_size();
+    if (index < proto_level.materials_size())
+    {
+        const auto& proto_material = proto_level.materials(index);
+        auto maybe_material = ParseMaterialOpenGL(proto_material, level_);
+        if (!maybe_material)
+        {
+            throw std::runtime_error(
+                fmt::format("invalid material : {}", proto_material.name()));
+        }
+        fragment.entity_ids.push_back(
+            level_.AddMaterial(std::move(maybe_material.value())));
+        return;
+    }
+    index -= proto_level.materials_size();
+    if (index < proto_scene_tree.scene_matrices_size())
+    {
+        const auto& proto_matrix = proto_scene_tree.scene_matrices(index);
+        auto node_id = ParseSceneMatrix(level_, proto_matrix);
+        if (!node_id)
+        {
+            throw std::runtime_error(
+                fmt::format("invalid matrix: {}", proto_matrix.name()));
+        }
+        fragment.entity_ids.push_back(node_id);
+        return;
+    }
+    index -= proto_scene_tree.scene_matrices_size();
+    if (index < proto_scene_tree.scene_static_meshes_size())
+    {
+        const auto& proto_static_mesh =
+            proto_scene_tree.scene_static_meshes(index);
+        // The mesh file was parsed by the background thread, only the
+        // buffers are created here. The meshes (and materials and textures)
+        // created are added to the fragment before the nodes.
+        auto& static_mesh_file = fragment.static_mesh_files.at(index);
+        auto node_ids = ParseSceneStaticMesh(
+            level_,
+            proto_static_mesh,
+            static_mesh_file ? &static_mesh_file.value() : nullptr,
+            &fragment.entity_ids);
+        static_mesh_file.reset();
+        if (node_ids.empty())
+        {
+            throw std::runtime_error(fmt::format(
+                "invalid static mesh: {}", proto_static_mesh.name()));
+        }
+        fragment.entity_ids.insert(
+            fragment.entity_ids.end(), node_ids.begin(), node_ids.end());
+        return;
+    }
+    index -= proto_scene_tree.scene_static_meshes_size();
+    if (index < proto_scene_tree.scene_cameras_size())
+    {
+        const auto& proto_camera = proto_scene_tree.scene_cameras(index);
+        auto node_id = ParseSceneCamera(level_, proto_camera);
+        if (!node_id)
+        {
+            throw std::runtime_error(
+                fmt::format("invalid camera: {}", proto_camera.name()));
+        }
+        fragment.entity_ids.push_back(node_id);
+        return;
+    }
+    index -= proto_scene_tree.scene_cameras_size();
+    const auto& proto_light = proto_scene_tree.scene_lights(index);
+    auto node_id = ParseSceneLight(level_, proto_light);
+    if (!node_id)
+    {
+        throw std::runtime_error("invalid light.");
+    }
+    fragment.entity_ids.push_back(node_id);
+}
+
+void LevelStreamer::RemoveEntities(Fragment& fragment)
+{
+    // Reverse order so nodes go before their meshes and materials before
+    // the programs and textures they use.
+    for (auto it = fragment.entity_ids.rbegin();
+         it != fragment.entity_ids.rend();
+         ++it)
+    {
+        switch (GetEntityTypeFromId(*it))
+        {
+        case EntityTypeEnum::NODE:
+            // Nodes of other fragments (or of the level) under a node of
+            // this fragment wait for it to be loaded again.
+            level_.RemoveSceneNodeKeepChildren(*it);
+            break;
+        case EntityTypeEnum::STATIC_MESH:
+            level_.RemoveStaticMesh(*it);
+            break;
+        case EntityTypeEnum::MATERIAL:
+            level_.RemoveMaterial(*it);
+            break;
+        case EntityTypeEnum::PROGRAM:
+            level_.RemoveProgram(*it);
+            break;
+        case EntityTypeEnum::TEXTURE:
+            level_.RemoveTexture(*it);
+            break;
+        default:
+            throw std::runtime_error(
+                fmt::format("Unexpected entity #{} in fragment.", *it));
+        }
+    }
+    fragment.entity_ids.clear();
+}
+
+} // End namespace frame::proto.
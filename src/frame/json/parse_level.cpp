@@ -25,6 +25,7 @@ std::unique_ptr<LevelInterface> LevelProto(
     auto level = std::make_unique<frame::Level>();
     level->SetName(proto_level.name());
     level->SetDefaultTextureName(proto_level.default_texture_name());
+    level->SetOcclusionCulling(proto_level.occlusion_culling());
 
     // Include the default cube and quad.
     auto cube_id = opengl::CreateCubeStaticMesh(*level.get());
@@ -1,5 +1,7 @@
 #include "frame/json/parse_pixel.h"
 
+#include <stdexcept>
+
 namespace frame::proto
 {
 
@@ -83,4 +85,25 @@ bool operator==(const PixelElementSize& l, const PixelElementSize& r)
     return l.value() == r.value();
 }
 
+std::size_t GetComponentCount(PixelStructure::Enum pixel_structure)
+{
+    switch (pixel_structure)
+    {
+    case PixelStructure::GREY:
+        return 1;
+    case PixelStructure::GREY_ALPHA:
+        return 2;
+    case PixelStructure::RGB:
+        [[fallthrough]];
+    case PixelStructure::BGR:
+        return 3;
+    case PixelStructure::RGB_ALPHA:
+        [[fallthrough]];
+    case PixelStructure::BGR_ALPHA:
+        return 4;
+    default:
+        throw std::runtime_error("Invalid pixel structure.");
+    }
+}
+
 } // End namespace frame::proto.
@@ -6,11 +6,70 @@
 #include "frame/file/file_system.h"
 #include "frame/json/parse_uniform.h"
 #include "frame/opengl/file/load_program.h"
+#include "frame/opengl/pre_render_cache.h"
 #include "frame/opengl/program.h"
 
 namespace frame::proto
 {
 
+void SetUniformParameters(
+    const google::protobuf::RepeatedPtrField<Uniform>& parameters,
+    ProgramInterface& program)
+{
+    program.Use();
+    for (const auto& parameter : parameters)
+    {
+        switch (parameter.value_oneof_case())
+        {
+        case Uniform::kUniformEnum:
+            break;
+        case Uniform::kUniformInt:
+            program.Uniform(parameter.name(), parameter.uniform_int());
+            break;
+        case Uniform::kUniformFloat:
+            program.Uniform(parameter.name(), parameter.uniform_float());
+            break;
+        case Uniform::kUniformVec2:
+            program.Uniform(
+                parameter.name(), ParseUniform(parameter.uniform_vec2()));
+            break;
+        case Uniform::kUniformVec3:
+            program.Uniform(
+                parameter.name(), ParseUniform(parameter.uniform_vec3()));
+            break;
+        case Uniform::kUniformVec4:
+            program.Uniform(
+                parameter.name(), ParseUniform(parameter.uniform_vec4()));
+            break;
+        case Uniform::kUniformMat4:
+            program.Uniform(
+                parameter.name(), ParseUniform(parameter.uniform_mat4()));
+            break;
+        case Uniform::kUniformVec2S:
+            program.Uniform(
+                parameter.name(), ParseUniform(parameter.uniform_vec2s()));
+            break;
+        case Uniform::kUniformVec3S:
+            program.Uniform(
+                parameter.name(), ParseUniform(parameter.uniform_vec3s()));
+            break;
+        case Uniform::kUniformVec4S:
+            program.Uniform(
+                parameter.name(), ParseUniform(parameter.uniform_vec4s()));
+            break;
+        case Uniform::kUniformFloatPlugin:
+            break;
+        case Uniform::kUniformIntPlugin:
+            break;
+        default:
+            throw std::runtime_error(fmt::format(
+                "No handle for parameter {}#?",
+                static_cast<int>(parameter.value_oneof_case())));
+        }
+    }
+    program.UnUse();
+}
+
 std::unique_ptr<frame::ProgramInterface> ParseProgramOpenGL(
     const Program& proto_program, LevelInterface& level)
 {
@@ -66,58 +125,32 @@ std::unique_ptr<frame::ProgramInterface> ParseProgramOpenGL(
             "No way {}?",
             static_cast<int>(proto_program.input_scene_type().value())));
     }
-    program->Use();
+    SetUniformParameters(proto_program.parameters(), *program);
+    auto& gl_program = dynamic_cast<opengl::Program&>(*program);
+    // The parameters are part of the content of the program.
+    auto content_hash = gl_program.GetContentHash();
     for (const auto& parameter : proto_program.parameters())
     {
-        switch (parameter.value_oneof_case())
-        {
-        case Uniform::kUniformEnum:
-            break;
-        case Uniform::kUniformInt:
-            program->Uniform(parameter.name(), parameter.uniform_int());
-            break;
-        case Uniform::kUniformFloat:
-            program->Uniform(parameter.name(), parameter.uniform_float());
-            break;
-        case Uniform::kUniformVec2:
-            program->Uniform(
-                parameter.name(), ParseUniform(parameter.uniform_vec2()));
-            break;
-        case Uniform::kUniformVec3:
-            program->Uniform(
-                parameter.name(), ParseUniform(parameter.uniform_vec3()));
-            break;
-        case Uniform::kUniformVec4:
-            program->Uniform(
-                parameter.name(), ParseUniform(parameter.uniform_vec4()));
-            break;
-        case Uniform::kUniformMat4:
-            program->Uniform(
-                parameter.name(), ParseUniform(parameter.uniform_mat4()));
-            break;
-        case Uniform::kUniformVec2S:
-            program->Uniform(
-                parameter.name(), ParseUniform(parameter.uniform_vec2s()));
-            break;
-        case Uniform::kUniformVec3S:
-            program->Uniform(
-                parameter.name(), ParseUniform(parameter.uniform_vec3s()));
-            break;
-        case Uniform::kUniformVec4S:
-            program->Uniform(
-                parameter.name(), ParseUniform(parameter.uniform_vec4s()));
-            break;
-        case Uniform::kUniformFloatPlugin:
-            break;
-        case Uniform::kUniformIntPlugin:
-            break;
-        default:
-            throw std::runtime_error(fmt::format(
-                "No handle for parameter {}#?",
-                static_cast<int>(parameter.value_oneof_case())));
-        }
+        content_hash = opengl::CombineContentHash(
+            content_hash, parameter.SerializeAsString());
+    }
+    gl_program.SetContentHash(content_hash);
+    if (proto_program.depth_prepass())
+    {
+        auto depth_only_program = opengl::CreateDepthOnlyProgram(gl_program);
+        // The vertex shader could use the parameters.
+        SetUniformParameters(
+            proto_program.parameters(), *depth_only_program);
+        gl_program.SetDepthOnlyProgram(std::move(depth_only_program));
+    }
+    // Without support the views are drawn one after the other.
+    if (proto_program.multi_view() && opengl::Program::IsMultiViewSupported())
+    {
+        auto multi_view_program = opengl::CreateMultiViewProgram(gl_program);
+        SetUniformParameters(
+            proto_program.parameters(), *multi_view_program);
+        gl_program.SetMultiViewProgram(std::move(multi_view_program));
     }
-    program->UnUse();
     return program;
 }
 
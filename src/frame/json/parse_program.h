@@ -10,6 +10,15 @@
 namespace frame::proto
 {
 
+/**
+ * @brief Set uniform parameters to a program (enum and plugin uniforms are
+ *        skipped, they are not values).
+ * @param parameters: The proto form of the uniforms.
+ * @param program: The program to be set.
+ */
+void SetUniformParameters(
+    const google::protobuf::RepeatedPtrField<Uniform>& parameters,
+    ProgramInterface& program);
 /**
  * @brief Parse a program as an OpenGL object.
  * @param proto_program: The proto form of the program.
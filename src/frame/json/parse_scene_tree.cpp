@@ -1,6 +1,7 @@
 #include "frame/json/parse_scene_tree.h"
 
 #include <fmt/core.h>
+#include <optional>
 
 #include "frame/file/file_system.h"
 #include "frame/file/obj.h"
@@ -23,17 +24,18 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
     LevelInterface& level)
 {
     return [&level](const std::string& name) -> NodeInterface* {
-        auto maybe_id = level.GetIdFromName(name);
+        auto maybe_id = level.TryGetIdFromName(name);
         if (!maybe_id)
         {
             throw std::runtime_error(fmt::format("No id from name: {}", name));
         }
-        EntityId id = maybe_id;
-        return &level.GetSceneNodeFromId(id);
+        return &level.GetSceneNodeFromId(maybe_id.value());
     };
 }
 
-[[nodiscard]] bool ParseSceneMatrix(
+} // End namespace.
+
+EntityId ParseSceneMatrix(
     LevelInterface& level, const SceneMatrix& proto_scene_matrix)
 {
     std::unique_ptr<NodeMatrix> scene_matrix = nullptr;
@@ -54,11 +56,13 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
     }
     scene_matrix->SetName(proto_scene_matrix.name());
     scene_matrix->SetParentName(proto_scene_matrix.parent());
-    auto maybe_scene_id = level.AddSceneNode(std::move(scene_matrix));
-    return static_cast<bool>(maybe_scene_id);
+    return level.AddSceneNode(std::move(scene_matrix));
 }
 
-[[nodiscard]] bool ParseSceneStaticMeshClearBuffer(
+namespace
+{
+
+std::vector<EntityId> ParseSceneStaticMeshClearBuffer(
     LevelInterface& level, const SceneStaticMesh& proto_scene_static_mesh)
 {
     auto node_interface = std::make_unique<NodeStaticMesh>(
@@ -69,10 +73,10 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
         throw std::runtime_error("No scene Id.");
     level.AddMeshMaterialId(
         maybe_scene_id, 0, proto_scene_static_mesh.render_time_enum());
-    return true;
+    return {maybe_scene_id};
 }
 
-[[nodiscard]] bool ParseSceneStaticMeshMeshEnum(
+std::vector<EntityId> ParseSceneStaticMeshMeshEnum(
     LevelInterface& level, const SceneStaticMesh& proto_scene_static_mesh)
 {
     if (proto_scene_static_mesh.mesh_enum() == SceneStaticMesh::INVALID)
@@ -86,14 +90,14 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
     case SceneStaticMesh::CUBE: {
         auto maybe_mesh_id = level.GetDefaultStaticMeshCubeId();
         if (!maybe_mesh_id)
-            return false;
+            return {};
         mesh_id = maybe_mesh_id;
         break;
     }
     case SceneStaticMesh::QUAD: {
         auto maybe_mesh_id = level.GetDefaultStaticMeshQuadId();
         if (!maybe_mesh_id)
-            return false;
+            return {};
         mesh_id = maybe_mesh_id;
         break;
     }
@@ -123,19 +127,30 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
     level.AddMeshMaterialId(maybe_scene_id, material_id, render_time_enum);
     if (!maybe_scene_id)
         throw std::runtime_error("No scene Id.");
-    return true;
+    return {maybe_scene_id};
 }
 
-[[nodiscard]] bool ParseSceneStaticMeshFileName(
-    LevelInterface& level, const SceneStaticMesh& proto_scene_static_mesh)
+std::vector<EntityId> ParseSceneStaticMeshFileName(
+    LevelInterface& level,
+    const SceneStaticMesh& proto_scene_static_mesh,
+    const opengl::file::StaticMeshFile* static_mesh_file,
+    std::vector<EntityId>* resource_ids)
 {
+    // Read here in case it wasn't read before (by the level streamer).
+    std::optional<opengl::file::StaticMeshFile> read_static_mesh_file;
+    if (!static_mesh_file)
+    {
+        static_mesh_file = &read_static_mesh_file.emplace(
+            ReadSceneStaticMeshFile(proto_scene_static_mesh));
+    }
     auto vec_node_mesh_id = opengl::file::LoadStaticMeshesFromFile(
         level,
-        "asset/model/" + proto_scene_static_mesh.file_name(),
+        *static_mesh_file,
         proto_scene_static_mesh.name(),
-        proto_scene_static_mesh.material_name());
+        proto_scene_static_mesh.material_name(),
+        resource_ids);
     if (vec_node_mesh_id.empty())
-        return false;
+        return {};
     int i = 0;
     for (const auto node_mesh_id : vec_node_mesh_id)
     {
@@ -145,14 +160,16 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
             proto_scene_static_mesh.render_primitive_enum());
         auto str = fmt::format("{}.{}", proto_scene_static_mesh.name(), i);
         mesh.SetName(str);
-        node.SetParentName(proto_scene_static_mesh.parent());
+        level.SetParentName(node_mesh_id, proto_scene_static_mesh.parent());
         ++i;
     }
-    return true;
+    return vec_node_mesh_id;
 }
 
-[[nodiscard]] bool ParseSceneStaticMeshStreamInput(
-    LevelInterface& level, const SceneStaticMesh& proto_scene_static_mesh)
+std::vector<EntityId> ParseSceneStaticMeshStreamInput(
+    LevelInterface& level,
+    const SceneStaticMesh& proto_scene_static_mesh,
+    std::vector<EntityId>* resource_ids)
 {
     assert(proto_scene_static_mesh.has_multi_plugin());
     auto point_buffer = std::make_unique<opengl::Buffer>(
@@ -186,12 +203,14 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
     auto mesh = std::make_unique<opengl::StaticMesh>(level, parameter);
     mesh->SetName("mesh." + proto_scene_static_mesh.name());
     auto mesh_id = level.AddStaticMesh(std::move(mesh));
+    if (resource_ids)
+        resource_ids->push_back(mesh_id);
 
     // Get the material id.
     auto maybe_material_id =
         level.GetIdFromName(proto_scene_static_mesh.material_name());
     if (!maybe_material_id)
-        return false;
+        return {};
     const EntityId material_id = maybe_material_id;
 
     // Create the node corresponding to the mesh.
@@ -207,12 +226,104 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
         scene_id, material_id, proto_scene_static_mesh.render_time_enum());
     if (!scene_id)
         throw std::runtime_error("No scene Id.");
-    return true;
+    return {scene_id};
 }
 
-[[nodiscard]] bool ParseSceneStaticMesh(
-    LevelInterface& level, const SceneStaticMesh& proto_scene_static_mesh)
+// Apply the culling option of the proto to the created nodes.
+std::vector<EntityId> SetFrustumCulling(
+    LevelInterface& level,
+    const SceneStaticMesh& proto_scene_static_mesh,
+    std::vector<EntityId> node_ids)
 {
+    for (const auto node_id : node_ids)
+    {
+        auto& node_static_mesh =
+            dynamic_cast<NodeStaticMesh&>(level.GetSceneNodeFromId(node_id));
+        node_static_mesh.SetFrustumCulling(
+            !proto_scene_static_mesh.skip_culling());
+    }
+    return node_ids;
+}
+
+// Get the material (and render time) a node was added with.
+std::tuple<EntityId, SceneStaticMesh::RenderTimeEnum> GetMeshMaterial(
+    const LevelInterface& level, EntityId node_id)
+{
+    for (const auto& [id, material_render] : level.GetStaticMeshMaterialIds())
+    {
+        if (id == node_id)
+            return material_render;
+    }
+    throw std::runtime_error(
+        fmt::format("No material for node: {}.", node_id));
+}
+
+// Place the created nodes at the instance matrices of the proto, the first
+// matrix is applied to the node itself and a node is added (same mesh,
+// material and parent) for every other one.
+std::vector<EntityId> AddInstances(
+    LevelInterface& level,
+    const SceneStaticMesh& proto_scene_static_mesh,
+    std::vector<EntityId> node_ids)
+{
+    const auto& instance_matrices =
+        proto_scene_static_mesh.instance_matrices();
+    if (instance_matrices.empty())
+        return node_ids;
+    const std::size_t node_count = node_ids.size();
+    for (std::size_t i = 0; i < node_count; ++i)
+    {
+        const auto node_id = node_ids[i];
+        auto& node =
+            dynamic_cast<NodeStaticMesh&>(level.GetSceneNodeFromId(node_id));
+        node.SetLocalTransform(ParseUniform(instance_matrices[0]));
+        const auto mesh_id = node.GetLocalMesh();
+        const auto name = node.GetName();
+        const auto parent_name = node.GetParentName();
+        const auto [material_id, render_time_enum] =
+            GetMeshMaterial(level, node_id);
+        for (int j = 1; j < instance_matrices.size(); ++j)
+        {
+            auto instance_node =
+                std::make_unique<NodeStaticMesh>(GetFunctor(level), mesh_id);
+            instance_node->SetName(fmt::format("{}.instance.{}", name, j));
+            instance_node->SetParentName(parent_name);
+            instance_node->SetLocalTransform(
+                ParseUniform(instance_matrices[j]));
+            auto instance_id = level.AddSceneNode(std::move(instance_node));
+            if (!instance_id)
+                throw std::runtime_error("No scene Id.");
+            level.AddMeshMaterialId(
+                instance_id, material_id, render_time_enum);
+            node_ids.push_back(instance_id);
+        }
+    }
+    return node_ids;
+}
+
+} // End namespace.
+
+opengl::file::StaticMeshFile ReadSceneStaticMeshFile(
+    const SceneStaticMesh& proto_scene_static_mesh)
+{
+    return opengl::file::ReadStaticMeshFile(
+        "asset/model/" + proto_scene_static_mesh.file_name());
+}
+
+std::vector<EntityId> ParseSceneStaticMesh(
+    LevelInterface& level,
+    const SceneStaticMesh& proto_scene_static_mesh,
+    const opengl::file::StaticMeshFile* static_mesh_file /* = nullptr*/,
+    std::vector<EntityId>* resource_ids /* = nullptr*/)
+{
+    if (proto_scene_static_mesh.instance_matrices_size() &&
+        (proto_scene_static_mesh.has_clean_buffer() ||
+         proto_scene_static_mesh.has_multi_plugin()))
+    {
+        throw std::runtime_error(fmt::format(
+            "Instance matrices need a mesh enum or a file name: [{}].",
+            proto_scene_static_mesh.name()));
+    }
     // 1st case this is a clean static mesh node.
     if (proto_scene_static_mesh.has_clean_buffer())
     {
@@ -221,22 +332,39 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
     // 2nd case this is a enum static mesh node (CUBE or QUAD).
     if (proto_scene_static_mesh.has_mesh_enum())
     {
-        return ParseSceneStaticMeshMeshEnum(level, proto_scene_static_mesh);
+        return SetFrustumCulling(
+            level,
+            proto_scene_static_mesh,
+            AddInstances(
+                level,
+                proto_scene_static_mesh,
+                ParseSceneStaticMeshMeshEnum(level, proto_scene_static_mesh)));
     }
     // 3rd case this is a mesh file.
     if (proto_scene_static_mesh.has_file_name())
     {
-        return ParseSceneStaticMeshFileName(level, proto_scene_static_mesh);
+        return SetFrustumCulling(
+            level,
+            proto_scene_static_mesh,
+            AddInstances(
+                level,
+                proto_scene_static_mesh,
+                ParseSceneStaticMeshFileName(
+                    level,
+                    proto_scene_static_mesh,
+                    static_mesh_file,
+                    resource_ids)));
     }
     // 4th case stream input.
     if (proto_scene_static_mesh.has_multi_plugin())
     {
-        return ParseSceneStaticMeshStreamInput(level, proto_scene_static_mesh);
+        return ParseSceneStaticMeshStreamInput(
+            level, proto_scene_static_mesh, resource_ids);
     }
-    return false;
+    return {};
 }
 
-[[nodiscard]] bool ParseSceneCamera(
+EntityId ParseSceneCamera(
     LevelInterface& level, const frame::proto::SceneCamera& proto_scene_camera)
 {
     if (proto_scene_camera.fov_degrees() == 0.0)
@@ -254,11 +382,10 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
         proto_scene_camera.far_clip());
     scene_camera->SetName(proto_scene_camera.name());
     scene_camera->SetParentName(proto_scene_camera.parent());
-    auto maybe_scene_id = level.AddSceneNode(std::move(scene_camera));
-    return static_cast<bool>(maybe_scene_id);
+    return level.AddSceneNode(std::move(scene_camera));
 }
 
-[[nodiscard]] bool ParseSceneLight(
+EntityId ParseSceneLight(
     LevelInterface& level, const proto::SceneLight& proto_scene_light)
 {
     switch (proto_scene_light.light_type())
@@ -270,8 +397,7 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
                 NodeLightEnum::POINT,
                 ParseUniform(proto_scene_light.position()),
                 ParseUniform(proto_scene_light.color()));
-        auto maybe_node_id = level.AddSceneNode(std::move(node_light));
-        return static_cast<bool>(maybe_node_id);
+        return level.AddSceneNode(std::move(node_light));
     }
     case proto::SceneLight::DIRECTIONAL: {
         std::unique_ptr<NodeInterface> node_light =
@@ -280,8 +406,7 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
                 NodeLightEnum::DIRECTIONAL,
                 ParseUniform(proto_scene_light.direction()),
                 ParseUniform(proto_scene_light.color()));
-        auto maybe_node_id = level.AddSceneNode(std::move(node_light));
-        return static_cast<bool>(maybe_node_id);
+        return level.AddSceneNode(std::move(node_light));
     }
     case proto::SceneLight::AMBIENT:
         [[fallthrough]];
@@ -294,12 +419,10 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
             "Unknown scene light type {}",
             static_cast<int>(proto_scene_light.light_type())));
     }
-    return false;
+    return NullId;
 }
 
-} // End namespace.
-
-[[nodiscard]] bool ParseSceneTreeFile(
+bool ParseSceneTreeFile(
     const SceneTree& proto_scene_tree, LevelInterface& level)
 {
     level.SetDefaultCameraName(proto_scene_tree.default_camera_name());
@@ -311,7 +434,7 @@ std::function<NodeInterface*(const std::string& name)> GetFunctor(
     }
     for (const auto& proto_static_mesh : proto_scene_tree.scene_static_meshes())
     {
-        if (!ParseSceneStaticMesh(level, proto_static_mesh))
+        if (ParseSceneStaticMesh(level, proto_static_mesh).empty())
             return false;
     }
     for (const auto& proto_camera : proto_scene_tree.scene_cameras())
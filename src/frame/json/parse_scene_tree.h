@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "frame/json/proto.h"
 #include "frame/level_interface.h"
+#include "frame/opengl/file/load_static_mesh.h"
 
 namespace frame::proto
 {
@@ -16,5 +18,55 @@ namespace frame::proto
  */
 [[nodiscard]] bool ParseSceneTreeFile(
     const SceneTree& proto_scene_tree, LevelInterface& level);
+/**
+ * @brief Parse a matrix node and add it to the level.
+ * @param level: The level to add the node to.
+ * @param proto_scene_matrix: Proto of the matrix node.
+ * @return The id of the new node or NullId in case of error.
+ */
+EntityId ParseSceneMatrix(
+    LevelInterface& level, const SceneMatrix& proto_scene_matrix);
+/**
+ * @brief Read and parse the mesh file of a static mesh node (no OpenGL
+ *        context needed).
+ * @param proto_scene_static_mesh: Proto of the static mesh node (with a
+ *        file name).
+ * @return The parsed mesh file.
+ */
+opengl::file::StaticMeshFile ReadSceneStaticMeshFile(
+    const SceneStaticMesh& proto_scene_static_mesh);
+/**
+ * @brief Parse a static mesh node (and its mesh in case of a file) and add
+ *        it to the level.
+ * @param level: The level to add the node to.
+ * @param proto_scene_static_mesh: Proto of the static mesh node.
+ * @param static_mesh_file: The mesh file already parsed (see
+ *        ReadSceneStaticMeshFile), read from the disk if null.
+ * @param resource_ids: If not null receive the entities added to the level
+ *        other than the nodes (meshes, materials and textures).
+ * @return The ids of the new nodes (more than one for some mesh files),
+ *         empty in case of error.
+ */
+std::vector<EntityId> ParseSceneStaticMesh(
+    LevelInterface& level,
+    const SceneStaticMesh& proto_scene_static_mesh,
+    const opengl::file::StaticMeshFile* static_mesh_file = nullptr,
+    std::vector<EntityId>* resource_ids = nullptr);
+/**
+ * @brief Parse a camera node and add it to the level.
+ * @param level: The level to add the node to.
+ * @param proto_scene_camera: Proto of the camera node.
+ * @return The id of the new node or NullId in case of error.
+ */
+EntityId ParseSceneCamera(
+    LevelInterface& level, const SceneCamera& proto_scene_camera);
+/**
+ * @brief Parse a light node and add it to the level.
+ * @param level: The level to add the node to.
+ * @param proto_scene_light: Proto of the light node.
+ * @return The id of the new node or NullId in case of error.
+ */
+EntityId ParseSceneLight(
+    LevelInterface& level, const SceneLight& proto_scene_light);
 
 } // End namespace frame::proto.
@@ -65,6 +65,15 @@ std::unique_ptr<frame::TextureInterface> ParseTexture(
     {
         texture = std::make_unique<frame::opengl::Texture>(texture_parameter);
     }
+    auto& opengl_texture = dynamic_cast<frame::opengl::Texture&>(*texture);
+    opengl_texture.SetTransient(proto_texture.transient());
+    // Keep the negative sizes so the texture can follow the window size.
+    glm::uvec2 window_divisor(0, 0);
+    if (proto_texture.size().x() < 0)
+        window_divisor.x = std::abs(proto_texture.size().x());
+    if (proto_texture.size().y() < 0)
+        window_divisor.y = std::abs(proto_texture.size().y());
+    opengl_texture.SetWindowDivisor(window_divisor);
     constexpr auto INVALID_TEXTURE = frame::proto::TextureFilter::INVALID;
     if (proto_texture.min_filter().value() != INVALID_TEXTURE)
         texture->SetMinFilter(proto_texture.min_filter().value());
@@ -1,18 +1,34 @@
 #include "frame/level.h"
 
 #include <algorithm>
+#include <functional>
 #include <numeric>
 
 #include "frame/device_interface.h"
 #include "frame/node_camera.h"
+#include "frame/node_static_mesh.h"
 
 namespace frame
 {
 
+namespace
+{
+
+// Combine a value into a hash (as boost::hash_combine).
+template <typename T> void CombineHash(std::uint64_t& seed, const T& value)
+{
+    seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) +
+            (seed >> 2);
+}
+
+} // End anonymous namespace.
+
 Level::~Level()
 {
+    DestroyRemovedEntities();
     // This has to be deleted first (it has reference to buffers).
-    id_static_mesh_map_.clear();
+    static_mesh_map_.Clear();
+    DestroyRemovedEntities();
 }
 
 EntityId Level::GetDefaultStaticMeshQuadId() const
@@ -40,201 +56,673 @@ EntityId Level::GetIdFromName(const std::string& name) const
         logger_->warn("name is empty.");
         return NullId;
     }
-    try
+    auto maybe_id = TryGetIdFromName(name);
+    if (!maybe_id)
     {
-        return name_id_map_.at(name);
+        logger_->warn("No element named: {}.", name);
+        return NullId;
     }
-    catch (std::out_of_range& ex)
+    return maybe_id.value();
+}
+
+std::optional<EntityId> Level::TryGetIdFromName(std::string_view name) const
+{
+    auto it = name_id_map_.find(name);
+    if (it == name_id_map_.end())
     {
-        logger_->warn(ex.what());
-        return NullId;
+        return std::nullopt;
     }
+    return it->second;
 }
 
 std::optional<std::string> Level::GetNameFromId(EntityId id) const
 {
-    try
+    auto it = id_name_map_.find(id);
+    if (it == id_name_map_.end())
     {
-        return id_name_map_.at(id);
+        logger_->warn("No element with id #{}.", id);
+        return std::nullopt;
     }
-    catch (std::out_of_range& ex)
+    return it->second;
+}
+
+void Level::InsertName(EntityId id, const std::string& name)
+{
+    auto [it, inserted] = id_name_map_.emplace(id, name);
+    name_id_map_.emplace(it->second, id);
+}
+
+void Level::EraseName(EntityId id)
+{
+    auto it = id_name_map_.find(id);
+    if (it == id_name_map_.end())
     {
-        logger_->warn(ex.what());
-        return std::nullopt;
+        return;
     }
+    // The view in name id map point to the string in id name map.
+    name_id_map_.erase(it->second);
+    id_name_map_.erase(it);
 }
 
-EntityId Level::AddSceneNode(std::unique_ptr<NodeInterface>&& scene_node)
+void Level::CheckNameIsFree(const std::string& name) const
 {
-    EntityId id = GetSceneNodeNewId();
-    std::string name = scene_node->GetName();
     // CHECKME(anirul): maybe this should return std::nullopt.
-    if (string_set_.count(name))
+    if (name_id_map_.contains(name))
     {
         throw std::runtime_error("Name: " + name + " is already in!");
     }
-    string_set_.insert(name);
-    id_scene_node_map_.insert({id, std::move(scene_node)});
-    id_name_map_.insert({id, name});
-    name_id_map_.insert({name, id});
-    id_enum_map_.insert({id, EntityTypeEnum::NODE});
+}
+
+EntityId Level::AddSceneNode(std::unique_ptr<NodeInterface>&& scene_node)
+{
+    std::string name = scene_node->GetName();
+    CheckNameIsFree(name);
+    EntityId id = scene_node_map_.Insert(std::move(scene_node)).GetId();
+    InsertName(id, name);
+    ++version_;
+    auto& node = scene_node_map_.At(Handle<NodeInterface>(id));
+    transform_map_.emplace(id, TransformCache{});
+    node.SetTransformChangedCallback([this, id] { MarkTransformDirty(id); });
+    MarkTransformDirty(id);
+    LinkSceneNode(id);
+    // Children that were waiting for this node.
+    auto pending = pending_children_map_.extract(name);
+    if (!pending.empty())
+    {
+        for (const auto child_id : pending.mapped())
+        {
+            LinkSceneNode(child_id);
+        }
+    }
     return id;
 }
 
 EntityId Level::AddTexture(std::unique_ptr<TextureInterface>&& texture)
 {
-    EntityId id = GetTextureNewId();
     std::string name = texture->GetName();
-    // CHECKME(anirul): maybe this should return std::nullopt.
-    if (string_set_.count(name))
-    {
-        throw std::runtime_error("Name: " + name + " is already in!");
-    }
-    string_set_.insert(name);
-    id_texture_map_.insert({id, std::move(texture)});
-    id_name_map_.insert({id, name});
-    name_id_map_.insert({name, id});
-    id_enum_map_.insert({id, EntityTypeEnum::TEXTURE});
+    CheckNameIsFree(name);
+    EntityId id = texture_map_.Insert(std::move(texture)).GetId();
+    InsertName(id, name);
+    ++version_;
     return id;
 }
 
 EntityId Level::AddProgram(std::unique_ptr<ProgramInterface>&& program)
 {
-    EntityId id = GetProgramNewId();
     std::string name = program->GetName();
-    // CHECKME(anirul): maybe this should return std::nullopt.
-    if (string_set_.count(name))
-    {
-        throw std::runtime_error("Name: " + name + " is already in!");
-    }
-    id_program_map_.insert({id, std::move(program)});
-    id_name_map_.insert({id, name});
-    name_id_map_.insert({name, id});
-    id_enum_map_.insert({id, EntityTypeEnum::PROGRAM});
+    CheckNameIsFree(name);
+    EntityId id = program_map_.Insert(std::move(program)).GetId();
+    InsertName(id, name);
+    ++version_;
     return id;
 }
 
 EntityId Level::AddMaterial(std::unique_ptr<MaterialInterface>&& material)
 {
-    EntityId id = GetMaterialNewId();
     std::string name = material->GetName();
-    // CHECKME(anirul): maybe this should return std::nullopt.
-    if (string_set_.count(name))
-    {
-        throw std::runtime_error("Name: " + name + " is already in!");
-    }
-    id_material_map_.insert({id, std::move(material)});
-    id_name_map_.insert({id, name});
-    name_id_map_.insert({name, id});
-    id_enum_map_.insert({id, EntityTypeEnum::MATERIAL});
+    CheckNameIsFree(name);
+    EntityId id = material_map_.Insert(std::move(material)).GetId();
+    InsertName(id, name);
+    ++version_;
     return id;
 }
 
 EntityId Level::AddBuffer(std::unique_ptr<BufferInterface>&& buffer)
 {
-    EntityId id = GetBufferNewId();
     std::string name = buffer->GetName();
-    // CHECKME(anirul): maybe this should return std::nullopt.
-    if (string_set_.count(name))
-    {
-        throw std::runtime_error("Name: " + name + " is already in!");
-    }
-    id_buffer_map_.insert({id, std::move(buffer)});
-    id_name_map_.insert({id, name});
-    name_id_map_.insert({name, id});
-    id_enum_map_.insert({id, EntityTypeEnum::BUFFER});
+    CheckNameIsFree(name);
+    EntityId id = buffer_map_.Insert(std::move(buffer)).GetId();
+    InsertName(id, name);
+    ++version_;
     return id;
 }
 
 void Level::RemoveBuffer(EntityId buffer_id)
 {
-    if (!id_buffer_map_.count(buffer_id))
+    EraseEntity(buffer_map_, buffer_id);
+}
+
+void Level::RemoveSceneNode(EntityId id)
+{
+    if (!scene_node_map_.Contains(Handle<NodeInterface>(id)))
     {
-        throw std::runtime_error(
-            fmt::format("No buffer with id #{}.", buffer_id));
+        throw std::runtime_error(fmt::format("No scene node with id #{}.", id));
+    }
+    // The subtree in breadth first order, removed from the leaves so no
+    // node is left waiting for its parent.
+    std::vector<EntityId> subtree_ids = {id};
+    for (std::size_t i = 0; i < subtree_ids.size(); ++i)
+    {
+        auto it = children_map_.find(subtree_ids[i]);
+        if (it != children_map_.end())
+        {
+            subtree_ids.insert(
+                subtree_ids.end(), it->second.begin(), it->second.end());
+        }
+    }
+    for (auto it = subtree_ids.rbegin(); it != subtree_ids.rend(); ++it)
+    {
+        RemoveSceneNodeKeepChildren(*it);
+    }
+}
+
+void Level::RemoveSceneNodeKeepChildren(EntityId id)
+{
+    if (!scene_node_map_.Contains(Handle<NodeInterface>(id)))
+    {
+        throw std::runtime_error(fmt::format("No scene node with id #{}.", id));
+    }
+    UnlinkSceneNode(id);
+    // Children wait for a node with the same name to be added again.
+    auto children = children_map_.extract(id);
+    if (!children.empty())
+    {
+        auto& pending = pending_children_map_[id_name_map_.at(id)];
+        for (const auto child_id : children.mapped())
+        {
+            parent_map_.erase(child_id);
+            pending.push_back(child_id);
+            MarkTransformDirty(child_id);
+        }
+    }
+    EraseMeshMaterialIds(
+        [id](EntityId node_id, EntityId) { return node_id == id; });
+    transform_map_.erase(id);
+    time_dependent_nodes_.erase(id);
+    std::erase(dirty_transforms_, id);
+    EraseEntity(scene_node_map_, id);
+}
+
+void Level::RemoveTexture(EntityId id)
+{
+    EraseEntity(texture_map_, id);
+    material_map_.ForEach(
+        [id](Handle<MaterialInterface>, MaterialInterface& material) {
+            material.RemoveTextureId(id);
+        });
+    program_map_.ForEach(
+        [id](Handle<ProgramInterface>, ProgramInterface& program) {
+            program.RemoveInputTextureId(id);
+            program.RemoveOutputTextureId(id);
+        });
+}
+
+void Level::RemoveProgram(EntityId id)
+{
+    // Materials are resolved before the program name is removed (they can
+    // refer to it by name), materials without a program are skipped.
+    std::vector<EntityId> material_ids;
+    material_map_.ForEach([this, id, &material_ids](
+                              Handle<MaterialInterface> handle,
+                              const MaterialInterface& material) {
+        try
+        {
+            if (material.GetProgramId(this) == id)
+                material_ids.push_back(handle.GetId());
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    });
+    EraseEntity(program_map_, id);
+    std::erase_if(program_uniforms_, [id](const auto& uniform) {
+        return uniform.first.first == id;
+    });
+    EraseMeshMaterialIds([&material_ids](EntityId, EntityId material_id) {
+        return std::find(
+                   material_ids.begin(), material_ids.end(), material_id) !=
+               material_ids.end();
+    });
+}
+
+void Level::RemoveMaterial(EntityId id)
+{
+    EraseEntity(material_map_, id);
+    EraseMeshMaterialIds(
+        [id](EntityId, EntityId material_id) { return material_id == id; });
+}
+
+void Level::RemoveStaticMesh(EntityId id)
+{
+    EraseEntity(static_mesh_map_, id);
+    EraseMeshMaterialIds([this, id](EntityId node_id, EntityId) {
+        const auto* node = scene_node_map_.Find(Handle<NodeInterface>(node_id));
+        return node && node->GetLocalMesh() == id;
+    });
+    // The nodes don't refer to the removed mesh (its id could be reused).
+    scene_node_map_.ForEach([id](Handle<NodeInterface>, NodeInterface& node) {
+        auto* node_static_mesh = dynamic_cast<NodeStaticMesh*>(&node);
+        if (node_static_mesh && node_static_mesh->GetLocalMesh() == id)
+            node_static_mesh->SetLocalMesh(NullId);
+    });
+    if (id == quad_id_)
+        quad_id_ = NullId;
+    if (id == cube_id_)
+        cube_id_ = NullId;
+}
+
+void Level::DestroyRemovedEntities()
+{
+    // Destructors can remove other entities (a static mesh remove its
+    // buffers) so loop until nothing is left.
+    while (!removed_entities_.empty())
+    {
+        std::swap(removed_entities_, destroyed_entities_);
+        destroyed_entities_.clear();
     }
-    std::string name = id_name_map_.at(buffer_id);
-    id_buffer_map_.erase(buffer_id);
-    id_name_map_.erase(buffer_id);
-    name_id_map_.erase(name);
-    id_enum_map_.erase(buffer_id);
 }
 
 EntityId Level::AddStaticMesh(
     std::unique_ptr<StaticMeshInterface>&& static_mesh)
 {
-    EntityId id = GetStaticMeshNewId();
     std::string name = static_mesh->GetName();
-    // CHECKME(anirul): maybe this should return std::nullopt.
-    if (string_set_.count(name))
-    {
-        throw std::runtime_error("Name: " + name + " is already in!");
-    }
-    string_set_.insert(name);
-    id_static_mesh_map_.insert({id, std::move(static_mesh)});
-    id_name_map_.insert({id, name});
-    name_id_map_.insert({name, id});
-    id_enum_map_.insert({id, EntityTypeEnum::STATIC_MESH});
+    CheckNameIsFree(name);
+    EntityId id = static_mesh_map_.Insert(std::move(static_mesh)).GetId();
+    InsertName(id, name);
+    ++version_;
     return id;
 }
 
 std::optional<std::vector<frame::EntityId>> Level::GetChildList(
     EntityId id) const
 {
-    std::vector<EntityId> list;
-    try
+    if (!scene_node_map_.Contains(Handle<NodeInterface>(id)))
+    {
+        logger_->warn("No node with id #{}.", id);
+        return std::nullopt;
+    }
+    auto it = children_map_.find(id);
+    if (it == children_map_.end())
+    {
+        return std::vector<EntityId>{};
+    }
+    return it->second;
+}
+
+EntityId Level::GetParentId(EntityId id) const
+{
+    if (!scene_node_map_.Contains(Handle<NodeInterface>(id)))
+    {
+        logger_->warn("No node with id #{}.", id);
+        return NullId;
+    }
+    auto it = parent_map_.find(id);
+    if (it == parent_map_.end())
+    {
+        return NullId;
+    }
+    return it->second;
+}
+
+void Level::SetParentName(EntityId id, const std::string& parent_name)
+{
+    auto& node = scene_node_map_.At(Handle<NodeInterface>(id));
+    UnlinkSceneNode(id);
+    node.SetParentName(parent_name);
+    LinkSceneNode(id);
+    MarkTransformDirty(id);
+}
+
+void Level::MarkTransformDirty(EntityId id)
+{
+    auto it = transform_map_.find(id);
+    if (it == transform_map_.end())
+    {
+        // Not in the level yet (or anymore).
+        return;
+    }
+    const auto& node = scene_node_map_.At(Handle<NodeInterface>(id));
+    if (node.IsTimeDependent())
+    {
+        time_dependent_nodes_.insert(id);
+    }
+    else
+    {
+        time_dependent_nodes_.erase(id);
+    }
+    if (!it->second.dirty)
     {
-        const auto& node = id_scene_node_map_.at(id);
-        // Check who has node as a parent.
-        for (const auto& id_node : id_scene_node_map_)
+        it->second.dirty = true;
+        dirty_transforms_.push_back(id);
+    }
+}
+
+bool Level::HasDirtyAncestor(EntityId id) const
+{
+    auto it = parent_map_.find(id);
+    while (it != parent_map_.end())
+    {
+        if (transform_map_.at(it->second).dirty)
         {
-            // In case this is node then add it to the list.
-            if (id_node.second->GetParentName() == node->GetName())
+            return true;
+        }
+        it = parent_map_.find(it->second);
+    }
+    return false;
+}
+
+void Level::UpdateTransforms(double dt)
+{
+    // Time dependent nodes are dirty every time the time change.
+    if (last_transform_dt_ != dt)
+    {
+        last_transform_dt_ = dt;
+        for (const auto id : time_dependent_nodes_)
+        {
+            auto& cache = transform_map_.at(id);
+            if (!cache.dirty)
             {
-                list.push_back(id_node.first);
+                cache.dirty = true;
+                dirty_transforms_.push_back(id);
             }
         }
     }
-    catch (std::out_of_range& ex)
+    for (const auto dirty_id : dirty_transforms_)
     {
-        logger_->warn(ex.what());
-        return std::nullopt;
+        // Already updated as part of the subtree of a dirty ancestor, or
+        // will be.
+        if (!transform_map_.at(dirty_id).dirty || HasDirtyAncestor(dirty_id))
+        {
+            continue;
+        }
+        transform_stack_.push_back(dirty_id);
+        while (!transform_stack_.empty())
+        {
+            EntityId id = transform_stack_.back();
+            transform_stack_.pop_back();
+            const auto& node = scene_node_map_.At(Handle<NodeInterface>(id));
+            auto& cache = transform_map_.at(id);
+            cache.local = node.ComputeLocalTransform(dt);
+            auto parent_it = parent_map_.find(id);
+            if (parent_it != parent_map_.end())
+            {
+                cache.world =
+                    transform_map_.at(parent_it->second).world * cache.local;
+            }
+            else
+            {
+                cache.world = cache.local;
+            }
+            cache.dirty = false;
+            auto children_it = children_map_.find(id);
+            if (children_it != children_map_.end())
+            {
+                transform_stack_.insert(
+                    transform_stack_.end(),
+                    children_it->second.begin(),
+                    children_it->second.end());
+            }
+        }
     }
-    return list;
+    dirty_transforms_.clear();
 }
 
-EntityId Level::GetParentId(EntityId id) const
+const glm::mat4& Level::GetWorldTransform(EntityId id) const
+{
+    auto it = transform_map_.find(id);
+    if (it == transform_map_.end())
+    {
+        throw std::out_of_range(fmt::format("No node with id #{}.", id));
+    }
+    return it->second.world;
+}
+
+void Level::PublishSceneState(double dt)
 {
-    try
+    // A state handed back by its last reader (recycled so its storage is
+    // already allocated).
+    auto scene_state = scene_state_pool_->Acquire();
+    auto& state = *scene_state;
+    state.frame = ++scene_state_frame_;
+    state.level_version = version_;
+    state.time = dt;
+    // Indexed by slot, this doesn't allocate once the capacity is reached.
+    std::uint32_t slot_count = 0;
+    for (const auto& [id, cache] : transform_map_)
     {
-        std::string name = id_scene_node_map_.at(id)->GetParentName();
-        auto maybe_id = GetIdFromName(name);
-        return maybe_id;
+        slot_count = std::max(slot_count, GetEntityIndexFromId(id) + 1);
     }
-    catch (std::out_of_range& ex)
+    state.world_transforms.assign(
+        slot_count, std::make_pair(NullId, glm::mat4(1.0f)));
+    for (const auto& [id, cache] : transform_map_)
     {
-        logger_->warn(ex.what());
-        return NullId;
+        state.world_transforms[GetEntityIndexFromId(id)] =
+            std::make_pair(id, cache.world);
+    }
+    // Default camera in world space (the inverse of the holder transform).
+    state.camera_id = NullId;
+    auto maybe_camera_id = TryGetIdFromName(default_camera_name_);
+    if (maybe_camera_id)
+    {
+        const auto& node = GetSceneNodeFromId(maybe_camera_id.value());
+        const auto* node_camera = dynamic_cast<const NodeCamera*>(&node);
+        const auto* world = state.FindWorldTransform(maybe_camera_id.value());
+        if (node_camera && world)
+        {
+            auto inverse_model = glm::inverse(*world);
+            state.camera_id = maybe_camera_id.value();
+            state.camera = node_camera->GetCamera();
+            state.camera.SetFront(
+                state.camera.GetFront() * glm::mat3(inverse_model));
+            state.camera.SetPosition(glm::vec3(
+                glm::vec4(state.camera.GetPosition(), 1.0) * inverse_model));
+        }
+    }
+    // Uniforms in (program id, name) order.
+    state.uniforms.resize(program_uniforms_.size());
+    std::size_t uniform_index = 0;
+    for (const auto& [key, uniform] : program_uniforms_)
+    {
+        auto& state_uniform = state.uniforms[uniform_index++];
+        state_uniform.program_id = uniform.program_id;
+        state_uniform.name = uniform.name;
+        state_uniform.size = uniform.size;
+        state_uniform.float_values = uniform.float_values;
+        state_uniform.int_values = uniform.int_values;
+    }
+    // Materials indexed by slot, with the textures in the order of the
+    // units (as the material enable them).
+    std::uint32_t material_slot_count = 0;
+    material_map_.ForEach([&material_slot_count](
+                              Handle<MaterialInterface> handle,
+                              const MaterialInterface&) {
+        material_slot_count = std::max(
+            material_slot_count, GetEntityIndexFromId(handle.GetId()) + 1);
+    });
+    state.materials.resize(material_slot_count);
+    for (auto& state_material : state.materials)
+        state_material.material_id = NullId;
+    state.material_hash = 0;
+    material_map_.ForEach([this, &state](
+                              Handle<MaterialInterface> handle,
+                              const MaterialInterface& material) {
+        auto& state_material =
+            state.materials[GetEntityIndexFromId(handle.GetId())];
+        state_material.material_id = handle.GetId();
+        CombineHash(state.material_hash, handle.GetId());
+        // Assigned over the textures of an old frame (reuse the strings).
+        auto& textures = state_material.textures;
+        std::size_t texture_count = 0;
+        for (const auto id : material.GetIds())
+        {
+            if (GetEnumTypeFromId(id) != EntityTypeEnum::TEXTURE)
+                continue;
+            if (texture_count == textures.size())
+                textures.emplace_back();
+            auto& texture = textures[texture_count++];
+            texture.first = id;
+            texture.second = material.GetInnerName(id);
+            CombineHash(state.material_hash, id);
+            CombineHash(state.material_hash, std::string_view(texture.second));
+        }
+        textures.resize(texture_count);
+    });
+    for (auto& state_material : state.materials)
+    {
+        if (state_material.material_id == NullId)
+            state_material.textures.clear();
+    }
+    // The previous front state go back to the pool once its readers are
+    // done with it (outside of the lock).
+    std::shared_ptr<SceneState> previous_scene_state = nullptr;
+    {
+        std::scoped_lock lock(scene_state_mutex_);
+        previous_scene_state =
+            std::exchange(front_scene_state_, std::move(scene_state));
     }
 }
 
-std::vector<frame::EntityId> Level::GetAllTextures() const
+std::shared_ptr<const SceneState> Level::GetSceneState() const
 {
-    std::vector<EntityId> list;
-    for (const auto& id_texture : id_texture_map_)
+    std::scoped_lock lock(scene_state_mutex_);
+    return front_scene_state_;
+}
+
+SceneUniform& Level::GetProgramUniform(
+    EntityId program_id, const std::string& name, glm::uvec2 size)
+{
+    if (!program_map_.Find(Handle<ProgramInterface>(program_id)))
+    {
+        throw std::runtime_error(
+            fmt::format("No program with id #{}.", program_id));
+    }
+    auto it = program_uniforms_.find(
+        std::make_pair(program_id, std::string_view(name)));
+    if (it == program_uniforms_.end())
+    {
+        it = program_uniforms_
+                 .emplace(std::make_pair(program_id, name), SceneUniform{})
+                 .first;
+        it->second.program_id = program_id;
+        it->second.name = name;
+    }
+    it->second.size = size;
+    return it->second;
+}
+
+void Level::SetProgramUniform(
+    EntityId program_id,
+    const std::string& name,
+    const std::vector<float>& values,
+    glm::uvec2 size /* = {1, 1}*/)
+{
+    auto& uniform = GetProgramUniform(program_id, name, size);
+    uniform.float_values = values;
+    uniform.int_values.clear();
+}
+
+void Level::SetProgramUniform(
+    EntityId program_id,
+    const std::string& name,
+    const std::vector<std::int32_t>& values,
+    glm::uvec2 size /* = {1, 1}*/)
+{
+    auto& uniform = GetProgramUniform(program_id, name, size);
+    uniform.int_values = values;
+    uniform.float_values.clear();
+}
+
+void Level::RemoveProgramUniform(EntityId program_id, const std::string& name)
+{
+    auto it = program_uniforms_.find(
+        std::make_pair(program_id, std::string_view(name)));
+    if (it != program_uniforms_.end())
+        program_uniforms_.erase(it);
+}
+
+void Level::LinkSceneNode(EntityId id)
+{
+    const auto& node = scene_node_map_.At(Handle<NodeInterface>(id));
+    if (node.IsRoot())
     {
-        list.push_back(id_texture.first);
+        return;
     }
+    const std::string parent_name = node.GetParentName();
+    auto maybe_parent_id = TryGetIdFromName(parent_name);
+    if (!maybe_parent_id || GetEntityTypeFromId(maybe_parent_id.value()) !=
+                                EntityTypeEnum::NODE)
+    {
+        pending_children_map_[parent_name].push_back(id);
+        return;
+    }
+    children_map_[maybe_parent_id.value()].push_back(id);
+    parent_map_.insert_or_assign(id, maybe_parent_id.value());
+    MarkTransformDirty(id);
+}
+
+void Level::UnlinkSceneNode(EntityId id)
+{
+    auto it = parent_map_.find(id);
+    if (it != parent_map_.end())
+    {
+        std::erase(children_map_[it->second], id);
+        parent_map_.erase(it);
+        return;
+    }
+    // Not linked yet, maybe waiting for its parent.
+    const auto& node = scene_node_map_.At(Handle<NodeInterface>(id));
+    auto pending_it = pending_children_map_.find(node.GetParentName());
+    if (pending_it != pending_children_map_.end())
+    {
+        std::erase(pending_it->second, id);
+        if (pending_it->second.empty())
+        {
+            pending_children_map_.erase(pending_it);
+        }
+    }
+}
+
+std::vector<frame::EntityId> Level::GetAllTextures() const
+{
+    std::vector<EntityId> list;
+    list.reserve(texture_map_.Size());
+    texture_map_.ForEach(
+        [&list](Handle<TextureInterface> handle, TextureInterface&) {
+            list.push_back(handle.GetId());
+        });
     return list;
 }
 
 std::unique_ptr<frame::TextureInterface> Level::ExtractTexture(EntityId id)
 {
-    auto node_texture = id_texture_map_.extract(id);
-    auto node_name = id_name_map_.extract(id);
-    auto node_id = name_id_map_.extract(node_name.mapped());
-    auto node_enum = id_enum_map_.extract(id);
-    return std::move(node_texture.mapped());
+    auto texture = texture_map_.Extract(Handle<TextureInterface>(id));
+    EraseName(id);
+    ++version_;
+    return texture;
+}
+
+EntityTypeEnum Level::GetEnumTypeFromId(EntityId id) const
+{
+    bool contains = false;
+    switch (GetEntityTypeFromId(id))
+    {
+    case EntityTypeEnum::NODE:
+        contains = scene_node_map_.Contains(Handle<NodeInterface>(id));
+        break;
+    case EntityTypeEnum::TEXTURE:
+        contains = texture_map_.Contains(Handle<TextureInterface>(id));
+        break;
+    case EntityTypeEnum::PROGRAM:
+        contains = program_map_.Contains(Handle<ProgramInterface>(id));
+        break;
+    case EntityTypeEnum::MATERIAL:
+        contains = material_map_.Contains(Handle<MaterialInterface>(id));
+        break;
+    case EntityTypeEnum::BUFFER:
+        contains = buffer_map_.Contains(Handle<BufferInterface>(id));
+        break;
+    case EntityTypeEnum::STATIC_MESH:
+        contains =
+            static_mesh_map_.Contains(Handle<StaticMeshInterface>(id));
+        break;
+    default:
+        break;
+    }
+    if (!contains)
+    {
+        throw std::out_of_range(fmt::format("No entity with id #{}.", id));
+    }
+    return GetEntityTypeFromId(id);
 }
 
 frame::Camera& Level::GetDefaultCamera()
@@ -252,12 +740,7 @@ void Level::ReplaceTexture(
     std::uint8_t bytes_per_pixel,
     EntityId id)
 {
-    if (!id_texture_map_.count(id))
-    {
-        throw std::runtime_error(
-            "trying to replace {} but no texture there yet?");
-    }
-    auto& texture = id_texture_map_.at(id);
+    auto* texture = texture_map_.Find(Handle<TextureInterface>(id));
     if (!texture)
     {
         throw std::runtime_error(
@@ -269,15 +752,17 @@ void Level::ReplaceTexture(
 void Level::ReplaceMesh(
     std::unique_ptr<StaticMeshInterface>&& mesh, EntityId id)
 {
-    if (!id_static_mesh_map_.count(id))
+    Handle<StaticMeshInterface> handle(id);
+    if (!static_mesh_map_.Contains(handle))
     {
         throw std::runtime_error(fmt::format(
             "trying to replace {} by {} but no mesh there yet?",
             mesh->GetName(),
             id));
     }
-    id_static_mesh_map_.erase(id);
-    id_static_mesh_map_.emplace(id, std::move(mesh));
+    removed_entities_.push_back(
+        static_mesh_map_.Replace(handle, std::move(mesh)));
+    ++version_;
 }
 
 } // End namespace frame.
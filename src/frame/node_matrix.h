@@ -75,6 +75,24 @@ class NodeMatrix : public NodeInterface
      * @return A mat4 representing the local model matrix.
      */
     glm::mat4 GetLocalModel(const double dt) const override;
+    /**
+     * @brief Compute the transform relative to the parent.
+     * @param dt: Delta time from the beginning of the software running in
+     *        seconds.
+     * @return A mat4 representing the local transform.
+     */
+    glm::mat4 ComputeLocalTransform(const double dt) const override
+    {
+        return ComputeLocalRotation(dt);
+    }
+    /**
+     * @brief Rotating matrices depend on time.
+     * @return True if the matrix is a rotation enabled one.
+     */
+    bool IsTimeDependent() const override
+    {
+        return enable_rotation_ && matrix_ != glm::mat4(1.0f);
+    }
 
   public:
     /**
@@ -85,6 +103,7 @@ class NodeMatrix : public NodeInterface
     void SetMatrix(glm::mat4 matrix)
     {
         matrix_ = matrix;
+        TransformChanged();
     }
 
   protected:
@@ -17,9 +17,9 @@ glm::mat4 NodeStaticMesh::GetLocalModel(const double dt) const
             throw std::runtime_error(fmt::format(
                 "SceneStaticMesh func({}) returned nullptr", GetParentName()));
         }
-        return parent_node->GetLocalModel(dt);
+        return parent_node->GetLocalModel(dt) * local_transform_;
     }
-    return glm::mat4(1.0f);
+    return local_transform_;
 }
 
 } // End namespace frame.
@@ -52,6 +52,16 @@ class NodeStaticMesh : public NodeInterface
      * @return A mat4 representing the local model matrix.
      */
     glm::mat4 GetLocalModel(const double dt) const override;
+    /**
+     * @brief Compute the transform relative to the parent.
+     * @param dt: Delta time from the beginning of the software running in
+     *        seconds.
+     * @return A mat4 representing the local transform.
+     */
+    glm::mat4 ComputeLocalTransform(const double dt) const override
+    {
+        return local_transform_;
+    }
 
   public:
     /**
@@ -62,6 +72,15 @@ class NodeStaticMesh : public NodeInterface
     {
         return static_mesh_id_;
     }
+    /**
+     * @brief Set the mesh attached to the node (NullId when the mesh was
+     *        removed from the level).
+     * @param static_mesh_id: Id of the mesh.
+     */
+    void SetLocalMesh(EntityId static_mesh_id)
+    {
+        static_mesh_id_ = static_mesh_id;
+    }
     /**
      * @brief Get clean buffer parameters.
      * @return Clean buffer.
@@ -70,10 +89,39 @@ class NodeStaticMesh : public NodeInterface
     {
         return clean_buffer_;
     }
+    /**
+     * @brief Enable or disable the frustum culling of this node (meshes that
+     *        are not drawn where their bounds are can't be culled).
+     * @param enable: Enable or disable (enabled by default).
+     */
+    void SetFrustumCulling(bool enable)
+    {
+        frustum_culling_ = enable;
+    }
+    /**
+     * @brief Check if the node can be frustum culled.
+     * @return True if it can be culled.
+     */
+    bool IsFrustumCulling() const
+    {
+        return frustum_culling_;
+    }
+    /**
+     * @brief Set the transform of the mesh relative to the parent (used to
+     *        place the instances of a mesh).
+     * @param local_transform: The local transform (identity by default).
+     */
+    void SetLocalTransform(glm::mat4 local_transform)
+    {
+        local_transform_ = local_transform;
+        TransformChanged();
+    }
 
   private:
     EntityId static_mesh_id_ = NullId;
     std::uint32_t clean_buffer_ = {};
+    bool frustum_culling_ = true;
+    glm::mat4 local_transform_ = glm::mat4(1.0f);
 };
 
 } // End namespace frame.
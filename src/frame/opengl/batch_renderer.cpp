@@ -0,0 +1,251 @@
+#include "frame/opengl/batch_renderer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include "frame/file/file_system.h"
+#include "frame/json/parse_json.h"
+#include "frame/json/parse_level.h"
+#include "frame/json/parse_program.h"
+#include "frame/json/parse_uniform.h"
+#include "frame/opengl/pre_render_cache.h"
+
+namespace frame::opengl
+{
+
+BatchRenderer::BatchRenderer(
+    std::unique_ptr<WindowInterface> window,
+    std::size_t worker_count /* = 2*/,
+    std::size_t queue_size /* = 8*/)
+    : window_(std::move(window)),
+      device_(dynamic_cast<Device&>(window_->GetDevice())),
+      writer_("", worker_count, queue_size)
+{
+}
+
+BatchRenderer::~BatchRenderer()
+{
+    Finish();
+}
+
+void BatchRenderer::Render(const proto::RenderJob& job)
+{
+    if (job.output_file().empty())
+        throw std::runtime_error("Render job without an output file.");
+    if (!start_time_)
+        start_time_ = std::chrono::steady_clock::now();
+    LoadLevel(job.level_file());
+    auto& level = device_.GetLevel();
+    // Each job start from the level as it was loaded.
+    RestorePrograms();
+    for (const auto& program_override : job.program_overrides())
+    {
+        const auto& program_name = program_override.program_name();
+        auto& program = GetProgram(program_name);
+        // Recorded before it is set, so that it is restored on failure.
+        previous_overrides_.push_back(
+            {program_name,
+             GetProgramParameters(program_name, program_override.parameters()),
+             program.GetContentHash()});
+        SetProgramParameters(program_name, program_override.parameters());
+        // The values are part of the content, a pre render using the program
+        // is done again (or restored from the cache).
+        auto content_hash = program.GetContentHash();
+        if (content_hash)
+        {
+            for (const auto& parameter : program_override.parameters())
+            {
+                content_hash = CombineContentHash(
+                    content_hash, parameter.SerializeAsString());
+            }
+            program.SetContentHash(content_hash);
+        }
+    }
+    auto& camera = level.GetDefaultCamera();
+    camera = level_camera_;
+    if (job.has_camera())
+    {
+        const auto& proto_camera = job.camera();
+        camera = Camera(
+            proto::ParseUniform(proto_camera.position()),
+            proto::ParseUniform(proto_camera.target()),
+            proto::ParseUniform(proto_camera.up()),
+            proto_camera.fov_degrees(),
+            level_camera_.GetAspectRatio(),
+            proto_camera.near_clip(),
+            proto_camera.far_clip());
+    }
+    // Wait for the encoders rather than dropping the images, the reads in
+    // flight can all complete (and be submitted) before the next job. Not in
+    // the read back as it would block in the middle of the display.
+    writer_.WaitForSlot(device_.GetReadbackQueue().GetPendingCount());
+    // Also complete the reads of the previous jobs that are done.
+    device_.Display(job.time_s());
+    auto& texture = dynamic_cast<Texture&>(
+        level.GetTextureFromId(level.GetDefaultOutputTextureId()));
+    proto::PixelElementSize pixel_element_size{};
+    pixel_element_size.set_value(texture.GetPixelElementSize());
+    proto::PixelStructure pixel_structure{};
+    pixel_structure.set_value(texture.GetPixelStructure());
+    // The writer outlive the reads (flushed before it is destroyed).
+    device_.GetReadbackQueue().ReadTexture(
+        texture,
+        [this,
+         file_name = job.output_file(),
+         size = texture.GetSize(),
+         pixel_element_size,
+         pixel_structure](std::span<const std::uint8_t> pixels) {
+            writer_.Submit(
+                file_name,
+                size,
+                pixel_element_size,
+                pixel_structure,
+                {pixels.begin(), pixels.end()});
+        });
+    ++stats_.rendered;
+}
+
+void BatchRenderer::Render(const proto::RenderJobs& jobs)
+{
+    // Same level in a row (the order of the images doesn't matter).
+    std::vector<const proto::RenderJob*> sorted_jobs;
+    for (const auto& job : jobs.jobs())
+        sorted_jobs.push_back(&job);
+    std::stable_sort(
+        sorted_jobs.begin(),
+        sorted_jobs.end(),
+        [this](const proto::RenderJob* left, const proto::RenderJob* right) {
+            // The level already loaded first.
+            const bool left_loaded = left->level_file() == level_file_;
+            const bool right_loaded = right->level_file() == level_file_;
+            if (left_loaded != right_loaded)
+                return left_loaded;
+            return left->level_file() < right->level_file();
+        });
+    for (const auto* job : sorted_jobs)
+    {
+        try
+        {
+            Render(*job);
+        }
+        catch (const std::exception& ex)
+        {
+            ++stats_.failed;
+            logger_->error(
+                "Could not render {}: {}", job->output_file(), ex.what());
+        }
+    }
+}
+
+void BatchRenderer::RenderFile(const std::filesystem::path& job_file)
+{
+    std::ifstream ifs(job_file.string());
+    if (!ifs.is_open())
+    {
+        throw std::runtime_error(
+            "Couldn't open job file : " + job_file.string());
+    }
+    std::string content(std::istreambuf_iterator<char>(ifs), {});
+    Render(proto::LoadProtoFromJson<proto::RenderJobs>(content));
+}
+
+void BatchRenderer::Finish()
+{
+    device_.GetReadbackQueue().Flush();
+    writer_.Wait();
+    if (start_time_)
+    {
+        stats_.seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - *start_time_)
+                             .count();
+    }
+}
+
+BatchRenderStats BatchRenderer::GetStats() const
+{
+    BatchRenderStats stats = stats_;
+    stats.written = writer_.GetWrittenCount();
+    stats.failed += writer_.GetFailedCount();
+    return stats;
+}
+
+void BatchRenderer::LoadLevel(const std::string& level_file)
+{
+    if (level_file.empty())
+        throw std::runtime_error("Render job without a level file.");
+    if (level_file == level_file_)
+        return;
+    // Relative to the asset (as the level files of the samples) if not found.
+    std::filesystem::path path = level_file;
+    if (!std::filesystem::exists(path))
+        path = file::FindFile(path);
+    std::ifstream ifs(path.string());
+    if (!ifs.is_open())
+        throw std::runtime_error("Couldn't open level file : " + level_file);
+    std::string content(std::istreambuf_iterator<char>(ifs), {});
+    auto proto_level = proto::LoadProtoFromJson<proto::Level>(content);
+    // The reads of the previous level are done before it is destroyed.
+    device_.GetReadbackQueue().Flush();
+    level_file_.clear();
+    previous_overrides_.clear();
+    proto_level_ = std::move(proto_level);
+    // The pre render of the programs is restored from the device cache.
+    device_.Startup(proto::ParseLevel(window_->GetSize(), proto_level_));
+    level_camera_ = device_.GetLevel().GetDefaultCamera();
+    level_file_ = level_file;
+    ++stats_.level_loaded;
+}
+
+Program& BatchRenderer::GetProgram(const std::string& program_name)
+{
+    auto& level = device_.GetLevel();
+    auto maybe_id = level.TryGetIdFromName(program_name);
+    if (!maybe_id)
+        throw std::runtime_error("No program named : " + program_name);
+    return dynamic_cast<Program&>(level.GetProgramFromId(*maybe_id));
+}
+
+google::protobuf::RepeatedPtrField<proto::Uniform>
+BatchRenderer::GetProgramParameters(
+    const std::string& program_name,
+    const google::protobuf::RepeatedPtrField<proto::Uniform>& parameters)
+{
+    auto& program = GetProgram(program_name);
+    google::protobuf::RepeatedPtrField<proto::Uniform> previous_parameters;
+    for (const auto& parameter : parameters)
+        *previous_parameters.Add() = program.GetUniformValue(parameter);
+    return previous_parameters;
+}
+
+void BatchRenderer::SetProgramParameters(
+    const std::string& program_name,
+    const google::protobuf::RepeatedPtrField<proto::Uniform>& parameters)
+{
+    auto& program = GetProgram(program_name);
+    proto::SetUniformParameters(parameters, program);
+    // The variants have their own uniforms.
+    if (program.GetDepthOnlyProgram())
+    {
+        proto::SetUniformParameters(parameters, *program.GetDepthOnlyProgram());
+    }
+    if (program.GetMultiViewProgram())
+    {
+        proto::SetUniformParameters(parameters, *program.GetMultiViewProgram());
+    }
+}
+
+void BatchRenderer::RestorePrograms()
+{
+    // Backward in case a program is overridden more than once.
+    for (auto it = previous_overrides_.rbegin();
+         it != previous_overrides_.rend();
+         ++it)
+    {
+        SetProgramParameters(it->program_name, it->parameters);
+        GetProgram(it->program_name).SetContentHash(it->content_hash);
+    }
+    previous_overrides_.clear();
+}
+
+} // End namespace frame::opengl.
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "frame/camera.h"
+#include "frame/file/image_sequence_writer.h"
+#include "frame/json/proto.h"
+#include "frame/logger.h"
+#include "frame/opengl/device.h"
+#include "frame/opengl/program.h"
+#include "frame/window_interface.h"
+
+namespace frame::opengl
+{
+
+/**
+ * @class BatchRenderStats
+ * @brief Counters of a batch renderer.
+ */
+struct BatchRenderStats
+{
+    //! @brief Jobs rendered (and read back).
+    std::uint64_t rendered = 0;
+    //! @brief Images written.
+    std::uint64_t written = 0;
+    //! @brief Jobs or images that failed (see the log).
+    std::uint64_t failed = 0;
+    //! @brief Number of times a level was parsed (and its programs built).
+    std::uint64_t level_loaded = 0;
+    //! @brief Time from the first job to the last finish in seconds.
+    double seconds = 0.0;
+    //! @brief Get the throughput in images per second.
+    double GetImagesPerSecond() const
+    {
+        return seconds > 0.0 ? static_cast<double>(written) / seconds : 0.0;
+    }
+};
+
+/**
+ * @class BatchRenderer
+ * @brief Render jobs (level, camera, uniforms, output file) one after the
+ *        other in a hidden window, as a long lived service.
+ *
+ * The level (and the programs compiled for it) is kept between jobs that use
+ * the same level file and the pre render (environment maps) is cached across
+ * reloads by the device. The render, the read back (pixel buffer objects) and
+ * the encoding (threads of the writer) of consecutive jobs overlap, when the
+ * encoders fall behind the rendering wait for them (no image is dropped).
+ */
+class BatchRenderer
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param window: The window to render into (usually NONE, the device
+     *        should be OpenGL), its size is the size of the images.
+     * @param worker_count: Number of encoding threads.
+     * @param queue_size: Number of images waiting to be encoded.
+     */
+    BatchRenderer(
+        std::unique_ptr<WindowInterface> window,
+        std::size_t worker_count = 2,
+        std::size_t queue_size = 8);
+    //! @brief Destructor, finish the jobs in flight.
+    ~BatchRenderer();
+
+  public:
+    /**
+     * @brief Render a job, the image is written later (see Finish).
+     * @param job: The job to be rendered.
+     */
+    void Render(const proto::RenderJob& job);
+    /**
+     * @brief Render a list of jobs (grouped by level file so that each level
+     *        is loaded once), a job that fail is logged and skipped.
+     * @param jobs: The jobs to be rendered.
+     */
+    void Render(const proto::RenderJobs& jobs);
+    /**
+     * @brief Render the jobs of a job file (JSON of a RenderJobs).
+     * @param job_file: Path to the job file.
+     */
+    void RenderFile(const std::filesystem::path& job_file);
+    //! @brief Wait for the images in flight to be written.
+    void Finish();
+    //! @brief Get the counters (up to date after a finish).
+    BatchRenderStats GetStats() const;
+
+  protected:
+    /**
+     * @brief Load a level (unless it is already loaded).
+     * @param level_file: Path to the level (JSON), searched as an asset if
+     *        it doesn't exist.
+     */
+    void LoadLevel(const std::string& level_file);
+    /**
+     * @brief Get a program of the level.
+     * @param program_name: Name of the program in the level.
+     * @return The program.
+     */
+    Program& GetProgram(const std::string& program_name);
+    /**
+     * @brief Get the current values of parameters of a program.
+     * @param program_name: Name of the program in the level.
+     * @param parameters: Parameters to be read (name and type).
+     * @return The parameters with the values of the program.
+     */
+    google::protobuf::RepeatedPtrField<proto::Uniform> GetProgramParameters(
+        const std::string& program_name,
+        const google::protobuf::RepeatedPtrField<proto::Uniform>& parameters);
+    /**
+     * @brief Set parameters to a program (and its variants).
+     * @param program_name: Name of the program in the level.
+     * @param parameters: Parameters to be set.
+     */
+    void SetProgramParameters(
+        const std::string& program_name,
+        const google::protobuf::RepeatedPtrField<proto::Uniform>& parameters);
+    //! @brief Set back the values the overridden parameters had before.
+    void RestorePrograms();
+
+  protected:
+    /**
+     * @class ProgramOverride
+     * @brief A program as it was before it was overridden.
+     */
+    struct ProgramOverride
+    {
+        std::string program_name;
+        google::protobuf::RepeatedPtrField<proto::Uniform> parameters;
+        std::uint64_t content_hash = 0;
+    };
+
+  private:
+    std::unique_ptr<WindowInterface> window_ = nullptr;
+    Device& device_;
+    file::ImageSequenceWriter writer_;
+    const Logger& logger_ = Logger::GetInstance();
+    // Level loaded (path), its proto (to parse it again) and its
+    // camera (for the jobs without a camera).
+    std::string level_file_ = "";
+    proto::Level proto_level_ = {};
+    Camera level_camera_ = {};
+    // Programs before they were overridden (by the previous job), in the
+    // order of the overrides.
+    std::vector<ProgramOverride> previous_overrides_ = {};
+    BatchRenderStats stats_ = {};
+    std::optional<std::chrono::steady_clock::time_point> start_time_ =
+        std::nullopt;
+};
+
+} // End namespace frame::opengl.
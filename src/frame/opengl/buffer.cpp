@@ -3,6 +3,8 @@
 #include <exception>
 #include <stdexcept>
 
+#include "frame/opengl/state_cache.h"
+
 namespace frame::opengl
 {
 
@@ -16,21 +18,22 @@ Buffer::Buffer(
 
 Buffer::~Buffer()
 {
-    glDeleteBuffers(1, &buffer_object_);
+    StateCache::GetInstance().DeleteBuffer(buffer_object_);
 }
 
 void Buffer::Bind(const unsigned int slot /* = 0*/) const
 {
     if (locked_bind_)
         return;
-    glBindBuffer(static_cast<GLenum>(buffer_type_), buffer_object_);
+    StateCache::GetInstance().BindBuffer(
+        static_cast<GLenum>(buffer_type_), buffer_object_);
 }
 
 void Buffer::UnBind() const
 {
     if (locked_bind_)
         return;
-    glBindBuffer(static_cast<GLenum>(buffer_type_), 0);
+    StateCache::GetInstance().UnbindBuffer(static_cast<GLenum>(buffer_type_));
 }
 
 void Buffer::Copy(const std::size_t size, const void* data /*= nullptr*/) const
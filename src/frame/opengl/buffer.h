@@ -131,6 +131,11 @@ class Buffer : public BindInterface, public BufferInterface
     {
         return buffer_object_;
     }
+    //! @brief Get the usage the buffer was created with.
+    BufferUsageEnum GetUsage() const
+    {
+        return buffer_usage_;
+    }
     /**
      * @brief From the name interface this is returning the name of the
      * buffer.
@@ -1,17 +1,20 @@
 #include "device.h"
 
+#include <array>
 #include <cmath>
 #include <fstream>
 #include <glm/gtc/matrix_transform.hpp>
 #include <random>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 #include "frame/file/image.h"
 #include "frame/level.h"
 #include "frame/opengl/frame_buffer.h"
 #include "frame/opengl/render_buffer.h"
 #include "frame/opengl/renderer.h"
+#include "frame/opengl/state_cache.h"
 #include "frame/opengl/texture_cube_map.h"
 
 namespace frame::opengl
@@ -20,18 +23,21 @@ namespace frame::opengl
 Device::Device(void* gl_context, glm::uvec2 size)
     : gl_context_(gl_context), size_(size)
 {
+    // New context, nothing is known about its state.
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.Invalidate();
     // This should maintain the culling to none.
     // FIXME(anirul): Change this as to be working!
-    glDisable(GL_CULL_FACE);
-    // glEnable(GL_CULL_FACE);
-    // glCullFace(GL_FRONT);
+    state_cache.SetCapability(GL_CULL_FACE, false);
+    // state_cache.SetCapability(GL_CULL_FACE, true);
+    // state_cache.CullFace(GL_FRONT);
     // glFrontFace(GL_CCW);
     glEnable(GL_PROGRAM_POINT_SIZE);
-    glEnable(GL_BLEND);
+    state_cache.SetCapability(GL_BLEND, true);
     // Enable blending to 1 - source alpha.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL);
+    state_cache.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    state_cache.SetCapability(GL_DEPTH_TEST, true);
+    state_cache.DepthFunc(GL_LEQUAL);
     // Enable seamless cube map.
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 }
@@ -52,6 +58,9 @@ void Device::Startup(std::unique_ptr<frame::LevelInterface>&& level)
     // Create a renderer.
     renderer_ = std::make_unique<Renderer>(
         *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    renderer_->SetPreRenderCache(&pre_render_cache_);
+    pass_timing_count_ = 0;
+    dynamic_resolution_timing_ = false;
     // Add a callback to allow plugins to be called at pre-render step.
     renderer_->SetMeshRenderCallback([this](
                                          UniformInterface& uniform,
@@ -78,6 +87,7 @@ void Device::AddPlugin(std::unique_ptr<PluginInterface>&& plugin_interface)
             {
                 plugin_interfaces_[i].reset();
                 plugin_interfaces_[i] = std::move(plugin_interface);
+                UpdatePluginPtrs();
                 return;
             }
         }
@@ -88,24 +98,30 @@ void Device::AddPlugin(std::unique_ptr<PluginInterface>&& plugin_interface)
         if (!plugin_interfaces_[i])
         {
             plugin_interfaces_[i] = std::move(plugin_interface);
+            UpdatePluginPtrs();
             return;
         }
     }
     // No free space add the plugin at the end.
     plugin_interfaces_.push_back(std::move(plugin_interface));
+    UpdatePluginPtrs();
 }
 
-std::vector<PluginInterface*> Device::GetPluginPtrs()
+const std::vector<PluginInterface*>& Device::GetPluginPtrs()
 {
-    std::vector<PluginInterface*> plugin_ptrs;
+    return plugin_ptrs_;
+}
+
+void Device::UpdatePluginPtrs()
+{
+    plugin_ptrs_.clear();
     for (auto& plugin_interface : plugin_interfaces_)
     {
         if (plugin_interface)
         {
-            plugin_ptrs.push_back(plugin_interface.get());
+            plugin_ptrs_.push_back(plugin_interface.get());
         }
     }
-    return plugin_ptrs;
 }
 
 std::vector<std::string> Device::GetPluginNames() const
@@ -130,6 +146,7 @@ void Device::RemovePluginByName(const std::string& name)
             if (plugin_interfaces_[i]->GetName() == name)
             {
                 plugin_interfaces_[i].reset();
+                UpdatePluginPtrs();
                 return;
             }
         }
@@ -138,6 +155,9 @@ void Device::RemovePluginByName(const std::string& name)
 
 void Device::Cleanup()
 {
+    // Write the screenshots and the frames still in flight.
+    StopCapture();
+    readback_queue_.Flush();
     renderer_ = nullptr;
 }
 
@@ -163,34 +183,61 @@ void Device::DisplayLeftRightCamera(
     glm::uvec4 viewport_right,
     double time)
 {
-    if (invert_left_right_)
-    {
-        DisplayCamera(camera_right, viewport_left, time);
-        DisplayCamera(camera_left, viewport_right, time);
-    }
-    else
-    {
-        DisplayCamera(camera_left, viewport_left, time);
-        DisplayCamera(camera_right, viewport_right, time);
-    }
+    // Both eyes in a single pass (the meshes of the multi view programs are
+    // drawn once for both).
+    const Camera& first_camera =
+        invert_left_right_ ? camera_right : camera_left;
+    const Camera& second_camera =
+        invert_left_right_ ? camera_left : camera_right;
+    const std::array<RenderView, 2> views = {
+        RenderView{
+            first_camera.ComputeProjection(),
+            first_camera.ComputeView(),
+            viewport_left},
+        RenderView{
+            second_camera.ComputeProjection(),
+            second_camera.ComputeView(),
+            viewport_right}};
+    renderer_->RenderAllMeshes(views, time);
 }
 
 void Device::Display(double dt /*= 0.0*/)
 {
     if (!renderer_)
         throw std::runtime_error("No Renderer.");
+    // Complete the reads of the previous frames that are done.
+    readback_queue_.Poll();
     Clear();
-    // Get the holder of the camera.
-    auto camera_holder_id = level_->GetDefaultCameraId();
-    auto enum_type = level_->GetEnumTypeFromId(camera_holder_id);
-    auto& node = level_->GetSceneNodeFromId(camera_holder_id);
-    auto matrix_node = node.GetLocalModel(dt);
-    auto inverse_model = glm::inverse(matrix_node);
-    Camera default_camera = level_->GetDefaultCamera();
-    default_camera.SetFront(
-        default_camera.GetFront() * glm::mat3(inverse_model));
-    default_camera.SetPosition(glm::vec3(
-        glm::vec4(default_camera.GetPosition(), 1.0) * inverse_model));
+    // Scale the render to the frame time budget, the GPU time of the passes
+    // is read a few frames later (once available) and only used when new.
+    if (dynamic_resolution_.IsEnabled())
+    {
+        renderer_->SetPassTiming(true);
+        dynamic_resolution_timing_ = true;
+        const auto pass_timing_count = renderer_->GetPassTimingCount();
+        if (pass_timing_count != pass_timing_count_)
+        {
+            pass_timing_count_ = pass_timing_count;
+            dynamic_resolution_.Update(
+                renderer_->GetRenderGraph().GetGpuTime());
+        }
+    }
+    else if (std::exchange(dynamic_resolution_timing_, false))
+    {
+        renderer_->SetPassTiming(false);
+    }
+    renderer_->SetResolutionScale(dynamic_resolution_.GetScale());
+    renderer_->SetUpscaleFilter(dynamic_resolution_.GetUpscaleFilter());
+    const glm::uvec2 render_size = renderer_->GetRenderSize();
+    // Update the world transforms (only the one that changed) once per
+    // frame and publish them, the renderer read them from the snapshot.
+    level_->UpdateTransforms(dt);
+    level_->PublishSceneState(dt);
+    auto scene_state = level_->GetSceneState();
+    if (!scene_state->camera_id)
+        throw std::runtime_error("No default camera.");
+    // Default camera already in world space.
+    Camera default_camera = scene_state->camera;
     // Compute left and right cameras.
     Camera left_camera = default_camera;
     left_camera.SetPosition(
@@ -210,33 +257,38 @@ void Device::Display(double dt /*= 0.0*/)
     switch (stereo_enum_)
     {
     case StereoEnum::NONE:
-        DisplayCamera(default_camera, glm::uvec4(0, 0, size_.x, size_.y), dt);
+        DisplayCamera(
+            default_camera,
+            glm::uvec4(0, 0, render_size.x, render_size.y),
+            dt);
         break;
     case StereoEnum::HORIZONTAL_SPLIT:
         DisplayLeftRightCamera(
             left_camera,
             right_camera,
-            glm::uvec4(0, 0, size_.x / 2, size_.y),
-            glm::uvec4(size_.x / 2, 0, size_.x / 2, size_.y),
+            glm::uvec4(0, 0, render_size.x / 2, render_size.y),
+            glm::uvec4(render_size.x / 2, 0, render_size.x / 2, render_size.y),
             dt);
         break;
     case StereoEnum::HORIZONTAL_SIDE_BY_SIDE:
         DisplayLeftRightCamera(
             left_camera,
             right_camera,
-            glm::uvec4(0, 0, size_.x / 2, size_.y / 2),
-            glm::uvec4(size_.x / 2, 0, size_.x / 2, size_.y / 2),
+            glm::uvec4(0, 0, render_size.x / 2, render_size.y / 2),
+            glm::uvec4(
+                render_size.x / 2, 0, render_size.x / 2, render_size.y / 2),
             dt);
         break;
     default:
         throw std::runtime_error(fmt::format(
             "Unknown StereoEnum type {}.", static_cast<int>(stereo_enum_)));
     }
-    // Reset viewport.
+    // Reset viewport (the display upscale to the whole window).
     renderer_->SetViewport(glm::uvec4(0, 0, size_.x, size_.y));
     // Final display.
     // CHECKME(anirul): Is this still needed?
     renderer_->Display(dt);
+    CaptureFrame(dt);
 }
 
 void Device::ScreenShot(const std::string& file) const
@@ -257,6 +309,137 @@ void Device::ScreenShot(const std::string& file) const
     output_image.SaveImageToFile(file);
 }
 
+void Device::ScreenShotAsync(const std::string& file)
+{
+    auto maybe_texture_id = level_->GetDefaultOutputTextureId();
+    if (!maybe_texture_id)
+        throw std::runtime_error("no default texture.");
+    auto& texture = dynamic_cast<Texture&>(
+        level_->GetTextureFromId(maybe_texture_id));
+    if (texture.GetPixelElementSize() != proto::PixelElementSize::BYTE)
+    {
+        throw std::runtime_error(
+            "Invalid format should be byte is : " +
+            proto::PixelElementSize_Enum_Name(texture.GetPixelElementSize()));
+    }
+    proto::PixelElementSize pixel_element_size{};
+    pixel_element_size.set_value(texture.GetPixelElementSize());
+    proto::PixelStructure pixel_structure{};
+    pixel_structure.set_value(texture.GetPixelStructure());
+    // The texture can be resized before the read complete, keep its format.
+    readback_queue_.ReadTexture(
+        texture,
+        [file,
+         size = texture.GetSize(),
+         pixel_element_size,
+         pixel_structure](std::span<const std::uint8_t> pixels) {
+            file::Image output_image(
+                size, pixel_element_size, pixel_structure);
+            // Only read to write the file.
+            output_image.SetData(const_cast<std::uint8_t*>(pixels.data()));
+            output_image.SaveImageToFile(file);
+        });
+}
+
+void Device::StartCapture(
+    const std::filesystem::path& prefix,
+    std::uint32_t frame_interval /* = 1*/,
+    double duration_s /* = 0.0*/)
+{
+    if (!frame_interval)
+        throw std::runtime_error("Capture frame interval should be positive.");
+    StopCapture();
+    capture_writer_ = std::make_unique<file::ImageSequenceWriter>(prefix);
+    capture_interval_ = frame_interval;
+    capture_duration_s_ = duration_s;
+    capture_start_s_ = -1.0;
+    capture_frame_ = 0;
+    capture_stats_ = {};
+    logger_->info("Start capture to {}.", prefix.string());
+}
+
+void Device::StopCapture()
+{
+    if (!capture_writer_)
+        return;
+    // The reads in flight hand their pixels to the writer.
+    readback_queue_.Flush();
+    capture_writer_->Wait();
+    capture_stats_ = GetCaptureStats();
+    capture_writer_ = nullptr;
+    if (capture_stats_.dropped)
+    {
+        logger_->warn(
+            "Capture stopped, {} frames written, {} dropped (encoders were "
+            "behind).",
+            capture_stats_.written,
+            capture_stats_.dropped);
+        return;
+    }
+    logger_->info(
+        "Capture stopped, {} frames written.", capture_stats_.written);
+}
+
+CaptureStats Device::GetCaptureStats() const
+{
+    if (!capture_writer_)
+        return capture_stats_;
+    CaptureStats capture_stats = capture_stats_;
+    capture_stats.written = capture_writer_->GetWrittenCount();
+    // Dropped before the read back (queue full) or after.
+    capture_stats.dropped += capture_writer_->GetDroppedCount() +
+                             capture_writer_->GetFailedCount();
+    return capture_stats;
+}
+
+void Device::CaptureFrame(double time)
+{
+    if (!capture_writer_)
+        return;
+    if (capture_start_s_ < 0.0)
+        capture_start_s_ = time;
+    if (capture_duration_s_ > 0.0 &&
+        time - capture_start_s_ >= capture_duration_s_)
+    {
+        StopCapture();
+        return;
+    }
+    if (capture_frame_++ % capture_interval_)
+        return;
+    // Numbered by captured frame, a dropped frame leave a hole.
+    const std::uint64_t index = capture_stats_.captured++;
+    if (capture_writer_->IsFull())
+    {
+        // Don't read back a frame that would be dropped.
+        ++capture_stats_.dropped;
+        return;
+    }
+    auto maybe_texture_id = level_->GetDefaultOutputTextureId();
+    if (!maybe_texture_id)
+        throw std::runtime_error("no default texture.");
+    auto& texture = dynamic_cast<Texture&>(
+        level_->GetTextureFromId(maybe_texture_id));
+    proto::PixelElementSize pixel_element_size{};
+    pixel_element_size.set_value(texture.GetPixelElementSize());
+    proto::PixelStructure pixel_structure{};
+    pixel_structure.set_value(texture.GetPixelStructure());
+    // The writer outlive the reads (flushed before it is destroyed).
+    readback_queue_.ReadTexture(
+        texture,
+        [writer = capture_writer_.get(),
+         index,
+         size = texture.GetSize(),
+         pixel_element_size,
+         pixel_structure](std::span<const std::uint8_t> pixels) {
+            writer->Submit(
+                index,
+                size,
+                pixel_element_size,
+                pixel_structure,
+                {pixels.begin(), pixels.end()});
+        });
+}
+
 std::unique_ptr<frame::BufferInterface> Device::CreatePointBuffer(
     std::vector<float>&& vector)
 {
@@ -294,9 +477,14 @@ std::unique_ptr<frame::TextureInterface> Device::CreateTexture(
 
 void Device::Resize(glm::uvec2 size)
 {
-    Cleanup();
     size_ = size;
-    Startup(std::move(level_));
+    if (!renderer_)
+        return;
+    // Resize in place, the level (and the renderer) are kept.
+    auto& camera = level_->GetDefaultCamera();
+    camera.SetAspectRatio(
+        static_cast<float>(size_.x) / static_cast<float>(size_.y));
+    renderer_->Resize(size_);
 }
 
 void Device::SetStereo(
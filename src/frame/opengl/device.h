@@ -10,11 +10,13 @@
 
 #include "frame/camera.h"
 #include "frame/device_interface.h"
+#include "frame/file/image_sequence_writer.h"
 #include "frame/logger.h"
 #include "frame/node_camera.h"
 #include "frame/opengl/buffer.h"
 #include "frame/opengl/material.h"
 #include "frame/opengl/program.h"
+#include "frame/opengl/readback_queue.h"
 #include "frame/opengl/renderer.h"
 #include "frame/opengl/static_mesh.h"
 #include "frame/opengl/texture.h"
@@ -71,7 +73,7 @@ class Device : public DeviceInterface
      * @brief Get a list of plugin.
      * @return A list of pointer to plugin.
      */
-    std::vector<PluginInterface*> GetPluginPtrs() final;
+    const std::vector<PluginInterface*>& GetPluginPtrs() final;
     /**
      * @brief Get plugin names.
      * @return A list of plugin names.
@@ -105,6 +107,40 @@ class Device : public DeviceInterface
      * extension it will be dropped at the path where the software is run.
      */
     void ScreenShot(const std::string& file) const final;
+    /**
+     * @brief Make a screen shot to a file without waiting for the GPU, the
+     *        pixels are read back through the readback queue and the file
+     *        is written by a later display.
+     * @param file: File name of the screenshot.
+     */
+    void ScreenShotAsync(const std::string& file) final;
+    /**
+     * @brief Start capturing the frames to a numbered image sequence, the
+     *        display texture is read back through the readback queue and
+     *        written by a pool of threads.
+     * @param prefix: Path and start of the file names.
+     * @param frame_interval: Capture one frame every frame_interval.
+     * @param duration_s: Duration of the capture in seconds (0 until
+     *        stopped).
+     */
+    void StartCapture(
+        const std::filesystem::path& prefix,
+        std::uint32_t frame_interval = 1,
+        double duration_s = 0.0) final;
+    //! @brief Stop the capture (wait for the frames in flight).
+    void StopCapture() final;
+    //! @brief Check if the frames are captured.
+    bool IsCapturing() const final
+    {
+        return capture_writer_ != nullptr;
+    }
+    //! @brief Get the frames of the current (or last) capture.
+    CaptureStats GetCaptureStats() const final;
+    //! @brief Get the readback queue (polled at every display).
+    ReadbackQueue& GetReadbackQueue()
+    {
+        return readback_queue_;
+    }
 
   public:
     /**
@@ -148,6 +184,14 @@ class Device : public DeviceInterface
     {
         return focus_point_;
     }
+    /**
+     * @brief Get the dynamic resolution controller.
+     * @return The controller of the scale of the render.
+     */
+    DynamicResolution& GetDynamicResolution() final
+    {
+        return dynamic_resolution_;
+    }
     /**
      * @brief Get the application programming interface of the device.
      * @return Return the application programming interface used by the
@@ -194,17 +238,38 @@ class Device : public DeviceInterface
         glm::uvec4 viewport_left,
         glm::uvec4 viewport_right,
         double time);
+    //! @brief Rebuild the plugin pointer list (after add or remove).
+    void UpdatePluginPtrs();
+    /**
+     * @brief Start the read back of the display texture (in case capturing).
+     * @param time: Time from the beginning of the software in seconds.
+     */
+    void CaptureFrame(double time);
 
   private:
     // Map of current stored level.
     std::unique_ptr<LevelInterface> level_ = nullptr;
     // Storage of the plugin.
     std::vector<std::unique_ptr<PluginInterface>> plugin_interfaces_ = {};
+    // Non null plugins (kept so it doesn't have to be built every frame).
+    std::vector<PluginInterface*> plugin_ptrs_ = {};
     // Open GL context.
     void* gl_context_ = nullptr;
     glm::uvec2 size_ = {0, 0};
     const proto::PixelElementSize pixel_element_size_ =
         proto::PixelElementSize_HALF();
+    // Results of the pre render, kept across resize and level reload (the
+    // renderer is created again).
+    PreRenderCache pre_render_cache_ = {};
+    // Asynchronous reads of textures (screenshots and capture).
+    ReadbackQueue readback_queue_ = {};
+    // Capture of the frames (null if not capturing).
+    std::unique_ptr<file::ImageSequenceWriter> capture_writer_ = nullptr;
+    std::uint32_t capture_interval_ = 1;
+    double capture_duration_s_ = 0.0;
+    double capture_start_s_ = -1.0;
+    std::uint64_t capture_frame_ = 0;
+    CaptureStats capture_stats_ = {};
     // Rendering pipeline.
     std::unique_ptr<Renderer> renderer_ = nullptr;
     // Stereo mode.
@@ -212,6 +277,12 @@ class Device : public DeviceInterface
     float interocular_distance_ = 0.0f;
     glm::vec3 focus_point_ = glm::vec3(0.0f);
     bool invert_left_right_ = false;
+    // Scale of the render (to keep the frame time under a budget).
+    DynamicResolution dynamic_resolution_ = {};
+    // The pass timing was enabled for the scaling and the timed frames
+    // already used.
+    bool dynamic_resolution_timing_ = false;
+    std::uint64_t pass_timing_count_ = 0;
     // Logger for the device.
     const Logger& logger_ = Logger::GetInstance();
 };
@@ -48,7 +48,9 @@ std::optional<std::unique_ptr<TextureInterface>> LoadTextureFromString(
 }
 
 std::optional<EntityId> LoadMaterialFromObj(
-    LevelInterface& level, const frame::file::ObjMaterial& material_obj)
+    LevelInterface& level,
+    const frame::file::ObjMaterial& material_obj,
+    std::vector<EntityId>* resource_ids = nullptr)
 {
     // Load textures.
     auto maybe_color = (material_obj.ambient_str.empty())
@@ -108,6 +110,15 @@ std::optional<EntityId> LoadMaterialFromObj(
         level.AddTexture(std::move(maybe_metallic.value()));
     if (!maybe_metallic_id)
         return std::nullopt;
+    if (resource_ids)
+    {
+        resource_ids->insert(
+            resource_ids->end(),
+            {maybe_color_id,
+             maybe_normal_id,
+             maybe_roughness_id,
+             maybe_metallic_id});
+    }
     // Create the material.
     std::unique_ptr<MaterialInterface> material =
         std::make_unique<opengl::Material>();
@@ -118,7 +129,10 @@ std::optional<EntityId> LoadMaterialFromObj(
     material->AddTextureId(maybe_metallic_id, metallic_name);
     // Finally add the material to the level.
     material->SetName(material_obj.name);
-    return level.AddMaterial(std::move(material));
+    auto material_id = level.AddMaterial(std::move(material));
+    if (resource_ids)
+        resource_ids->push_back(material_id);
+    return material_id;
 }
 
 std::pair<EntityId, EntityId> LoadStaticMeshFromObj(
@@ -181,6 +195,7 @@ std::pair<EntityId, EntityId> LoadStaticMeshFromObj(
     parameter.normal_buffer_id = normal_buffer_id;
     parameter.texture_buffer_id = tex_coord_buffer_id;
     parameter.index_buffer_id = index_buffer_id;
+    parameter.bounding_box = ComputeBoundingBox(points);
     auto static_mesh = std::make_unique<opengl::StaticMesh>(level, parameter);
     auto material_id = NullId;
     if (!material_ids.empty())
@@ -275,6 +290,7 @@ EntityId LoadStaticMeshFromPly(
     StaticMeshParameter parameter = {};
     parameter.point_buffer_id = point_buffer_id;
     parameter.index_buffer_id = index_buffer_id;
+    parameter.bounding_box = ComputeBoundingBox(points);
 
     // Add for present buffer.
     if (!normals.empty())
@@ -299,14 +315,15 @@ EntityId LoadStaticMeshFromPly(
     return maybe_mesh_id;
 }
 
-std::vector<EntityId> LoadStaticMeshesFromObjFile(
+std::vector<EntityId> LoadStaticMeshesFromObj(
     LevelInterface& level,
+    const frame::file::Obj& obj,
     const std::filesystem::path& file,
     const std::string& name,
-    const std::string& material_name /* = ""*/)
+    const std::string& material_name,
+    std::vector<EntityId>* resource_ids)
 {
     std::vector<EntityId> entity_id_vec;
-    frame::file::Obj obj(file);
     const auto& meshes = obj.GetMeshes();
     Logger& logger = Logger::GetInstance();
     std::vector<EntityId> material_ids;
@@ -324,6 +341,8 @@ std::vector<EntityId> LoadStaticMeshesFromObjFile(
             level, mesh, name, material_ids, mesh_counter);
         if (!static_mesh_id)
             return {};
+        if (resource_ids)
+            resource_ids->push_back(static_mesh_id);
         auto func = [&level](const std::string& name) -> NodeInterface* {
             auto maybe_id = level.GetIdFromName(name);
             if (!maybe_id)
@@ -345,14 +364,14 @@ std::vector<EntityId> LoadStaticMeshesFromObjFile(
     return entity_id_vec;
 }
 
-EntityId LoadStaticMeshFromPlyFile(
+EntityId LoadStaticMeshesFromPly(
     LevelInterface& level,
-    const std::filesystem::path& file,
+    const frame::file::Ply& ply,
     const std::string& name,
-    const std::string& material_name /* = ""*/)
+    const std::string& material_name,
+    std::vector<EntityId>* resource_ids)
 {
     EntityId entity_id = NullId;
-    frame::file::Ply ply(file);
     Logger& logger = Logger::GetInstance();
     EntityId material_id = NullId;
     if (!material_name.empty())
@@ -364,6 +383,8 @@ EntityId LoadStaticMeshFromPlyFile(
     auto static_mesh_id = LoadStaticMeshFromPly(level, ply, name);
     if (!static_mesh_id)
         return NullId;
+    if (resource_ids)
+        resource_ids->push_back(static_mesh_id);
     auto func = [&level](const std::string& name) -> NodeInterface* {
         auto maybe_id = level.GetIdFromName(name);
         if (!maybe_id)
@@ -384,21 +405,51 @@ EntityId LoadStaticMeshFromPlyFile(
 
 } // End namespace.
 
+StaticMeshFile ReadStaticMeshFile(const std::filesystem::path& file)
+{
+    StaticMeshFile static_mesh_file{};
+    auto extension = file.extension();
+    static_mesh_file.file = frame::file::FindFile(file);
+    if (extension == ".obj")
+        static_mesh_file.obj.emplace(static_mesh_file.file);
+    if (extension == ".ply")
+        static_mesh_file.ply.emplace(static_mesh_file.file);
+    return static_mesh_file;
+}
+
+std::vector<EntityId> LoadStaticMeshesFromFile(
+    LevelInterface& level,
+    const StaticMeshFile& static_mesh_file,
+    const std::string& name,
+    const std::string& material_name /* = ""*/,
+    std::vector<EntityId>* resource_ids /* = nullptr*/)
+{
+    if (static_mesh_file.obj)
+    {
+        return LoadStaticMeshesFromObj(
+            level,
+            *static_mesh_file.obj,
+            static_mesh_file.file,
+            name,
+            material_name,
+            resource_ids);
+    }
+    if (static_mesh_file.ply)
+    {
+        return {LoadStaticMeshesFromPly(
+            level, *static_mesh_file.ply, name, material_name, resource_ids)};
+    }
+    return {};
+}
+
 std::vector<EntityId> LoadStaticMeshesFromFile(
     LevelInterface& level,
     const std::filesystem::path& file,
     const std::string& name,
     const std::string& material_name /* = ""*/)
 {
-    auto extension = file.extension();
-    std::filesystem::path final_path = frame::file::FindFile(file);
-    if (extension == ".obj")
-        return LoadStaticMeshesFromObjFile(
-            level, final_path, name, material_name);
-    if (extension == ".ply")
-        return {
-            LoadStaticMeshFromPlyFile(level, final_path, name, material_name)};
-    return {};
+    return LoadStaticMeshesFromFile(
+        level, ReadStaticMeshFile(file), name, material_name);
 }
 
 } // End namespace frame::opengl::file.
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "frame/file/obj.h"
+#include "frame/file/ply.h"
 #include "frame/level_interface.h"
 #include "frame/node_static_mesh.h"
 #include "frame/static_mesh_interface.h"
@@ -11,6 +15,42 @@
 namespace frame::opengl::file
 {
 
+/**
+ * @class StaticMeshFile
+ * @brief A mesh file read and parsed, only one of the two is set.
+ */
+struct StaticMeshFile
+{
+    std::filesystem::path file;
+    std::optional<frame::file::Obj> obj = std::nullopt;
+    std::optional<frame::file::Ply> ply = std::nullopt;
+};
+
+/**
+ * @brief Read and parse a mesh file, this doesn't need an OpenGL context
+ *        (so it can be done on another thread).
+ * @param file: The file name of the mesh (OBJ or PLY).
+ * @return The parsed file (nothing set in case of an unknown extension).
+ */
+StaticMeshFile ReadStaticMeshFile(const std::filesystem::path& file);
+/**
+ * @brief Load static meshes from a parsed file (create the buffers).
+ * @param level: The level in which you want to load the mesh.
+ * @param static_mesh_file: The parsed mesh file.
+ * @param name: The name of the mesh.
+ * @param material_name: The material that is used.
+ * @param resource_ids: If not null receive the entities added to the level
+ *        other than the nodes (meshes, materials and textures).
+ * @return The entity id of the nodes in the level (could be more than one
+ *         in case OBJ file).
+ */
+std::vector<EntityId> LoadStaticMeshesFromFile(
+    LevelInterface& level,
+    const StaticMeshFile& static_mesh_file,
+    const std::string& name,
+    const std::string& material_name = "",
+    std::vector<EntityId>* resource_ids = nullptr);
+
 /**
  * @brief Load static meshes from file.
  * @param level: The level in which you want to load the mesh.
@@ -11,6 +11,7 @@
 #include "frame/logger.h"
 #include "frame/node_matrix.h"
 #include "frame/opengl/material.h"
+#include "frame/opengl/pre_render_cache.h"
 #include "frame/opengl/renderer.h"
 #include "frame/opengl/static_mesh.h"
 #include "frame/opengl/texture.h"
@@ -91,6 +92,31 @@ std::uint32_t PowerFloor(std::uint32_t x)
     return power;
 }
 
+// Content hash of a texture loaded from a file, the file (its path, size
+// and last write time) and the format it is loaded in.
+std::uint64_t GetFileContentHash(
+    std::uint64_t seed,
+    const std::filesystem::path& file,
+    proto::PixelElementSize pixel_element_size,
+    proto::PixelStructure pixel_structure)
+{
+    std::uint64_t hash = CombineContentHash(seed, file.string());
+    std::error_code error;
+    const auto file_size = std::filesystem::file_size(file, error);
+    if (!error)
+        hash = CombineContentHash(hash, std::to_string(file_size));
+    const auto write_time = std::filesystem::last_write_time(file, error);
+    if (!error)
+    {
+        hash = CombineContentHash(
+            hash, std::to_string(write_time.time_since_epoch().count()));
+    }
+    hash = CombineContentHash(
+        hash, PixelElementSize_Enum_Name(pixel_element_size.value()));
+    return CombineContentHash(
+        hash, PixelStructure_Enum_Name(pixel_structure.value()));
+}
+
 } // End namespace.
 
 std::unique_ptr<frame::TextureInterface> LoadTextureFromFile(
@@ -102,7 +128,10 @@ std::unique_ptr<frame::TextureInterface> LoadTextureFromFile(
     frame::file::Image image(file, pixel_element_size, pixel_structure);
     TextureParameter texture_parameter = {
         pixel_element_size, pixel_structure, image.GetSize(), image.Data()};
-    return std::make_unique<frame::opengl::Texture>(texture_parameter);
+    auto texture = std::make_unique<frame::opengl::Texture>(texture_parameter);
+    texture->SetContentHash(
+        GetFileContentHash(0, file, pixel_element_size, pixel_structure));
+    return texture;
 }
 
 std::unique_ptr<frame::TextureInterface> LoadCubeMapTextureFromFile(
@@ -171,7 +200,13 @@ std::unique_ptr<frame::TextureInterface> LoadCubeMapTextureFromFile(
     auto maybe_output_id = level->GetIdFromName("OutputTexture");
     if (!maybe_output_id)
         return nullptr;
-    return level->ExtractTexture(maybe_output_id);
+    auto texture = level->ExtractTexture(maybe_output_id);
+    if (texture)
+    {
+        texture->SetContentHash(CombineContentHash(
+            equirectangular->GetContentHash(), "equirectangular"));
+    }
+    return texture;
 }
 
 std::unique_ptr<frame::TextureInterface> LoadCubeMapTextureFromFiles(
@@ -197,7 +232,15 @@ std::unique_ptr<frame::TextureInterface> LoadCubeMapTextureFromFiles(
         texture_parameter.array_data_ptr[i] = images[i]->Data();
     }
     texture_parameter.size = images[0]->GetSize();
-    return std::make_unique<opengl::TextureCubeMap>(texture_parameter);
+    auto texture = std::make_unique<opengl::TextureCubeMap>(texture_parameter);
+    std::uint64_t content_hash = 0;
+    for (const auto& file : final_files)
+    {
+        content_hash = GetFileContentHash(
+            content_hash, file, pixel_element_size, pixel_structure);
+    }
+    texture->SetContentHash(content_hash);
+    return texture;
 }
 
 std::unique_ptr<TextureInterface> LoadTextureFromVec4(const glm::vec4& vec4)
@@ -208,7 +251,12 @@ std::unique_ptr<TextureInterface> LoadTextureFromVec4(const glm::vec4& vec4)
         proto::PixelStructure_RGB_ALPHA(),
         {1, 1},
         (void*)&ar};
-    return std::make_unique<frame::opengl::Texture>(texture_parameter);
+    auto texture = std::make_unique<frame::opengl::Texture>(texture_parameter);
+    texture->SetContentHash(CombineContentHash(
+        0,
+        std::string_view(
+            reinterpret_cast<const char*>(ar.data()), sizeof(ar))));
+    return texture;
 }
 
 std::unique_ptr<TextureInterface> LoadTextureFromFloat(float f)
@@ -218,7 +266,10 @@ std::unique_ptr<TextureInterface> LoadTextureFromFloat(float f)
         frame::proto::PixelStructure_GREY(),
         {1, 1},
         (void*)&f};
-    return std::make_unique<frame::opengl::Texture>(texture_parameter);
+    auto texture = std::make_unique<frame::opengl::Texture>(texture_parameter);
+    texture->SetContentHash(CombineContentHash(
+        0, std::string_view(reinterpret_cast<const char*>(&f), sizeof(f))));
+    return texture;
 }
 
 } // namespace frame::opengl::file
@@ -2,10 +2,12 @@
 
 #include <GL/glew.h>
 
+#include <array>
 #include <cassert>
 #include <sstream>
 #include <stdexcept>
 
+#include "frame/opengl/state_cache.h"
 #include "texture.h"
 
 namespace frame::opengl
@@ -18,7 +20,7 @@ FrameBuffer::FrameBuffer()
 
 FrameBuffer::~FrameBuffer()
 {
-    glDeleteFramebuffers(1, &frame_id_);
+    StateCache::GetInstance().DeleteFramebuffer(frame_id_);
 }
 
 void FrameBuffer::Bind(const unsigned int slot /*= 0*/) const
@@ -26,22 +28,22 @@ void FrameBuffer::Bind(const unsigned int slot /*= 0*/) const
     assert(slot == 0);
     if (locked_bind_)
         return;
-    glBindFramebuffer(GL_FRAMEBUFFER, frame_id_);
+    StateCache::GetInstance().BindFramebuffer(frame_id_);
 }
 
 void FrameBuffer::UnBind() const
 {
     if (locked_bind_)
         return;
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    StateCache::GetInstance().BindFramebuffer(0);
 }
 
 void FrameBuffer::AttachRender(const RenderBuffer& render) const
 {
     Bind();
     render.Bind();
-    glFramebufferRenderbuffer(
-        GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, render.GetId());
+    StateCache::GetInstance().FramebufferRenderbuffer(
+        GL_DEPTH_ATTACHMENT, render.GetId());
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
     {
         auto error_pair = GetError();
@@ -62,9 +64,11 @@ void FrameBuffer::AttachTexture(
     ,
     const int mipmap /*= 0*/) const
 {
+    auto& state_cache = StateCache::GetInstance();
+    // A texture can't be sampled while it is rendered to.
+    state_cache.UnbindTextureFromAllUnits(texture_id);
     Bind();
-    glFramebufferTexture2D(
-        GL_FRAMEBUFFER,
+    state_cache.FramebufferTexture2D(
         static_cast<GLenum>(frame_color_attachment),
         GetFrameTextureType(frame_texture_type),
         texture_id,
@@ -141,13 +145,13 @@ void FrameBuffer::DrawBuffers(const std::uint32_t size /*= 1*/)
 {
     Bind();
     assert(size < 9);
-    std::vector<unsigned int> draw_buffer = {};
+    std::array<GLenum, 8> draw_buffer = {};
     for (std::uint32_t i = 0; i < size; ++i)
     {
-        draw_buffer.emplace_back(
-            static_cast<unsigned int>(FrameBuffer::GetFrameColorAttachment(i)));
+        draw_buffer[i] =
+            static_cast<GLenum>(FrameBuffer::GetFrameColorAttachment(i));
     }
-    glDrawBuffers(static_cast<GLsizei>(draw_buffer.size()), draw_buffer.data());
+    glDrawBuffers(static_cast<GLsizei>(size), draw_buffer.data());
     UnBind();
 }
 
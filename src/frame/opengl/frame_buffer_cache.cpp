@@ -0,0 +1,49 @@
+#include "frame/opengl/frame_buffer_cache.h"
+
+#include <fmt/core.h>
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace frame::opengl
+{
+
+void FrameBufferKey::AddColorAttachment(
+    GLuint texture, FrameTextureType frame_texture_type)
+{
+    if (color_attachment_count >= max_color_attachments)
+    {
+        throw std::runtime_error(fmt::format(
+            "Only {} color attachments allowed.", max_color_attachments));
+    }
+    textures[color_attachment_count] = texture;
+    texture_types[color_attachment_count] = frame_texture_type;
+    ++color_attachment_count;
+}
+
+FrameBuffer& FrameBufferCache::GetFrameBuffer(
+    const FrameBufferKey& key, const RenderBuffer& depth)
+{
+    assert(key.depth_render_buffer == depth.GetId());
+    auto it = frame_buffers_.find(key);
+    if (it != frame_buffers_.end())
+        return *it->second;
+    auto frame_buffer = std::make_unique<FrameBuffer>();
+    frame_buffer->AttachRender(depth);
+    for (std::uint32_t i = 0; i < key.color_attachment_count; ++i)
+    {
+        // TODO(anirul): Check the mipmap level (last parameter)!
+        frame_buffer->AttachTexture(
+            key.textures[i],
+            FrameBuffer::GetFrameColorAttachment(i),
+            key.texture_types[i],
+            0);
+    }
+    frame_buffer->DrawBuffers(key.color_attachment_count);
+    auto& frame_buffer_ref = *frame_buffer;
+    frame_buffers_.emplace(key, std::move(frame_buffer));
+    return frame_buffer_ref;
+}
+
+} // End namespace frame::opengl.
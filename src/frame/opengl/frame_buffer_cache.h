@@ -0,0 +1,89 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <absl/container/flat_hash_map.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "frame/opengl/frame_buffer.h"
+#include "frame/opengl/render_buffer.h"
+
+namespace frame::opengl
+{
+
+/**
+ * @class FrameBufferKey
+ * @brief Set of attachments of a frame buffer: the color attachments (in
+ *        order) and the depth render buffer.
+ */
+struct FrameBufferKey
+{
+    //! @brief Maximum number of color attachments (see DrawBuffers).
+    static constexpr std::size_t max_color_attachments = 8;
+    /**
+     * @brief Add a color attachment (at the next attachment point).
+     * @param texture: OpenGL texture id.
+     * @param frame_texture_type: Texture 2D or face of a cube map.
+     */
+    void AddColorAttachment(
+        GLuint texture, FrameTextureType frame_texture_type);
+
+    std::array<GLuint, max_color_attachments> textures = {};
+    std::array<FrameTextureType, max_color_attachments> texture_types = {};
+    std::uint32_t color_attachment_count = 0;
+    GLuint depth_render_buffer = 0;
+
+    friend bool operator==(
+        const FrameBufferKey&, const FrameBufferKey&) = default;
+    template <typename H>
+    friend H AbslHashValue(H h, const FrameBufferKey& key)
+    {
+        return H::combine(
+            std::move(h),
+            key.textures,
+            key.texture_types,
+            key.color_attachment_count,
+            key.depth_render_buffer);
+    }
+};
+
+/**
+ * @class FrameBufferCache
+ * @brief Frame buffers with their attachments already made, keyed by the set
+ *        of attachments. Switching to a set of outputs is a single bind of
+ *        the frame buffer instead of attaching every texture again.
+ *
+ * The cache has to be cleared when the attached textures could be deleted
+ * (a texture id can be reused by a new texture).
+ */
+class FrameBufferCache
+{
+  public:
+    /**
+     * @brief Get the frame buffer for a set of attachments, it is created
+     *        (and the attachments are made) in case it is not in the cache.
+     * @param key: The set of attachments.
+     * @param depth: The depth render buffer (has to match the key).
+     * @return The frame buffer with the attachments.
+     */
+    FrameBuffer& GetFrameBuffer(
+        const FrameBufferKey& key, const RenderBuffer& depth);
+    //! @brief Delete all the frame buffers.
+    void Clear()
+    {
+        frame_buffers_.clear();
+    }
+    //! @brief Get the number of frame buffers in the cache.
+    std::size_t GetSize() const
+    {
+        return frame_buffers_.size();
+    }
+
+  private:
+    absl::flat_hash_map<FrameBufferKey, std::unique_ptr<FrameBuffer>>
+        frame_buffers_ = {};
+};
+
+} // End namespace frame::opengl.
@@ -0,0 +1,265 @@
+#include "frame/opengl/geometry_arena.h"
+
+#include <algorithm>
+#include <array>
+
+#include "frame/opengl/state_cache.h"
+#include "frame/opengl/static_mesh.h"
+
+namespace frame::opengl
+{
+
+namespace
+{
+
+// Get an attribute buffer of a mesh (null in case there is none).
+const Buffer* GetAttributeBuffer(LevelInterface& level, EntityId buffer_id)
+{
+    if (!buffer_id)
+        return nullptr;
+    return &dynamic_cast<const Buffer&>(level.GetBufferFromId(buffer_id));
+}
+
+// Copy the start of a buffer at an offset of another one (sizes in bytes),
+// this stay on the GPU.
+void CopyBuffer(
+    const Buffer& source,
+    const Buffer& destination,
+    std::size_t size,
+    std::size_t offset)
+{
+    if (!size)
+        return;
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.BindBuffer(GL_COPY_READ_BUFFER, source.GetId());
+    state_cache.BindBuffer(GL_COPY_WRITE_BUFFER, destination.GetId());
+    glCopyBufferSubData(
+        GL_COPY_READ_BUFFER,
+        GL_COPY_WRITE_BUFFER,
+        0,
+        static_cast<GLintptr>(offset),
+        static_cast<GLsizeiptr>(size));
+}
+
+// Create a buffer with storage for a number of floats (or indices).
+std::unique_ptr<Buffer> CreateBuffer(
+    BufferTypeEnum buffer_type, std::size_t element_count)
+{
+    auto buffer = std::make_unique<Buffer>(buffer_type);
+    buffer->Copy(element_count * sizeof(float));
+    return buffer;
+}
+
+// Set a float attribute of the bound vertex array.
+void SetAttribute(
+    const Buffer& buffer,
+    GLuint location,
+    std::uint32_t size,
+    GLboolean normalized)
+{
+    buffer.Bind();
+    glVertexAttribPointer(location, size, GL_FLOAT, normalized, 0, nullptr);
+    glEnableVertexAttribArray(location);
+    buffer.UnBind();
+}
+
+} // namespace
+
+GeometryArena::~GeometryArena()
+{
+    Clear();
+}
+
+bool GeometryArena::IsSupported()
+{
+    return GLEW_VERSION_4_3;
+}
+
+void GeometryArena::Build(
+    LevelInterface& level, std::span<const EntityId> static_mesh_ids)
+{
+    Clear();
+    // Meshes to be copied once the pools are created.
+    struct MeshCopy
+    {
+        const StaticMesh* static_mesh = nullptr;
+        GeometryRange range = {};
+        std::uint32_t vertex_count = 0;
+    };
+    std::vector<MeshCopy> mesh_copies;
+    absl::flat_hash_map<VertexLayout, std::uint32_t> pool_map;
+    for (const auto static_mesh_id : static_mesh_ids)
+    {
+        if (ranges_.contains(static_mesh_id))
+            continue;
+        const auto* static_mesh = dynamic_cast<const StaticMesh*>(
+            &level.GetStaticMeshFromId(static_mesh_id));
+        if (!static_mesh || !static_mesh->GetIndexSize())
+            continue;
+        const auto* point_buffer =
+            GetAttributeBuffer(level, static_mesh->GetPointBufferId());
+        const auto* color_buffer =
+            GetAttributeBuffer(level, static_mesh->GetColorBufferId());
+        const auto* normal_buffer =
+            GetAttributeBuffer(level, static_mesh->GetNormalBufferId());
+        const auto* texture_buffer =
+            GetAttributeBuffer(level, static_mesh->GetTextureBufferId());
+        // Streamed meshes change every frame so they keep their buffers.
+        const std::array<const Buffer*, 4> buffers = {
+            point_buffer, color_buffer, normal_buffer, texture_buffer};
+        if (std::ranges::any_of(buffers, [](const Buffer* buffer) {
+                return buffer &&
+                       buffer->GetUsage() != BufferUsageEnum::STATIC_DRAW;
+            }))
+        {
+            continue;
+        }
+        VertexLayout layout = {};
+        layout.point_size = static_mesh->GetPointBufferSize();
+        layout.color_size =
+            color_buffer ? static_mesh->GetColorBufferSize() : 0;
+        layout.normal_size =
+            normal_buffer ? static_mesh->GetNormalBufferSize() : 0;
+        layout.texture_size =
+            texture_buffer ? static_mesh->GetTextureBufferSize() : 0;
+        auto [pool_it, inserted] = pool_map.emplace(
+            layout, static_cast<std::uint32_t>(pools_.size()));
+        if (inserted)
+        {
+            pools_.emplace_back();
+            pools_.back().layout = layout;
+        }
+        auto& pool = pools_[pool_it->second];
+        MeshCopy mesh_copy = {};
+        mesh_copy.static_mesh = static_mesh;
+        mesh_copy.vertex_count = static_cast<std::uint32_t>(
+            point_buffer->GetSize() / (layout.point_size * sizeof(float)));
+        mesh_copy.range.pool = pool_it->second;
+        mesh_copy.range.first_index = pool.index_count;
+        mesh_copy.range.index_count = static_cast<std::uint32_t>(
+            static_mesh->GetIndexSize() / sizeof(std::uint32_t));
+        mesh_copy.range.base_vertex =
+            static_cast<std::int32_t>(pool.vertex_count);
+        pool.vertex_count += mesh_copy.vertex_count;
+        pool.index_count += mesh_copy.range.index_count;
+        ranges_.emplace(static_mesh_id, mesh_copy.range);
+        mesh_copies.push_back(mesh_copy);
+    }
+    for (auto& pool : pools_)
+    {
+        CreatePool(pool);
+    }
+    // Copy the meshes at their place in the pools.
+    for (const auto& mesh_copy : mesh_copies)
+    {
+        const auto& pool = pools_[mesh_copy.range.pool];
+        const auto& static_mesh = *mesh_copy.static_mesh;
+        const auto base_vertex =
+            static_cast<std::size_t>(mesh_copy.range.base_vertex);
+        auto copy_attribute = [&level, &mesh_copy, base_vertex](
+                                  EntityId buffer_id,
+                                  const std::unique_ptr<Buffer>& destination,
+                                  std::uint32_t size) {
+            if (!destination)
+                return;
+            const auto& source =
+                dynamic_cast<const Buffer&>(level.GetBufferFromId(buffer_id));
+            // Never write past the vertices of the mesh.
+            const std::size_t vertex_bytes = size * sizeof(float);
+            CopyBuffer(
+                source,
+                *destination,
+                std::min(
+                    source.GetSize(), mesh_copy.vertex_count * vertex_bytes),
+                base_vertex * vertex_bytes);
+        };
+        copy_attribute(
+            static_mesh.GetPointBufferId(),
+            pool.point_buffer,
+            pool.layout.point_size);
+        copy_attribute(
+            static_mesh.GetColorBufferId(),
+            pool.color_buffer,
+            pool.layout.color_size);
+        copy_attribute(
+            static_mesh.GetNormalBufferId(),
+            pool.normal_buffer,
+            pool.layout.normal_size);
+        copy_attribute(
+            static_mesh.GetTextureBufferId(),
+            pool.texture_buffer,
+            pool.layout.texture_size);
+        CopyBuffer(
+            dynamic_cast<const Buffer&>(
+                level.GetBufferFromId(static_mesh.GetIndexBufferId())),
+            *pool.index_buffer,
+            mesh_copy.range.index_count * sizeof(std::uint32_t),
+            mesh_copy.range.first_index * sizeof(std::uint32_t));
+    }
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.UnbindBuffer(GL_COPY_READ_BUFFER);
+    state_cache.UnbindBuffer(GL_COPY_WRITE_BUFFER);
+}
+
+void GeometryArena::CreatePool(Pool& pool) const
+{
+    auto& state_cache = StateCache::GetInstance();
+    glGenVertexArrays(1, &pool.vertex_array);
+    state_cache.BindVertexArray(pool.vertex_array);
+    // The index buffer binding is part of the vertex array.
+    pool.index_buffer =
+        CreateBuffer(BufferTypeEnum::ELEMENT_ARRAY_BUFFER, pool.index_count);
+    pool.index_buffer->Bind();
+    // Same locations as the static mesh, the points then the color, the
+    // normal and the texture coordinates (in case they are present).
+    const auto& layout = pool.layout;
+    GLuint location = 0;
+    pool.point_buffer = CreateBuffer(
+        BufferTypeEnum::ARRAY_BUFFER, pool.vertex_count * layout.point_size);
+    SetAttribute(*pool.point_buffer, location, layout.point_size, GL_FALSE);
+    if (layout.color_size)
+    {
+        pool.color_buffer = CreateBuffer(
+            BufferTypeEnum::ARRAY_BUFFER,
+            pool.vertex_count * layout.color_size);
+        SetAttribute(
+            *pool.color_buffer, ++location, layout.color_size, GL_FALSE);
+    }
+    if (layout.normal_size)
+    {
+        pool.normal_buffer = CreateBuffer(
+            BufferTypeEnum::ARRAY_BUFFER,
+            pool.vertex_count * layout.normal_size);
+        SetAttribute(
+            *pool.normal_buffer, ++location, layout.normal_size, GL_TRUE);
+    }
+    if (layout.texture_size)
+    {
+        pool.texture_buffer = CreateBuffer(
+            BufferTypeEnum::ARRAY_BUFFER,
+            pool.vertex_count * layout.texture_size);
+        SetAttribute(
+            *pool.texture_buffer, ++location, layout.texture_size, GL_FALSE);
+    }
+    state_cache.BindVertexArray(0);
+}
+
+void GeometryArena::Clear()
+{
+    for (const auto& pool : pools_)
+    {
+        StateCache::GetInstance().DeleteVertexArray(pool.vertex_array);
+    }
+    pools_.clear();
+    ranges_.clear();
+}
+
+const GeometryRange* GeometryArena::FindRange(EntityId static_mesh_id) const
+{
+    auto it = ranges_.find(static_mesh_id);
+    if (it == ranges_.end())
+        return nullptr;
+    return &it->second;
+}
+
+} // End namespace frame::opengl.
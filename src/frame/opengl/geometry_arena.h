@@ -0,0 +1,157 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <absl/container/flat_hash_map.h>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "frame/level_interface.h"
+#include "frame/opengl/buffer.h"
+
+namespace frame::opengl
+{
+
+/**
+ * @class VertexLayout
+ * @brief Number of floats per vertex of every attribute of a static mesh (0
+ *        in case the mesh doesn't have it). Meshes with the same layout use
+ *        the same attribute locations and can share buffers.
+ */
+struct VertexLayout
+{
+    std::uint32_t point_size = 3;
+    std::uint32_t color_size = 0;
+    std::uint32_t normal_size = 0;
+    std::uint32_t texture_size = 0;
+
+    friend bool operator==(const VertexLayout&, const VertexLayout&) = default;
+    template <typename H>
+    friend H AbslHashValue(H h, const VertexLayout& layout)
+    {
+        return H::combine(
+            std::move(h),
+            layout.point_size,
+            layout.color_size,
+            layout.normal_size,
+            layout.texture_size);
+    }
+};
+
+/**
+ * @class GeometryRange
+ * @brief Where a static mesh is in the arena, the pool and the range in the
+ *        index buffer (in indices), the indices are relative to the base
+ *        vertex.
+ */
+struct GeometryRange
+{
+    std::uint32_t pool = 0;
+    std::uint32_t first_index = 0;
+    std::uint32_t index_count = 0;
+    std::int32_t base_vertex = 0;
+};
+
+/**
+ * @class DrawElementsIndirectCommand
+ * @brief A draw as read from the indirect buffer by
+ *        glMultiDrawElementsIndirect (the layout is fixed by OpenGL).
+ */
+struct DrawElementsIndirectCommand
+{
+    std::uint32_t count = 0;
+    std::uint32_t instance_count = 0;
+    std::uint32_t first_index = 0;
+    std::int32_t base_vertex = 0;
+    std::uint32_t base_instance = 0;
+};
+
+/**
+ * @class GeometryArena
+ * @brief Copy of the static meshes in a few large buffers, one pool (a
+ *        buffer per attribute, an index buffer and a vertex array) per
+ *        vertex layout. Every mesh of a pool is drawn with the same vertex
+ *        array so a list of them can be drawn in a single multi draw call.
+ *
+ * The arena has to be built again when the meshes could be deleted, meshes
+ * with streamed buffers (that change every frame) are not copied.
+ */
+class GeometryArena
+{
+  public:
+    //! @brief Destructor delete the vertex arrays.
+    ~GeometryArena();
+
+  public:
+    /**
+     * @brief Check if the arena can be used for drawing, this need multi
+     *        draw indirect and base instance (OpenGL 4.3).
+     * @return True if supported.
+     */
+    static bool IsSupported();
+    /**
+     * @brief Copy static meshes to the arena (replacing what was there).
+     * @param level: The level the meshes are from.
+     * @param static_mesh_ids: Meshes to be copied (can have duplicates).
+     */
+    void Build(
+        LevelInterface& level, std::span<const EntityId> static_mesh_ids);
+    //! @brief Delete all the pools.
+    void Clear();
+    /**
+     * @brief Find where a static mesh is in the arena.
+     * @param static_mesh_id: The static mesh id.
+     * @return The range of the mesh or null in case it is not in the arena.
+     */
+    const GeometryRange* FindRange(EntityId static_mesh_id) const;
+    /**
+     * @brief Get the vertex array of a pool (with the index buffer bound).
+     * @param pool: The pool index (from the range of a mesh).
+     * @return OpenGL vertex array id.
+     */
+    GLuint GetVertexArray(std::uint32_t pool) const
+    {
+        return pools_[pool].vertex_array;
+    }
+    //! @brief Get the number of pools (vertex layouts).
+    std::size_t GetPoolCount() const
+    {
+        return pools_.size();
+    }
+    //! @brief Get the number of meshes in the arena.
+    std::size_t GetMeshCount() const
+    {
+        return ranges_.size();
+    }
+
+  private:
+    /**
+     * @brief Buffers and vertex array of a vertex layout.
+     */
+    struct Pool
+    {
+        VertexLayout layout = {};
+        std::uint32_t vertex_count = 0;
+        std::uint32_t index_count = 0;
+        GLuint vertex_array = 0;
+        std::unique_ptr<Buffer> point_buffer = nullptr;
+        std::unique_ptr<Buffer> color_buffer = nullptr;
+        std::unique_ptr<Buffer> normal_buffer = nullptr;
+        std::unique_ptr<Buffer> texture_buffer = nullptr;
+        std::unique_ptr<Buffer> index_buffer = nullptr;
+    };
+    /**
+     * @brief Create the buffers and the vertex array of a pool (the vertex
+     *        and index count are known).
+     * @param pool: The pool.
+     */
+    void CreatePool(Pool& pool) const;
+
+  private:
+    std::vector<Pool> pools_ = {};
+    absl::flat_hash_map<EntityId, GeometryRange> ranges_ = {};
+};
+
+} // End namespace frame::opengl.
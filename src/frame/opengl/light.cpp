@@ -1,27 +1,44 @@
 #include "light.h"
 
+#include <array>
 #include <stdexcept>
+#include <string>
 
 namespace frame::opengl
 {
 
+namespace
+{
+
+constexpr std::size_t max_lights = 32;
+
+// Build the uniform names once (this is called per program).
+std::array<std::string, max_lights> MakeUniformNames(const std::string& name)
+{
+    std::array<std::string, max_lights> names;
+    for (std::size_t i = 0; i < max_lights; ++i)
+    {
+        names[i] = name + "[" + std::to_string(i) + "]";
+    }
+    return names;
+}
+
+} // namespace
+
 void LightManager::RegisterToProgram(Program& program) const
 {
-    if (lights_.size() > 32)
+    static const auto light_position_names =
+        MakeUniformNames("light_position");
+    static const auto light_color_names = MakeUniformNames("light_color");
+    if (lights_.size() > max_lights)
     {
         throw std::runtime_error("too many lights!");
     }
     program.Use();
-    int i = 0;
-    for (const auto& light : lights_)
+    for (std::size_t i = 0; i < lights_.size(); ++i)
     {
-        program.Uniform(
-            "light_position[" + std::to_string(i) + "]",
-            lights_[i]->GetVector());
-        program.Uniform(
-            "light_color[" + std::to_string(i) + "]",
-            lights_[i]->GetColorIntensity());
-        ++i;
+        program.Uniform(light_position_names[i], lights_[i]->GetVector());
+        program.Uniform(light_color_names[i], lights_[i]->GetColorIntensity());
     }
     program.Uniform("light_max", static_cast<int>(lights_.size()));
     program.UnUse();
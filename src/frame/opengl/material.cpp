@@ -1,5 +1,6 @@
 #include "material.h"
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 
@@ -9,7 +10,10 @@ namespace frame::opengl
 bool Material::AddTextureId(EntityId id, const std::string& name)
 {
     RemoveTextureId(id);
-    return id_name_map_.insert({id, name}).second;
+    if (!id_name_map_.insert({id, name}).second)
+        return false;
+    ids_.insert(std::lower_bound(ids_.begin(), ids_.end(), id), id);
+    return true;
 }
 
 bool Material::HasTextureId(EntityId id) const
@@ -23,6 +27,7 @@ bool Material::RemoveTextureId(EntityId id)
         return false;
     auto it = id_name_map_.find(id);
     id_name_map_.erase(it);
+    ids_.erase(std::lower_bound(ids_.begin(), ids_.end(), id));
     return true;
 }
 
@@ -82,14 +87,17 @@ void Material::DisableAll() const
     }
 }
 
-const std::vector<EntityId> Material::GetIds() const
+const std::vector<EntityId>& Material::GetIds() const
 {
-    std::vector<EntityId> vec;
-    for (const auto& p : id_name_map_)
-    {
-        vec.push_back(p.first);
-    }
-    return vec;
+    return ids_;
+}
+
+const std::string& Material::GetInnerName(EntityId id) const
+{
+    auto it = id_name_map_.find(id);
+    if (it == id_name_map_.end())
+        throw std::runtime_error("No texture id: " + std::to_string(id));
+    return it->second;
 }
 
 frame::EntityId Material::GetProgramId(
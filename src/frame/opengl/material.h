@@ -60,7 +60,13 @@ class Material : public MaterialInterface
      * @brief Get ids of a material.
      * @return Return the list of texture ids.
      */
-    const std::vector<EntityId> GetIds() const final;
+    const std::vector<EntityId>& GetIds() const final;
+    /**
+     * @brief Get the name of a texture in the shader.
+     * @param id: Texture id (has to be in the material).
+     * @return The associated name.
+     */
+    const std::string& GetInnerName(EntityId id) const override;
     /**
      * @brief Enable a texture to be used by the context.
      * @param id: Id of the texture to be enabled.
@@ -97,6 +103,9 @@ class Material : public MaterialInterface
 
   private:
     std::map<EntityId, std::string> id_name_map_ = {};
+    // Keys of the id name map (in the same order), kept to avoid building a
+    // vector every time GetIds is called.
+    std::vector<EntityId> ids_ = {};
     mutable std::array<EntityId, 32> id_array_ = {};
     mutable EntityId program_id_ = 0;
     std::string name_;
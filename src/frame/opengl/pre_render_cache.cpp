@@ -0,0 +1,123 @@
+#include "frame/opengl/pre_render_cache.h"
+
+#include <GL/glew.h>
+
+#include "frame/opengl/bind_interface.h"
+#include "frame/opengl/texture.h"
+#include "frame/opengl/texture_cube_map.h"
+
+namespace frame::opengl
+{
+
+namespace
+{
+
+// Copy the level 0 of a texture (every face of a cube map) to another one
+// of the same size and format.
+void CopyTexture(
+    const TextureInterface& source, const TextureInterface& destination)
+{
+    const auto size = source.GetSize();
+    const GLenum target =
+        source.IsCubeMap() ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+    glCopyImageSubData(
+        dynamic_cast<const BindInterface&>(source).GetId(),
+        target,
+        0,
+        0,
+        0,
+        0,
+        dynamic_cast<const BindInterface&>(destination).GetId(),
+        target,
+        0,
+        0,
+        0,
+        0,
+        static_cast<GLsizei>(size.x),
+        static_cast<GLsizei>(size.y),
+        source.IsCubeMap() ? 6 : 1);
+}
+
+// Check that two textures can be copied.
+bool IsSameLayout(const TextureInterface& left, const TextureInterface& right)
+{
+    return left.IsCubeMap() == right.IsCubeMap() &&
+           left.GetSize() == right.GetSize() &&
+           left.GetPixelElementSize() == right.GetPixelElementSize() &&
+           left.GetPixelStructure() == right.GetPixelStructure();
+}
+
+} // namespace
+
+std::uint64_t CombineContentHash(std::uint64_t seed, std::string_view data)
+{
+    // FNV-1a (stable across runs), seeded with the previous hash.
+    constexpr std::uint64_t offset_basis = 14695981039346656037ull;
+    constexpr std::uint64_t prime = 1099511628211ull;
+    std::uint64_t hash = offset_basis ^ seed;
+    for (const char c : data)
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= prime;
+    }
+    return hash ? hash : 1;
+}
+
+bool PreRenderCache::IsCopySupported()
+{
+    return GLEW_VERSION_4_3;
+}
+
+void PreRenderCache::Store(
+    std::uint64_t key, std::span<TextureInterface* const> outputs)
+{
+    if (!IsCopySupported())
+        return;
+    std::vector<std::unique_ptr<TextureInterface>> copies;
+    for (const auto* output : outputs)
+    {
+        TextureParameter texture_parameter = {};
+        texture_parameter.pixel_element_size.set_value(
+            output->GetPixelElementSize());
+        texture_parameter.pixel_structure.set_value(
+            output->GetPixelStructure());
+        texture_parameter.size = output->GetSize();
+        std::unique_ptr<TextureInterface> copy = nullptr;
+        if (output->IsCubeMap())
+        {
+            texture_parameter.map_type = TextureTypeEnum::CUBMAP;
+            copy = std::make_unique<TextureCubeMap>(texture_parameter);
+        }
+        else
+        {
+            copy = std::make_unique<Texture>(texture_parameter);
+        }
+        CopyTexture(*output, *copy);
+        copy->SetContentHash(output->GetContentHash());
+        copies.push_back(std::move(copy));
+    }
+    entries_[key] = std::move(copies);
+}
+
+bool PreRenderCache::Restore(
+    std::uint64_t key, std::span<TextureInterface* const> outputs) const
+{
+    if (!IsCopySupported())
+        return false;
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.size() != outputs.size())
+        return false;
+    for (std::size_t i = 0; i < outputs.size(); ++i)
+    {
+        if (!IsSameLayout(*it->second[i], *outputs[i]))
+            return false;
+    }
+    for (std::size_t i = 0; i < outputs.size(); ++i)
+    {
+        CopyTexture(*it->second[i], *outputs[i]);
+        outputs[i]->SetContentHash(it->second[i]->GetContentHash());
+    }
+    return true;
+}
+
+} // End namespace frame::opengl.
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "frame/texture_interface.h"
+
+namespace frame::opengl
+{
+
+/**
+ * @brief Combine a content hash with some data (the result is never 0 as 0
+ *        is an unknown content).
+ * @param seed: The content hash so far (0 to start).
+ * @param data: The data to add to the hash.
+ * @return The new content hash.
+ */
+std::uint64_t CombineContentHash(std::uint64_t seed, std::string_view data);
+
+/**
+ * @class PreRenderCache
+ * @brief Copies of the outputs of the pre render addressed by the content of
+ *        their inputs (the program, its parameters and the input textures),
+ *        kept on the GPU by the device across resize and level reload.
+ */
+class PreRenderCache
+{
+  public:
+    /**
+     * @brief Check if the copies can be made (glCopyImageSubData need
+     *        OpenGL 4.3).
+     * @return True if outputs can be stored and restored.
+     */
+    static bool IsCopySupported();
+    /**
+     * @brief Copy the outputs of a pre render in the cache (replace the
+     *        previous copies of the key).
+     * @param key: Content hash of the pre render.
+     * @param outputs: The output textures.
+     */
+    void Store(std::uint64_t key, std::span<TextureInterface* const> outputs);
+    /**
+     * @brief Copy the outputs of a pre render from the cache, the textures
+     *        must have the same size and format as the stored ones.
+     * @param key: Content hash of the pre render.
+     * @param outputs: The output textures.
+     * @return True if the key was found and the outputs restored.
+     */
+    bool Restore(
+        std::uint64_t key, std::span<TextureInterface* const> outputs) const;
+    //! @brief Remove all the copies.
+    void Clear()
+    {
+        entries_.clear();
+    }
+    //! @brief Get the number of pre render stored.
+    std::size_t GetEntryCount() const
+    {
+        return entries_.size();
+    }
+
+  private:
+    absl::flat_hash_map<
+        std::uint64_t,
+        std::vector<std::unique_ptr<TextureInterface>>>
+        entries_ = {};
+};
+
+} // End namespace frame::opengl.
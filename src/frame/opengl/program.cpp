@@ -3,12 +3,17 @@
 #include <absl/strings/match.h>
 #include <absl/strings/string_view.h>
 
+#include <array>
+#include <cstdlib>
 #include <regex>
+#include <sstream>
 #include <stdexcept>
 #include <string_view>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "frame/logger.h"
+#include "frame/opengl/pre_render_cache.h"
+#include "frame/opengl/state_cache.h"
 
 namespace frame::opengl
 {
@@ -21,7 +26,7 @@ Program::Program(const std::string& name)
 
 Program::~Program()
 {
-    glDeleteProgram(program_id_);
+    StateCache::GetInstance().DeleteProgram(program_id_);
 }
 
 void Program::AddShader(const Shader& shader)
@@ -54,16 +59,18 @@ void Program::LinkShader()
         glDetachShader(program_id_, id);
     }
     CreateUniformList();
+    instanced_ = glGetAttribLocation(program_id_, "instance_model") ==
+                 static_cast<GLint>(instance_model_location);
 }
 
 void Program::Use() const
 {
-    glUseProgram(program_id_);
+    StateCache::GetInstance().UseProgram(program_id_);
 }
 
 void Program::Use(const UniformInterface& uniform_interface) const
 {
-    glUseProgram(program_id_);
+    StateCache::GetInstance().UseProgram(program_id_);
     if (HasUniform("projection"))
     {
         Uniform("projection", uniform_interface.GetProjection());
@@ -451,7 +458,8 @@ void Program::SetSceneRoot(EntityId scene_root)
 
 void Program::UnUse() const
 {
-    glUseProgram(0);
+    // Lazy, the program stay in use until an other one is used.
+    StateCache::GetInstance().UnuseProgram();
 }
 
 void Program::CreateUniformList() const
@@ -488,16 +496,137 @@ std::vector<std::string> Program::GetUniformNameList() const
 
 bool Program::HasUniform(const std::string& name) const
 {
-    std::vector<std::string> uniform_list = GetUniformNameList();
-    if (!std::count(uniform_list.begin(), uniform_list.end(), name))
-    {
-        // To solve the fact that the uniform could end with a `[0]`.
-        return std::count(
-            uniform_list.begin(), uniform_list.end(), name + "[0]");
+    // This is called per uniform per draw so no copy of the names.
+    return std::any_of(
+        uniform_list_.cbegin(),
+        uniform_list_.cend(),
+        [&name](const UniformValue& uniform) {
+            const std::string_view uniform_name = uniform.name;
+            if (uniform_name == name)
+                return true;
+            // To solve the fact that the uniform could end with a `[0]`.
+            return uniform_name.size() == name.size() + 3 &&
+                   uniform_name.starts_with(name) &&
+                   uniform_name.ends_with("[0]");
+        });
+}
+
+proto::Uniform Program::GetUniformValue(const proto::Uniform& parameter) const
+{
+    proto::Uniform uniform = parameter;
+    // Large enough for a mat4, the elements of an array have their own
+    // location.
+    std::array<float, 16> values = {};
+    auto read_values = [this, &values](GLint location) {
+        values.fill(0.0f);
+        glGetUniformfv(program_id_, location, values.data());
+    };
+    auto element_location = [this, &parameter](int index) {
+        return glGetUniformLocation(
+            program_id_,
+            fmt::format("{}[{}]", parameter.name(), index).c_str());
+    };
+    switch (parameter.value_oneof_case())
+    {
+    case proto::Uniform::kUniformInt: {
+        GLint value = 0;
+        glGetUniformiv(
+            program_id_, GetMemoizeUniformLocation(parameter.name()), &value);
+        uniform.set_uniform_int(value);
+        break;
+    }
+    case proto::Uniform::kUniformFloat:
+        read_values(GetMemoizeUniformLocation(parameter.name()));
+        uniform.set_uniform_float(values[0]);
+        break;
+    case proto::Uniform::kUniformVec2: {
+        read_values(GetMemoizeUniformLocation(parameter.name()));
+        auto* vec2 = uniform.mutable_uniform_vec2();
+        vec2->set_x(values[0]);
+        vec2->set_y(values[1]);
+        break;
+    }
+    case proto::Uniform::kUniformVec3: {
+        read_values(GetMemoizeUniformLocation(parameter.name()));
+        auto* vec3 = uniform.mutable_uniform_vec3();
+        vec3->set_x(values[0]);
+        vec3->set_y(values[1]);
+        vec3->set_z(values[2]);
+        break;
+    }
+    case proto::Uniform::kUniformVec4: {
+        read_values(GetMemoizeUniformLocation(parameter.name()));
+        auto* vec4 = uniform.mutable_uniform_vec4();
+        vec4->set_x(values[0]);
+        vec4->set_y(values[1]);
+        vec4->set_z(values[2]);
+        vec4->set_w(values[3]);
+        break;
+    }
+    case proto::Uniform::kUniformMat4: {
+        read_values(GetMemoizeUniformLocation(parameter.name()));
+        // Column major as in ParseUniform.
+        auto* mat4 = uniform.mutable_uniform_mat4();
+        const auto* descriptor = mat4->GetDescriptor();
+        const auto* reflection = mat4->GetReflection();
+        for (int i = 0; i < 16; ++i)
+            reflection->SetFloat(mat4, descriptor->field(i), values[i]);
+        break;
+    }
+    case proto::Uniform::kUniformVec2S: {
+        auto* vec2s = uniform.mutable_uniform_vec2s();
+        for (int i = 0; i < vec2s->values_size(); ++i)
+        {
+            read_values(element_location(i));
+            vec2s->mutable_values(i)->set_x(values[0]);
+            vec2s->mutable_values(i)->set_y(values[1]);
+        }
+        break;
+    }
+    case proto::Uniform::kUniformVec3S: {
+        auto* vec3s = uniform.mutable_uniform_vec3s();
+        for (int i = 0; i < vec3s->values_size(); ++i)
+        {
+            read_values(element_location(i));
+            vec3s->mutable_values(i)->set_x(values[0]);
+            vec3s->mutable_values(i)->set_y(values[1]);
+            vec3s->mutable_values(i)->set_z(values[2]);
+        }
+        break;
+    }
+    case proto::Uniform::kUniformVec4S: {
+        auto* vec4s = uniform.mutable_uniform_vec4s();
+        for (int i = 0; i < vec4s->values_size(); ++i)
+        {
+            read_values(element_location(i));
+            vec4s->mutable_values(i)->set_x(values[0]);
+            vec4s->mutable_values(i)->set_y(values[1]);
+            vec4s->mutable_values(i)->set_z(values[2]);
+            vec4s->mutable_values(i)->set_w(values[3]);
+        }
+        break;
     }
+    default:
+        break;
+    }
+    return uniform;
+}
+
+bool Program::BindUniformBlock(
+    const std::string& name, std::uint32_t binding) const
+{
+    const GLuint index = glGetUniformBlockIndex(program_id_, name.c_str());
+    if (index == GL_INVALID_INDEX)
+        return false;
+    glUniformBlockBinding(program_id_, index, binding);
     return true;
 }
 
+bool Program::IsMultiViewSupported()
+{
+    return GLEW_ARB_viewport_array && GLEW_ARB_shader_viewport_layer_array;
+}
+
 std::string Program::GetTemporarySceneRoot() const
 {
     return temporary_scene_root_;
@@ -535,10 +664,111 @@ std::unique_ptr<ProgramInterface> CreateProgram(
     program->AddShader(vertex);
     program->AddShader(fragment);
     program->LinkShader();
+    program->SetVertexSource(vertex_source);
+    program->SetPixelSource(pixel_source);
+    program->SetContentHash(CombineContentHash(
+        CombineContentHash(0, vertex_source), pixel_source));
 #ifdef _DEBUG
     logger->info("with pointer := {}", static_cast<void*>(program.get()));
 #endif // _DEBUG
     return std::move(program);
 }
 
+std::unique_ptr<ProgramInterface> CreateDepthOnlyProgram(const Program& program)
+{
+    const auto& vertex_source = program.GetVertexSource();
+    if (vertex_source.empty())
+    {
+        throw std::runtime_error(fmt::format(
+            "No vertex source for the depth only variant of [{}]?",
+            program.GetName()));
+    }
+    // The fragment shader use the same version as the vertex shader.
+    std::string version = "#version 330 core";
+    const auto version_begin = vertex_source.find("#version");
+    if (version_begin != std::string::npos)
+    {
+        version = vertex_source.substr(
+            version_begin,
+            vertex_source.find('\n', version_begin) - version_begin);
+    }
+    std::istringstream vertex_iss(vertex_source);
+    std::istringstream fragment_iss(version + "\n\nvoid main()\n{\n}\n");
+    return CreateProgram(
+        program.GetName() + "DepthOnly", vertex_iss, fragment_iss);
+}
+
+std::unique_ptr<ProgramInterface> CreateMultiViewProgram(const Program& program)
+{
+    std::string vertex_source = program.GetVertexSource();
+    if (vertex_source.empty() || program.GetPixelSource().empty())
+    {
+        throw std::runtime_error(fmt::format(
+            "No sources for the multi view variant of [{}]?",
+            program.GetName()));
+    }
+    const std::regex projection_regex(R"(uniform\s+mat4\s+projection\s*;)");
+    const std::regex view_regex(R"(uniform\s+mat4\s+view\s*;)");
+    const std::regex main_regex(R"(void\s+main\s*\(\s*(void)?\s*\))");
+    if (!std::regex_search(vertex_source, projection_regex) ||
+        !std::regex_search(vertex_source, view_regex) ||
+        !std::regex_search(vertex_source, main_regex))
+    {
+        throw std::runtime_error(fmt::format(
+            "No projection, view or main in the vertex shader of [{}]?",
+            program.GetName()));
+    }
+    vertex_source = std::regex_replace(vertex_source, projection_regex, "");
+    vertex_source = std::regex_replace(vertex_source, view_regex, "");
+    vertex_source =
+        std::regex_replace(vertex_source, main_regex, "void frame_view_main()");
+    // The extension need GLSL 4.10, the declarations go after the version.
+    std::size_t header_begin = 0;
+    constexpr std::string_view version_directive = "#version";
+    const auto version_begin = vertex_source.find(version_directive);
+    if (version_begin != std::string::npos)
+    {
+        const auto version_end = vertex_source.find('\n', version_begin);
+        const int version = std::atoi(
+            vertex_source.c_str() + version_begin + version_directive.size());
+        if (version < 410)
+        {
+            vertex_source.replace(
+                version_begin,
+                version_end - version_begin,
+                "#version 410 core");
+        }
+        header_begin = vertex_source.find('\n', version_begin) + 1;
+    }
+    vertex_source.insert(
+        header_begin,
+        fmt::format(
+            "#extension GL_ARB_shader_viewport_layer_array : require\n"
+            "\n"
+            "// Views of the multi view draw (see CreateMultiViewProgram).\n"
+            "layout(std140) uniform FrameViews\n"
+            "{{\n"
+            "\tmat4 frame_view_projections[{0}];\n"
+            "\tmat4 frame_view_views[{0}];\n"
+            "}};\n"
+            "uniform int frame_view_count;\n"
+            "#define frame_view_index (gl_InstanceID % frame_view_count)\n"
+            "#define projection frame_view_projections[frame_view_index]\n"
+            "#define view frame_view_views[frame_view_index]\n",
+            Program::max_view_count));
+    vertex_source +=
+        "\nvoid main()\n"
+        "{\n"
+        "\tframe_view_main();\n"
+        "\tgl_ViewportIndex = frame_view_index;\n"
+        "}\n";
+    std::istringstream vertex_iss(vertex_source);
+    std::istringstream fragment_iss(program.GetPixelSource());
+    auto multi_view_program = CreateProgram(
+        program.GetName() + "MultiView", vertex_iss, fragment_iss);
+    dynamic_cast<Program&>(*multi_view_program)
+        .BindUniformBlock("FrameViews", Program::view_block_binding);
+    return multi_view_program;
+}
+
 } // End namespace frame::opengl.
@@ -21,6 +21,16 @@ namespace frame::opengl
  */
 class Program : public ProgramInterface
 {
+  public:
+    //! @brief Location of the per instance model matrix (a mat4 use this
+    //!        location and the 3 next ones).
+    static constexpr std::uint32_t instance_model_location = 8;
+    //! @brief Maximum number of views drawn at once by a multi view program
+    //!        (the minimum number of viewports of OpenGL).
+    static constexpr std::uint32_t max_view_count = 16;
+    //! @brief Binding point of the uniform block of the views.
+    static constexpr std::uint32_t view_block_binding = 0;
+
   public:
     //! @brief Constructor create the program.
     Program(const std::string& name);
@@ -121,7 +131,7 @@ class Program : public ProgramInterface
      * @brief Use the program, a little bit like bind.
      */
     void Use() const override;
-    //! @brief Stop using the program, a little bit like unbind.
+    //! @brief Stop using the program (lazy see StateCache).
     void UnUse() const override;
     /**
      * @brief Create a uniform from a string and a bool.
@@ -219,6 +229,119 @@ class Program : public ProgramInterface
      * @return True if present false otherwise.
      */
     bool HasUniform(const std::string& name) const override;
+    /**
+     * @brief Read back the current value of a uniform.
+     * @param parameter: Name and type (and size for the arrays) of the
+     *        uniform, enum and plugin uniforms are returned as is.
+     * @return The uniform with the value currently in the program.
+     */
+    proto::Uniform GetUniformValue(const proto::Uniform& parameter) const;
+    /**
+     * @brief Check if the program take a per instance model matrix
+     *        (`layout (location = 8) in mat4 instance_model;`), the model
+     *        of an instance is then model * instance_model.
+     * @return True if meshes can be drawn instanced with this program.
+     */
+    bool IsInstanced() const
+    {
+        return instanced_;
+    }
+    /**
+     * @brief Get the hash of the sources and the parameters of the program
+     *        (used to address the results of the pre render).
+     * @return The content hash (0 if unknown).
+     */
+    std::uint64_t GetContentHash() const
+    {
+        return content_hash_;
+    }
+    /**
+     * @brief Set the hash of the sources and the parameters of the program.
+     * @param content_hash: The content hash.
+     */
+    void SetContentHash(std::uint64_t content_hash)
+    {
+        content_hash_ = content_hash;
+    }
+    //! @brief Get the source of the vertex shader (empty if unknown).
+    const std::string& GetVertexSource() const
+    {
+        return vertex_source_;
+    }
+    /**
+     * @brief Set the source of the vertex shader (kept to generate the
+     *        variants of the program).
+     * @param vertex_source: Source of the vertex shader.
+     */
+    void SetVertexSource(const std::string& vertex_source)
+    {
+        vertex_source_ = vertex_source;
+    }
+    //! @brief Get the source of the fragment shader (empty if unknown).
+    const std::string& GetPixelSource() const
+    {
+        return pixel_source_;
+    }
+    /**
+     * @brief Set the source of the fragment shader (kept to generate the
+     *        variants of the program).
+     * @param pixel_source: Source of the fragment shader.
+     */
+    void SetPixelSource(const std::string& pixel_source)
+    {
+        pixel_source_ = pixel_source;
+    }
+    /**
+     * @brief Get the depth only variant of the program, used for the depth
+     *        prepass of the meshes drawn with this program.
+     * @return The depth only program (null if the program has no prepass).
+     */
+    ProgramInterface* GetDepthOnlyProgram() const
+    {
+        return depth_only_program_.get();
+    }
+    /**
+     * @brief Set the depth only variant of the program (enable the depth
+     *        prepass), see CreateDepthOnlyProgram.
+     * @param depth_only_program: The depth only program.
+     */
+    void SetDepthOnlyProgram(
+        std::unique_ptr<ProgramInterface> depth_only_program)
+    {
+        depth_only_program_ = std::move(depth_only_program);
+    }
+    /**
+     * @brief Get the multi view variant of the program, used to draw the
+     *        meshes of this program once for all the views.
+     * @return The multi view program (null if the program has none).
+     */
+    ProgramInterface* GetMultiViewProgram() const
+    {
+        return multi_view_program_.get();
+    }
+    /**
+     * @brief Set the multi view variant of the program, see
+     *        CreateMultiViewProgram.
+     * @param multi_view_program: The multi view program.
+     */
+    void SetMultiViewProgram(
+        std::unique_ptr<ProgramInterface> multi_view_program)
+    {
+        multi_view_program_ = std::move(multi_view_program);
+    }
+    /**
+     * @brief Bind a uniform block of the program to a binding point.
+     * @param name: Name of the uniform block.
+     * @param binding: Binding point (of glBindBufferBase).
+     * @return False if the program has no such block.
+     */
+    bool BindUniformBlock(const std::string& name, std::uint32_t binding) const;
+    /**
+     * @brief Check if multi view programs can be made (a viewport per view
+     *        selected from the vertex shader).
+     * @return True if GL_ARB_shader_viewport_layer_array is supported.
+     */
+    static bool IsMultiViewSupported();
 
   protected:
     /**
@@ -266,6 +389,12 @@ class Program : public ProgramInterface
     std::string temporary_scene_root_;
     std::string name_;
     int program_id_ = 0;
+    bool instanced_ = false;
+    std::string vertex_source_;
+    std::string pixel_source_;
+    std::uint64_t content_hash_ = 0;
+    std::unique_ptr<ProgramInterface> depth_only_program_ = nullptr;
+    std::unique_ptr<ProgramInterface> multi_view_program_ = nullptr;
     EntityId scene_root_ = 0;
     std::vector<EntityId> input_texture_ids_ = {};
     std::vector<EntityId> output_texture_ids_ = {};
@@ -281,4 +410,27 @@ std::unique_ptr<frame::ProgramInterface> CreateProgram(
     std::istream& vertex_shader_code,
     std::istream& pixel_shader_code);
 
+/**
+ * @brief Create the depth only variant of a program, the vertex shader is
+ *        the same (so the depth is exactly the same and can be tested with
+ *        GL_EQUAL) and the fragment shader is empty.
+ * @param program: The program (it must have its vertex source).
+ * @return The depth only program.
+ */
+std::unique_ptr<frame::ProgramInterface> CreateDepthOnlyProgram(
+    const Program& program);
+
+/**
+ * @brief Create the multi view variant of a program, the meshes are drawn
+ *        instanced once per view. The projection and view uniforms of the
+ *        vertex shader are replaced by the matrices of the view (instance
+ *        modulo frame_view_count) in the FrameViews uniform block and the
+ *        view select its viewport. The vertex shader should not use
+ *        gl_InstanceID itself.
+ * @param program: The program (it must have its sources).
+ * @return The multi view program.
+ */
+std::unique_ptr<frame::ProgramInterface> CreateMultiViewProgram(
+    const Program& program);
+
 } // End namespace frame::opengl.
@@ -0,0 +1,164 @@
+#include "frame/opengl/readback_queue.h"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "frame/json/parse_pixel.h"
+#include "frame/opengl/pixel.h"
+
+namespace frame::opengl
+{
+
+namespace
+{
+
+// Size of an element as read by glGetTexImage.
+std::size_t GetElementByteSize(GLenum type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_BYTE:
+        return sizeof(std::uint8_t);
+    case GL_UNSIGNED_SHORT:
+        return sizeof(std::uint16_t);
+    case GL_UNSIGNED_INT:
+        return sizeof(std::uint32_t);
+    case GL_FLOAT:
+        return sizeof(float);
+    default:
+        throw std::runtime_error(
+            "Unknown element type : " + std::to_string(type));
+    }
+}
+
+} // End anonymous namespace.
+
+ReadbackQueue::ReadbackQueue(std::size_t slot_count /* = 3*/)
+{
+    if (slot_count == 0)
+        throw std::runtime_error("Readback queue need at least a slot.");
+    slots_.resize(slot_count);
+}
+
+ReadbackQueue::~ReadbackQueue()
+{
+    for (auto& slot : slots_)
+    {
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+    }
+}
+
+void ReadbackQueue::ReadTexture(
+    const Texture& texture, ReadbackCallback callback)
+{
+    // All the slots are in flight, this is the only place that wait.
+    if (pending_count_ == slots_.size())
+        CompleteOldest(true);
+    auto& slot = slots_[(oldest_slot_ + pending_count_) % slots_.size()];
+    proto::PixelStructure pixel_structure{};
+    pixel_structure.set_value(texture.GetPixelStructure());
+    proto::PixelElementSize pixel_element_size{};
+    pixel_element_size.set_value(texture.GetPixelElementSize());
+    const auto format = ConvertToGLType(pixel_structure);
+    const auto type = ConvertToGLType(pixel_element_size);
+    const auto size = texture.GetSize();
+    slot.byte_size = static_cast<std::size_t>(size.x) *
+                     static_cast<std::size_t>(size.y) *
+                     proto::GetComponentCount(texture.GetPixelStructure()) *
+                     GetElementByteSize(type);
+    if (!slot.buffer)
+    {
+        slot.buffer = std::make_unique<Buffer>(
+            BufferTypeEnum::PIXEL_PACK_BUFFER, BufferUsageEnum::STREAM_READ);
+        slot.buffer->SetName("ReadbackBuffer");
+    }
+    if (slot.capacity < slot.byte_size)
+    {
+        slot.buffer->Copy(slot.byte_size);
+        slot.capacity = slot.byte_size;
+    }
+    // Copy to the buffer (the pointer is an offset in the buffer).
+    texture.Bind();
+    slot.buffer->Bind();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTexImage(GL_TEXTURE_2D, 0, format, type, nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    slot.buffer->UnBind();
+    texture.UnBind();
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.callback = std::move(callback);
+    ++pending_count_;
+}
+
+std::future<std::vector<std::uint8_t>> ReadbackQueue::ReadTexture(
+    const Texture& texture)
+{
+    // Shared as the callback has to be copyable.
+    auto promise = std::make_shared<std::promise<std::vector<std::uint8_t>>>();
+    auto future = promise->get_future();
+    ReadTexture(texture, [promise](std::span<const std::uint8_t> pixels) {
+        promise->set_value({pixels.begin(), pixels.end()});
+    });
+    return future;
+}
+
+std::uint32_t ReadbackQueue::Poll()
+{
+    std::uint32_t completed = 0;
+    while (pending_count_ && CompleteOldest(false))
+        ++completed;
+    return completed;
+}
+
+void ReadbackQueue::Flush()
+{
+    while (pending_count_)
+        CompleteOldest(true);
+}
+
+bool ReadbackQueue::CompleteOldest(bool wait)
+{
+    auto& slot = slots_[oldest_slot_];
+    const GLuint64 timeout =
+        wait ? std::numeric_limits<GLuint64>::max() : GLuint64{0};
+    // Flush so the fence is signaled even if nothing else is submitted.
+    const auto status =
+        glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    if (status == GL_TIMEOUT_EXPIRED)
+        return false;
+    // The slot is released in any case (a failed read is dropped so that it
+    // is not waited on again).
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    oldest_slot_ = (oldest_slot_ + 1) % slots_.size();
+    --pending_count_;
+    auto callback = std::move(slot.callback);
+    slot.callback = nullptr;
+    if (status == GL_WAIT_FAILED)
+        throw std::runtime_error("Readback fence wait failed.");
+    slot.buffer->Bind();
+    const auto* data = static_cast<const std::uint8_t*>(glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, slot.byte_size, GL_MAP_READ_BIT));
+    if (!data)
+    {
+        slot.buffer->UnBind();
+        throw std::runtime_error("Couldn't map the readback buffer.");
+    }
+    try
+    {
+        callback(std::span<const std::uint8_t>(data, slot.byte_size));
+    }
+    catch (...)
+    {
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        slot.buffer->UnBind();
+        throw;
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    slot.buffer->UnBind();
+    return true;
+}
+
+} // End namespace frame::opengl.
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "frame/opengl/buffer.h"
+#include "frame/opengl/texture.h"
+
+namespace frame::opengl
+{
+
+//! @brief Called with the pixels read back (only valid during the call).
+using ReadbackCallback = std::function<void(std::span<const std::uint8_t>)>;
+
+/**
+ * @class ReadbackQueue
+ * @brief Read textures back from the GPU without waiting for it, the pixels
+ *        are copied to a ring of pixel buffer objects and are available
+ *        once the fence that follow the copy is signaled (usually a frame or
+ *        two later).
+ *
+ * The pixels are tightly packed (no row alignment), in the format of the
+ * texture (half float textures are read as float). The callbacks are called
+ * by Poll (on the thread of the OpenGL context), in the order of the reads.
+ */
+class ReadbackQueue
+{
+  public:
+    /**
+     * @brief Constructor (the buffers are created at the first read).
+     * @param slot_count: Number of reads in flight, a read when they are
+     *        all in flight wait for the oldest one.
+     */
+    ReadbackQueue(std::size_t slot_count = 3);
+    //! @brief Destructor the pending reads are dropped (broken promises).
+    ~ReadbackQueue();
+
+  public:
+    /**
+     * @brief Start the read back of a texture (2D).
+     * @param texture: The texture to be read.
+     * @param callback: Called by a later poll with the pixels.
+     */
+    void ReadTexture(const Texture& texture, ReadbackCallback callback);
+    /**
+     * @brief Start the read back of a texture (2D).
+     * @param texture: The texture to be read.
+     * @return A future set by a later poll with the pixels.
+     */
+    std::future<std::vector<std::uint8_t>> ReadTexture(const Texture& texture);
+    /**
+     * @brief Complete the reads whose copies are done (don't wait), should
+     *        be called once per frame.
+     * @return Number of reads completed.
+     */
+    std::uint32_t Poll();
+    //! @brief Wait for the GPU and complete all the pending reads.
+    void Flush();
+    //! @brief Get the number of reads in flight.
+    std::size_t GetPendingCount() const
+    {
+        return pending_count_;
+    }
+
+  protected:
+    /**
+     * @class Slot
+     * @brief A pixel buffer object and the read it hold.
+     */
+    struct Slot
+    {
+        std::unique_ptr<Buffer> buffer = nullptr;
+        std::size_t capacity = 0;
+        std::size_t byte_size = 0;
+        GLsync fence = nullptr;
+        ReadbackCallback callback = nullptr;
+    };
+    /**
+     * @brief Complete the oldest read.
+     * @param wait: Wait for the copy to be done.
+     * @return True if the read was completed.
+     */
+    bool CompleteOldest(bool wait);
+
+  private:
+    std::vector<Slot> slots_ = {};
+    // Oldest read in flight (the reads are in the ring order).
+    std::size_t oldest_slot_ = 0;
+    std::size_t pending_count_ = 0;
+};
+
+} // End namespace frame::opengl.
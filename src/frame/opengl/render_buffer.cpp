@@ -4,6 +4,7 @@
 
 #include <stdexcept>
 
+#include "frame/opengl/state_cache.h"
 #include "pixel.h"
 
 namespace frame::opengl
@@ -16,7 +17,7 @@ RenderBuffer::RenderBuffer()
 
 RenderBuffer::~RenderBuffer()
 {
-    glDeleteRenderbuffers(1, &render_id_);
+    StateCache::GetInstance().DeleteRenderbuffer(render_id_);
 }
 
 void RenderBuffer::Bind(const unsigned int slot /*= 0*/) const
@@ -24,14 +25,14 @@ void RenderBuffer::Bind(const unsigned int slot /*= 0*/) const
     assert(slot == 0);
     if (locked_bind_)
         return;
-    glBindRenderbuffer(GL_RENDERBUFFER, render_id_);
+    StateCache::GetInstance().BindRenderbuffer(render_id_);
 }
 
 void RenderBuffer::UnBind() const
 {
     if (locked_bind_)
         return;
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    StateCache::GetInstance().BindRenderbuffer(0);
 }
 
 void RenderBuffer::CreateStorage(glm::uvec2 size) const
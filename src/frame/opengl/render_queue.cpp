@@ -0,0 +1,400 @@
+#include "frame/opengl/render_queue.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <algorithm>
+#include <cassert>
+#include <fmt/core.h>
+#include <limits>
+#include <stdexcept>
+
+#include "frame/logger.h"
+#include "frame/node_static_mesh.h"
+#include "frame/opengl/buffer.h"
+#include "frame/opengl/program.h"
+#include "frame/opengl/static_mesh.h"
+#include "frame/opengl/texture.h"
+#include "frame/opengl/texture_cube_map.h"
+
+namespace frame::opengl
+{
+
+namespace
+{
+
+// Get a dense index (in order of appearance) for an id, this is what goes
+// in the sort key as entity ids are too large.
+std::uint16_t GetDenseIndex(
+    absl::flat_hash_map<EntityId, std::uint16_t>& index_map, EntityId id)
+{
+    auto it = index_map.find(id);
+    if (it != index_map.end())
+        return it->second;
+    if (index_map.size() > std::numeric_limits<std::uint16_t>::max())
+    {
+        throw std::runtime_error(
+            fmt::format("Too many entities in render queue ({}).", id));
+    }
+    auto index = static_cast<std::uint16_t>(index_map.size());
+    index_map.emplace(id, index);
+    return index;
+}
+
+GLenum GetPrimitive(proto::SceneStaticMesh::RenderPrimitiveEnum primitive)
+{
+    switch (primitive)
+    {
+    case proto::SceneStaticMesh::TRIANGLE:
+        return GL_TRIANGLES;
+    case proto::SceneStaticMesh::POINT:
+        return GL_POINTS;
+    case proto::SceneStaticMesh::LINE:
+        return GL_LINES;
+    default:
+        throw std::runtime_error(fmt::format(
+            "Couldn't draw primitive {}",
+            proto::SceneStaticMesh_RenderPrimitiveEnum_Name(primitive)));
+    }
+}
+
+GLbitfield GetClearBits(std::uint32_t clean_buffer)
+{
+    GLbitfield bit_field = 0;
+    if (clean_buffer & proto::CleanBuffer::CLEAR_COLOR)
+        bit_field |= GL_COLOR_BUFFER_BIT;
+    if (clean_buffer & proto::CleanBuffer::CLEAR_DEPTH)
+        bit_field |= GL_DEPTH_BUFFER_BIT;
+    return bit_field;
+}
+
+// Check if a packet can be drawn in the same instanced call as the first
+// one, same key (so same pass, program, material and mesh) and the program
+// take a per instance model matrix.
+bool IsSameInstance(const DrawPacket& first, const DrawPacket& packet)
+{
+    return !first.clear_bits && first.per_instance_model &&
+           first.sort_key == packet.sort_key &&
+           first.frustum_culling == packet.frustum_culling;
+}
+
+// Add a use of a program (with a material) to the render graph, the inputs
+// are the textures of the material and the outputs the one of the program.
+void AddRenderPass(
+    LevelInterface& level,
+    RenderGraph& render_graph,
+    EntityId program_id,
+    const MaterialInterface& material)
+{
+    auto& program = level.GetProgramFromId(program_id);
+    std::vector<EntityId> input_ids;
+    for (const auto id : material.GetIds())
+    {
+        if (level.GetEnumTypeFromId(id) == EntityTypeEnum::TEXTURE)
+            input_ids.push_back(id);
+    }
+    const auto output_ids = program.GetOutputTextureIds();
+    for (const auto id : input_ids)
+    {
+        render_graph.SetTextureName(id, level.GetTextureFromId(id).GetName());
+    }
+    for (const auto id : output_ids)
+    {
+        render_graph.SetTextureName(id, level.GetTextureFromId(id).GetName());
+    }
+    render_graph.AddPass(program_id, program.GetName(), input_ids, output_ids);
+}
+
+} // namespace
+
+bool IsFrustumCullable(
+    const NodeStaticMesh& node,
+    const StaticMeshInterface& static_mesh,
+    const ProgramInterface& program)
+{
+    return node.IsFrustumCulling() &&
+           !static_mesh.GetBoundingBox().IsEmpty() &&
+           program.HasUniform("projection") && program.HasUniform("view") &&
+           program.HasUniform("model");
+}
+
+void RenderQueue::Compile(
+    LevelInterface& level, const SceneState* scene_state /* = nullptr*/)
+{
+    packets_.clear();
+    pre_render_nodes_.clear();
+    render_targets_.clear();
+    texture_bindings_.clear();
+    instance_node_ids_.clear();
+    render_graph_.Clear();
+    absl::flat_hash_map<EntityId, std::uint16_t> program_index_map;
+    absl::flat_hash_map<EntityId, std::uint16_t> material_index_map;
+    absl::flat_hash_map<EntityId, std::uint16_t> mesh_index_map;
+    // Material id -> (first binding, binding count).
+    absl::flat_hash_map<EntityId, std::pair<std::uint32_t, std::uint32_t>>
+        material_binding_map;
+    // Program id -> render target index.
+    absl::flat_hash_map<EntityId, std::uint32_t> render_target_map;
+    // Textures read and written in the current pass, a pass is split when a
+    // draw read a texture written in the pass (or the other way around) so
+    // that sorting never reorder dependent draws.
+    absl::flat_hash_set<EntityId> pass_read_set;
+    absl::flat_hash_set<EntityId> pass_write_set;
+    std::uint16_t pass = 0;
+    auto next_pass = [&pass, &pass_read_set, &pass_write_set] {
+        if (pass == std::numeric_limits<std::uint16_t>::max())
+            throw std::runtime_error("Too many passes in render queue.");
+        ++pass;
+        pass_read_set.clear();
+        pass_write_set.clear();
+    };
+
+    for (const auto& [node_id, material_render] :
+         level.GetStaticMeshMaterialIds())
+    {
+        const auto [material_id, render_time_enum] = material_render;
+        if (render_time_enum == proto::SceneStaticMesh::PRE_RENDER)
+        {
+            pre_render_nodes_.emplace_back(node_id, material_id);
+            if (material_id != NullId)
+            {
+                auto& material = level.GetMaterialFromId(material_id);
+                AddRenderPass(
+                    level,
+                    render_graph_,
+                    material.GetProgramId(&level),
+                    material);
+            }
+            continue;
+        }
+        if (node_id == NullId)
+            continue;
+        auto& node = level.GetSceneNodeFromId(node_id);
+        auto& node_static_mesh = dynamic_cast<NodeStaticMesh&>(node);
+        auto mesh_id = node.GetLocalMesh();
+        // In case no mesh then this is a clear event (in its own pass).
+        if (!mesh_id)
+        {
+            GLbitfield clear_bits =
+                GetClearBits(node_static_mesh.GetCleanBuffer());
+            if (!clear_bits)
+                continue;
+            next_pass();
+            DrawPacket packet{};
+            packet.sort_key = MakeSortKey(pass, 0, 0, 0);
+            packet.node_id = node_id;
+            packet.clear_bits = clear_bits;
+            packets_.push_back(packet);
+            next_pass();
+            continue;
+        }
+        if (material_id == NullId)
+        {
+            throw std::runtime_error("No material?");
+        }
+        auto& material = level.GetMaterialFromId(material_id);
+        auto program_id = material.GetProgramId(&level);
+        auto& program = level.GetProgramFromId(program_id);
+        const auto output_ids = program.GetOutputTextureIds();
+        assert(output_ids.size());
+        const auto material_ids = material.GetIds();
+        AddRenderPass(level, render_graph_, program_id, material);
+        // Check for read after write or write after read in this pass.
+        bool hazard = false;
+        for (const auto id : material_ids)
+        {
+            if (pass_write_set.contains(id))
+                hazard = true;
+        }
+        for (const auto id : output_ids)
+        {
+            if (pass_read_set.contains(id))
+                hazard = true;
+        }
+        if (hazard)
+            next_pass();
+        pass_read_set.insert(material_ids.begin(), material_ids.end());
+        pass_write_set.insert(output_ids.begin(), output_ids.end());
+
+        DrawPacket packet{};
+        packet.node_id = node_id;
+        packet.program_id = program_id;
+        packet.program = &program;
+        packet.material = &material;
+        const auto* gl_program = dynamic_cast<const Program*>(&program);
+        packet.per_instance_model = gl_program && gl_program->IsInstanced();
+        packet.depth_only_program =
+            gl_program ? gl_program->GetDepthOnlyProgram() : nullptr;
+        packet.multi_view_program =
+            gl_program ? gl_program->GetMultiViewProgram() : nullptr;
+
+        // Resolve the output textures once per program.
+        auto render_target_it = render_target_map.find(program_id);
+        if (render_target_it == render_target_map.end())
+        {
+            std::vector<OutputTexture> output_textures;
+            for (const auto texture_id : output_ids)
+            {
+                auto& texture = level.GetTextureFromId(texture_id);
+                if (texture.IsCubeMap())
+                {
+                    auto& gl_texture = dynamic_cast<TextureCubeMap&>(texture);
+                    output_textures.push_back({gl_texture.GetId(), true});
+                }
+                else
+                {
+                    auto& gl_texture = dynamic_cast<Texture&>(texture);
+                    output_textures.push_back({gl_texture.GetId(), false});
+                }
+            }
+            render_targets_.push_back(std::move(output_textures));
+            render_target_it =
+                render_target_map
+                    .emplace(
+                        program_id,
+                        static_cast<std::uint32_t>(render_targets_.size() - 1))
+                    .first;
+        }
+        packet.render_target_index = render_target_it->second;
+
+        // Resolve the textures once per material, slots are the one given by
+        // the material (in order of the ids).
+        auto binding_it = material_binding_map.find(material_id);
+        if (binding_it == material_binding_map.end())
+        {
+            const auto first =
+                static_cast<std::uint32_t>(texture_bindings_.size());
+            // Textures as published in the snapshot (in the unit order).
+            std::vector<std::pair<EntityId, std::string>> textures;
+            const SceneMaterial* scene_material =
+                scene_state ? scene_state->FindMaterial(material_id) : nullptr;
+            if (scene_material)
+            {
+                textures = scene_material->textures;
+            }
+            else
+            {
+                for (const auto id : material_ids)
+                {
+                    if (level.GetEnumTypeFromId(id) != EntityTypeEnum::TEXTURE)
+                        continue;
+                    textures.emplace_back(id, material.GetInnerName(id));
+                }
+            }
+            for (std::size_t unit = 0; unit < textures.size(); ++unit)
+            {
+                const auto& [id, uniform_name] = textures[unit];
+                auto& texture = level.GetTextureFromId(id);
+                TextureBinding binding{};
+                binding.uniform_name = uniform_name;
+                binding.unit = static_cast<int>(unit);
+                if (texture.IsCubeMap())
+                {
+                    binding.target = GL_TEXTURE_CUBE_MAP;
+                    binding.texture =
+                        dynamic_cast<TextureCubeMap&>(texture).GetId();
+                }
+                else
+                {
+                    binding.target = GL_TEXTURE_2D;
+                    binding.texture = dynamic_cast<Texture&>(texture).GetId();
+                }
+                texture_bindings_.push_back(std::move(binding));
+            }
+            binding_it =
+                material_binding_map
+                    .emplace(
+                        material_id,
+                        std::make_pair(
+                            first,
+                            static_cast<std::uint32_t>(
+                                texture_bindings_.size()) -
+                                first))
+                    .first;
+        }
+        packet.first_texture_binding = binding_it->second.first;
+        packet.texture_binding_count = binding_it->second.second;
+
+        // Resolve the mesh.
+        auto& static_mesh = level.GetStaticMeshFromId(mesh_id);
+        auto& gl_static_mesh = dynamic_cast<StaticMesh&>(static_mesh);
+        auto& gl_index_buffer = dynamic_cast<Buffer&>(
+            level.GetBufferFromId(static_mesh.GetIndexBufferId()));
+        packet.static_mesh_id = mesh_id;
+        packet.static_mesh = &static_mesh;
+        packet.vertex_array_object = gl_static_mesh.GetId();
+        packet.index_buffer = gl_index_buffer.GetId();
+        packet.primitive = GetPrimitive(static_mesh.GetRenderPrimitive());
+        packet.frustum_culling =
+            IsFrustumCullable(node_static_mesh, static_mesh, program);
+
+        packet.sort_key = MakeSortKey(
+            pass,
+            GetDenseIndex(program_index_map, program_id),
+            GetDenseIndex(material_index_map, material_id),
+            GetDenseIndex(mesh_index_map, mesh_id));
+        packets_.push_back(packet);
+    }
+    // Prune the passes whose outputs never reach the display, this is done
+    // before sorting so the pruned packets never get merged.
+    std::vector<EntityId> external_texture_ids;
+    const auto display_texture_id = level.GetDefaultOutputTextureId();
+    if (pass_pruning_ && display_texture_id != NullId)
+        external_texture_ids.push_back(display_texture_id);
+    const auto pruned_count = render_graph_.Compile(external_texture_ids);
+    if (pruned_count)
+    {
+        std::erase_if(packets_, [this](const DrawPacket& packet) {
+            return !packet.clear_bits &&
+                   !render_graph_.IsLive(packet.program_id);
+        });
+        std::erase_if(
+            pre_render_nodes_,
+            [this, &level](const std::pair<EntityId, EntityId>& node_material) {
+                if (node_material.second == NullId)
+                    return false;
+                auto& material = level.GetMaterialFromId(node_material.second);
+                return !render_graph_.IsLive(material.GetProgramId(&level));
+            });
+        Logger::GetInstance()->info(
+            "Render queue pruned {} pass(es).", pruned_count);
+    }
+    // Stable so that equal keys keep the level order.
+    std::stable_sort(
+        packets_.begin(),
+        packets_.end(),
+        [](const DrawPacket& left, const DrawPacket& right) {
+            return left.sort_key < right.sort_key;
+        });
+    // Merge the packets that draw the same mesh with the same material into
+    // a single instanced packet.
+    std::vector<DrawPacket> merged_packets;
+    merged_packets.reserve(packets_.size());
+    for (std::size_t i = 0; i < packets_.size();)
+    {
+        std::size_t end = i + 1;
+        while (end < packets_.size() &&
+               IsSameInstance(packets_[i], packets_[end]))
+        {
+            ++end;
+        }
+        DrawPacket packet = packets_[i];
+        if (end - i > 1)
+        {
+            packet.first_instance =
+                static_cast<std::uint32_t>(instance_node_ids_.size());
+            packet.instance_count = static_cast<std::uint32_t>(end - i);
+            for (std::size_t j = i; j < end; ++j)
+            {
+                instance_node_ids_.push_back(packets_[j].node_id);
+            }
+        }
+        merged_packets.push_back(packet);
+        i = end;
+    }
+    packets_ = std::move(merged_packets);
+    version_ = level.GetVersion();
+    material_hash_ = scene_state ? scene_state->material_hash : 0;
+    compiled_ = true;
+}
+
+} // End namespace frame::opengl.
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "frame/level_interface.h"
+#include "frame/node_static_mesh.h"
+#include "frame/render_graph.h"
+#include "frame/scene_state.h"
+
+namespace frame::opengl
+{
+
+/**
+ * @brief Build the sort key of a draw packet, the pass is in the most
+ *        significant bits so the order between passes is kept, then the
+ *        program, the material and the mesh so that state changes are
+ *        minimized inside of a pass.
+ * @param pass: Pass index (passes are split on clears and texture
+ *        dependencies).
+ * @param program: Program index (in the queue not the entity id).
+ * @param material: Material index (in the queue not the entity id).
+ * @param mesh: Mesh index (in the queue not the entity id).
+ * @return The 64 bit sort key.
+ */
+constexpr std::uint64_t MakeSortKey(
+    std::uint16_t pass,
+    std::uint16_t program,
+    std::uint16_t material,
+    std::uint16_t mesh)
+{
+    return (static_cast<std::uint64_t>(pass) << 48) |
+           (static_cast<std::uint64_t>(program) << 32) |
+           (static_cast<std::uint64_t>(material) << 16) |
+           static_cast<std::uint64_t>(mesh);
+}
+
+/**
+ * @brief Check if a node can be frustum culled, the mesh need bounds, the
+ *        node should not opt out and the program has to place the mesh with
+ *        the projection, view and model matrices (effects on a full screen
+ *        quad don't).
+ * @param node: The node that hold the mesh.
+ * @param static_mesh: The mesh of the node.
+ * @param program: The program used to draw it.
+ * @return True if the node can be skipped when out of the frustum.
+ */
+bool IsFrustumCullable(
+    const NodeStaticMesh& node,
+    const StaticMeshInterface& static_mesh,
+    const ProgramInterface& program);
+
+/**
+ * @class TextureBinding
+ * @brief A texture of a material resolved to its OpenGL handle and unit.
+ */
+struct TextureBinding
+{
+    std::string uniform_name;
+    GLenum target = GL_TEXTURE_2D;
+    GLuint texture = 0;
+    std::int32_t unit = 0;
+};
+
+/**
+ * @class OutputTexture
+ * @brief An output texture of a program resolved to its OpenGL handle.
+ */
+struct OutputTexture
+{
+    GLuint texture = 0;
+    bool is_cube_map = false;
+};
+
+/**
+ * @class DrawPacket
+ * @brief Everything needed to draw a node without any lookup in the level,
+ *        in case clear bits are set this is a clear packet (no draw). In
+ *        case the instance count is not 0 this draw the same mesh for every
+ *        instance node (the node id is the first one).
+ */
+struct DrawPacket
+{
+    std::uint64_t sort_key = 0;
+    EntityId node_id = NullId;
+    GLbitfield clear_bits = 0;
+    EntityId program_id = NullId;
+    ProgramInterface* program = nullptr;
+    MaterialInterface* material = nullptr;
+    EntityId static_mesh_id = NullId;
+    StaticMeshInterface* static_mesh = nullptr;
+    GLuint vertex_array_object = 0;
+    GLuint index_buffer = 0;
+    GLenum primitive = GL_TRIANGLES;
+    std::uint32_t render_target_index = 0;
+    std::uint32_t first_texture_binding = 0;
+    std::uint32_t texture_binding_count = 0;
+    bool frustum_culling = false;
+    // The program take a per instance model matrix (see Program).
+    bool per_instance_model = false;
+    // Depth only variant of the program (null if the program has no depth
+    // prepass).
+    ProgramInterface* depth_only_program = nullptr;
+    // Multi view variant of the program (null if the program has none).
+    ProgramInterface* multi_view_program = nullptr;
+    std::uint32_t first_instance = 0;
+    std::uint32_t instance_count = 0;
+};
+
+/**
+ * @class RenderQueue
+ * @brief Flat sorted array of draw packets compiled from the level, it has
+ *        to be compiled again when the level version change.
+ */
+class RenderQueue
+{
+  public:
+    /**
+     * @brief Compile the queue from the mesh/material list of the level.
+     * @param level: The level to compile.
+     * @param scene_state: Snapshot the textures of the materials are taken
+     *        from (from the level if null or not in the snapshot).
+     */
+    void Compile(
+        LevelInterface& level, const SceneState* scene_state = nullptr);
+    /**
+     * @brief Check if the queue was compiled from this version of the level
+     *        (and the same textures of the materials).
+     * @param level: The level to check.
+     * @param scene_state: Snapshot to be rendered (can be null).
+     * @return True if the queue can be used as is.
+     */
+    bool IsValid(
+        const LevelInterface& level,
+        const SceneState* scene_state = nullptr) const
+    {
+        return compiled_ && version_ == level.GetVersion() &&
+               (!scene_state || scene_state->material_hash == material_hash_);
+    }
+    /**
+     * @brief Enable or disable the pruning of the passes whose outputs never
+     *        reach the display (the queue has to be compiled again).
+     * @param enable: Enable or disable (enabled by default).
+     */
+    void SetPassPruning(bool enable)
+    {
+        pass_pruning_ = enable;
+        compiled_ = false;
+    }
+    //! @brief Compile again at next use (the textures changed storage).
+    void Invalidate()
+    {
+        compiled_ = false;
+    }
+    //! @brief Get the render graph of the last compile.
+    const RenderGraph& GetRenderGraph() const
+    {
+        return render_graph_;
+    }
+    //! @brief Get the render graph of the last compile (to set the timing).
+    RenderGraph& GetRenderGraph()
+    {
+        return render_graph_;
+    }
+    //! @brief Get the sorted draw packets.
+    const std::vector<DrawPacket>& GetPackets() const
+    {
+        return packets_;
+    }
+    //! @brief Get the (node id, material id) rendered before the first frame.
+    const std::vector<std::pair<EntityId, EntityId>>& GetPreRenderNodes() const
+    {
+        return pre_render_nodes_;
+    }
+    //! @brief Get the output textures of every render target.
+    const std::vector<std::vector<OutputTexture>>& GetRenderTargets() const
+    {
+        return render_targets_;
+    }
+    /**
+     * @brief Get the output textures of a packet.
+     * @param packet: The draw packet.
+     * @return The output textures (in attachment order).
+     */
+    std::span<const OutputTexture> GetOutputTextures(
+        const DrawPacket& packet) const
+    {
+        return render_targets_[packet.render_target_index];
+    }
+    /**
+     * @brief Get the texture bindings of a packet.
+     * @param packet: The draw packet.
+     * @return The textures to be bound.
+     */
+    std::span<const TextureBinding> GetTextureBindings(
+        const DrawPacket& packet) const
+    {
+        return std::span<const TextureBinding>(texture_bindings_)
+            .subspan(
+                packet.first_texture_binding, packet.texture_binding_count);
+    }
+    /**
+     * @brief Get the nodes drawn by an instanced packet.
+     * @param packet: The draw packet.
+     * @return The instance node ids (empty if not instanced).
+     */
+    std::span<const EntityId> GetInstanceNodeIds(const DrawPacket& packet) const
+    {
+        return std::span<const EntityId>(instance_node_ids_)
+            .subspan(packet.first_instance, packet.instance_count);
+    }
+    //! @brief Get the node ids of all the instanced packets.
+    const std::vector<EntityId>& GetInstanceNodeIds() const
+    {
+        return instance_node_ids_;
+    }
+
+  private:
+    bool compiled_ = false;
+    bool pass_pruning_ = true;
+    std::uint64_t version_ = 0;
+    std::uint64_t material_hash_ = 0;
+    std::vector<DrawPacket> packets_ = {};
+    std::vector<std::pair<EntityId, EntityId>> pre_render_nodes_ = {};
+    std::vector<std::vector<OutputTexture>> render_targets_ = {};
+    std::vector<TextureBinding> texture_bindings_ = {};
+    std::vector<EntityId> instance_node_ids_ = {};
+    RenderGraph render_graph_ = {};
+};
+
+} // End namespace frame::opengl.
@@ -0,0 +1,290 @@
+#include "frame/opengl/render_target_pool.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <algorithm>
+#include <numeric>
+
+namespace frame::opengl
+{
+
+namespace
+{
+
+// Size of a storage in bytes.
+std::size_t GetStorageBytes(const RenderTargetKey& key)
+{
+    std::size_t element_bytes = 1;
+    switch (key.pixel_element_size)
+    {
+    case proto::PixelElementSize::SHORT:
+    case proto::PixelElementSize::HALF:
+        element_bytes = 2;
+        break;
+    case proto::PixelElementSize::FLOAT:
+        element_bytes = 4;
+        break;
+    default:
+        break;
+    }
+    std::size_t channel_count = 4;
+    switch (key.pixel_structure)
+    {
+    case proto::PixelStructure::GREY:
+        channel_count = 1;
+        break;
+    case proto::PixelStructure::GREY_ALPHA:
+        channel_count = 2;
+        break;
+    case proto::PixelStructure::RGB:
+    case proto::PixelStructure::BGR:
+        channel_count = 3;
+        break;
+    default:
+        break;
+    }
+    return static_cast<std::size_t>(key.size.x) *
+           static_cast<std::size_t>(key.size.y) * element_bytes *
+           channel_count;
+}
+
+RenderTargetKey GetKey(const Texture& texture)
+{
+    RenderTargetKey key = {};
+    key.size = texture.GetSize();
+    key.pixel_element_size = texture.GetPixelElementSize();
+    key.pixel_structure = texture.GetPixelStructure();
+    key.min_filter = texture.GetMinFilter();
+    key.mag_filter = texture.GetMagFilter();
+    key.wrap_s = texture.GetWrapS();
+    key.wrap_t = texture.GetWrapT();
+    return key;
+}
+
+} // namespace
+
+RenderTargetPool::~RenderTargetPool()
+{
+    Release();
+}
+
+std::vector<std::uint32_t> RenderTargetPool::AssignStorages(
+    std::span<const RenderTargetUse> uses)
+{
+    // Greedy in the order of the first use, a storage is free for a use in
+    // case its last use is before (uses in the same step overlap).
+    std::vector<std::uint32_t> order(uses.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, {}, [uses](std::uint32_t i) {
+        return uses[i].first_step;
+    });
+    // Key and last step of every storage.
+    std::vector<std::pair<RenderTargetKey, std::uint32_t>> storages;
+    std::vector<std::uint32_t> storage_indices(uses.size(), 0);
+    for (const auto i : order)
+    {
+        const auto& use = uses[i];
+        auto it = std::ranges::find_if(storages, [&use](const auto& storage) {
+            return storage.first == use.key &&
+                   storage.second < use.first_step;
+        });
+        if (it == storages.end())
+        {
+            storages.emplace_back(use.key, use.last_step);
+            storage_indices[i] =
+                static_cast<std::uint32_t>(storages.size() - 1);
+            continue;
+        }
+        it->second = use.last_step;
+        storage_indices[i] =
+            static_cast<std::uint32_t>(std::distance(storages.begin(), it));
+    }
+    return storage_indices;
+}
+
+RenderTargetPool::Storage RenderTargetPool::CreateStorage(
+    const RenderTargetKey& key) const
+{
+    TextureParameter texture_parameter = {};
+    texture_parameter.pixel_element_size.set_value(key.pixel_element_size);
+    texture_parameter.pixel_structure.set_value(key.pixel_structure);
+    texture_parameter.size = key.size;
+    Storage storage = {};
+    storage.key = key;
+    storage.texture = std::make_unique<Texture>(texture_parameter);
+    storage.texture->SetMinFilter(key.min_filter);
+    storage.texture->SetMagFilter(key.mag_filter);
+    storage.texture->SetWrapS(key.wrap_s);
+    storage.texture->SetWrapT(key.wrap_t);
+    return storage;
+}
+
+bool RenderTargetPool::Build(const RenderQueue& render_queue)
+{
+    const auto& render_graph = render_queue.GetRenderGraph();
+    const auto& passes = render_graph.GetPasses();
+    // Textures used outside of the frame keep their storage, the display
+    // and the one of the pre render (only done once).
+    absl::flat_hash_set<EntityId> persistent_ids;
+    persistent_ids.insert(level_.GetDefaultOutputTextureId());
+    for (const auto& [node_id, material_id] :
+         render_queue.GetPreRenderNodes())
+    {
+        if (material_id == NullId)
+            continue;
+        auto& material = level_.GetMaterialFromId(material_id);
+        auto maybe_index =
+            render_graph.FindPass(material.GetProgramId(&level_));
+        if (!maybe_index)
+            continue;
+        const auto& pass = passes[*maybe_index];
+        persistent_ids.insert(pass.inputs.begin(), pass.inputs.end());
+        persistent_ids.insert(pass.outputs.begin(), pass.outputs.end());
+    }
+    // First and last step every texture is used in, a texture first used
+    // as an input is read before it is written (kept across frames).
+    struct TextureUse
+    {
+        std::uint32_t first_step = 0;
+        std::uint32_t last_step = 0;
+        bool read_first = false;
+        std::uint32_t last_packet_index = 0;
+    };
+    absl::flat_hash_map<EntityId, TextureUse> texture_uses;
+    std::uint32_t step = 0;
+    const auto& packets = render_queue.GetPackets();
+    for (std::uint32_t packet_index = 0; packet_index < packets.size();
+         ++packet_index)
+    {
+        const auto& packet = packets[packet_index];
+        if (packet.clear_bits)
+            continue;
+        auto maybe_index = render_graph.FindPass(packet.program_id);
+        if (!maybe_index)
+            continue;
+        const auto& pass = passes[*maybe_index];
+        for (const auto id : pass.inputs)
+        {
+            auto [it, inserted] =
+                texture_uses.try_emplace(id, TextureUse{step, step, true});
+            it->second.last_step = step;
+            it->second.last_packet_index = packet_index;
+        }
+        for (const auto id : pass.outputs)
+        {
+            auto [it, inserted] =
+                texture_uses.try_emplace(id, TextureUse{step, step, false});
+            it->second.last_step = step;
+            it->second.last_packet_index = packet_index;
+        }
+        ++step;
+    }
+    // Transient textures that can be pooled, the others get their storage
+    // back.
+    bool changed = false;
+    const auto all_texture_ids = level_.GetAllTextures();
+    std::vector<Texture*> textures;
+    std::vector<EntityId> texture_ids;
+    std::vector<RenderTargetUse> uses;
+    std::vector<std::uint32_t> last_packet_indices;
+    for (const auto id : all_texture_ids)
+    {
+        auto* texture = dynamic_cast<Texture*>(&level_.GetTextureFromId(id));
+        if (!texture || !texture->IsTransient())
+            continue;
+        auto it = texture_uses.find(id);
+        if (persistent_ids.contains(id) || it == texture_uses.end() ||
+            it->second.read_first)
+        {
+            const auto texture_id = texture->GetId();
+            texture->ReleasePoolStorage();
+            changed |= texture_id != texture->GetId();
+            continue;
+        }
+        RenderTargetUse use = {};
+        use.key = GetKey(*texture);
+        use.first_step = it->second.first_step;
+        use.last_step = it->second.last_step;
+        textures.push_back(texture);
+        texture_ids.push_back(id);
+        uses.push_back(use);
+        last_packet_indices.push_back(it->second.last_packet_index);
+    }
+    // Textures that were pooled and are not transient anymore.
+    for (const auto id : pooled_texture_ids_)
+    {
+        if (std::ranges::find(texture_ids, id) != texture_ids.end() ||
+            std::ranges::find(all_texture_ids, id) == all_texture_ids.end())
+        {
+            continue;
+        }
+        auto* texture = dynamic_cast<Texture*>(&level_.GetTextureFromId(id));
+        if (texture && texture->IsPooled())
+        {
+            texture->ReleasePoolStorage();
+            changed = true;
+        }
+    }
+    // Create the storages, the previous ones are reused in case they have
+    // the same key (so the textures keep their OpenGL id).
+    const auto storage_indices = AssignStorages(uses);
+    std::vector<RenderTargetKey> storage_keys;
+    for (std::size_t i = 0; i < uses.size(); ++i)
+    {
+        if (storage_indices[i] >= storage_keys.size())
+            storage_keys.resize(storage_indices[i] + 1);
+        storage_keys[storage_indices[i]] = uses[i].key;
+    }
+    std::vector<Storage> previous_storages = std::move(storages_);
+    storages_.clear();
+    for (const auto& key : storage_keys)
+    {
+        auto it = std::ranges::find(previous_storages, key, &Storage::key);
+        if (it == previous_storages.end())
+        {
+            storages_.push_back(CreateStorage(key));
+            continue;
+        }
+        storages_.push_back(std::move(*it));
+        previous_storages.erase(it);
+    }
+    stats_ = {};
+    last_uses_.clear();
+    for (std::size_t i = 0; i < textures.size(); ++i)
+    {
+        const auto texture_id = textures[i]->GetId();
+        textures[i]->SetPoolStorage(
+            storages_[storage_indices[i]].texture->GetId());
+        changed |= texture_id != textures[i]->GetId();
+        stats_.naive_bytes += GetStorageBytes(uses[i].key);
+        last_uses_.emplace_back(last_packet_indices[i], textures[i]->GetId());
+    }
+    std::ranges::sort(last_uses_);
+    for (const auto& storage : storages_)
+    {
+        stats_.peak_bytes += GetStorageBytes(storage.key);
+    }
+    stats_.texture_count = static_cast<std::uint32_t>(textures.size());
+    stats_.storage_count = static_cast<std::uint32_t>(storages_.size());
+    pooled_texture_ids_ = std::move(texture_ids);
+    return changed;
+}
+
+void RenderTargetPool::Release()
+{
+    const auto all_texture_ids = level_.GetAllTextures();
+    for (const auto id : pooled_texture_ids_)
+    {
+        if (std::ranges::find(all_texture_ids, id) == all_texture_ids.end())
+            continue;
+        auto* texture = dynamic_cast<Texture*>(&level_.GetTextureFromId(id));
+        if (texture)
+            texture->ReleasePoolStorage();
+    }
+    pooled_texture_ids_.clear();
+    storages_.clear();
+    last_uses_.clear();
+    stats_ = {};
+}
+
+} // End namespace frame::opengl.
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "frame/level_interface.h"
+#include "frame/opengl/render_queue.h"
+#include "frame/opengl/texture.h"
+
+namespace frame::opengl
+{
+
+/**
+ * @class RenderTargetKey
+ * @brief What has to be the same for two textures to share a storage, the
+ *        size, the format and the sampling (part of the OpenGL texture).
+ */
+struct RenderTargetKey
+{
+    glm::uvec2 size = glm::uvec2(0, 0);
+    proto::PixelElementSize::Enum pixel_element_size =
+        proto::PixelElementSize::INVALID;
+    proto::PixelStructure::Enum pixel_structure =
+        proto::PixelStructure::INVALID;
+    proto::TextureFilter::Enum min_filter = proto::TextureFilter::INVALID;
+    proto::TextureFilter::Enum mag_filter = proto::TextureFilter::INVALID;
+    proto::TextureFilter::Enum wrap_s = proto::TextureFilter::INVALID;
+    proto::TextureFilter::Enum wrap_t = proto::TextureFilter::INVALID;
+
+    friend bool operator==(
+        const RenderTargetKey&, const RenderTargetKey&) = default;
+};
+
+/**
+ * @class RenderTargetUse
+ * @brief When a transient texture is used in a frame, the first and the
+ *        last step (draw packet) it is written or read in.
+ */
+struct RenderTargetUse
+{
+    RenderTargetKey key = {};
+    std::uint32_t first_step = 0;
+    std::uint32_t last_step = 0;
+};
+
+/**
+ * @class RenderTargetPoolStats
+ * @brief Memory used by the transient textures, with the pool (peak) and
+ *        with a storage per texture (naive).
+ */
+struct RenderTargetPoolStats
+{
+    std::uint32_t texture_count = 0;
+    std::uint32_t storage_count = 0;
+    std::size_t naive_bytes = 0;
+    std::size_t peak_bytes = 0;
+};
+
+/**
+ * @class RenderTargetPool
+ * @brief Storage of the textures marked as transient (only used inside a
+ *        frame). Textures with the same key whose uses in the frame don't
+ *        overlap share the same OpenGL texture.
+ *
+ * The display texture, textures used by pre render and textures read
+ * before they are written in a frame (content kept across frames) keep a
+ * storage of their own.
+ */
+class RenderTargetPool
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param level: The level the textures are from.
+     */
+    RenderTargetPool(LevelInterface& level) : level_(level)
+    {
+    }
+    //! @brief Destructor give the textures a storage of their own back.
+    ~RenderTargetPool();
+
+  public:
+    /**
+     * @brief Assign a storage to every transient texture of a compiled
+     *        render queue (the storage are reused in case they still fit).
+     * @param render_queue: The compiled render queue (uses are in the order
+     *        of its packets).
+     * @return True if the OpenGL id of a texture changed (the queue has to
+     *         be compiled again).
+     */
+    bool Build(const RenderQueue& render_queue);
+    //! @brief Give the textures a storage of their own back.
+    void Release();
+    /**
+     * @brief Assign the uses to storages, uses of the same key that don't
+     *        overlap share a storage.
+     * @param uses: Uses of the textures.
+     * @return The storage index of every use.
+     */
+    static std::vector<std::uint32_t> AssignStorages(
+        std::span<const RenderTargetUse> uses);
+    /**
+     * @brief Get the packet each pooled texture is last used by (its content
+     *        is not needed after it in the frame).
+     * @return Packet index and OpenGL texture, sorted by packet index.
+     */
+    std::span<const std::pair<std::uint32_t, GLuint>> GetLastUses() const
+    {
+        return last_uses_;
+    }
+    //! @brief Get the memory used by the pool.
+    RenderTargetPoolStats GetStats() const
+    {
+        return stats_;
+    }
+
+  private:
+    /**
+     * @brief Texture whose OpenGL texture is shared by transient textures.
+     */
+    struct Storage
+    {
+        RenderTargetKey key = {};
+        std::unique_ptr<Texture> texture = nullptr;
+    };
+    /**
+     * @brief Create the texture of a storage.
+     * @param key: Size, format and sampling of the storage.
+     * @return The storage.
+     */
+    Storage CreateStorage(const RenderTargetKey& key) const;
+
+  private:
+    LevelInterface& level_;
+    std::vector<Storage> storages_ = {};
+    std::vector<EntityId> pooled_texture_ids_ = {};
+    std::vector<std::pair<std::uint32_t, GLuint>> last_uses_ = {};
+    RenderTargetPoolStats stats_ = {};
+};
+
+} // End namespace frame::opengl.
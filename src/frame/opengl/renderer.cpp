@@ -3,12 +3,17 @@
 #include <GL/glew.h>
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
 
 #include "frame/node_matrix.h"
 #include "frame/node_static_mesh.h"
 #include "frame/opengl/file/load_program.h"
 #include "frame/opengl/material.h"
+#include "frame/opengl/program.h"
+#include "frame/opengl/state_cache.h"
 #include "frame/opengl/static_mesh.h"
 #include "frame/opengl/texture.h"
 #include "frame/opengl/texture_cube_map.h"
@@ -48,15 +53,45 @@ const std::array<glm::mat4, 6> views_cubemap = {
 // Projection cube map.
 const glm::mat4 projection_cubemap =
     glm::perspective(glm::radians(90.0f), 1.0f, 0.01f, 10.0f);
+
+// Check if a point is inside a box (or close enough that the near plane
+// could clip the box).
+bool IsInside(const AxisAlignedBoundingBox& box, glm::vec3 point)
+{
+    constexpr float margin = 0.1f;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (point[i] < box.min[i] - margin || point[i] > box.max[i] + margin)
+            return false;
+    }
+    return true;
+}
 } // namespace
 
 Renderer::Renderer(LevelInterface& level, glm::uvec4 viewport)
-    : level_(level), viewport_(viewport)
+    : level_(level), viewport_(viewport),
+      window_size_(viewport.z - viewport.x, viewport.w - viewport.y)
 {
     // TODO(anirul): Check viewport!!!
-    render_buffer_.CreateStorage(
-        {viewport_.z - viewport_.x, viewport_.w - viewport_.y});
-    frame_buffer_.AttachRender(render_buffer_);
+    render_buffer_.CreateStorage(window_size_);
+    // Meshes that are not drawn instanced read the generic value of the per
+    // instance model matrix, set it to identity.
+    const glm::mat4 identity(1.0f);
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        glVertexAttrib4fv(
+            Program::instance_model_location + i, &identity[i][0]);
+    }
+    // In case the level was already used by a renderer (resize) reuse the
+    // display program and material.
+    auto maybe_program_id = level_.TryGetIdFromName("DisplayProgram");
+    auto maybe_material_id = level_.TryGetIdFromName("DisplayMaterial");
+    if (maybe_program_id && maybe_material_id)
+    {
+        display_program_id_ = maybe_program_id.value();
+        display_material_id_ = maybe_material_id.value();
+        return;
+    }
     auto program = file::LoadProgram("display");
     if (!program)
         throw std::runtime_error("No program!");
@@ -88,6 +123,78 @@ Renderer::Renderer(LevelInterface& level, glm::uvec4 viewport)
     }
 }
 
+void Renderer::Resize(glm::uvec2 size)
+{
+    window_size_ = size;
+    ResizeRenderTargets();
+}
+
+void Renderer::SetResolutionScale(float scale)
+{
+    if (scale <= 0.0f || scale > 1.0f)
+        throw std::runtime_error("Resolution scale should be in ]0, 1].");
+    if (scale == resolution_scale_)
+        return;
+    resolution_scale_ = scale;
+    ResizeRenderTargets();
+}
+
+glm::uvec2 Renderer::GetRenderSize() const
+{
+    glm::uvec2 render_size;
+    for (int i = 0; i < 2; ++i)
+    {
+        render_size[i] = std::max(
+            1u,
+            static_cast<std::uint32_t>(
+                std::lround(window_size_[i] * resolution_scale_)));
+    }
+    return render_size;
+}
+
+void Renderer::ResizeRenderTargets()
+{
+    const auto render_size = GetRenderSize();
+    viewport_ = glm::uvec4(0, 0, render_size.x, render_size.y);
+    render_buffer_.CreateStorage(render_size);
+    // The pool storages have the previous size.
+    render_target_pool_.Release();
+    for (const auto id : level_.GetAllTextures())
+    {
+        auto* texture = dynamic_cast<Texture*>(&level_.GetTextureFromId(id));
+        if (texture)
+            texture->ResizeToWindow(render_size);
+    }
+    // The OpenGL ids and the frame buffers are resolved by the compile.
+    render_queue_.Invalidate();
+    // The pre render outputs that were resized have no content anymore, the
+    // other ones are still up to date and are skipped.
+    first_render_ = true;
+}
+
+Renderer::~Renderer()
+{
+    ClearOcclusionQueries();
+    for (const auto& pass_queries : pass_query_frames_)
+    {
+        for (const auto& [program_id, query] : pass_queries)
+        {
+            free_queries_.push_back(query);
+        }
+    }
+    if (!free_queries_.empty())
+    {
+        glDeleteQueries(
+            static_cast<GLsizei>(free_queries_.size()), free_queries_.data());
+    }
+    if (!overdraw_queries_.empty())
+    {
+        glDeleteQueries(
+            static_cast<GLsizei>(overdraw_queries_.size()),
+            overdraw_queries_.data());
+    }
+}
+
 void Renderer::RenderNode(
     EntityId node_id,
     EntityId material_id,
@@ -108,10 +215,10 @@ void Renderer::RenderNode(
     {
         GLbitfield bit_field = 0;
         std::uint32_t clean_buffer = node_static_mesh.GetCleanBuffer();
-        if (clean_buffer | proto::CleanBuffer::CLEAR_COLOR)
-            bit_field += GL_COLOR_BUFFER_BIT;
-        if (clean_buffer | proto::CleanBuffer::CLEAR_DEPTH)
-            bit_field += GL_DEPTH_BUFFER_BIT;
+        if (clean_buffer & proto::CleanBuffer::CLEAR_COLOR)
+            bit_field |= GL_COLOR_BUFFER_BIT;
+        if (clean_buffer & proto::CleanBuffer::CLEAR_DEPTH)
+            bit_field |= GL_DEPTH_BUFFER_BIT;
         if (bit_field)
             glClear(bit_field);
         return;
@@ -124,7 +231,12 @@ void Renderer::RenderNode(
     }
     MaterialInterface& material = level_.GetMaterialFromId(material_id);
     RenderMesh(
-        static_mesh, material, projection, view, node.GetLocalModel(dt), dt);
+        static_mesh,
+        material,
+        projection,
+        view,
+        GetWorldTransform(node_id),
+        dt);
 }
 
 void Renderer::RenderMesh(
@@ -145,58 +257,44 @@ void Renderer::RenderMesh(
     // Go through the callback.
     callback_(uniform_wrapper, static_mesh, material);
     program.Use(uniform_wrapper);
+    SetSceneUniforms(program_id, program);
 
-    auto texture_out_ids = program.GetOutputTextureIds();
-    auto& texture_ref = level_.GetTextureFromId(*texture_out_ids.cbegin());
-    auto size = texture_ref.GetSize();
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.Viewport(glm::ivec4(viewport_));
 
-    glViewport(viewport_.x, viewport_.y, viewport_.z, viewport_.w);
-
-    ScopedBind scoped_frame(frame_buffer_);
-    int i = 0;
+    FrameBufferKey frame_buffer_key = {};
+    frame_buffer_key.depth_render_buffer = render_buffer_.GetId();
     for (const auto& texture_id : program.GetOutputTextureIds())
     {
-        if (level_.GetTextureFromId(texture_id).IsCubeMap())
+        auto& texture = level_.GetTextureFromId(texture_id);
+        if (texture.IsCubeMap())
         {
-            auto& opengl_texture = dynamic_cast<TextureCubeMap&>(
-                level_.GetTextureFromId(texture_id));
-            // TODO(anirul): Check the mipmap level (last parameter)!
-            frame_buffer_.AttachTexture(
+            auto& opengl_texture = dynamic_cast<TextureCubeMap&>(texture);
+            frame_buffer_key.AddColorAttachment(
                 opengl_texture.GetId(),
-                FrameBuffer::GetFrameColorAttachment(i),
-                FrameBuffer::GetFrameTextureType(texture_frame_),
-                0);
+                FrameBuffer::GetFrameTextureType(texture_frame_));
         }
         else
         {
-            auto& opengl_texture =
-                dynamic_cast<Texture&>(level_.GetTextureFromId(texture_id));
-            // TODO(anirul): Check the mipmap level (last parameter)!
-            frame_buffer_.AttachTexture(
-                opengl_texture.GetId(),
-                FrameBuffer::GetFrameColorAttachment(i),
-                FrameTextureType::TEXTURE_2D,
-                0);
+            auto& opengl_texture = dynamic_cast<Texture&>(texture);
+            frame_buffer_key.AddColorAttachment(
+                opengl_texture.GetId(), FrameTextureType::TEXTURE_2D);
         }
-        i++;
     }
-    frame_buffer_.DrawBuffers(
-        static_cast<std::uint32_t>(texture_out_ids.size()));
+    ScopedBind scoped_frame(
+        frame_buffer_cache_.GetFrameBuffer(frame_buffer_key, render_buffer_));
 
     std::map<std::string, std::vector<std::int32_t>> uniform_include;
     for (const auto& id : material.GetIds())
     {
-        EntityId texture_id = NullId;
-        if (level_.GetEnumTypeFromId(id) == EntityTypeEnum::TEXTURE)
-        {
-            texture_id = id;
-        }
-        else
+        // Ids are typed (see entity_id.h) so a non texture id can't be
+        // turned into a texture one.
+        if (level_.GetEnumTypeFromId(id) != EntityTypeEnum::TEXTURE)
         {
-            // TODO(anirul): Find a better way to find the texture
-            // associated with the stream.
-            texture_id = id + 1;
+            logger_->warn("Material id #{} is not a texture.", id);
+            continue;
         }
+        EntityId texture_id = id;
         // TODO(anirul): Why? id and not texture id?
         const auto p = material.EnableTextureId(id);
         auto& texture = level_.GetTextureFromId(texture_id);
@@ -217,7 +315,7 @@ void Renderer::RenderMesh(
     }
 
     auto& gl_static_mesh = dynamic_cast<StaticMesh&>(static_mesh);
-    glBindVertexArray(gl_static_mesh.GetId());
+    state_cache.BindVertexArray(gl_static_mesh.GetId());
 
     auto& index_buffer = level_.GetBufferFromId(static_mesh.GetIndexBufferId());
     auto& gl_index_buffer = dynamic_cast<Buffer&>(index_buffer);
@@ -260,15 +358,15 @@ void Renderer::RenderMesh(
         gl_index_buffer.UnBind();
     }
     program.UnUse();
-    glBindVertexArray(0);
+    state_cache.BindVertexArray(0);
 
     for (const auto id : material.GetIds())
     {
-        EntityId texture_id = id;
         if (level_.GetEnumTypeFromId(id) != EntityTypeEnum::TEXTURE)
         {
-            texture_id = id + 1;
+            continue;
         }
+        EntityId texture_id = id;
         auto& texture = level_.GetTextureFromId(texture_id);
         if (texture.IsCubeMap())
         {
@@ -300,6 +398,12 @@ void Renderer::Display(double dt /* = 0.0*/)
     auto& program = level_.GetProgramFromId(display_program_id_);
     UniformWrapper uniform_wrapper{};
     program.Use(uniform_wrapper);
+    // The display cover the whole window (the render can be scaled down).
+    StateCache::GetInstance().Viewport(glm::ivec4(viewport_));
+    if (program.HasUniform("upscale_filter"))
+    {
+        program.Uniform("upscale_filter", static_cast<int>(upscale_filter_));
+    }
     auto& material = level_.GetMaterialFromId(display_material_id_);
     for (const auto id : material.GetIds())
     {
@@ -310,7 +414,8 @@ void Renderer::Display(double dt /* = 0.0*/)
         program.Uniform(p.first, p.second);
     }
     auto& gl_quad = dynamic_cast<StaticMesh&>(quad);
-    glBindVertexArray(gl_quad.GetId());
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.BindVertexArray(gl_quad.GetId());
     auto& index_buffer = level_.GetBufferFromId(quad.GetIndexBufferId());
     auto& gl_index_buffer = dynamic_cast<Buffer&>(index_buffer);
 
@@ -323,7 +428,7 @@ void Renderer::Display(double dt /* = 0.0*/)
     gl_index_buffer.UnBind();
 
     program.UnUse();
-    glBindVertexArray(0);
+    state_cache.BindVertexArray(0);
 
     for (const auto id : material.GetIds())
     {
@@ -336,64 +441,1147 @@ void Renderer::Display(double dt /* = 0.0*/)
 
 void Renderer::SetDepthTest(bool enable)
 {
-    if (enable)
-    {
-        glEnable(GL_DEPTH_TEST);
-    }
-    else
-    {
-        glDisable(GL_DEPTH_TEST);
-    }
+    StateCache::GetInstance().SetCapability(GL_DEPTH_TEST, enable);
 }
 
 void Renderer::RenderAllMeshes(
     const glm::mat4& projection, const glm::mat4& view, double dt /*= 0.0*/)
 {
+    const RenderView render_view = {projection, view, viewport_};
+    RenderAllMeshes(std::span<const RenderView>(&render_view, 1), dt);
+}
+
+void Renderer::RenderAllMeshes(
+    std::span<const RenderView> views, double dt /*= 0.0*/)
+{
+    if (views.empty())
+        return;
+    // Hold the snapshot for this pass only, so the level can reuse it.
+    scene_state_ = level_.GetSceneState();
+    culling_stats_ = {};
+    // Compile the queue only when the level changed.
+    if (!render_queue_.IsValid(level_, scene_state_.get()))
+    {
+        render_queue_.Compile(level_, scene_state_.get());
+        // The OpenGL ids of the textures are resolved by the compile so it
+        // has to be done again in case the pool changed a storage.
+        if (render_target_pool_.Build(render_queue_))
+            render_queue_.Compile(level_, scene_state_.get());
+        const auto pool_stats = render_target_pool_.GetStats();
+        if (pool_stats.texture_count)
+        {
+            logger_->info(
+                "Render target pool: {} transient texture(s) in {} "
+                "storage(s), {} bytes (instead of {} bytes).",
+                pool_stats.texture_count,
+                pool_stats.storage_count,
+                pool_stats.peak_bytes,
+                pool_stats.naive_bytes);
+        }
+        // The attached textures could have been deleted (and their ids
+        // reused), build a frame buffer for every render target. The ones
+        // with a cube map depend on the cube map target and are built when
+        // first used.
+        frame_buffer_cache_.Clear();
+        // The nodes could have been deleted (and their ids reused).
+        ClearOcclusionQueries();
+        for (const auto& outputs : render_queue_.GetRenderTargets())
+        {
+            if (std::ranges::any_of(outputs, &OutputTexture::is_cube_map))
+                continue;
+            frame_buffer_cache_.GetFrameBuffer(
+                GetFrameBufferKey(outputs), render_buffer_);
+        }
+        // Same for the meshes copied in the geometry arena.
+        if (multi_draw_indirect_)
+        {
+            std::vector<EntityId> static_mesh_ids;
+            for (const auto& packet : render_queue_.GetPackets())
+            {
+                if (packet.static_mesh_id)
+                    static_mesh_ids.push_back(packet.static_mesh_id);
+            }
+            geometry_arena_.Build(level_, static_mesh_ids);
+        }
+    }
+    // A program of a pre render changed, the other pre render are skipped
+    // as they are up to date.
+    if (UpdatePreRenderProgramHashes())
+        first_render_ = true;
     // This will ensure that it is only true once.
     auto first_render = std::exchange(first_render_, false);
-    for (const auto& p : level_.GetStaticMeshMaterialIds())
+    if (first_render)
     {
-        auto [material_id, render_time_enum] = p.second;
-        // Check this is a pre render action and this is the first render.
-        if (render_time_enum == proto::SceneStaticMesh::PRE_RENDER)
+        // The content of the textures written by the frame is not the one of
+        // the pre render.
+        absl::flat_hash_set<EntityId> frame_output_ids;
+        if (pre_render_cache_)
         {
-            auto temp_viewport = viewport_;
-            if (first_render)
+            for (const auto& packet : render_queue_.GetPackets())
             {
-                // Now this get the image size from the environment map.
-                auto& material = level_.GetMaterialFromId(material_id);
-                auto ids = material.GetIds();
-                assert(!ids.empty());
-                auto& texture = level_.GetTextureFromId(ids[0]);
-                auto size = texture.GetSize();
-                viewport_ = glm::ivec4(0, 0, size.x / 2, size.y / 2);
-                for (std::uint32_t i = 0; i < 6; ++i)
+                if (!packet.program)
+                    continue;
+                const auto output_ids = packet.program->GetOutputTextureIds();
+                frame_output_ids.insert(output_ids.begin(), output_ids.end());
+            }
+        }
+        for (const auto& [node_id, material_id] :
+             render_queue_.GetPreRenderNodes())
+        {
+            std::optional<std::uint64_t> maybe_key = std::nullopt;
+            std::vector<TextureInterface*> outputs;
+            if (pre_render_cache_)
+            {
+                maybe_key =
+                    GetPreRenderKey(node_id, material_id, frame_output_ids);
+                auto& program = level_.GetProgramFromId(
+                    level_.GetMaterialFromId(material_id).GetProgramId());
+                for (const auto id : program.GetOutputTextureIds())
+                {
+                    outputs.push_back(&level_.GetTextureFromId(id));
+                }
+            }
+            // Output i of a pre render has the content hash (key, i).
+            auto output_hash = [&maybe_key](std::size_t i) {
+                return CombineContentHash(*maybe_key, std::to_string(i));
+            };
+            if (maybe_key)
+            {
+                // Still in the outputs (the renderer was created again for a
+                // resize) or in the cache (the level was reloaded).
+                bool up_to_date = !outputs.empty();
+                for (std::size_t i = 0; i < outputs.size(); ++i)
                 {
-                    SetCubeMapTarget(GetTextureFrameFromPosition(i));
-                    RenderNode(
-                        p.first,
+                    if (outputs[i]->GetContentHash() != output_hash(i))
+                        up_to_date = false;
+                }
+                if (up_to_date ||
+                    pre_render_cache_->Restore(*maybe_key, outputs))
+                {
+                    ++pre_render_cached_count_;
+                    continue;
+                }
+            }
+            auto temp_viewport = viewport_;
+            // Now this get the image size from the environment map.
+            auto& material = level_.GetMaterialFromId(material_id);
+            auto ids = material.GetIds();
+            assert(!ids.empty());
+            auto& texture = level_.GetTextureFromId(ids[0]);
+            auto size = texture.GetSize();
+            viewport_ = glm::ivec4(0, 0, size.x / 2, size.y / 2);
+            for (std::uint32_t i = 0; i < 6; ++i)
+            {
+                // Each face of the cube map has its own frustum.
+                if (!IsInFrustum(
+                        node_id,
                         material_id,
-                        projection_cubemap,
-                        views_cubemap[i],
-                        dt);
+                        Frustum(projection_cubemap, views_cubemap[i])))
+                {
+                    ++culling_stats_.culled;
+                    continue;
                 }
-                // Again why?
-                SetCubeMapTarget(GetTextureFrameFromPosition(0));
+                ++culling_stats_.drawn;
+                ++culling_stats_.draw_calls;
+                SetCubeMapTarget(GetTextureFrameFromPosition(i));
                 RenderNode(
-                    p.first,
+                    node_id,
                     material_id,
                     projection_cubemap,
-                    views_cubemap[0],
+                    views_cubemap[i],
                     dt);
             }
+            // Again why?
+            SetCubeMapTarget(GetTextureFrameFromPosition(0));
+            RenderNode(
+                node_id,
+                material_id,
+                projection_cubemap,
+                views_cubemap[0],
+                dt);
             viewport_ = temp_viewport;
+            if (maybe_key)
+            {
+                for (std::size_t i = 0; i < outputs.size(); ++i)
+                {
+                    outputs[i]->SetContentHash(output_hash(i));
+                }
+                pre_render_cache_->Store(*maybe_key, outputs);
+            }
+        }
+    }
+    // Once per frame, the views could be rendered in more than one run.
+    ReadPassTiming();
+    // A multi view program draw as many views as there are viewports.
+    for (std::size_t i = 0; i < views.size(); i += Program::max_view_count)
+    {
+        ExecuteRenderQueue(
+            views.subspan(
+                i,
+                std::min<std::size_t>(
+                    Program::max_view_count, views.size() - i)),
+            dt);
+    }
+    scene_state_ = nullptr;
+    logger_->trace(
+        "Frustum culling: {} drawn, {} culled ({} draw calls).",
+        culling_stats_.drawn,
+        culling_stats_.culled,
+        culling_stats_.draw_calls);
+}
+
+const glm::mat4& Renderer::GetWorldTransform(EntityId node_id) const
+{
+    if (scene_state_)
+    {
+        const glm::mat4* world_transform =
+            scene_state_->FindWorldTransform(node_id);
+        if (world_transform)
+            return *world_transform;
+    }
+    return level_.GetWorldTransform(node_id);
+}
+
+void Renderer::SetSceneUniforms(
+    EntityId program_id, const ProgramInterface& program) const
+{
+    // Outside of a render (the snapshot is released) take the last one.
+    std::shared_ptr<const SceneState> scene_state = scene_state_;
+    if (!scene_state)
+        scene_state = level_.GetSceneState();
+    if (!scene_state)
+        return;
+    for (const auto& uniform : scene_state->FindUniforms(program_id))
+    {
+        if (!program.HasUniform(uniform.name))
+            continue;
+        if (uniform.int_values.empty())
+            program.Uniform(uniform.name, uniform.float_values, uniform.size);
+        else
+            program.Uniform(uniform.name, uniform.int_values, uniform.size);
+    }
+}
+
+bool Renderer::IsInFrustum(
+    EntityId node_id, EntityId material_id, const Frustum& frustum)
+{
+    auto& node =
+        dynamic_cast<NodeStaticMesh&>(level_.GetSceneNodeFromId(node_id));
+    auto mesh_id = node.GetLocalMesh();
+    if (!mesh_id || material_id == NullId)
+        return true;
+    auto& static_mesh = level_.GetStaticMeshFromId(mesh_id);
+    auto& material = level_.GetMaterialFromId(material_id);
+    auto& program = level_.GetProgramFromId(material.GetProgramId());
+    if (!IsFrustumCullable(node, static_mesh, program))
+        return true;
+    return frustum.IsVisible(
+        static_mesh.GetBoundingBox().Transform(GetWorldTransform(node_id)));
+}
+
+void Renderer::CullPackets(std::span<const Frustum> frustums)
+{
+    const auto& packets = render_queue_.GetPackets();
+    // Same size every frame (unless the queue is compiled) so no allocation.
+    packet_visibility_.assign(packets.size(), 1);
+    instance_visibility_.assign(
+        render_queue_.GetInstanceNodeIds().size(), 1);
+    world_bounding_boxes_.clear();
+    cullable_packet_indices_.clear();
+    cullable_instance_indices_.clear();
+    // The boxes of the packets first and then the ones of the instances (the
+    // visibility is read back in that order).
+    for (std::uint32_t i = 0; i < packets.size(); ++i)
+    {
+        const auto& packet = packets[i];
+        if (!packet.frustum_culling || packet.instance_count)
+            continue;
+        world_bounding_boxes_.push_back(
+            packet.static_mesh->GetBoundingBox().Transform(
+                GetWorldTransform(packet.node_id)));
+        cullable_packet_indices_.push_back(i);
+    }
+    for (const auto& packet : packets)
+    {
+        if (!packet.frustum_culling || !packet.instance_count)
+            continue;
+        const auto& bounding_box = packet.static_mesh->GetBoundingBox();
+        const auto node_ids = render_queue_.GetInstanceNodeIds(packet);
+        for (std::uint32_t j = 0; j < node_ids.size(); ++j)
+        {
+            world_bounding_boxes_.push_back(
+                bounding_box.Transform(GetWorldTransform(node_ids[j])));
+            cullable_instance_indices_.push_back(packet.first_instance + j);
+        }
+    }
+    cullable_packet_visibility_.assign(world_bounding_boxes_.size(), 0);
+    view_box_visibility_.resize(world_bounding_boxes_.size());
+    for (const auto& frustum : frustums)
+    {
+        frustum.CullBoxes(world_bounding_boxes_, view_box_visibility_);
+        for (std::size_t i = 0; i < view_box_visibility_.size(); ++i)
+            cullable_packet_visibility_[i] |= view_box_visibility_[i];
+    }
+    std::size_t box_index = 0;
+    for (const auto packet_index : cullable_packet_indices_)
+    {
+        packet_visibility_[packet_index] =
+            cullable_packet_visibility_[box_index++];
+    }
+    for (const auto instance_index : cullable_instance_indices_)
+    {
+        instance_visibility_[instance_index] =
+            cullable_packet_visibility_[box_index++];
+    }
+}
+
+void Renderer::PackInstances()
+{
+    const auto& packets = render_queue_.GetPackets();
+    instance_matrices_.clear();
+    instance_ranges_.assign(packets.size(), {0, 0});
+    for (std::size_t i = 0; i < packets.size(); ++i)
+    {
+        const auto& packet = packets[i];
+        if (!packet.instance_count)
+            continue;
+        const auto first =
+            static_cast<std::uint32_t>(instance_matrices_.size());
+        const auto node_ids = render_queue_.GetInstanceNodeIds(packet);
+        for (std::uint32_t j = 0; j < node_ids.size(); ++j)
+        {
+            if (instance_visibility_[packet.first_instance + j])
+                instance_matrices_.push_back(GetWorldTransform(node_ids[j]));
+        }
+        const auto count =
+            static_cast<std::uint32_t>(instance_matrices_.size()) - first;
+        instance_ranges_[i] = {first, count};
+        packet_visibility_[i] = count ? 1 : 0;
+    }
+}
+
+void Renderer::BuildIndirectBatches(std::uint32_t view_count)
+{
+    const auto& packets = render_queue_.GetPackets();
+    indirect_commands_.clear();
+    indirect_batches_.clear();
+    packet_batches_.assign(packets.size(), no_batch);
+    // Batched meshes can't be occlusion culled one by one.
+    if (!multi_draw_indirect_ || level_.IsOcclusionCulling())
+        return;
+    const DrawPacket* batch_packet = nullptr;
+    for (std::uint32_t i = 0; i < packets.size(); ++i)
+    {
+        const auto& packet = packets[i];
+        // Culled packets are not drawn so they don't split a batch.
+        if (!packet.clear_bits && !packet_visibility_[i])
+            continue;
+        // The model matrix come from the instances so the program has to
+        // take them.
+        const GeometryRange* range =
+            packet.per_instance_model
+                ? geometry_arena_.FindRange(packet.static_mesh_id)
+                : nullptr;
+        if (!range)
+        {
+            batch_packet = nullptr;
+            continue;
+        }
+        if (!batch_packet || batch_packet->program != packet.program ||
+            batch_packet->material != packet.material ||
+            batch_packet->render_target_index != packet.render_target_index ||
+            batch_packet->primitive != packet.primitive ||
+            batch_packet->static_mesh->IsClearBuffer() !=
+                packet.static_mesh->IsClearBuffer() ||
+            indirect_batches_.back().pool != range->pool)
+        {
+            IndirectBatch batch = {};
+            batch.first_packet = i;
+            batch.first_command =
+                static_cast<std::uint32_t>(indirect_commands_.size());
+            batch.pool = range->pool;
+            indirect_batches_.push_back(batch);
+            batch_packet = &packet;
+        }
+        // The base instance select the model matrices of the draw.
+        DrawElementsIndirectCommand command = {};
+        command.count = range->index_count;
+        command.first_index = range->first_index;
+        command.base_vertex = range->base_vertex;
+        if (packet.instance_count)
+        {
+            command.base_instance = instance_ranges_[i].first;
+            command.instance_count = instance_ranges_[i].second;
+        }
+        else
+        {
+            command.base_instance =
+                static_cast<std::uint32_t>(instance_matrices_.size());
+            command.instance_count = 1;
+            instance_matrices_.push_back(GetWorldTransform(packet.node_id));
+        }
+        // The instances of a multi view program are drawn once per view.
+        if (packet.multi_view_program)
+            command.instance_count *= view_count;
+        indirect_commands_.push_back(command);
+        ++indirect_batches_.back().command_count;
+        packet_batches_[i] =
+            static_cast<std::uint32_t>(indirect_batches_.size() - 1);
+    }
+}
+
+void Renderer::UploadDrawData()
+{
+    if (!instance_matrices_.empty())
+    {
+        instance_buffer_.Copy(
+            instance_matrices_.size() * sizeof(glm::mat4),
+            instance_matrices_.data());
+    }
+    if (!indirect_commands_.empty())
+    {
+        indirect_buffer_.Copy(
+            indirect_commands_.size() * sizeof(DrawElementsIndirectCommand),
+            indirect_commands_.data());
+    }
+}
+
+void Renderer::SetInstanceAttributes(
+    std::uint32_t first_instance,
+    bool enable,
+    std::uint32_t view_count /*= 1*/)
+{
+    // Base instance need OpenGL 4.2 so the attributes point at the range.
+    instance_buffer_.Bind();
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        const GLuint location = Program::instance_model_location + i;
+        if (!enable)
+        {
+            glDisableVertexAttribArray(location);
+            continue;
+        }
+        glVertexAttribPointer(
+            location,
+            4,
+            GL_FLOAT,
+            GL_FALSE,
+            sizeof(glm::mat4),
+            reinterpret_cast<const void*>(
+                first_instance * sizeof(glm::mat4) + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, view_count);
+        glEnableVertexAttribArray(location);
+    }
+    instance_buffer_.UnBind();
+}
+
+GLenum Renderer::GetOcclusionQueryTarget()
+{
+    if (GLEW_VERSION_4_3)
+        return GL_ANY_SAMPLES_PASSED_CONSERVATIVE;
+    if (GLEW_VERSION_3_3)
+        return GL_ANY_SAMPLES_PASSED;
+    return GL_SAMPLES_PASSED;
+}
+
+void Renderer::ReadOcclusionQueries()
+{
+    // The results are read once available so the CPU never wait.
+    double latency = 0.0;
+    std::uint32_t result_count = 0;
+    for (auto& [node_id, occlusion_query] : occlusion_queries_)
+    {
+        for (std::size_t i = 0; i < occlusion_query.queries.size(); ++i)
+        {
+            if (!occlusion_query.pending[i])
+                continue;
+            GLuint available = GL_FALSE;
+            glGetQueryObjectuiv(
+                occlusion_query.queries[i],
+                GL_QUERY_RESULT_AVAILABLE,
+                &available);
+            if (!available)
+                continue;
+            GLuint samples = 0;
+            glGetQueryObjectuiv(
+                occlusion_query.queries[i], GL_QUERY_RESULT, &samples);
+            occlusion_query.pending[i] = false;
+            if (samples)
+                ++culling_stats_.occlusion_visible;
+            else
+                ++culling_stats_.occlusion_occluded;
+            latency +=
+                static_cast<double>(frame_index_ - occlusion_query.frames[i]);
+            ++result_count;
+        }
+    }
+    if (result_count)
+        culling_stats_.occlusion_latency = latency / result_count;
+}
+
+GLuint Renderer::GetOcclusionCondition(EntityId node_id) const
+{
+    auto it = occlusion_queries_.find(node_id);
+    if (it == occlusion_queries_.end())
+        return 0;
+    // Only the test of the previous frame is used.
+    const std::size_t slot = (frame_index_ - 1) % 2;
+    if (it->second.frames[slot] != frame_index_ - 1)
+        return 0;
+    return it->second.queries[slot];
+}
+
+void Renderer::DrawOcclusionProxy(
+    EntityId node_id,
+    const AxisAlignedBoundingBox& world_box,
+    const glm::mat4& projection,
+    const glm::mat4& view)
+{
+    if (!occlusion_program_)
+    {
+        occlusion_program_ = file::LoadProgram("occlusion");
+        if (!occlusion_program_)
+            throw std::runtime_error("No occlusion program!");
+    }
+    auto [it, inserted] = occlusion_queries_.try_emplace(node_id);
+    auto& occlusion_query = it->second;
+    if (inserted)
+    {
+        glGenQueries(
+            static_cast<GLsizei>(occlusion_query.queries.size()),
+            occlusion_query.queries.data());
+    }
+    const std::size_t slot = frame_index_ % 2;
+    occlusion_query.frames[slot] = frame_index_;
+    occlusion_query.pending[slot] = true;
+    // The cube is a unit cube around the origin.
+    const glm::mat4 model =
+        glm::scale(
+            glm::translate(
+                glm::mat4(1.0f), (world_box.min + world_box.max) * 0.5f),
+            world_box.max - world_box.min);
+    UniformWrapper uniform_wrapper(projection, view, model, 0.0);
+    occlusion_program_->Use(uniform_wrapper);
+    auto& cube =
+        level_.GetStaticMeshFromId(level_.GetDefaultStaticMeshCubeId());
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.BindVertexArray(dynamic_cast<StaticMesh&>(cube).GetId());
+    state_cache.BindBuffer(
+        GL_ELEMENT_ARRAY_BUFFER,
+        dynamic_cast<Buffer&>(level_.GetBufferFromId(cube.GetIndexBufferId()))
+            .GetId());
+    // Only the depth test, nothing is written.
+    state_cache.ColorMask(false);
+    state_cache.DepthMask(false);
+    glBeginQuery(occlusion_query_target_, occlusion_query.queries[slot]);
+    glDrawElements(
+        GL_TRIANGLES,
+        static_cast<GLsizei>(cube.GetIndexSize() / sizeof(std::uint32_t)),
+        GL_UNSIGNED_INT,
+        nullptr);
+    glEndQuery(occlusion_query_target_);
+    state_cache.ColorMask(true);
+    state_cache.DepthMask(true);
+}
+
+void Renderer::ClearOcclusionQueries()
+{
+    for (const auto& [node_id, occlusion_query] : occlusion_queries_)
+    {
+        glDeleteQueries(
+            static_cast<GLsizei>(occlusion_query.queries.size()),
+            occlusion_query.queries.data());
+    }
+    occlusion_queries_.clear();
+}
+
+void Renderer::DrawPacketGeometry(
+    std::size_t packet_index,
+    GLuint occlusion_condition /*= 0*/,
+    std::uint32_t view_count /*= 1*/)
+{
+    const auto& packet = render_queue_.GetPackets()[packet_index];
+    auto& state_cache = StateCache::GetInstance();
+    const auto batch_index = packet_batches_[packet_index];
+    if (batch_index != no_batch)
+    {
+        const auto& batch = indirect_batches_[batch_index];
+        state_cache.BindVertexArray(geometry_arena_.GetVertexArray(batch.pool));
+        // The base instance of the commands is the offset.
+        SetInstanceAttributes(0, true, view_count);
+        indirect_buffer_.Bind();
+        glMultiDrawElementsIndirect(
+            packet.primitive,
+            GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>(
+                batch.first_command * sizeof(DrawElementsIndirectCommand)),
+            static_cast<GLsizei>(batch.command_count),
+            0);
+        return;
+    }
+    // No draw without index, this was crashing the driver so...
+    if (!packet.static_mesh->GetIndexSize())
+        return;
+    state_cache.BindVertexArray(packet.vertex_array_object);
+    state_cache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, packet.index_buffer);
+    const auto index_count =
+        static_cast<GLsizei>(packet.static_mesh->GetIndexSize()) /
+        sizeof(std::uint32_t);
+    if (packet.instance_count)
+    {
+        const auto [first_instance, instance_count] =
+            instance_ranges_[packet_index];
+        SetInstanceAttributes(first_instance, true, view_count);
+        glDrawElementsInstanced(
+            packet.primitive,
+            index_count,
+            GL_UNSIGNED_INT,
+            nullptr,
+            static_cast<GLsizei>(instance_count * view_count));
+        SetInstanceAttributes(first_instance, false);
+        return;
+    }
+    if (occlusion_condition)
+        glBeginConditionalRender(occlusion_condition, GL_QUERY_NO_WAIT);
+    if (view_count > 1)
+    {
+        glDrawElementsInstanced(
+            packet.primitive,
+            index_count,
+            GL_UNSIGNED_INT,
+            nullptr,
+            static_cast<GLsizei>(view_count));
+    }
+    else
+    {
+        glDrawElements(
+            packet.primitive, index_count, GL_UNSIGNED_INT, nullptr);
+    }
+    if (occlusion_condition)
+        glEndConditionalRender();
+}
+
+std::size_t Renderer::DrawDepthPrepass(
+    std::size_t packet_index,
+    const glm::mat4& projection,
+    const glm::mat4& view,
+    double dt)
+{
+    const auto& packets = render_queue_.GetPackets();
+    const auto& first_packet = packets[packet_index];
+    const glm::vec3 eye = glm::vec3(glm::inverse(view)[3]);
+    // The run is the packets of the program in this pass, the visible ones
+    // (first of a batch) are drawn by distance of their node to the eye.
+    depth_prepass_order_.clear();
+    std::size_t end_index = packet_index;
+    for (; end_index < packets.size(); ++end_index)
+    {
+        const auto& packet = packets[end_index];
+        if (packet.clear_bits || packet.program_id != first_packet.program_id ||
+            (packet.sort_key >> 48) != (first_packet.sort_key >> 48))
+        {
+            break;
+        }
+        const auto batch_index = packet_batches_[end_index];
+        if (!packet_visibility_[end_index] ||
+            (batch_index != no_batch &&
+             indirect_batches_[batch_index].first_packet != end_index))
+        {
+            continue;
+        }
+        const glm::vec3 position =
+            glm::vec3(GetWorldTransform(packet.node_id)[3]);
+        depth_prepass_order_.emplace_back(
+            glm::length(position - eye), static_cast<std::uint32_t>(end_index));
+    }
+    std::sort(depth_prepass_order_.begin(), depth_prepass_order_.end());
+    auto& state_cache = StateCache::GetInstance();
+    auto& depth_only_program = *first_packet.depth_only_program;
+    state_cache.ColorMask(false);
+    for (const auto& [distance, index] : depth_prepass_order_)
+    {
+        const auto& packet = packets[index];
+        UniformWrapper uniform_wrapper(
+            projection,
+            view,
+            (packet.instance_count || packet_batches_[index] != no_batch)
+                ? glm::mat4(1.0f)
+                : GetWorldTransform(packet.node_id),
+            dt);
+        callback_(uniform_wrapper, *packet.static_mesh, *packet.material);
+        depth_only_program.Use(uniform_wrapper);
+        SetSceneUniforms(packet.program_id, depth_only_program);
+        DrawPacketGeometry(index);
+        ++culling_stats_.depth_prepass_draw_calls;
+    }
+    state_cache.ColorMask(true);
+    return end_index;
+}
+
+void Renderer::ReadOverdrawQueries()
+{
+    for (std::size_t i = 0; i < overdraw_query_count_; ++i)
+    {
+        GLuint samples = 0;
+        glGetQueryObjectuiv(overdraw_queries_[i], GL_QUERY_RESULT, &samples);
+        culling_stats_.shaded_samples += samples;
+    }
+}
+
+bool Renderer::UpdatePreRenderProgramHashes()
+{
+    const auto& pre_render_nodes = render_queue_.GetPreRenderNodes();
+    // Same size every frame (unless the queue is compiled) so no allocation.
+    pre_render_program_hashes_.resize(pre_render_nodes.size());
+    bool changed = false;
+    for (std::size_t i = 0; i < pre_render_nodes.size(); ++i)
+    {
+        const auto [node_id, material_id] = pre_render_nodes[i];
+        const auto* program = dynamic_cast<const Program*>(
+            &level_.GetProgramFromId(
+                level_.GetMaterialFromId(material_id).GetProgramId()));
+        const std::uint64_t content_hash =
+            program ? program->GetContentHash() : 0;
+        auto& [previous_node_id, previous_hash] = pre_render_program_hashes_[i];
+        // A node new to the queue is not a change.
+        if (previous_node_id == node_id && previous_hash != content_hash)
+            changed = true;
+        previous_node_id = node_id;
+        previous_hash = content_hash;
+    }
+    return changed;
+}
+
+std::optional<std::uint64_t> Renderer::GetPreRenderKey(
+    EntityId node_id,
+    EntityId material_id,
+    const absl::flat_hash_set<EntityId>& frame_output_ids) const
+{
+    auto& material = level_.GetMaterialFromId(material_id);
+    auto& program = level_.GetProgramFromId(material.GetProgramId());
+    const auto* gl_program = dynamic_cast<const Program*>(&program);
+    if (!gl_program || !gl_program->GetContentHash())
+        return std::nullopt;
+    std::uint64_t key = gl_program->GetContentHash();
+    auto mesh_id = level_.GetSceneNodeFromId(node_id).GetLocalMesh();
+    if (!mesh_id)
+        return std::nullopt;
+    auto& static_mesh = level_.GetStaticMeshFromId(mesh_id);
+    key = CombineContentHash(key, static_mesh.GetName());
+    key = CombineContentHash(key, std::to_string(static_mesh.GetIndexSize()));
+    const auto& model = GetWorldTransform(node_id);
+    key = CombineContentHash(
+        key,
+        std::string_view(
+            reinterpret_cast<const char*>(&model), sizeof(glm::mat4)));
+    for (const auto id : material.GetIds())
+    {
+        if (level_.GetEnumTypeFromId(id) != EntityTypeEnum::TEXTURE)
+            continue;
+        auto& texture = level_.GetTextureFromId(id);
+        if (!texture.GetContentHash())
+        {
+            material.DisableAll();
+            return std::nullopt;
+        }
+        const auto [uniform_name, unit] = material.EnableTextureId(id);
+        key = CombineContentHash(key, uniform_name);
+        key = CombineContentHash(
+            key,
+            fmt::format(
+                "{} {} {} {} {}",
+                texture.GetContentHash(),
+                static_cast<int>(texture.GetMinFilter()),
+                static_cast<int>(texture.GetMagFilter()),
+                static_cast<int>(texture.GetWrapS()),
+                static_cast<int>(texture.GetWrapT())));
+    }
+    material.DisableAll();
+    for (const auto id : program.GetOutputTextureIds())
+    {
+        if (frame_output_ids.contains(id))
+            return std::nullopt;
+        auto& texture = level_.GetTextureFromId(id);
+        key = CombineContentHash(
+            key,
+            fmt::format(
+                "{} {} {} {} {}",
+                texture.GetSize().x,
+                texture.GetSize().y,
+                static_cast<int>(texture.GetPixelElementSize()),
+                static_cast<int>(texture.GetPixelStructure()),
+                texture.IsCubeMap()));
+    }
+    return key;
+}
+
+void Renderer::BeginPassTiming(EntityId program_id)
+{
+    if (!pass_timing_frame_ || timed_program_id_ == program_id)
+        return;
+    EndPassTiming();
+    GLuint query = 0;
+    if (free_queries_.empty())
+    {
+        glGenQueries(1, &query);
+    }
+    else
+    {
+        query = free_queries_.back();
+        free_queries_.pop_back();
+    }
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    pass_query_frames_[(pass_query_first_ + pass_query_frame_count_ - 1) %
+                       pass_query_frames_.size()]
+        .emplace_back(program_id, query);
+    timed_program_id_ = program_id;
+}
+
+void Renderer::EndPassTiming()
+{
+    if (timed_program_id_ == NullId)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    timed_program_id_ = NullId;
+}
+
+void Renderer::ReadPassTiming()
+{
+    auto& render_graph = render_queue_.GetRenderGraph();
+    // Read the frames in flight (oldest first) that the GPU has finished,
+    // the results are never waited on.
+    while (pass_query_frame_count_)
+    {
+        auto& pass_queries = pass_query_frames_[pass_query_first_];
+        const bool available =
+            std::ranges::all_of(pass_queries, [](const auto& pass_query) {
+                GLuint query_available = GL_FALSE;
+                glGetQueryObjectuiv(
+                    pass_query.second,
+                    GL_QUERY_RESULT_AVAILABLE,
+                    &query_available);
+                return query_available == GL_TRUE;
+            });
+        if (!available)
+            break;
+        // A program can be timed more than once per frame (it is split by
+        // the other passes or the views).
+        pass_times_.assign(render_graph.GetPasses().size(), 0.0);
+        for (const auto& [program_id, query] : pass_queries)
+        {
+            GLuint64 time_elapsed = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &time_elapsed);
+            free_queries_.push_back(query);
+            // The queue could have been compiled since.
+            auto maybe_index = render_graph.FindPass(program_id);
+            if (maybe_index)
+                pass_times_[*maybe_index] += time_elapsed / 1e6;
+        }
+        if (!pass_queries.empty())
+        {
+            for (std::uint32_t i = 0; i < pass_times_.size(); ++i)
+            {
+                render_graph.SetPassTime(i, pass_times_[i]);
+            }
+            ++pass_timing_count_;
+        }
+        pass_queries.clear();
+        pass_query_first_ = (pass_query_first_ + 1) % pass_query_frames_.size();
+        --pass_query_frame_count_;
+    }
+    // The frame is not timed in case the GPU is too far behind.
+    pass_timing_frame_ =
+        pass_timing_ && pass_query_frame_count_ < pass_query_frames_.size();
+    if (pass_timing_frame_)
+        ++pass_query_frame_count_;
+}
+
+FrameBufferKey Renderer::GetFrameBufferKey(
+    std::span<const OutputTexture> outputs) const
+{
+    FrameBufferKey frame_buffer_key = {};
+    frame_buffer_key.depth_render_buffer = render_buffer_.GetId();
+    for (const auto& output : outputs)
+    {
+        frame_buffer_key.AddColorAttachment(
+            output.texture,
+            output.is_cube_map
+                ? FrameBuffer::GetFrameTextureType(texture_frame_)
+                : FrameTextureType::TEXTURE_2D);
+    }
+    return frame_buffer_key;
+}
+
+void Renderer::UploadViews(std::span<const RenderView> views)
+{
+    // Same layout as the FrameViews block (std140), see
+    // CreateMultiViewProgram.
+    std::array<glm::mat4, Program::max_view_count * 2> matrices = {};
+    view_viewports_.clear();
+    for (std::size_t i = 0; i < views.size(); ++i)
+    {
+        matrices[i] = views[i].projection;
+        matrices[Program::max_view_count + i] = views[i].view;
+        view_viewports_.emplace_back(views[i].viewport);
+    }
+    view_buffer_.Copy(sizeof(matrices), matrices.data());
+    StateCache::GetInstance().BindBufferBase(
+        GL_UNIFORM_BUFFER, Program::view_block_binding, view_buffer_.GetId());
+}
+
+void Renderer::ExecuteRenderQueue(
+    std::span<const RenderView> views, double dt)
+{
+    const auto& packets = render_queue_.GetPackets();
+    if (packets.empty())
+        return;
+    // The depth prepass and the occlusion tests are made from the first
+    // view and only in case there is one.
+    const glm::mat4& projection = views[0].projection;
+    const glm::mat4& view = views[0].view;
+    const auto view_count = static_cast<std::uint32_t>(views.size());
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.Viewport(glm::ivec4(views[0].viewport));
+    ++frame_index_;
+    const bool occlusion_culling = level_.IsOcclusionCulling();
+    if (occlusion_culling)
+        ReadOcclusionQueries();
+    view_frustums_.clear();
+    for (const auto& render_view : views)
+    {
+        view_frustums_.emplace_back(render_view.projection, render_view.view);
+    }
+    CullPackets(view_frustums_);
+    PackInstances();
+    BuildIndirectBatches(view_count);
+    UploadDrawData();
+    if (view_count > 1)
+        UploadViews(views);
+    // The viewports of the views are set (for the multi view programs) or
+    // a single one (for the programs drawn once per view).
+    bool view_viewports_set = false;
+    // The proxies of the meshes are not tested when the camera is inside.
+    const glm::vec3 eye = glm::vec3(glm::inverse(view)[3]);
+    // Only change the state that differ from the previous packet (the state
+    // cache filter what is still the same across packets and frames).
+    constexpr std::uint32_t no_render_target =
+        std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t current_render_target = no_render_target;
+    const MaterialInterface* current_material = nullptr;
+    // End of the depth prepass run being drawn (0 if none), after the run
+    // the depth test is back to the default (set by the device) and the
+    // depth is cleared once for the meshes of the run.
+    std::size_t depth_prepass_end = 0;
+    auto end_depth_prepass = [&]() {
+        state_cache.DepthFunc(GL_LEQUAL);
+        state_cache.DepthMask(true);
+        if (packets[depth_prepass_end - 1].static_mesh->IsClearBuffer() &&
+            !occlusion_culling)
+        {
+            glClear(GL_DEPTH_BUFFER_BIT);
+        }
+        depth_prepass_end = 0;
+    };
+    overdraw_query_count_ = 0;
+    // The content of the pooled textures is not needed after their last
+    // use, so it doesn't have to be kept (or written back on tilers).
+    const bool invalidate = GLEW_VERSION_4_3;
+    const auto last_uses = render_target_pool_.GetLastUses();
+    auto last_use_it = last_uses.begin();
+    auto invalidate_until = [&](std::size_t packet_index) {
+        for (; last_use_it != last_uses.end() &&
+               last_use_it->first < packet_index;
+             ++last_use_it)
+        {
+            if (invalidate)
+                glInvalidateTexImage(last_use_it->second, 0);
+        }
+    };
+    for (std::size_t packet_index = 0; packet_index < packets.size();
+         ++packet_index)
+    {
+        const auto& packet = packets[packet_index];
+        invalidate_until(packet_index);
+        if (depth_prepass_end && packet_index == depth_prepass_end)
+            end_depth_prepass();
+        // Clear packet, this is done outside of the frame buffer.
+        if (packet.clear_bits)
+        {
+            if (current_render_target != no_render_target)
+            {
+                state_cache.BindFramebuffer(0);
+                current_render_target = no_render_target;
+            }
+            glClear(packet.clear_bits);
+            continue;
+        }
+        // Out of the frustum, as every mesh clear the depth after it is
+        // drawn skipping it (and its clear) doesn't change the others.
+        const auto instance_count = instance_ranges_[packet_index].second;
+        if (!packet_visibility_[packet_index])
+        {
+            culling_stats_.culled +=
+                packet.instance_count ? packet.instance_count : 1;
+            continue;
+        }
+        if (packet.instance_count)
+        {
+            culling_stats_.drawn += instance_count;
+            culling_stats_.culled += packet.instance_count - instance_count;
         }
         else
         {
-            // This should also call clear buffers.
-            RenderNode(p.first, material_id, projection, view, dt);
+            ++culling_stats_.drawn;
+        }
+        // The packets of a batch are drawn with the first one.
+        const auto batch_index = packet_batches_[packet_index];
+        if (batch_index != no_batch &&
+            indirect_batches_[batch_index].first_packet != packet_index)
+        {
+            continue;
+        }
+        ++culling_stats_.draw_calls;
+        if (pass_timing_)
+            BeginPassTiming(packet.program_id);
+
+        // The attachments are made once per set of outputs, switching
+        // render target is a single bind.
+        if (packet.render_target_index != current_render_target)
+        {
+            frame_buffer_cache_
+                .GetFrameBuffer(
+                    GetFrameBufferKey(render_queue_.GetOutputTextures(packet)),
+                    render_buffer_)
+                .Bind();
+            current_render_target = packet.render_target_index;
+        }
+
+        // The depth of the run is drawn first (front to back), the meshes
+        // are then shaded where their depth is equal so once per pixel.
+        if (packet.depth_only_program && !depth_prepass_end &&
+            view_count == 1)
+        {
+            depth_prepass_end =
+                DrawDepthPrepass(packet_index, projection, view, dt);
+            state_cache.DepthFunc(GL_EQUAL);
+            state_cache.DepthMask(false);
+        }
+
+        // Test the bounding box against the depth of the meshes drawn
+        // before, the mesh itself is drawn in case the test of the previous
+        // frame passed (the GPU doesn't wait for a late result).
+        GLuint occlusion_condition = 0;
+        if (occlusion_culling && view_count == 1 && packet.frustum_culling &&
+            !packet.instance_count && batch_index == no_batch &&
+            !packet.depth_only_program)
+        {
+            const auto world_box =
+                packet.static_mesh->GetBoundingBox().Transform(
+                    GetWorldTransform(packet.node_id));
+            if (!IsInside(world_box, eye))
+            {
+                occlusion_condition = GetOcclusionCondition(packet.node_id);
+                DrawOcclusionProxy(
+                    packet.node_id, world_box, projection, view);
+            }
+        }
+
+        // A multi view program draw all the views at once, the other ones
+        // are drawn once per view.
+        const bool multi_view = view_count > 1 && packet.multi_view_program;
+        auto& program =
+            multi_view ? *packet.multi_view_program : *packet.program;
+        last_program_id_ = packet.program_id;
+        // Instances (and batches) have their world transform in the instance
+        // buffer.
+        const glm::mat4 model =
+            (packet.instance_count || batch_index != no_batch)
+                ? glm::mat4(1.0f)
+                : GetWorldTransform(packet.node_id);
+        const std::uint32_t draw_count = multi_view ? 1 : view_count;
+        for (std::uint32_t view_index = 0; view_index < draw_count;
+             ++view_index)
+        {
+            const auto& render_view = views[view_index];
+            if (multi_view && !view_viewports_set)
+            {
+                state_cache.ViewportArray(view_viewports_);
+                view_viewports_set = true;
+            }
+            else if (!multi_view && view_count > 1)
+            {
+                state_cache.Viewport(glm::ivec4(render_view.viewport));
+                view_viewports_set = false;
+            }
+            UniformWrapper uniform_wrapper(
+                render_view.projection, render_view.view, model, dt);
+            callback_(uniform_wrapper, *packet.static_mesh, *packet.material);
+            program.Use(uniform_wrapper);
+            SetSceneUniforms(packet.program_id, program);
+            if (multi_view)
+            {
+                program.Uniform(
+                    "frame_view_count", static_cast<int>(view_count));
+            }
+
+            // A material always use the same program so textures and
+            // samplers are only set when the material change. Textures are
+            // not unbound (the ones rendered to are unbound when attached).
+            if (packet.material != current_material)
+            {
+                for (const auto& binding :
+                     render_queue_.GetTextureBindings(packet))
+                {
+                    state_cache.BindTextureUnit(
+                        binding.unit, binding.target, binding.texture);
+                    program.Uniform(binding.uniform_name, binding.unit);
+                }
+                current_material = packet.material;
+            }
+
+            if (overdraw_counting_)
+            {
+                if (overdraw_query_count_ == overdraw_queries_.size())
+                {
+                    overdraw_queries_.push_back(0);
+                    glGenQueries(1, &overdraw_queries_.back());
+                }
+                glBeginQuery(
+                    GL_SAMPLES_PASSED,
+                    overdraw_queries_[overdraw_query_count_++]);
+            }
+            DrawPacketGeometry(
+                packet_index, occlusion_condition, multi_view ? view_count : 1);
+            if (overdraw_counting_)
+                glEndQuery(GL_SAMPLES_PASSED);
+        }
+        culling_stats_.draw_calls += draw_count - 1;
+        if (multi_view)
+            ++culling_stats_.multi_view_draw_calls;
+        // With occlusion culling the meshes share the depth buffer, in a
+        // depth prepass run it is cleared after the run.
+        if (packet.static_mesh->IsClearBuffer() && !occlusion_culling &&
+            !depth_prepass_end)
+        {
+            glClear(GL_DEPTH_BUFFER_BIT);
         }
     }
+    if (depth_prepass_end)
+        end_depth_prepass();
+    EndPassTiming();
+    if (overdraw_counting_)
+        ReadOverdrawQueries();
+    // The depth buffer is only used inside a frame (cleared by the meshes or
+    // the clean buffer nodes) so its content doesn't have to be kept (or
+    // written back on tilers).
+    if (current_render_target != no_render_target && invalidate)
+    {
+        const GLenum attachment = GL_DEPTH_ATTACHMENT;
+        glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &attachment);
+    }
+    invalidate_until(packets.size());
+    state_cache.BindVertexArray(0);
+    state_cache.BindFramebuffer(0);
 }
 
 } // End namespace frame::opengl.
@@ -1,11 +1,30 @@
 #pragma once
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <array>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "frame/bounding_box.h"
+#include "frame/dynamic_resolution.h"
+#include "frame/frustum.h"
 
-#include "frame/opengl/frame_buffer.h"
+#include "frame/opengl/buffer.h"
+#include "frame/opengl/frame_buffer_cache.h"
+#include "frame/opengl/geometry_arena.h"
+#include "frame/opengl/pre_render_cache.h"
 #include "frame/opengl/render_buffer.h"
+#include "frame/opengl/render_queue.h"
+#include "frame/opengl/render_target_pool.h"
 #include "frame/program_interface.h"
 #include "frame/renderer_interface.h"
+#include "frame/scene_state.h"
 #include "frame/static_mesh_interface.h"
 #include "frame/uniform_interface.h"
 #include "frame/window_interface.h"
@@ -13,6 +32,40 @@
 namespace frame::opengl
 {
 
+/**
+ * @class CullingStats
+ * @brief Number of meshes drawn and skipped by the frustum culling and
+ *        number of draw calls (instances of a mesh share a draw call). With
+ *        occlusion culling the results of the queries read in the frame and
+ *        the average number of frames they took to be available. With
+ *        overdraw counting the samples shaded by the draws (compared to the
+ *        size of the viewport this is the overdraw). With many views the
+ *        draw calls that drew all of them at once.
+ */
+struct CullingStats
+{
+    std::uint32_t drawn = 0;
+    std::uint32_t culled = 0;
+    std::uint32_t draw_calls = 0;
+    std::uint32_t multi_view_draw_calls = 0;
+    std::uint32_t depth_prepass_draw_calls = 0;
+    std::uint64_t shaded_samples = 0;
+    std::uint32_t occlusion_visible = 0;
+    std::uint32_t occlusion_occluded = 0;
+    double occlusion_latency = 0.0;
+};
+
+/**
+ * @class RenderView
+ * @brief A camera of a multi view render and the viewport it is drawn to.
+ */
+struct RenderView
+{
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::uvec4 viewport = glm::uvec4(0, 0, 0, 0);
+};
+
 /**
  * @class Renderer
  * @brief This is the renderer class this is the class that is doing the
@@ -27,6 +80,8 @@ class Renderer : public RendererInterface
      * @param viewport: The viewport.
      */
     Renderer(LevelInterface& level, glm::uvec4 viewport);
+    //! @brief Destructor delete the timer queries.
+    ~Renderer() override;
 
   public:
     /**
@@ -78,6 +133,36 @@ class Renderer : public RendererInterface
     {
         viewport_ = viewport;
     }
+    /**
+     * @brief Resize the render in place, only the textures relative to the
+     *        window and the depth buffer are reallocated (the programs,
+     *        meshes and fixed size textures are kept).
+     * @param size: New size of the window.
+     */
+    void Resize(glm::uvec2 size);
+    /**
+     * @brief Set the scale of the internal resolution, the textures relative
+     *        to the window are reallocated at the scaled size and upscaled
+     *        by the display pass.
+     * @param scale: Scale of each axis (in ]0, 1]).
+     */
+    void SetResolutionScale(float scale);
+    //! @brief Get the scale of the internal resolution.
+    float GetResolutionScale() const
+    {
+        return resolution_scale_;
+    }
+    //! @brief Get the size of the textures relative to the window.
+    glm::uvec2 GetRenderSize() const;
+    /**
+     * @brief Set the filter used by the display pass to upscale (in case the
+     *        display program has an upscale_filter uniform).
+     * @param upscale_filter: The filter.
+     */
+    void SetUpscaleFilter(UpscaleFilterEnum upscale_filter)
+    {
+        upscale_filter_ = upscale_filter;
+    }
     /**
      * @brief Add a mesh render callback.
      * @param callback: The callback to be added to the render.
@@ -86,6 +171,83 @@ class Renderer : public RendererInterface
     {
         callback_ = callback;
     }
+    /**
+     * @brief Get the meshes drawn and culled by the last render all meshes.
+     * @return The culling stats.
+     */
+    CullingStats GetCullingStats() const
+    {
+        return culling_stats_;
+    }
+    /**
+     * @brief Enable or disable the pruning of the passes whose outputs never
+     *        reach the display texture.
+     * @param enable: Enable or disable (enabled by default).
+     */
+    void SetPassPruning(bool enable)
+    {
+        render_queue_.SetPassPruning(enable);
+    }
+    /**
+     * @brief Enable or disable the GPU timing of the passes, the time of a
+     *        frame is read a few frames later (once the GPU is done).
+     * @param enable: Enable or disable (disabled by default).
+     */
+    void SetPassTiming(bool enable)
+    {
+        pass_timing_ = enable;
+    }
+    /**
+     * @brief Get the number of frames whose pass timing was read (the time
+     *        in the render graph is new when it changed).
+     * @return The count of timed frames read.
+     */
+    std::uint64_t GetPassTimingCount() const
+    {
+        return pass_timing_count_;
+    }
+    /**
+     * @brief Enable or disable the counting of the samples shaded by the
+     *        draws (wait on the GPU at the end of the frame, debug only).
+     * @param enable: Enable or disable (disabled by default).
+     */
+    void SetOverdrawCounting(bool enable)
+    {
+        overdraw_counting_ = enable;
+    }
+    //! @brief Get the render graph of the level (passes and timing).
+    const RenderGraph& GetRenderGraph() const
+    {
+        return render_queue_.GetRenderGraph();
+    }
+    /**
+     * @brief Dump the render graph (with the pass timing) for debugging.
+     * @return The graph in the graphviz dot format.
+     */
+    std::string DumpRenderGraph() const
+    {
+        return render_queue_.GetRenderGraph().ToDot();
+    }
+    //! @brief Get the memory used by the transient render targets.
+    RenderTargetPoolStats GetRenderTargetPoolStats() const
+    {
+        return render_target_pool_.GetStats();
+    }
+    /**
+     * @brief Set the cache of the pre render results (owned by the device so
+     *        it outlive the renderer), the pre render whose outputs are
+     *        still there or in the cache are skipped.
+     * @param pre_render_cache: The cache (or null for none).
+     */
+    void SetPreRenderCache(PreRenderCache* pre_render_cache)
+    {
+        pre_render_cache_ = pre_render_cache;
+    }
+    //! @brief Get the number of pre render skipped (results reused).
+    std::uint32_t GetPreRenderCachedCount() const
+    {
+        return pre_render_cached_count_;
+    }
 
   public:
     /**
@@ -127,6 +289,16 @@ class Renderer : public RendererInterface
         const glm::mat4& projection,
         const glm::mat4& view,
         double dt = 0.0) override;
+    /**
+     * @brief Render all meshes for many views (stereo or many cameras), the
+     *        meshes of the programs with a multi view variant are drawn once
+     *        for all the views (up to Program::max_view_count at a time),
+     *        the other ones once per view.
+     * @param views: The views (camera and viewport).
+     * @param dt: Delta time between the beginning of execution and now in
+     * seconds.
+     */
+    void RenderAllMeshes(std::span<const RenderView> views, double dt = 0.0);
     /**
      * @brief Display to the screen at dt time.
      * @param dt: Delta time between the beginning of execution and now in
@@ -139,8 +311,217 @@ class Renderer : public RendererInterface
      */
     void SetDepthTest(bool enable) override;
 
+  protected:
+    /**
+     * @brief Execute the compiled render queue (everything but pre render).
+     * @param views: The views (at most Program::max_view_count).
+     * @param dt: Delta time between the beginning of execution and now in
+     * seconds.
+     */
+    void ExecuteRenderQueue(std::span<const RenderView> views, double dt);
+    /**
+     * @brief Get the world transform of a node from the scene state (or
+     *        from the level for nodes added after the publish).
+     * @param node_id: The node id.
+     * @return The world transform of the node.
+     */
+    const glm::mat4& GetWorldTransform(EntityId node_id) const;
+    /**
+     * @brief Set the uniforms of a program published in the scene state.
+     * @param program_id: The program id (in the level).
+     * @param program: The program in use (or one of its variants).
+     */
+    void SetSceneUniforms(
+        EntityId program_id, const ProgramInterface& program) const;
+    /**
+     * @brief Get the frame buffer key of a set of output textures (cube maps
+     *        are attached with the face of the cube map target).
+     * @param outputs: The output textures (in attachment order).
+     * @return The key to use with the frame buffer cache.
+     */
+    FrameBufferKey GetFrameBufferKey(
+        std::span<const OutputTexture> outputs) const;
+    /**
+     * @brief Check the packets (and the instances) of the render queue
+     *        against the frustums and fill the packet visibility (visible in
+     *        one of the frustums).
+     * @param frustums: The frustums of the cameras.
+     */
+    void CullPackets(std::span<const Frustum> frustums);
+    /**
+     * @brief Pack the world transforms of the visible instances in the
+     *        instance buffer (a range per instanced packet), instanced
+     *        packets with no visible instance are set as not visible.
+     */
+    void PackInstances();
+    /**
+     * @brief Point the per instance model matrix of the bound vertex array
+     *        at a range of the instance buffer (or disable it).
+     * @param first_instance: First matrix of the range in the buffer.
+     * @param enable: Enable or disable the per instance matrix.
+     * @param view_count: Number of views the instances are drawn to (the
+     *        instances of a matrix).
+     */
+    void SetInstanceAttributes(
+        std::uint32_t first_instance,
+        bool enable,
+        std::uint32_t view_count = 1);
+    /**
+     * @brief Group the visible packets that are in the geometry arena and
+     *        share a program, a material and a render target into batches
+     *        drawn with a single multi draw indirect call, the model matrix
+     *        of every draw is packed with the instances.
+     * @param view_count: Number of views drawn by the multi view programs.
+     */
+    void BuildIndirectBatches(std::uint32_t view_count);
+    //! @brief Upload the instance matrices and the indirect commands.
+    void UploadDrawData();
+    /**
+     * @brief Draw the mesh (instances or batch) of a packet, the program,
+     *        the uniforms and the render target are already set.
+     * @param packet_index: Index of the packet in the queue.
+     * @param occlusion_condition: Query the draw is conditioned on (0 if
+     *        none).
+     * @param view_count: Number of views drawn at once (by a multi view
+     *        program).
+     */
+    void DrawPacketGeometry(
+        std::size_t packet_index,
+        GLuint occlusion_condition = 0,
+        std::uint32_t view_count = 1);
+    /**
+     * @brief Upload the views to the uniform block of the multi view
+     *        programs (and keep their viewports).
+     * @param views: The views (at most Program::max_view_count).
+     */
+    void UploadViews(std::span<const RenderView> views);
+    /**
+     * @brief Reallocate the depth buffer and the textures relative to the
+     *        window at the render size (the ones that keep their size keep
+     *        their content).
+     */
+    void ResizeRenderTargets();
+    /**
+     * @brief Draw the depth of the visible packets of a run (the packets of
+     *        the same program in the same pass) front to back with the depth
+     *        only variant of the program.
+     * @param packet_index: First packet of the run to be drawn.
+     * @param projection: Projection matrix used.
+     * @param view: View matrix used.
+     * @param dt: Delta time between the beginning of execution and now in
+     *        seconds.
+     * @return Index of the packet after the run.
+     */
+    std::size_t DrawDepthPrepass(
+        std::size_t packet_index,
+        const glm::mat4& projection,
+        const glm::mat4& view,
+        double dt);
+    //! @brief Read the samples shaded in the frame (wait on the GPU).
+    void ReadOverdrawQueries();
+    /**
+     * @brief Get the content hash of a pre render, the program (sources and
+     *        parameters), the mesh and its transform and the input textures
+     *        (content and sampling) and the layout of the outputs.
+     * @param node_id: The node id.
+     * @param material_id: The material id.
+     * @param frame_output_ids: Textures written by the frame (their content
+     *        doesn't stay the one of the pre render).
+     * @return The key (none if an input content is unknown).
+     */
+    std::optional<std::uint64_t> GetPreRenderKey(
+        EntityId node_id,
+        EntityId material_id,
+        const absl::flat_hash_set<EntityId>& frame_output_ids) const;
+    /**
+     * @brief Update the content hashes of the pre render programs.
+     * @return True if the program of a pre render node changed (parameters
+     *        overridden) since the previous frame.
+     */
+    bool UpdatePreRenderProgramHashes();
+    /**
+     * @brief Check if a node (drawn with a material) is in a frustum, nodes
+     *        that can't be culled are always in.
+     * @param node_id: The node id.
+     * @param material_id: The material id.
+     * @param frustum: The frustum.
+     * @return True if the node has to be drawn.
+     */
+    bool IsInFrustum(
+        EntityId node_id, EntityId material_id, const Frustum& frustum);
+    /**
+     * @brief Get the best occlusion query supported (any sample passed
+     *        conservative need OpenGL 4.3 and any sample passed 3.3).
+     * @return The query target.
+     */
+    static GLenum GetOcclusionQueryTarget();
+    /**
+     * @brief Start timing a pass (end the timing of the previous one).
+     * @param program_id: Program of the pass.
+     */
+    void BeginPassTiming(EntityId program_id);
+    //! @brief End the timing of the current pass (if any).
+    void EndPassTiming();
+    /**
+     * @brief Read the timing of the previous frames that are available in
+     *        the render graph and start the timing of a new frame.
+     */
+    void ReadPassTiming();
+    //! @brief Read the occlusion queries that are available (in the stats).
+    void ReadOcclusionQueries();
+    /**
+     * @brief Get the occlusion query of the previous frame of a node.
+     * @param node_id: The node id.
+     * @return The query to use for conditional render (0 if none).
+     */
+    GLuint GetOcclusionCondition(EntityId node_id) const;
+    /**
+     * @brief Draw the bounding box of a node (without writing anything) in
+     *        the occlusion query of this frame.
+     * @param node_id: The node id.
+     * @param world_box: Bounding box of the node in world space.
+     * @param projection: Projection matrix used.
+     * @param view: View matrix used.
+     */
+    void DrawOcclusionProxy(
+        EntityId node_id,
+        const AxisAlignedBoundingBox& world_box,
+        const glm::mat4& projection,
+        const glm::mat4& view);
+    //! @brief Delete the occlusion queries.
+    void ClearOcclusionQueries();
+
+  private:
+    /**
+     * @brief Packets drawn in a single multi draw indirect call (the state
+     *        is set by the first one).
+     */
+    struct IndirectBatch
+    {
+        std::uint32_t first_packet = 0;
+        std::uint32_t first_command = 0;
+        std::uint32_t command_count = 0;
+        std::uint32_t pool = 0;
+    };
+    static constexpr std::uint32_t no_batch =
+        std::numeric_limits<std::uint32_t>::max();
+    /**
+     * @brief Occlusion queries of a node, one per frame parity (the one of
+     *        the previous frame is used while the other one is drawn).
+     */
+    struct OcclusionQuery
+    {
+        std::array<GLuint, 2> queries = {0, 0};
+        // Frame the query was drawn in (0 never).
+        std::array<std::uint64_t, 2> frames = {0, 0};
+        // The result was not read yet.
+        std::array<bool, 2> pending = {false, false};
+    };
+
   private:
     LevelInterface& level_;
+    // Scene state snapshot held while rendering (released after).
+    std::shared_ptr<const SceneState> scene_state_ = nullptr;
     EntityId last_program_id_ = NullId;
     Logger& logger_ = Logger::GetInstance();
     // Projection / View / Model matrices.
@@ -149,15 +530,87 @@ class Renderer : public RendererInterface
     glm::mat4 model_ = glm::mat4(1.0f);
     // Viewport top left and bottom right.
     glm::uvec4 viewport_;
-    // Frame & Render buffers.
-    FrameBuffer frame_buffer_{};
+    // Size of the window and scale of the textures relative to it.
+    glm::uvec2 window_size_;
+    float resolution_scale_ = 1.0f;
+    UpscaleFilterEnum upscale_filter_ = UpscaleFilterEnum::BILINEAR;
+    // Depth buffer and frame buffers (one per set of outputs).
     RenderBuffer render_buffer_{};
+    FrameBufferCache frame_buffer_cache_{};
     // Display ids.
     EntityId display_program_id_ = 0;
     EntityId display_material_id_ = 0;
     // Texture frame (used in render mesh).
     frame::proto::TextureFrame texture_frame_;
     bool first_render_ = true;
+    // Sorted draw packets, compiled again when the level version change.
+    RenderQueue render_queue_{};
+    // Results of the pre render (not owned) and the ones reused.
+    PreRenderCache* pre_render_cache_ = nullptr;
+    std::uint32_t pre_render_cached_count_ = 0;
+    // Content hash of the program of every pre render node (by node).
+    std::vector<std::pair<EntityId, std::uint64_t>> pre_render_program_hashes_ =
+        {};
+    // Storage of the transient textures (shared when they don't overlap).
+    RenderTargetPool render_target_pool_{level_};
+    // World bounds of the packets that can be culled (and their index) and
+    // visibility of every packet, kept so they are not allocated per frame.
+    std::vector<AxisAlignedBoundingBox> world_bounding_boxes_ = {};
+    std::vector<std::uint32_t> cullable_packet_indices_ = {};
+    std::vector<std::uint8_t> cullable_packet_visibility_ = {};
+    // Frustum of every view and visibility of the boxes in one of them.
+    std::vector<Frustum> view_frustums_ = {};
+    std::vector<std::uint8_t> view_box_visibility_ = {};
+    std::vector<std::uint8_t> packet_visibility_ = {};
+    // Same for the instances, the world transforms of the visible ones are
+    // packed (per packet) in the instance buffer.
+    std::vector<std::uint32_t> cullable_instance_indices_ = {};
+    std::vector<std::uint8_t> instance_visibility_ = {};
+    std::vector<glm::mat4> instance_matrices_ = {};
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> instance_ranges_ =
+        {};
+    Buffer instance_buffer_{
+        BufferTypeEnum::ARRAY_BUFFER, BufferUsageEnum::STREAM_DRAW};
+    // Static meshes copied in shared buffers and the batches drawn from it
+    // (only in case multi draw indirect is supported).
+    bool multi_draw_indirect_ = GeometryArena::IsSupported();
+    GeometryArena geometry_arena_{};
+    std::vector<DrawElementsIndirectCommand> indirect_commands_ = {};
+    std::vector<IndirectBatch> indirect_batches_ = {};
+    std::vector<std::uint32_t> packet_batches_ = {};
+    Buffer indirect_buffer_{
+        BufferTypeEnum::DRAW_INDIRECT_BUFFER, BufferUsageEnum::STREAM_DRAW};
+    // Matrices of the views of the multi view programs (FrameViews block)
+    // and their viewports.
+    Buffer view_buffer_{
+        BufferTypeEnum::UNIFORM_BUFFER, BufferUsageEnum::STREAM_DRAW};
+    std::vector<glm::vec4> view_viewports_ = {};
+    CullingStats culling_stats_ = {};
+    // Occlusion queries (by node) and the program drawing the proxies.
+    std::uint64_t frame_index_ = 0;
+    absl::flat_hash_map<EntityId, OcclusionQuery> occlusion_queries_ = {};
+    std::unique_ptr<ProgramInterface> occlusion_program_ = nullptr;
+    GLenum occlusion_query_target_ = GetOcclusionQueryTarget();
+    // Packets of a depth prepass run sorted front to back (view distance and
+    // packet index), kept so it is not allocated per frame.
+    std::vector<std::pair<float, std::uint32_t>> depth_prepass_order_ = {};
+    // Samples passed queries of the draws (the first ones are used).
+    bool overdraw_counting_ = false;
+    std::vector<GLuint> overdraw_queries_ = {};
+    std::size_t overdraw_query_count_ = 0;
+    // Timer queries of the passes (by program) of the frames in flight (a
+    // ring, the current frame is the last one), read once available so the
+    // GPU is not waited on, and the ones that can be reused.
+    bool pass_timing_ = false;
+    bool pass_timing_frame_ = false;
+    EntityId timed_program_id_ = NullId;
+    std::array<std::vector<std::pair<EntityId, GLuint>>, 3>
+        pass_query_frames_ = {};
+    std::size_t pass_query_first_ = 0;
+    std::size_t pass_query_frame_count_ = 0;
+    std::uint64_t pass_timing_count_ = 0;
+    std::vector<GLuint> free_queries_ = {};
+    std::vector<double> pass_times_ = {};
     // The render callback it will be called once per mesh.
     RenderCallback callback_ =
         [](UniformInterface&, StaticMeshInterface&, MaterialInterface&) {};
@@ -82,6 +82,7 @@ void SDLOpenGLNone::Run(std::function<void()> lambda)
         plugin_interface->Update(*device_.get(), 0.0);
     }
     lambda();
+    device_->GetLevel().DestroyRemovedEntities();
 }
 
 void* SDLOpenGLNone::GetGraphicContext() const
@@ -7,9 +7,14 @@
 #pragma comment(lib, "Shcore.lib")
 #endif
 
+#include <fmt/format.h>
+#include <iterator>
+
+#include "frame/allocation_tracker.h"
 #include "frame/gui/draw_gui_interface.h"
 #include "frame/opengl/gui/sdl_opengl_draw_gui.h"
 #include "frame/opengl/message_callback.h"
+#include "frame/opengl/state_cache.h"
 
 namespace frame::opengl
 {
@@ -71,8 +76,12 @@ void SDLOpenGLWindow::Run(std::function<void()> lambda)
     double previous_count = 0.0;
     // Timing counter.
     auto start = std::chrono::system_clock::now();
+    auto& allocation_tracker = AllocationTracker::GetInstance();
+    auto& state_cache = StateCache::GetInstance();
     do
     {
+        allocation_tracker.BeginFrame();
+        state_cache.BeginFrame();
         // Compute the time difference from previous frame.
         auto end = std::chrono::system_clock::now();
         std::chrono::duration<double> time = end - start;
@@ -118,8 +127,12 @@ void SDLOpenGLWindow::Run(std::function<void()> lambda)
             }
         }
 
-        SetWindowTitle(
-            "SDL OpenGL - " + std::to_string(static_cast<float>(GetFPS(dt))));
+        window_title_.clear();
+        fmt::format_to(
+            std::back_inserter(window_title_),
+            "SDL OpenGL - {:f}",
+            static_cast<float>(GetFPS(dt)));
+        SetWindowTitle(window_title_);
         previous_count = time.count();
         lambda();
 
@@ -127,7 +140,29 @@ void SDLOpenGLWindow::Run(std::function<void()> lambda)
         if (device_)
         {
             SDL_GL_SwapWindow(sdl_window_);
+            // Safe point, entities removed during the frame can go.
+            device_->GetLevel().DestroyRemovedEntities();
+        }
+        allocation_tracker.EndFrame();
+        state_cache.EndFrame();
+        // Logged outside of the frame so it is not counted.
+        if (allocation_tracker.IsEnabled())
+        {
+            const auto frame_stats = allocation_tracker.GetFrameStats();
+            if (frame_stats.count)
+            {
+                logger_->debug(
+                    "Frame allocations: {} ({} bytes).",
+                    frame_stats.count,
+                    frame_stats.bytes);
+            }
         }
+        const auto state_stats = state_cache.GetFrameStats();
+        logger_->trace(
+            "Frame GL state changes: {} issued, {} filtered, {} attachments.",
+            state_stats.issued,
+            state_stats.filtered,
+            state_stats.attachments);
     } while (loop);
 }
 
@@ -146,7 +181,14 @@ bool SDLOpenGLWindow::RunEvent(const SDL_Event& event, const double dt)
         switch (event.key.keysym.sym)
         {
         case SDLK_PRINTSCREEN:
-            device_->ScreenShot("ScreenShot.png");
+            device_->ScreenShotAsync("ScreenShot.png");
+            return true;
+        case SDLK_F12:
+            // Toggle the capture of every frame (Capture_000000.png...).
+            if (device_->IsCapturing())
+                device_->StopCapture();
+            else
+                device_->StartCapture("Capture");
             return true;
         }
         if (key_callbacks_.count(event.key.keysym.sym))
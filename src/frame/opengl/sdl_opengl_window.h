@@ -91,6 +91,8 @@ class SDLOpenGLWindow : public WindowInterface
     std::unique_ptr<InputInterface> input_interface_ = nullptr;
     SDL_Window* sdl_window_ = nullptr;
     std::map<std::int32_t, std::function<bool()>> key_callbacks_ = {};
+    // Reused every frame (keep the capacity).
+    std::string window_title_ = {};
 #if defined(_WIN32) || defined(_WIN64)
     HWND hwnd_ = nullptr;
 #endif
@@ -0,0 +1,439 @@
+#include "frame/opengl/state_cache.h"
+
+#include <limits>
+#include <optional>
+
+namespace frame::opengl
+{
+
+namespace
+{
+
+// Value of a state that is not known (never set or invalidated).
+constexpr GLuint unknown_state = std::numeric_limits<GLuint>::max();
+
+constexpr std::array<GLenum, 2> cached_texture_targets = {
+    GL_TEXTURE_2D,
+    GL_TEXTURE_CUBE_MAP,
+};
+
+constexpr std::array<GLenum, 14> cached_buffer_targets = {
+    GL_ARRAY_BUFFER,
+    GL_ATOMIC_COUNTER_BUFFER,
+    GL_COPY_READ_BUFFER,
+    GL_COPY_WRITE_BUFFER,
+    GL_DISPATCH_INDIRECT_BUFFER,
+    GL_DRAW_INDIRECT_BUFFER,
+    GL_ELEMENT_ARRAY_BUFFER,
+    GL_PIXEL_PACK_BUFFER,
+    GL_PIXEL_UNPACK_BUFFER,
+    GL_QUERY_BUFFER,
+    GL_SHADER_STORAGE_BUFFER,
+    GL_TEXTURE_BUFFER,
+    GL_TRANSFORM_FEEDBACK_BUFFER,
+    GL_UNIFORM_BUFFER,
+};
+
+constexpr std::array<GLenum, 5> cached_capabilities = {
+    GL_BLEND,
+    GL_CULL_FACE,
+    GL_DEPTH_TEST,
+    GL_SCISSOR_TEST,
+    GL_STENCIL_TEST,
+};
+
+template <std::size_t N>
+std::optional<std::size_t> FindIndex(
+    const std::array<GLenum, N>& values, GLenum value)
+{
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (values[i] == value)
+            return i;
+    }
+    return std::nullopt;
+}
+
+// Unbinding these targets change the meaning of other calls (pointers
+// become offsets in the bound buffer), they are always unbound.
+bool IsLazyUnbindTarget(GLenum target)
+{
+    switch (target)
+    {
+    case GL_DISPATCH_INDIRECT_BUFFER:
+    case GL_DRAW_INDIRECT_BUFFER:
+    case GL_ELEMENT_ARRAY_BUFFER:
+    case GL_PIXEL_PACK_BUFFER:
+    case GL_PIXEL_UNPACK_BUFFER:
+    case GL_QUERY_BUFFER:
+        return false;
+    default:
+        return true;
+    }
+}
+
+} // End namespace.
+
+StateCache::StateCache()
+{
+    Invalidate();
+}
+
+StateCache& StateCache::GetInstance()
+{
+    static StateCache state_cache;
+    return state_cache;
+}
+
+void StateCache::Invalidate()
+{
+    program_ = unknown_state;
+    vertex_array_ = unknown_state;
+    frame_buffer_ = unknown_state;
+    render_buffer_ = unknown_state;
+    active_texture_ = unknown_state;
+    for (auto& unit : textures_)
+        unit.fill(unknown_state);
+    buffers_.fill(unknown_state);
+    capabilities_.fill(-1);
+    viewport_valid_ = false;
+    depth_func_ = unknown_state;
+    blend_source_ = unknown_state;
+    blend_destination_ = unknown_state;
+    cull_face_ = unknown_state;
+    color_mask_ = -1;
+    depth_mask_ = -1;
+}
+
+bool StateCache::Issue(bool redundant)
+{
+    if (redundant)
+    {
+        ++total_stats_.filtered;
+        return false;
+    }
+    ++total_stats_.issued;
+    return true;
+}
+
+void StateCache::UseProgram(GLuint program)
+{
+    if (Issue(program_ == program))
+    {
+        glUseProgram(program);
+        program_ = program;
+    }
+}
+
+void StateCache::UnuseProgram()
+{
+    Issue(true);
+}
+
+void StateCache::BindVertexArray(GLuint vertex_array)
+{
+    if (Issue(vertex_array_ == vertex_array))
+    {
+        glBindVertexArray(vertex_array);
+        vertex_array_ = vertex_array;
+        // The element array buffer binding is part of the vertex array.
+        buffers_[*FindIndex(cached_buffer_targets, GL_ELEMENT_ARRAY_BUFFER)] =
+            unknown_state;
+    }
+}
+
+void StateCache::BindBuffer(GLenum target, GLuint buffer)
+{
+    auto maybe_index = FindIndex(cached_buffer_targets, target);
+    if (!maybe_index)
+    {
+        Issue(false);
+        glBindBuffer(target, buffer);
+        return;
+    }
+    auto& current = buffers_[*maybe_index];
+    if (Issue(current == buffer))
+    {
+        glBindBuffer(target, buffer);
+        current = buffer;
+    }
+}
+
+void StateCache::UnbindBuffer(GLenum target)
+{
+    if (IsLazyUnbindTarget(target))
+    {
+        Issue(true);
+        return;
+    }
+    BindBuffer(target, 0);
+}
+
+void StateCache::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    Issue(false);
+    glBindBufferBase(target, index, buffer);
+    auto maybe_index = FindIndex(cached_buffer_targets, target);
+    if (maybe_index)
+        buffers_[*maybe_index] = buffer;
+}
+
+void StateCache::ActiveTexture(GLuint unit)
+{
+    if (Issue(active_texture_ == unit))
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        active_texture_ = unit;
+    }
+}
+
+void StateCache::BindTexture(GLenum target, GLuint texture)
+{
+    auto maybe_index = FindIndex(cached_texture_targets, target);
+    if (!maybe_index || active_texture_ >= texture_unit_count_)
+    {
+        Issue(false);
+        glBindTexture(target, texture);
+        return;
+    }
+    auto& current = textures_[active_texture_][*maybe_index];
+    if (Issue(current == texture))
+    {
+        glBindTexture(target, texture);
+        current = texture;
+    }
+}
+
+void StateCache::BindTextureUnit(GLuint unit, GLenum target, GLuint texture)
+{
+    // Don't change the active unit in case the texture is already there.
+    auto maybe_index = FindIndex(cached_texture_targets, target);
+    if (maybe_index && unit < texture_unit_count_ &&
+        textures_[unit][*maybe_index] == texture)
+    {
+        Issue(true);
+        return;
+    }
+    ActiveTexture(unit);
+    BindTexture(target, texture);
+}
+
+void StateCache::UnbindTexture(GLenum target)
+{
+    // The texture stay bound until it is replaced, deleted or attached.
+    Issue(true);
+}
+
+void StateCache::UnbindTextureFromAllUnits(GLuint texture)
+{
+    if (!texture)
+        return;
+    for (GLuint unit = 0; unit < texture_unit_count_; ++unit)
+    {
+        for (std::size_t i = 0; i < texture_target_count_; ++i)
+        {
+            if (textures_[unit][i] == texture)
+            {
+                BindTextureUnit(unit, cached_texture_targets[i], 0);
+            }
+        }
+    }
+}
+
+void StateCache::BindFramebuffer(GLuint frame_buffer)
+{
+    if (Issue(frame_buffer_ == frame_buffer))
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer);
+        frame_buffer_ = frame_buffer;
+    }
+}
+
+void StateCache::BindRenderbuffer(GLuint render_buffer)
+{
+    if (Issue(render_buffer_ == render_buffer))
+    {
+        glBindRenderbuffer(GL_RENDERBUFFER, render_buffer);
+        render_buffer_ = render_buffer;
+    }
+}
+
+void StateCache::FramebufferTexture2D(
+    GLenum attachment, GLenum target, GLuint texture, GLint level)
+{
+    ++total_stats_.attachments;
+    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, target, texture, level);
+}
+
+void StateCache::FramebufferRenderbuffer(
+    GLenum attachment, GLuint render_buffer)
+{
+    ++total_stats_.attachments;
+    glFramebufferRenderbuffer(
+        GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, render_buffer);
+}
+
+void StateCache::Viewport(glm::ivec4 viewport)
+{
+    if (Issue(viewport_valid_ && viewport_ == viewport))
+    {
+        glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+        viewport_ = viewport;
+        viewport_valid_ = true;
+    }
+}
+
+void StateCache::ViewportArray(std::span<const glm::vec4> viewports)
+{
+    Issue(false);
+    glViewportArrayv(
+        0, static_cast<GLsizei>(viewports.size()), &viewports[0][0]);
+    viewport_valid_ = false;
+}
+
+void StateCache::SetCapability(GLenum capability, bool enable)
+{
+    auto maybe_index = FindIndex(cached_capabilities, capability);
+    if (maybe_index)
+    {
+        auto& current = capabilities_[*maybe_index];
+        const std::int8_t value = enable ? 1 : 0;
+        if (!Issue(current == value))
+            return;
+        current = value;
+    }
+    else
+    {
+        Issue(false);
+    }
+    if (enable)
+        glEnable(capability);
+    else
+        glDisable(capability);
+}
+
+void StateCache::DepthFunc(GLenum func)
+{
+    if (Issue(depth_func_ == func))
+    {
+        glDepthFunc(func);
+        depth_func_ = func;
+    }
+}
+
+void StateCache::BlendFunc(GLenum source, GLenum destination)
+{
+    if (Issue(
+            blend_source_ == source && blend_destination_ == destination))
+    {
+        glBlendFunc(source, destination);
+        blend_source_ = source;
+        blend_destination_ = destination;
+    }
+}
+
+void StateCache::CullFace(GLenum mode)
+{
+    if (Issue(cull_face_ == mode))
+    {
+        glCullFace(mode);
+        cull_face_ = mode;
+    }
+}
+
+void StateCache::ColorMask(bool enable)
+{
+    const std::int8_t value = enable ? 1 : 0;
+    if (Issue(color_mask_ == value))
+    {
+        const GLboolean mask = enable ? GL_TRUE : GL_FALSE;
+        glColorMask(mask, mask, mask, mask);
+        color_mask_ = value;
+    }
+}
+
+void StateCache::DepthMask(bool enable)
+{
+    const std::int8_t value = enable ? 1 : 0;
+    if (Issue(depth_mask_ == value))
+    {
+        glDepthMask(enable ? GL_TRUE : GL_FALSE);
+        depth_mask_ = value;
+    }
+}
+
+void StateCache::DeleteProgram(GLuint program)
+{
+    glDeleteProgram(program);
+    // A deleted program stay in use until an other one is used, the id can
+    // be reused by a new program so the next use has to be issued.
+    if (program_ == program)
+        program_ = unknown_state;
+}
+
+void StateCache::DeleteVertexArray(GLuint vertex_array)
+{
+    glDeleteVertexArrays(1, &vertex_array);
+    // Deleting the bound vertex array bind the default one.
+    if (vertex_array_ == vertex_array)
+    {
+        vertex_array_ = 0;
+        buffers_[*FindIndex(cached_buffer_targets, GL_ELEMENT_ARRAY_BUFFER)] =
+            unknown_state;
+    }
+}
+
+void StateCache::DeleteBuffer(GLuint buffer)
+{
+    glDeleteBuffers(1, &buffer);
+    // Deleting a buffer unbind it from all the targets.
+    for (auto& current : buffers_)
+    {
+        if (current == buffer)
+            current = 0;
+    }
+}
+
+void StateCache::DeleteTexture(GLuint texture)
+{
+    glDeleteTextures(1, &texture);
+    // Deleting a texture unbind it from all the units.
+    for (auto& unit : textures_)
+    {
+        for (auto& current : unit)
+        {
+            if (current == texture)
+                current = 0;
+        }
+    }
+}
+
+void StateCache::DeleteFramebuffer(GLuint frame_buffer)
+{
+    glDeleteFramebuffers(1, &frame_buffer);
+    if (frame_buffer_ == frame_buffer)
+        frame_buffer_ = 0;
+}
+
+void StateCache::DeleteRenderbuffer(GLuint render_buffer)
+{
+    glDeleteRenderbuffers(1, &render_buffer);
+    if (render_buffer_ == render_buffer)
+        render_buffer_ = 0;
+}
+
+void StateCache::BeginFrame()
+{
+    frame_begin_stats_ = total_stats_;
+}
+
+void StateCache::EndFrame()
+{
+    frame_stats_.issued = total_stats_.issued - frame_begin_stats_.issued;
+    frame_stats_.filtered =
+        total_stats_.filtered - frame_begin_stats_.filtered;
+    frame_stats_.attachments =
+        total_stats_.attachments - frame_begin_stats_.attachments;
+}
+
+} // End namespace frame::opengl.
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <glm/glm.hpp>
+
+namespace frame::opengl
+{
+
+/**
+ * @class StateCacheStats
+ * @brief Number of OpenGL state changes issued and filtered by the cache and
+ *        number of attachments made to frame buffers.
+ */
+struct StateCacheStats
+{
+    std::uint64_t issued = 0;
+    std::uint64_t filtered = 0;
+    std::uint64_t attachments = 0;
+};
+
+/**
+ * @class StateCache
+ * @brief Shadow copy of the OpenGL state of the current context, state
+ *        changes that would not change anything are not issued.
+ *
+ * All the OpenGL wrappers (programs, textures, buffers, static meshes, frame
+ * and render buffers and the renderer) change the state through it. Code
+ * that change the state directly has to restore it (like ImGui does) or call
+ * Invalidate.
+ *
+ * Unbinding a program, a texture or a buffer that doesn't affect other calls
+ * is lazy: nothing is issued and the object stay bound until something else
+ * is bound in its place (or it is deleted or attached to a frame buffer).
+ */
+class StateCache
+{
+  private:
+    StateCache();
+
+  public:
+    //! @brief Get the instance of the cache (there is a single context).
+    static StateCache& GetInstance();
+
+  public:
+    //! @brief Forget everything (new context or state changed outside).
+    void Invalidate();
+    /**
+     * @brief Use a program (glUseProgram).
+     * @param program: OpenGL program id.
+     */
+    void UseProgram(GLuint program);
+    //! @brief Lazy unuse, the program stay current.
+    void UnuseProgram();
+    /**
+     * @brief Bind a vertex array (glBindVertexArray), the element array
+     *        buffer is part of the vertex array state.
+     * @param vertex_array: OpenGL vertex array id (0 to unbind).
+     */
+    void BindVertexArray(GLuint vertex_array);
+    /**
+     * @brief Bind a buffer to a target (glBindBuffer).
+     * @param target: Buffer target (GL_ARRAY_BUFFER, ...).
+     * @param buffer: OpenGL buffer id (0 to unbind).
+     */
+    void BindBuffer(GLenum target, GLuint buffer);
+    /**
+     * @brief Unbind the buffer of a target, this is lazy for the targets
+     *        that are only used by explicit calls (array, copy, uniform,
+     *        storage...) and not for the ones that change the meaning of
+     *        other calls (element array, pixel pack/unpack, indirect).
+     * @param target: Buffer target.
+     */
+    void UnbindBuffer(GLenum target);
+    /**
+     * @brief Bind a buffer to an indexed binding point (glBindBufferBase),
+     *        it is also bound to the target. The indexed bindings are not
+     *        cached.
+     * @param target: Buffer target (GL_UNIFORM_BUFFER, ...).
+     * @param index: Binding point.
+     * @param buffer: OpenGL buffer id.
+     */
+    void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    /**
+     * @brief Select the active texture unit (glActiveTexture).
+     * @param unit: Texture unit (0 based, not GL_TEXTURE0 based).
+     */
+    void ActiveTexture(GLuint unit);
+    /**
+     * @brief Bind a texture to the active texture unit (glBindTexture).
+     * @param target: Texture target (GL_TEXTURE_2D, ...).
+     * @param texture: OpenGL texture id (0 to unbind).
+     */
+    void BindTexture(GLenum target, GLuint texture);
+    /**
+     * @brief Bind a texture to a texture unit (select the unit if needed).
+     * @param unit: Texture unit (0 based).
+     * @param target: Texture target (GL_TEXTURE_2D, ...).
+     * @param texture: OpenGL texture id (0 to unbind).
+     */
+    void BindTextureUnit(GLuint unit, GLenum target, GLuint texture);
+    /**
+     * @brief Lazy unbind of a texture from the active texture unit.
+     * @param target: Texture target.
+     */
+    void UnbindTexture(GLenum target);
+    /**
+     * @brief Unbind a texture from every unit it is still bound to (used
+     *        before rendering to it so it can't be sampled at the same time).
+     * @param texture: OpenGL texture id.
+     */
+    void UnbindTextureFromAllUnits(GLuint texture);
+    /**
+     * @brief Bind a frame buffer (glBindFramebuffer with GL_FRAMEBUFFER).
+     * @param frame_buffer: OpenGL frame buffer id (0 for the default one).
+     */
+    void BindFramebuffer(GLuint frame_buffer);
+    /**
+     * @brief Bind a render buffer (glBindRenderbuffer).
+     * @param render_buffer: OpenGL render buffer id (0 to unbind).
+     */
+    void BindRenderbuffer(GLuint render_buffer);
+    /**
+     * @brief Attach a texture to the bound frame buffer
+     *        (glFramebufferTexture2D), counted as an attachment change.
+     * @param attachment: Attachment point (GL_COLOR_ATTACHMENT0, ...).
+     * @param target: Texture target (GL_TEXTURE_2D or a cube map face).
+     * @param texture: OpenGL texture id.
+     * @param level: Mipmap level.
+     */
+    void FramebufferTexture2D(
+        GLenum attachment, GLenum target, GLuint texture, GLint level);
+    /**
+     * @brief Attach a render buffer to the bound frame buffer
+     *        (glFramebufferRenderbuffer), counted as an attachment change.
+     * @param attachment: Attachment point (GL_DEPTH_ATTACHMENT, ...).
+     * @param render_buffer: OpenGL render buffer id.
+     */
+    void FramebufferRenderbuffer(GLenum attachment, GLuint render_buffer);
+    /**
+     * @brief Set the viewport (glViewport).
+     * @param viewport: Position and size (x, y, width, height).
+     */
+    void Viewport(glm::ivec4 viewport);
+    /**
+     * @brief Set the first viewports (glViewportArrayv), the other ones and
+     *        the cached viewport are then unknown.
+     * @param viewports: Position and size of the viewports (x, y, width,
+     *        height).
+     */
+    void ViewportArray(std::span<const glm::vec4> viewports);
+    /**
+     * @brief Enable or disable a capability (glEnable/glDisable), only the
+     *        blend, cull face, depth, scissor and stencil tests are cached.
+     * @param capability: OpenGL capability.
+     * @param enable: Enable or disable.
+     */
+    void SetCapability(GLenum capability, bool enable);
+    /**
+     * @brief Set the depth function (glDepthFunc).
+     * @param func: Depth function.
+     */
+    void DepthFunc(GLenum func);
+    /**
+     * @brief Set the blend function (glBlendFunc).
+     * @param source: Source factor.
+     * @param destination: Destination factor.
+     */
+    void BlendFunc(GLenum source, GLenum destination);
+    /**
+     * @brief Set the face to be culled (glCullFace).
+     * @param mode: Face to be culled.
+     */
+    void CullFace(GLenum mode);
+    /**
+     * @brief Enable or disable the writes to every color channel
+     *        (glColorMask).
+     * @param enable: Enable or disable.
+     */
+    void ColorMask(bool enable);
+    /**
+     * @brief Enable or disable the writes to the depth buffer (glDepthMask).
+     * @param enable: Enable or disable.
+     */
+    void DepthMask(bool enable);
+    //! @brief Delete a program (and forget it).
+    void DeleteProgram(GLuint program);
+    //! @brief Delete a vertex array (and forget it).
+    void DeleteVertexArray(GLuint vertex_array);
+    //! @brief Delete a buffer (and forget it).
+    void DeleteBuffer(GLuint buffer);
+    //! @brief Delete a texture (and forget it).
+    void DeleteTexture(GLuint texture);
+    //! @brief Delete a frame buffer (and forget it).
+    void DeleteFramebuffer(GLuint frame_buffer);
+    //! @brief Delete a render buffer (and forget it).
+    void DeleteRenderbuffer(GLuint render_buffer);
+
+  public:
+    /**
+     * @brief Get the state changes since the start of the program.
+     * @return The total stats.
+     */
+    StateCacheStats GetTotalStats() const
+    {
+        return total_stats_;
+    }
+    //! @brief Start counting the state changes of a frame.
+    void BeginFrame();
+    //! @brief Stop counting the state changes of a frame.
+    void EndFrame();
+    /**
+     * @brief Get the state changes of the last frame (between the last call
+     *        to BeginFrame and EndFrame).
+     * @return The stats of the last frame.
+     */
+    StateCacheStats GetFrameStats() const
+    {
+        return frame_stats_;
+    }
+
+  private:
+    /**
+     * @brief Count a state change.
+     * @param redundant: True if the state is already the one asked.
+     * @return True if the change has to be issued.
+     */
+    bool Issue(bool redundant);
+
+  private:
+    // Texture units and targets that are cached (others are always issued).
+    static constexpr std::size_t texture_unit_count_ = 32;
+    static constexpr std::size_t texture_target_count_ = 2;
+    // Buffer targets that are cached (others are always issued).
+    static constexpr std::size_t buffer_target_count_ = 14;
+    // Capabilities that are cached (others are always issued).
+    static constexpr std::size_t capability_count_ = 5;
+    GLuint program_;
+    GLuint vertex_array_;
+    GLuint frame_buffer_;
+    GLuint render_buffer_;
+    GLuint active_texture_;
+    std::array<std::array<GLuint, texture_target_count_>, texture_unit_count_>
+        textures_;
+    std::array<GLuint, buffer_target_count_> buffers_;
+    // 0 disabled, 1 enabled and -1 unknown.
+    std::array<std::int8_t, capability_count_> capabilities_;
+    glm::ivec4 viewport_;
+    bool viewport_valid_;
+    GLenum depth_func_;
+    GLenum blend_source_;
+    GLenum blend_destination_;
+    GLenum cull_face_;
+    // 0 disabled, 1 enabled and -1 unknown.
+    std::int8_t color_mask_;
+    std::int8_t depth_mask_;
+    StateCacheStats total_stats_ = {};
+    StateCacheStats frame_begin_stats_ = {};
+    StateCacheStats frame_stats_ = {};
+};
+
+} // End namespace frame::opengl.
@@ -7,6 +7,8 @@
 #include <numeric>
 #include <sstream>
 
+#include "frame/opengl/state_cache.h"
+
 namespace frame::opengl
 {
 
@@ -21,7 +23,8 @@ StaticMesh::StaticMesh(
       texture_buffer_id_(parameter.texture_buffer_id),
       texture_buffer_size_(parameter.texture_buffer_size),
       index_buffer_id_(parameter.index_buffer_id),
-      render_primitive_enum_(parameter.render_primitive_enum)
+      render_primitive_enum_(parameter.render_primitive_enum),
+      bounding_box_(parameter.bounding_box)
 {
     if (!point_buffer_id_)
     {
@@ -29,7 +32,8 @@ StaticMesh::StaticMesh(
     }
     // Create a new vertex array (to render the mesh).
     glGenVertexArrays(1, &vertex_array_object_);
-    glBindVertexArray(vertex_array_object_);
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.BindVertexArray(vertex_array_object_);
 
     // Point buffer.
     auto& point_buffer_ref =
@@ -218,12 +222,12 @@ StaticMesh::StaticMesh(
     {
         glEnableVertexAttribArray(i);
     }
-    glBindVertexArray(0);
+    state_cache.BindVertexArray(0);
 }
 
 StaticMesh::~StaticMesh()
 {
-    glDeleteVertexArrays(1, &vertex_array_object_);
+    StateCache::GetInstance().DeleteVertexArray(vertex_array_object_);
     // Try to delete assigned buffers.
     if (point_buffer_id_)
     {
@@ -251,14 +255,14 @@ void StaticMesh::Bind(const unsigned int slot /*= 0*/) const
 {
     if (locked_bind_)
         return;
-    glBindVertexArray(vertex_array_object_);
+    StateCache::GetInstance().BindVertexArray(vertex_array_object_);
 }
 
 void StaticMesh::UnBind() const
 {
     if (locked_bind_)
         return;
-    glBindVertexArray(0);
+    StateCache::GetInstance().BindVertexArray(0);
 }
 
 EntityId CreateQuadStaticMesh(LevelInterface& level)
@@ -342,6 +346,7 @@ EntityId CreateQuadStaticMesh(LevelInterface& level)
     parameter.texture_buffer_id = maybe_texture_buffer_id;
     parameter.index_buffer_id = maybe_index_buffer_id;
     parameter.render_primitive_enum = proto::SceneStaticMesh::TRIANGLE;
+    parameter.bounding_box = ComputeBoundingBox(points);
     auto mesh = std::make_unique<StaticMesh>(level, parameter);
     mesh->SetName(fmt::format("QuadMesh.{}", count));
     return level.AddStaticMesh(std::move(mesh));
@@ -524,6 +529,7 @@ EntityId CreateCubeStaticMesh(LevelInterface& level)
     parameter.texture_buffer_id = maybe_texture_buffer_id;
     parameter.index_buffer_id = maybe_index_buffer_id;
     parameter.render_primitive_enum = proto::SceneStaticMesh::TRIANGLE;
+    parameter.bounding_box = ComputeBoundingBox(points);
     auto mesh = std::make_unique<StaticMesh>(level, parameter);
     mesh->SetName(fmt::format("CubeMesh.{}", count));
     return level.AddStaticMesh(std::move(mesh));
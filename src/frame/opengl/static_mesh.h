@@ -114,6 +114,34 @@ class StaticMesh : public BindInterface, public StaticMeshInterface
     {
         return render_primitive_enum_;
     }
+    /**
+     * @brief Get the bounding box of the mesh (in local space).
+     * @return The bounding box (empty if unknown).
+     */
+    const AxisAlignedBoundingBox& GetBoundingBox() const override
+    {
+        return bounding_box_;
+    }
+    //! @brief Get the number of float per point.
+    std::uint32_t GetPointBufferSize() const
+    {
+        return point_buffer_size_;
+    }
+    //! @brief Get the number of float per color.
+    std::uint32_t GetColorBufferSize() const
+    {
+        return color_buffer_size_;
+    }
+    //! @brief Get the number of float per normal.
+    std::uint32_t GetNormalBufferSize() const
+    {
+        return normal_buffer_size_;
+    }
+    //! @brief Get the number of float per texture coordinate.
+    std::uint32_t GetTextureBufferSize() const
+    {
+        return texture_buffer_size_;
+    }
     //! @brief Lock the bind for RAII interface to the bind interface.
     void LockedBind() const override
     {
@@ -189,6 +217,7 @@ class StaticMesh : public BindInterface, public StaticMeshInterface
     unsigned int vertex_array_object_ = 0;
     proto::SceneStaticMesh::RenderPrimitiveEnum render_primitive_enum_ = {};
     float point_size_ = 1.0f;
+    AxisAlignedBoundingBox bounding_box_ = {};
     std::string name_;
 };
 
@@ -14,6 +14,7 @@
 #include "frame/opengl/program.h"
 #include "frame/opengl/render_buffer.h"
 #include "frame/opengl/renderer.h"
+#include "frame/opengl/state_cache.h"
 #include "frame/opengl/static_mesh.h"
 
 namespace frame::opengl
@@ -52,7 +53,72 @@ void Texture::CreateTexture(const void* data /* = nullptr*/)
 
 Texture::~Texture()
 {
-    glDeleteTextures(1, &texture_id_);
+    if (!pooled_)
+        StateCache::GetInstance().DeleteTexture(texture_id_);
+}
+
+void Texture::SetPoolStorage(unsigned int texture_id)
+{
+    if (texture_id == texture_id_)
+        return;
+    if (!pooled_)
+        StateCache::GetInstance().DeleteTexture(texture_id_);
+    texture_id_ = texture_id;
+    pooled_ = true;
+    // The frame buffer used to clear is attached to the previous storage.
+    frame_ = nullptr;
+    render_ = nullptr;
+}
+
+void Texture::ReleasePoolStorage()
+{
+    if (!pooled_)
+        return;
+    // The sampling is the one of the pool storage.
+    const auto min_filter = GetMinFilter();
+    const auto mag_filter = GetMagFilter();
+    const auto wrap_s = GetWrapS();
+    const auto wrap_t = GetWrapT();
+    pooled_ = false;
+    frame_ = nullptr;
+    render_ = nullptr;
+    CreateTexture();
+    SetMinFilter(min_filter);
+    SetMagFilter(mag_filter);
+    SetWrapS(wrap_s);
+    SetWrapT(wrap_t);
+}
+
+bool Texture::ResizeToWindow(glm::uvec2 window_size)
+{
+    if (window_divisor_ == glm::uvec2(0, 0))
+        return false;
+    // The storage of a pool has the previous size, release it first.
+    assert(!pooled_);
+    glm::uvec2 size = size_;
+    for (int i = 0; i < 2; ++i)
+    {
+        if (window_divisor_[i])
+            size[i] = window_size[i] / window_divisor_[i];
+    }
+    if (size == size_)
+        return false;
+    const auto min_filter = GetMinFilter();
+    const auto mag_filter = GetMagFilter();
+    const auto wrap_s = GetWrapS();
+    const auto wrap_t = GetWrapT();
+    StateCache::GetInstance().DeleteTexture(texture_id_);
+    size_ = size;
+    content_hash_ = 0;
+    // The frame buffer used to clear is attached to the previous storage.
+    frame_ = nullptr;
+    render_ = nullptr;
+    CreateTexture();
+    SetMinFilter(min_filter);
+    SetMagFilter(mag_filter);
+    SetWrapS(wrap_s);
+    SetWrapT(wrap_t);
+    return true;
 }
 
 void Texture::Bind(const unsigned int slot /*= 0*/) const
@@ -60,15 +126,16 @@ void Texture::Bind(const unsigned int slot /*= 0*/) const
     if (locked_bind_)
         return;
     assert(slot < GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, texture_id_);
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.ActiveTexture(slot);
+    state_cache.BindTexture(GL_TEXTURE_2D, texture_id_);
 }
 
 void Texture::UnBind() const
 {
     if (locked_bind_)
         return;
-    glBindTexture(GL_TEXTURE_2D, 0);
+    StateCache::GetInstance().UnbindTexture(GL_TEXTURE_2D);
 }
 
 void Texture::EnableMipmap() const
@@ -156,12 +223,14 @@ void Texture::CreateFrameAndRenderBuffer()
 
 void Texture::Clear(const glm::vec4 color)
 {
+    // The content is not the one of the source anymore.
+    content_hash_ = 0;
     // First time this is called this will create a frame and a render.
     Bind();
     if (!frame_)
         CreateFrameAndRenderBuffer();
     ScopedBind scoped_frame(*frame_);
-    glViewport(0, 0, size_.x, size_.y);
+    StateCache::GetInstance().Viewport(glm::ivec4(0, 0, size_.x, size_.y));
     GLfloat clear_color[4] = {color.r, color.g, color.b, color.a};
     glClearBufferfv(GL_COLOR, 0, clear_color);
     UnBind();
@@ -326,6 +395,7 @@ void Texture::Update(
 {
     ScopedBind scoped_bind(*this);
     size_ = size;
+    content_hash_ = 0;
     assert(pixel_element_size_.value() == 1);
     auto format = opengl::ConvertToGLType(pixel_structure_);
     auto type = opengl::ConvertToGLType(pixel_element_size_);
@@ -208,6 +208,80 @@ class Texture : public TextureInterface, public BindInterface
     {
         name_ = name;
     }
+    /**
+     * @brief Get the hash of the content of the texture (its source or the
+     *        pre render that made it).
+     * @return The content hash (0 if unknown, a render target).
+     */
+    std::uint64_t GetContentHash() const override
+    {
+        return content_hash_;
+    }
+    /**
+     * @brief Set the hash of the content of the texture.
+     * @param content_hash: The content hash (0 if unknown).
+     */
+    void SetContentHash(std::uint64_t content_hash) override
+    {
+        content_hash_ = content_hash;
+    }
+    /**
+     * @brief Mark the texture as only used inside a frame (its content is
+     *        not kept across frames) so its storage can be shared.
+     * @param transient: Is the texture transient.
+     */
+    void SetTransient(bool transient)
+    {
+        transient_ = transient;
+    }
+    /**
+     * @brief Check if the texture is only used inside a frame.
+     * @return True if transient.
+     */
+    bool IsTransient() const
+    {
+        return transient_;
+    }
+    /**
+     * @brief Use the storage of a render target pool (same size, format and
+     *        sampling), the storage of the texture is freed.
+     * @param texture_id: OpenGL id of the storage (owned by the pool).
+     */
+    void SetPoolStorage(unsigned int texture_id);
+    //! @brief Get a storage of its own back (the content is lost).
+    void ReleasePoolStorage();
+    /**
+     * @brief Check if the storage is owned by a render target pool.
+     * @return True if pooled.
+     */
+    bool IsPooled() const
+    {
+        return pooled_;
+    }
+    /**
+     * @brief Make the size relative to the window (a negative size in the
+     *        level), the size is the window size divided by the divisor.
+     * @param window_divisor: Divisor per axis (0 for a fixed size).
+     */
+    void SetWindowDivisor(glm::uvec2 window_divisor)
+    {
+        window_divisor_ = window_divisor;
+    }
+    /**
+     * @brief Get the divisor of the window size.
+     * @return Divisor per axis (0 for a fixed size).
+     */
+    glm::uvec2 GetWindowDivisor() const
+    {
+        return window_divisor_;
+    }
+    /**
+     * @brief Reallocate the storage of a texture relative to the window at
+     *        the new window size (the content is lost, the sampling kept).
+     * @param window_size: The new size of the window.
+     * @return True if the storage changed (so did the OpenGL id).
+     */
+    bool ResizeToWindow(glm::uvec2 window_size);
 
   protected:
     /**
@@ -256,6 +330,10 @@ class Texture : public TextureInterface, public BindInterface
     const proto::PixelElementSize pixel_element_size_;
     const proto::PixelStructure pixel_structure_;
     mutable bool locked_bind_ = false;
+    bool transient_ = false;
+    bool pooled_ = false;
+    std::uint64_t content_hash_ = 0;
+    glm::uvec2 window_divisor_ = glm::uvec2(0, 0);
     std::unique_ptr<RenderBuffer> render_ = nullptr;
     std::unique_ptr<FrameBuffer> frame_ = nullptr;
     std::string name_;
@@ -14,6 +14,7 @@
 #include "frame/opengl/program.h"
 #include "frame/opengl/render_buffer.h"
 #include "frame/opengl/renderer.h"
+#include "frame/opengl/state_cache.h"
 #include "frame/opengl/static_mesh.h"
 
 namespace frame::opengl
@@ -50,7 +51,7 @@ proto::TextureFrame GetTextureFrameFromPosition(int i)
 
 TextureCubeMap::~TextureCubeMap()
 {
-    glDeleteTextures(1, &texture_id_);
+    StateCache::GetInstance().DeleteTexture(texture_id_);
 }
 
 TextureCubeMap::TextureCubeMap(const TextureParameter& texture_parameter)
@@ -68,15 +69,16 @@ void TextureCubeMap::Bind(const unsigned int slot /*= 0*/) const
     assert(slot < GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
     if (locked_bind_)
         return;
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id_);
+    auto& state_cache = StateCache::GetInstance();
+    state_cache.ActiveTexture(slot);
+    state_cache.BindTexture(GL_TEXTURE_CUBE_MAP, texture_id_);
 }
 
 void TextureCubeMap::UnBind() const
 {
     if (locked_bind_)
         return;
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    StateCache::GetInstance().UnbindTexture(GL_TEXTURE_CUBE_MAP);
 }
 
 void TextureCubeMap::EnableMipmap() const
@@ -277,12 +279,14 @@ void TextureCubeMap::CreateFrameAndRenderBuffer()
 
 void TextureCubeMap::Clear(const glm::vec4 color)
 {
+    // The content is not the one of the source anymore.
+    content_hash_ = 0;
     // First time this is called this will create a frame and a render.
     Bind();
     if (!frame_)
         CreateFrameAndRenderBuffer();
     ScopedBind scoped_frame(*frame_);
-    glViewport(0, 0, size_.x, size_.y);
+    StateCache::GetInstance().Viewport(glm::ivec4(0, 0, size_.x, size_.y));
     GLfloat clear_color[4] = {color.r, color.g, color.b, color.a};
     glClearBufferfv(GL_COLOR, 0, clear_color);
     UnBind();
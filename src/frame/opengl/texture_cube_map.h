@@ -232,6 +232,23 @@ class TextureCubeMap : public TextureInterface, public BindInterface
     {
         return pixel_structure_.value();
     }
+    /**
+     * @brief Get the hash of the content of the texture (its source or the
+     *        pre render that made it).
+     * @return The content hash (0 if unknown, a render target).
+     */
+    std::uint64_t GetContentHash() const override
+    {
+        return content_hash_;
+    }
+    /**
+     * @brief Set the hash of the content of the texture.
+     * @param content_hash: The content hash (0 if unknown).
+     */
+    void SetContentHash(std::uint64_t content_hash) override
+    {
+        content_hash_ = content_hash;
+    }
 
   protected:
     /**
@@ -285,6 +302,7 @@ class TextureCubeMap : public TextureInterface, public BindInterface
     std::unique_ptr<RenderBuffer> render_ = nullptr;
     std::unique_ptr<FrameBuffer> frame_ = nullptr;
     std::string name_;
+    std::uint64_t content_hash_ = 0;
 };
 
 } // End namespace frame::opengl.
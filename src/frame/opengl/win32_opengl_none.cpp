@@ -102,6 +102,7 @@ void Win32OpenGLNone::Run(std::function<void()> lambda)
         plugin_interface->Update(*device_.get(), 0.0);
     }
     lambda();
+    device_->GetLevel().DestroyRemovedEntities();
 }
 
 void* Win32OpenGLNone::GetGraphicContext() const
@@ -0,0 +1,188 @@
+#include "frame/render_graph.h"
+
+#include <absl/container/flat_hash_set.h>
+#include <algorithm>
+#include <fmt/core.h>
+
+namespace frame
+{
+
+namespace
+{
+
+// Add the ids that are not already in the list (keep the order).
+void AddUnique(std::vector<EntityId>& list, std::span<const EntityId> ids)
+{
+    for (const auto id : ids)
+    {
+        if (std::find(list.begin(), list.end(), id) == list.end())
+            list.push_back(id);
+    }
+}
+
+} // namespace
+
+void RenderGraph::Clear()
+{
+    passes_.clear();
+    texture_names_.clear();
+}
+
+std::uint32_t RenderGraph::AddPass(
+    EntityId program_id,
+    const std::string& name,
+    std::span<const EntityId> inputs,
+    std::span<const EntityId> outputs)
+{
+    auto maybe_index = FindPass(program_id);
+    if (!maybe_index)
+    {
+        RenderPass pass = {};
+        pass.program_id = program_id;
+        pass.name = name;
+        passes_.push_back(std::move(pass));
+        maybe_index = static_cast<std::uint32_t>(passes_.size() - 1);
+    }
+    auto& pass = passes_[*maybe_index];
+    AddUnique(pass.inputs, inputs);
+    AddUnique(pass.outputs, outputs);
+    return *maybe_index;
+}
+
+void RenderGraph::SetTextureName(EntityId texture_id, const std::string& name)
+{
+    for (auto& [id, texture_name] : texture_names_)
+    {
+        if (id == texture_id)
+        {
+            texture_name = name;
+            return;
+        }
+    }
+    texture_names_.emplace_back(texture_id, name);
+}
+
+std::uint32_t RenderGraph::Compile(
+    std::span<const EntityId> external_texture_ids)
+{
+    // A pass depend on every pass that write one of its inputs (before it in
+    // this frame or after it in the previous one).
+    for (std::uint32_t i = 0; i < passes_.size(); ++i)
+    {
+        auto& pass = passes_[i];
+        pass.dependencies.clear();
+        for (std::uint32_t j = 0; j < passes_.size(); ++j)
+        {
+            if (i == j)
+                continue;
+            const auto& outputs = passes_[j].outputs;
+            if (std::ranges::any_of(pass.inputs, [&outputs](EntityId id) {
+                    return std::ranges::find(outputs, id) != outputs.end();
+                }))
+            {
+                pass.dependencies.push_back(j);
+            }
+        }
+    }
+    if (external_texture_ids.empty())
+    {
+        for (auto& pass : passes_)
+        {
+            pass.live = true;
+        }
+        return 0;
+    }
+    // Walk back from the external textures, a pass is live in case it write
+    // a texture read by a live pass (or by the outside).
+    absl::flat_hash_set<EntityId> live_textures(
+        external_texture_ids.begin(), external_texture_ids.end());
+    for (auto& pass : passes_)
+    {
+        pass.live = false;
+    }
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto& pass : passes_)
+        {
+            if (pass.live)
+                continue;
+            const bool reach_live = std::ranges::any_of(
+                pass.outputs,
+                [&live_textures](EntityId id) {
+                    return live_textures.contains(id);
+                });
+            if (!reach_live)
+                continue;
+            pass.live = true;
+            live_textures.insert(pass.inputs.begin(), pass.inputs.end());
+            changed = true;
+        }
+    }
+    return static_cast<std::uint32_t>(
+        std::ranges::count(passes_, false, &RenderPass::live));
+}
+
+std::optional<std::uint32_t> RenderGraph::FindPass(EntityId program_id) const
+{
+    for (std::uint32_t i = 0; i < passes_.size(); ++i)
+    {
+        if (passes_[i].program_id == program_id)
+            return i;
+    }
+    return std::nullopt;
+}
+
+bool RenderGraph::IsLive(EntityId program_id) const
+{
+    auto maybe_index = FindPass(program_id);
+    return !maybe_index || passes_[*maybe_index].live;
+}
+
+double RenderGraph::GetGpuTime() const
+{
+    double gpu_time_ms = 0.0;
+    for (const auto& pass : passes_)
+    {
+        if (pass.live)
+            gpu_time_ms += pass.gpu_time_ms;
+    }
+    return gpu_time_ms;
+}
+
+std::string RenderGraph::ToDot() const
+{
+    auto texture_name = [this](EntityId id) {
+        for (const auto& [texture_id, name] : texture_names_)
+        {
+            if (texture_id == id)
+                return name;
+        }
+        return fmt::format("texture {}", id);
+    };
+    std::string dot = "digraph RenderGraph {\n";
+    for (std::uint32_t i = 0; i < passes_.size(); ++i)
+    {
+        const auto& pass = passes_[i];
+        dot += fmt::format(
+            "  pass{} [shape=box, label=\"{}: {}\\n{:.3f} ms\"{}];\n",
+            i,
+            i,
+            pass.name,
+            pass.gpu_time_ms,
+            pass.live ? "" : ", style=dashed");
+        for (const auto id : pass.inputs)
+        {
+            dot += fmt::format("  \"{}\" -> pass{};\n", texture_name(id), i);
+        }
+        for (const auto id : pass.outputs)
+        {
+            dot += fmt::format("  pass{} -> \"{}\";\n", i, texture_name(id));
+        }
+    }
+    dot += "}\n";
+    return dot;
+}
+
+} // End namespace frame.
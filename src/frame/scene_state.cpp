@@ -0,0 +1,129 @@
+#include "frame/scene_state.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+#include <new>
+#include <stdexcept>
+
+namespace frame
+{
+
+const glm::mat4& SceneState::GetWorldTransform(EntityId id) const
+{
+    const glm::mat4* world_transform = FindWorldTransform(id);
+    if (!world_transform)
+    {
+        throw std::out_of_range(
+            fmt::format("No node with id #{} in the scene state.", id));
+    }
+    return *world_transform;
+}
+
+std::span<const SceneUniform> SceneState::FindUniforms(
+    EntityId program_id) const
+{
+    const auto range = std::ranges::equal_range(
+        uniforms, program_id, {}, &SceneUniform::program_id);
+    return std::span<const SceneUniform>(range.begin(), range.end());
+}
+
+template <typename T> struct SceneStatePool::Allocator
+{
+    using value_type = T;
+    explicit Allocator(std::shared_ptr<SceneStatePool> scene_state_pool)
+        : pool(std::move(scene_state_pool))
+    {
+    }
+    template <typename U>
+    Allocator(const Allocator<U>& other) : pool(other.pool)
+    {
+    }
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(pool->AllocateBlock(n * sizeof(T)));
+    }
+    void deallocate(T* block, std::size_t n)
+    {
+        pool->DeallocateBlock(block, n * sizeof(T));
+    }
+    template <typename U> bool operator==(const Allocator<U>& other) const
+    {
+        return pool == other.pool;
+    }
+    std::shared_ptr<SceneStatePool> pool;
+};
+
+struct SceneStatePool::Recycler
+{
+    void operator()(SceneState* scene_state) const
+    {
+        pool->Release(scene_state);
+    }
+    std::shared_ptr<SceneStatePool> pool;
+};
+
+SceneStatePool::~SceneStatePool()
+{
+    for (void* block : free_blocks_)
+        ::operator delete(block);
+}
+
+std::shared_ptr<SceneState> SceneStatePool::Acquire()
+{
+    std::unique_ptr<SceneState> scene_state = nullptr;
+    {
+        std::scoped_lock lock(mutex_);
+        if (!free_states_.empty())
+        {
+            scene_state = std::move(free_states_.back());
+            free_states_.pop_back();
+        }
+    }
+    if (!scene_state)
+        scene_state = std::make_unique<SceneState>();
+    auto self = shared_from_this();
+    return std::shared_ptr<SceneState>(
+        scene_state.release(),
+        Recycler{self},
+        Allocator<SceneState>(self));
+}
+
+void SceneStatePool::Release(SceneState* scene_state)
+{
+    // The holders released it (acquire release on the count) before, so
+    // the next fill is ordered after their last read by the mutex.
+    std::scoped_lock lock(mutex_);
+    free_states_.emplace_back(scene_state);
+}
+
+void* SceneStatePool::AllocateBlock(std::size_t size)
+{
+    {
+        std::scoped_lock lock(mutex_);
+        if (size == block_size_ && !free_blocks_.empty())
+        {
+            void* block = free_blocks_.back();
+            free_blocks_.pop_back();
+            return block;
+        }
+        // All the control blocks have the same size.
+        if (!block_size_)
+            block_size_ = size;
+    }
+    return ::operator new(size);
+}
+
+void SceneStatePool::DeallocateBlock(void* block, std::size_t size)
+{
+    {
+        std::scoped_lock lock(mutex_);
+        if (size == block_size_)
+        {
+            free_blocks_.push_back(block);
+            return;
+        }
+    }
+    ::operator delete(block);
+}
+
+} // End namespace frame.
@@ -32,11 +32,16 @@ glm::mat4 UniformWrapper::GetModel() const
 void UniformWrapper::SetValueFloat(
     const std::string& name, const std::vector<float>& vector, glm::uvec2 size)
 {
-    if (stream_value_float_map_.count(name))
+    auto it = stream_value_float_map_.find(name);
+    if (it != stream_value_float_map_.end())
     {
-        stream_value_float_map_.erase(name);
+        // Reuse the storage of the previous value.
+        it->second.value.assign(vector.begin(), vector.end());
+        it->second.size = size;
+        return;
     }
     stream_value_float_map_.insert({name, {vector, size}});
+    float_names_.push_back(name);
 }
 
 void UniformWrapper::SetValueInt(
@@ -44,42 +49,38 @@ void UniformWrapper::SetValueInt(
     const std::vector<std::int32_t>& vector,
     glm::uvec2 size)
 {
-    if (stream_value_int_map_.count(name))
+    auto it = stream_value_int_map_.find(name);
+    if (it != stream_value_int_map_.end())
     {
-        stream_value_int_map_.erase(name);
+        // Reuse the storage of the previous value.
+        it->second.value.assign(vector.begin(), vector.end());
+        it->second.size = size;
+        return;
     }
     stream_value_int_map_.insert({name, {vector, size}});
+    int_names_.push_back(name);
 }
 
-std::vector<float> UniformWrapper::GetValueFloat(const std::string& name) const
+const std::vector<float>& UniformWrapper::GetValueFloat(
+    const std::string& name) const
 {
     return stream_value_float_map_.at(name).value;
 }
 
-std::vector<std::int32_t> UniformWrapper::GetValueInt(
+const std::vector<std::int32_t>& UniformWrapper::GetValueInt(
     const std::string& name) const
 {
     return stream_value_int_map_.at(name).value;
 }
 
-std::vector<std::string> UniformWrapper::GetFloatNames() const
+const std::vector<std::string>& UniformWrapper::GetFloatNames() const
 {
-    std::vector<std::string> list;
-    for (const auto& [name, _] : stream_value_float_map_)
-    {
-        list.push_back(name);
-    }
-    return list;
+    return float_names_;
 }
 
-std::vector<std::string> UniformWrapper::GetIntNames() const
+const std::vector<std::string>& UniformWrapper::GetIntNames() const
 {
-    std::vector<std::string> list;
-    for (const auto& [name, _] : stream_value_int_map_)
-    {
-        list.push_back(name);
-    }
-    return list;
+    return int_names_;
 }
 
 glm::uvec2 UniformWrapper::GetSizeFromFloat(const std::string& name) const
@@ -105,24 +105,25 @@ class UniformWrapper : public UniformInterface
      * @param name: Name of the stream.
      * @return The vector that correspond to the value of a stream.
      */
-    std::vector<float> GetValueFloat(const std::string& name) const override;
+    const std::vector<float>& GetValueFloat(
+        const std::string& name) const override;
     /**
      * @brief Get the value of a stream.
      * @param name: Name of the stream.
      * @return The vector that correspond to the value of a stream.
      */
-    std::vector<std::int32_t> GetValueInt(
+    const std::vector<std::int32_t>& GetValueInt(
         const std::string& name) const override;
     /**
      * @brief Get a list of names for the float uniform plugin.
      * @return The list of names for the float uniform plugin.
      */
-    std::vector<std::string> GetFloatNames() const override;
+    const std::vector<std::string>& GetFloatNames() const override;
     /**
      * @brief Get a list of names for the int uniform plugin.
      * @return The list of names for the int uniform plugin.
      */
-    std::vector<std::string> GetIntNames() const override;
+    const std::vector<std::string>& GetIntNames() const override;
     /**
      * @brief Get the value of a stream.
      * @param name: Name of the stream.
@@ -157,6 +158,9 @@ class UniformWrapper : public UniformInterface
     glm::mat4 view_ = glm::mat4(1.0f);
     std::map<std::string, FloatValues> stream_value_float_map_ = {};
     std::map<std::string, IntValues> stream_value_int_map_ = {};
+    // Keys of the maps, so the names are not copied for every program.
+    std::vector<std::string> float_names_ = {};
+    std::vector<std::string> int_names_ = {};
     double time_ = 0.0;
 };
 
@@ -100,7 +100,7 @@ void Device::AddPlugin(std::unique_ptr<PluginInterface>&& plugin_interface)
     throw std::runtime_error("Not implemented!");
 }
 
-std::vector<PluginInterface*> Device::GetPluginPtrs()
+const std::vector<PluginInterface*>& Device::GetPluginPtrs()
 {
     throw std::runtime_error("Not implemented!");
 }
@@ -140,6 +140,19 @@ void Device::ScreenShot(const std::string& file) const
     throw std::runtime_error("Not implemented!");
 }
 
+void Device::ScreenShotAsync(const std::string& file)
+{
+    throw std::runtime_error("Not implemented!");
+}
+
+void Device::StartCapture(
+    const std::filesystem::path& prefix,
+    std::uint32_t frame_interval /* = 1*/,
+    double duration_s /* = 0.0*/)
+{
+    throw std::runtime_error("Not implemented!");
+}
+
 std::unique_ptr<frame::BufferInterface> Device::CreatePointBuffer(
     std::vector<float>&& vector)
 {
@@ -66,7 +66,7 @@ class Device : public DeviceInterface
      * @brief Get a list of plugin.
      * @return A list of pointer to plugin.
      */
-    std::vector<PluginInterface*> GetPluginPtrs() final;
+    const std::vector<PluginInterface*>& GetPluginPtrs() final;
     /**
      * @brief Get plugin names.
      * @return A list of plugin names.
@@ -101,6 +101,36 @@ class Device : public DeviceInterface
      *        run.
      */
     void ScreenShot(const std::string& file) const final;
+    /**
+     * @brief Make a screen shot to a file without waiting for the GPU.
+     * @param file: File name of the screenshot.
+     */
+    void ScreenShotAsync(const std::string& file) final;
+    /**
+     * @brief Start capturing the frames to a numbered image sequence.
+     * @param prefix: Path and start of the file names.
+     * @param frame_interval: Capture one frame every frame_interval.
+     * @param duration_s: Duration of the capture in seconds (0 until
+     *        stopped).
+     */
+    void StartCapture(
+        const std::filesystem::path& prefix,
+        std::uint32_t frame_interval = 1,
+        double duration_s = 0.0) final;
+    //! @brief Stop the capture (nothing to stop).
+    void StopCapture() final
+    {
+    }
+    //! @brief Check if the frames are captured (never).
+    bool IsCapturing() const final
+    {
+        return false;
+    }
+    //! @brief Get the frames of the capture (none).
+    CaptureStats GetCaptureStats() const final
+    {
+        return {};
+    }
     /**
      * @brief Create a point buffer from a vector of floats.
      * @param device: A pointer to a device.
@@ -172,6 +202,14 @@ class Device : public DeviceInterface
     {
         return focus_point_;
     }
+    /**
+     * @brief Get the dynamic resolution controller.
+     * @return The controller of the scale of the render.
+     */
+    DynamicResolution& GetDynamicResolution() final
+    {
+        return dynamic_resolution_;
+    }
     /**
      * @brief Get the application programming interface of the device.
      * @return Return the application programming interface used by the
@@ -205,6 +243,8 @@ class Device : public DeviceInterface
     float interocular_distance_ = 0.0f;
     glm::vec3 focus_point_ = glm::vec3(0.0f);
     bool invert_left_right_ = false;
+    // Scale of the render (to keep the frame time under a budget).
+    DynamicResolution dynamic_resolution_ = {};
     // Logger for the device.
     const Logger& logger_ = Logger::GetInstance();
 };
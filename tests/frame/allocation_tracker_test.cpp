@@ -0,0 +1,37 @@
+#include "frame/allocation_tracker_test.h"
+
+#include <array>
+#include <memory>
+
+namespace test
+{
+
+TEST_F(AllocationTrackerTest, EnabledAllocationTrackerTest)
+{
+    // The test is linked with the allocation hook.
+    auto ptr = std::make_unique<int>(42);
+    EXPECT_TRUE(allocation_tracker_.IsEnabled());
+}
+
+TEST_F(AllocationTrackerTest, CountAllocationTrackerTest)
+{
+    allocation_tracker_.BeginFrame();
+    auto ptr = std::make_unique<std::array<char, 64>>();
+    allocation_tracker_.EndFrame();
+    const auto frame_stats = allocation_tracker_.GetFrameStats();
+    EXPECT_EQ(1, frame_stats.count);
+    EXPECT_EQ(64, frame_stats.bytes);
+}
+
+TEST_F(AllocationTrackerTest, EmptyFrameAllocationTrackerTest)
+{
+    allocation_tracker_.BeginFrame();
+    std::array<char, 64> array = {};
+    array[0] = 1;
+    allocation_tracker_.EndFrame();
+    const auto frame_stats = allocation_tracker_.GetFrameStats();
+    EXPECT_EQ(0, frame_stats.count);
+    EXPECT_EQ(0, frame_stats.bytes);
+}
+
+} // End namespace test.
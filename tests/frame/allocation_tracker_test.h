@@ -0,0 +1,20 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/allocation_tracker.h"
+
+namespace test
+{
+
+class AllocationTrackerTest : public testing::Test
+{
+  public:
+    AllocationTrackerTest() = default;
+
+  protected:
+    frame::AllocationTracker& allocation_tracker_ =
+        frame::AllocationTracker::GetInstance();
+};
+
+} // End namespace test.
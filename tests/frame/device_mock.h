@@ -22,7 +22,10 @@ class DeviceMock : public frame::DeviceInterface
         ((std::unique_ptr<frame::PluginInterface>&&)),
         (override));
     MOCK_METHOD(
-        std::vector<frame::PluginInterface*>, GetPluginPtrs, (), (override));
+        const std::vector<frame::PluginInterface*>&,
+        GetPluginPtrs,
+        (),
+        (override));
     MOCK_METHOD(
         std::vector<std::string>, GetPluginNames, (), (const, override));
     MOCK_METHOD(void, RemovePluginByName, ((const std::string&)), (override));
@@ -33,6 +36,15 @@ class DeviceMock : public frame::DeviceInterface
     MOCK_METHOD(frame::LevelInterface*, GetLevel, (), (override));
     MOCK_METHOD(void*, GetDeviceContext, (), (const, override));
     MOCK_METHOD(void, ScreenShot, ((const std::string&)), (const, override));
+    MOCK_METHOD(void, ScreenShotAsync, ((const std::string&)), (override));
+    MOCK_METHOD(
+        void,
+        StartCapture,
+        ((const std::filesystem::path&), std::uint32_t, double),
+        (override));
+    MOCK_METHOD(void, StopCapture, (), (override));
+    MOCK_METHOD(bool, IsCapturing, (), (const, override));
+    MOCK_METHOD(frame::CaptureStats, GetCaptureStats, (), (const, override));
     MOCK_METHOD(frame::DeviceEnum, GetDeviceEnum, (), (const, override));
     MOCK_METHOD(
         std::unique_ptr<frame::BufferInterface>,
@@ -54,6 +66,8 @@ class DeviceMock : public frame::DeviceInterface
         CreateTexture,
         ((const frame::TextureParameter&)),
         (override));
+    MOCK_METHOD(
+        frame::DynamicResolution&, GetDynamicResolution, (), (override));
 };
 
 } // End namespace test.
@@ -0,0 +1,50 @@
+#include "frame/dynamic_resolution_test.h"
+
+namespace test
+{
+
+TEST_F(DynamicResolutionTest, DisabledDynamicResolutionTest)
+{
+    EXPECT_FALSE(dynamic_resolution_.IsEnabled());
+    EXPECT_FALSE(dynamic_resolution_.Update(100.0));
+    EXPECT_FLOAT_EQ(1.0f, dynamic_resolution_.GetScale());
+}
+
+TEST_F(DynamicResolutionTest, ScaleDownDynamicResolutionTest)
+{
+    dynamic_resolution_.SetEnabled(true);
+    dynamic_resolution_.SetTargetFrameTime(10.0);
+    // Twice the budget at full resolution, the scale should reach ~0.7.
+    Run(20.0, 200);
+    const float scale = dynamic_resolution_.GetScale();
+    EXPECT_LT(scale, 0.75f);
+    EXPECT_GE(scale, 0.65f);
+    // Stable once reached.
+    EXPECT_FALSE(dynamic_resolution_.Update(20.0 * scale * scale));
+    // Under load it stay in the bounds.
+    Run(1000.0, 200);
+    EXPECT_FLOAT_EQ(0.5f, dynamic_resolution_.GetScale());
+    // And go back up once the load is gone.
+    Run(5.0, 200);
+    EXPECT_FLOAT_EQ(1.0f, dynamic_resolution_.GetScale());
+    dynamic_resolution_.SetEnabled(false);
+    EXPECT_FLOAT_EQ(1.0f, dynamic_resolution_.GetScale());
+}
+
+TEST_F(DynamicResolutionTest, BoundsDynamicResolutionTest)
+{
+    EXPECT_THROW(
+        dynamic_resolution_.SetScaleBounds(0.0f, 1.0f), std::exception);
+    EXPECT_THROW(
+        dynamic_resolution_.SetScaleBounds(0.8f, 0.7f), std::exception);
+    EXPECT_THROW(
+        dynamic_resolution_.SetScaleBounds(0.5f, 1.5f), std::exception);
+    EXPECT_THROW(dynamic_resolution_.SetTargetFrameTime(0.0), std::exception);
+    dynamic_resolution_.SetScaleBounds(0.25f, 0.75f);
+    EXPECT_FLOAT_EQ(0.75f, dynamic_resolution_.GetScale());
+    dynamic_resolution_.SetEnabled(true);
+    Run(1000.0, 200);
+    EXPECT_FLOAT_EQ(0.25f, dynamic_resolution_.GetScale());
+}
+
+} // End namespace test.
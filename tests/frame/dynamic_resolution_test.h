@@ -0,0 +1,35 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/dynamic_resolution.h"
+
+namespace test
+{
+
+class DynamicResolutionTest : public testing::Test
+{
+  public:
+    DynamicResolutionTest() = default;
+
+  protected:
+    /**
+     * @brief Update the controller for a number of frames with a GPU time
+     *        proportional to the pixel count.
+     * @param full_time_ms: GPU time at full resolution.
+     * @param frame_count: Number of frames.
+     */
+    void Run(double full_time_ms, int frame_count)
+    {
+        for (int i = 0; i < frame_count; ++i)
+        {
+            const double scale = dynamic_resolution_.GetScale();
+            dynamic_resolution_.Update(full_time_ms * scale * scale);
+        }
+    }
+
+  protected:
+    frame::DynamicResolution dynamic_resolution_ = {};
+};
+
+} // End namespace test.
@@ -0,0 +1,131 @@
+#include "frame/file/image_sequence_writer_test.h"
+
+#include <cstring>
+
+#include "frame/file/image.h"
+
+namespace test
+{
+
+TEST_F(ImageSequenceWriterTest, WriteImageSequenceWriterTest)
+{
+    frame::file::ImageSequenceWriter writer(directory_ / "frame");
+    EXPECT_EQ(
+        (directory_ / "frame").string() + "_000042.png",
+        writer.GetFileName(42));
+    for (std::uint64_t i = 0; i < 3; ++i)
+    {
+        std::vector<std::uint8_t> pixels(2 * 2 * 3, 128);
+        EXPECT_TRUE(writer.Submit(
+            i,
+            {2, 2},
+            frame::proto::PixelElementSize_BYTE(),
+            frame::proto::PixelStructure_RGB(),
+            std::move(pixels)));
+    }
+    // Float pixels are clamped to bytes.
+    std::vector<float> values(2 * 2 * 3, 2.0f);
+    std::vector<std::uint8_t> pixels(values.size() * sizeof(float));
+    std::memcpy(pixels.data(), values.data(), pixels.size());
+    EXPECT_TRUE(writer.Submit(
+        3,
+        {2, 2},
+        frame::proto::PixelElementSize_FLOAT(),
+        frame::proto::PixelStructure_RGB(),
+        std::move(pixels)));
+    writer.Wait();
+    EXPECT_EQ(4, writer.GetWrittenCount());
+    EXPECT_EQ(0, writer.GetDroppedCount());
+    for (std::uint64_t i = 0; i < 4; ++i)
+        EXPECT_TRUE(std::filesystem::exists(writer.GetFileName(i)));
+    frame::file::Image image(writer.GetFileName(3));
+    EXPECT_EQ(255, static_cast<const std::uint8_t*>(image.Data())[0]);
+}
+
+TEST_F(ImageSequenceWriterTest, DropImageSequenceWriterTest)
+{
+    EXPECT_THROW(
+        frame::file::ImageSequenceWriter(directory_ / "frame", 0),
+        std::exception);
+    frame::file::ImageSequenceWriter writer(directory_ / "frame", 1, 1);
+    EXPECT_THROW(
+        writer.Submit(
+            0,
+            {1, 1},
+            frame::proto::PixelElementSize_SHORT(),
+            frame::proto::PixelStructure_RGB(),
+            std::vector<std::uint8_t>(6)),
+        std::exception);
+    // More images than the encoder can follow, some are dropped and the
+    // submit never block.
+    constexpr std::uint64_t image_count = 32;
+    std::uint64_t accepted = 0;
+    for (std::uint64_t i = 0; i < image_count; ++i)
+    {
+        std::vector<std::uint8_t> pixels(256 * 256 * 3, 64);
+        if (writer.Submit(
+                i,
+                {256, 256},
+                frame::proto::PixelElementSize_BYTE(),
+                frame::proto::PixelStructure_RGB(),
+                std::move(pixels)))
+        {
+            ++accepted;
+        }
+    }
+    writer.Wait();
+    EXPECT_EQ(accepted, writer.GetWrittenCount());
+    EXPECT_EQ(image_count, writer.GetWrittenCount() + writer.GetDroppedCount());
+    EXPECT_LT(0, writer.GetDroppedCount());
+}
+
+TEST_F(ImageSequenceWriterTest, WaitForSlotImageSequenceWriterTest)
+{
+    frame::file::ImageSequenceWriter writer(directory_ / "frame", 1, 1);
+    // Waiting for a slot before each submit, none is dropped.
+    constexpr std::uint64_t image_count = 8;
+    for (std::uint64_t i = 0; i < image_count; ++i)
+    {
+        std::vector<std::uint8_t> pixels(256 * 256 * 3, 64);
+        writer.WaitForSlot();
+        EXPECT_TRUE(writer.Submit(
+            (directory_ / ("image_" + std::to_string(i) + ".png")).string(),
+            {256, 256},
+            frame::proto::PixelElementSize_BYTE(),
+            frame::proto::PixelStructure_RGB(),
+            std::move(pixels)));
+    }
+    writer.Wait();
+    EXPECT_EQ(image_count, writer.GetWrittenCount());
+    EXPECT_EQ(0, writer.GetDroppedCount());
+    EXPECT_TRUE(std::filesystem::exists(directory_ / "image_7.png"));
+}
+
+TEST_F(ImageSequenceWriterTest, WaitForSlotsImageSequenceWriterTest)
+{
+    frame::file::ImageSequenceWriter writer(directory_ / "frame", 1, 4);
+    // Waiting for room for a batch before it is submitted, none is dropped.
+    constexpr std::uint64_t batch_count = 4;
+    constexpr std::uint64_t batch_size = 3;
+    for (std::uint64_t i = 0; i < batch_count; ++i)
+    {
+        writer.WaitForSlot(batch_size);
+        for (std::uint64_t j = 0; j < batch_size; ++j)
+        {
+            std::vector<std::uint8_t> pixels(64 * 64 * 3, 64);
+            const auto index = i * batch_size + j;
+            EXPECT_TRUE(writer.Submit(
+                (directory_ / ("image_" + std::to_string(index) + ".png"))
+                    .string(),
+                {64, 64},
+                frame::proto::PixelElementSize_BYTE(),
+                frame::proto::PixelStructure_RGB(),
+                std::move(pixels)));
+        }
+    }
+    writer.Wait();
+    EXPECT_EQ(batch_count * batch_size, writer.GetWrittenCount());
+    EXPECT_EQ(0, writer.GetDroppedCount());
+}
+
+} // End namespace test.
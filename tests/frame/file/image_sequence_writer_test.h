@@ -0,0 +1,29 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "frame/file/image_sequence_writer.h"
+
+namespace test
+{
+
+class ImageSequenceWriterTest : public testing::Test
+{
+  public:
+    ImageSequenceWriterTest()
+    {
+        std::filesystem::create_directories(directory_);
+    }
+    ~ImageSequenceWriterTest() override
+    {
+        std::filesystem::remove_all(directory_);
+    }
+
+  protected:
+    const std::filesystem::path directory_ =
+        std::filesystem::temp_directory_path() / "frame_image_sequence";
+};
+
+} // End namespace test.
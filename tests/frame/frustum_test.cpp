@@ -0,0 +1,61 @@
+#include "frame/frustum_test.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace test
+{
+
+TEST_F(FrustumTest, ComputeBoundingBoxFrustumTest)
+{
+    std::vector<float> points = {
+        1.f, 2.f, 3.f, -1.f, -2.f, -3.f, 0.f, 5.f, 0.f};
+    auto box = frame::ComputeBoundingBox(points);
+    EXPECT_FALSE(box.IsEmpty());
+    EXPECT_FLOAT_EQ(-1.f, box.min.x);
+    EXPECT_FLOAT_EQ(5.f, box.max.y);
+    EXPECT_FLOAT_EQ(-3.f, box.min.z);
+    EXPECT_TRUE(frame::ComputeBoundingBox({}).IsEmpty());
+    EXPECT_THROW(frame::ComputeBoundingBox(points, 2), std::exception);
+}
+
+TEST_F(FrustumTest, TransformBoundingBoxFrustumTest)
+{
+    auto box = MakeBox(glm::vec3(0.f));
+    auto world_box =
+        box.Transform(glm::translate(glm::mat4(1.f), glm::vec3(10.f, 0, 0)));
+    EXPECT_FLOAT_EQ(9.5f, world_box.min.x);
+    EXPECT_FLOAT_EQ(10.5f, world_box.max.x);
+    EXPECT_FLOAT_EQ(-0.5f, world_box.min.y);
+    EXPECT_TRUE(frame::AxisAlignedBoundingBox{}.Transform(glm::mat4(1.f))
+                    .IsEmpty());
+}
+
+TEST_F(FrustumTest, IsVisibleFrustumTest)
+{
+    frame::Frustum frustum(camera_.ComputeProjection(), camera_.ComputeView());
+    EXPECT_TRUE(frustum.IsVisible(MakeBox(glm::vec3(0.f))));
+    // Behind the camera.
+    EXPECT_FALSE(frustum.IsVisible(MakeBox(glm::vec3(0.f, 0.f, 10.f))));
+    // On the side.
+    EXPECT_FALSE(frustum.IsVisible(MakeBox(glm::vec3(100.f, 0.f, 0.f))));
+    // Further than the far plane.
+    EXPECT_FALSE(frustum.IsVisible(MakeBox(glm::vec3(0.f, 0.f, -1e6f))));
+}
+
+TEST_F(FrustumTest, CullBoxesFrustumTest)
+{
+    frame::Frustum frustum(camera_.ComputeProjection(), camera_.ComputeView());
+    std::vector<frame::AxisAlignedBoundingBox> boxes = {
+        MakeBox(glm::vec3(0.f)),
+        MakeBox(glm::vec3(0.f, 0.f, 10.f)),
+        MakeBox(glm::vec3(0.f, 1.f, 0.f)),
+    };
+    std::vector<std::uint8_t> visibility(boxes.size());
+    EXPECT_EQ(2, frustum.CullBoxes(boxes, visibility));
+    EXPECT_EQ(1, visibility[0]);
+    EXPECT_EQ(0, visibility[1]);
+    EXPECT_EQ(1, visibility[2]);
+}
+
+} // End namespace test.
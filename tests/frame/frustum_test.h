@@ -0,0 +1,38 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/camera.h"
+#include "frame/frustum.h"
+
+namespace test
+{
+
+class FrustumTest : public testing::Test
+{
+  public:
+    FrustumTest() = default;
+
+  protected:
+    /**
+     * @brief Create a unit box around a position.
+     * @param position: Center of the box.
+     * @return The bounding box.
+     */
+    frame::AxisAlignedBoundingBox MakeBox(glm::vec3 position) const
+    {
+        frame::AxisAlignedBoundingBox box;
+        box.Extend(position - glm::vec3(0.5f));
+        box.Extend(position + glm::vec3(0.5f));
+        return box;
+    }
+
+  protected:
+    // Camera at (0, 0, 3) looking at the origin.
+    frame::Camera camera_ = frame::Camera(
+        glm::vec3(0.f, 0.f, 3.f),
+        glm::vec3(0.f, 0.f, -1.f),
+        glm::vec3(0.f, 1.f, 0.f));
+};
+
+} // End namespace test.
@@ -0,0 +1,82 @@
+#include "frame/json/level_streamer_test.h"
+
+#include <thread>
+
+#include "frame/file/file_system.h"
+#include "frame/json/parse_level.h"
+
+namespace test
+{
+
+int LevelStreamerTest::UpdateUntilIdle(frame::proto::LevelStreamer& streamer)
+{
+    int frames = 0;
+    while (!streamer.IsIdle() && frames < 10'000)
+    {
+        streamer.Update(std::chrono::microseconds(0));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++frames;
+    }
+    return frames;
+}
+
+TEST_F(LevelStreamerTest, LoadUnloadLevelStreamerTest)
+{
+    level_ = frame::proto::ParseLevel(
+        glm::uvec2(320, 200),
+        frame::file::FindFile("asset/json/level_test.json"));
+    ASSERT_TRUE(level_);
+    const auto version = level_->GetVersion();
+    frame::proto::LevelStreamer streamer(*level_, glm::uvec2(320, 200));
+    streamer.LoadFragment(
+        "fragment",
+        frame::file::FindFile("asset/json/level_fragment_test.json"));
+    EXPECT_FALSE(streamer.IsIdle());
+    // With no budget only one element is added per frame.
+    EXPECT_LE(4, UpdateUntilIdle(streamer));
+    EXPECT_EQ(
+        frame::proto::FragmentStateEnum::LOADED,
+        streamer.GetFragmentState("fragment"));
+    EXPECT_LT(version, level_->GetVersion());
+    auto texture_id = level_->GetIdFromName("FragmentTexture");
+    ASSERT_TRUE(texture_id);
+    EXPECT_NE(glm::uvec2(0, 0), level_->GetTextureFromId(texture_id).GetSize());
+    auto root_id = level_->GetIdFromName("root");
+    auto fragment_root_id = level_->GetIdFromName("fragment_root");
+    auto fragment_child_id = level_->GetIdFromName("fragment_child");
+    EXPECT_EQ(root_id, level_->GetParentId(fragment_root_id));
+    EXPECT_EQ(fragment_root_id, level_->GetParentId(fragment_child_id));
+    // Unload remove everything the fragment added.
+    streamer.UnloadFragment("fragment");
+    EXPECT_EQ(
+        frame::proto::FragmentStateEnum::UNKNOWN,
+        streamer.GetFragmentState("fragment"));
+    EXPECT_FALSE(level_->TryGetIdFromName("FragmentTexture"));
+    EXPECT_FALSE(level_->TryGetIdFromName("FragmentEmptyTexture"));
+    EXPECT_FALSE(level_->TryGetIdFromName("fragment_root"));
+    EXPECT_FALSE(level_->TryGetIdFromName("fragment_child"));
+    EXPECT_EQ(1, level_->GetChildList(root_id)->size());
+}
+
+TEST_F(LevelStreamerTest, MissingFileLevelStreamerTest)
+{
+    level_ = frame::proto::ParseLevel(
+        glm::uvec2(320, 200),
+        frame::file::FindFile("asset/json/level_test.json"));
+    ASSERT_TRUE(level_);
+    frame::proto::LevelStreamer streamer(*level_, glm::uvec2(320, 200));
+    streamer.LoadFragment("missing", "asset/json/missing_fragment.json");
+    UpdateUntilIdle(streamer);
+    EXPECT_EQ(
+        frame::proto::FragmentStateEnum::FAILED,
+        streamer.GetFragmentState("missing"));
+    EXPECT_THROW(
+        streamer.LoadFragment("missing", "asset/json/missing.json"),
+        std::runtime_error);
+    streamer.UnloadFragment("missing");
+    EXPECT_EQ(
+        frame::proto::FragmentStateEnum::UNKNOWN,
+        streamer.GetFragmentState("missing"));
+}
+
+} // End namespace test.
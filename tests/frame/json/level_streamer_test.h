@@ -0,0 +1,33 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/json/level_streamer.h"
+#include "frame/level_interface.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class LevelStreamerTest : public testing::Test
+{
+  public:
+    LevelStreamerTest()
+        : window_(frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+    }
+
+  public:
+    /**
+     * @brief Update the streamer until it is idle (or too many frames).
+     * @param streamer: The streamer to be updated.
+     * @return The number of frames (calls to Update).
+     */
+    int UpdateUntilIdle(frame::proto::LevelStreamer& streamer);
+
+  protected:
+    std::shared_ptr<frame::WindowInterface> window_ = nullptr;
+    std::unique_ptr<frame::LevelInterface> level_ = nullptr;
+};
+
+} // End namespace test.
@@ -114,4 +114,18 @@ TEST_F(ParsePixelTest, CompareStructureTest)
         frame::proto::PixelStructure_RGB_ALPHA()));
 }
 
+TEST_F(ParsePixelTest, ComponentCountTest)
+{
+    using frame::proto::PixelStructure;
+    EXPECT_EQ(1, frame::proto::GetComponentCount(PixelStructure::GREY));
+    EXPECT_EQ(2, frame::proto::GetComponentCount(PixelStructure::GREY_ALPHA));
+    EXPECT_EQ(3, frame::proto::GetComponentCount(PixelStructure::RGB));
+    EXPECT_EQ(4, frame::proto::GetComponentCount(PixelStructure::RGB_ALPHA));
+    EXPECT_EQ(3, frame::proto::GetComponentCount(PixelStructure::BGR));
+    EXPECT_EQ(4, frame::proto::GetComponentCount(PixelStructure::BGR_ALPHA));
+    EXPECT_THROW(
+        frame::proto::GetComponentCount(PixelStructure::INVALID),
+        std::runtime_error);
+}
+
 } // End namespace test.
@@ -1,6 +1,7 @@
 #include "frame/json/parse_program_test.h"
 
 #include "frame/json/parse_program.h"
+#include "frame/opengl/program.h"
 
 namespace test
 {
@@ -27,4 +28,18 @@ TEST_F(ParseProgramTest, CreateParseProgramUniformTest)
     EXPECT_TRUE(program_);
 }
 
+TEST_F(ParseProgramTest, CreateParseProgramDepthPrepassTest)
+{
+    auto proto_program = proto_level_.programs(0);
+    proto_program.set_depth_prepass(true);
+    auto program =
+        frame::proto::ParseProgramOpenGL(proto_program, *level_.get());
+    ASSERT_TRUE(program);
+    auto& gl_program = dynamic_cast<frame::opengl::Program&>(*program);
+    ASSERT_TRUE(gl_program.GetDepthOnlyProgram());
+    EXPECT_EQ(
+        program->GetName() + "DepthOnly",
+        gl_program.GetDepthOnlyProgram()->GetName());
+}
+
 } // End namespace test.
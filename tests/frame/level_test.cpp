@@ -0,0 +1,487 @@
+#include "frame/level_test.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fmt/core.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <thread>
+
+#include "frame/node_matrix.h"
+
+namespace test
+{
+
+std::vector<frame::EntityId> LevelTest::FillLevel(std::size_t count)
+{
+    std::vector<frame::EntityId> ids;
+    ids.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto node = std::make_unique<frame::NodeMatrix>(glm::mat4(1.0f));
+        node->SetName(fmt::format("node_{}", i));
+        ids.push_back(level_->AddSceneNode(std::move(node)));
+    }
+    return ids;
+}
+
+frame::EntityId LevelTest::FillTree(
+    std::size_t count, std::size_t arity, bool reverse /* = false*/)
+{
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        const std::size_t i = reverse ? count - j - 1 : j;
+        auto node = std::make_unique<frame::NodeMatrix>(glm::mat4(1.0f));
+        node->SetName(fmt::format("node_{}", i));
+        if (i)
+        {
+            node->SetParentName(fmt::format("node_{}", (i - 1) / arity));
+        }
+        level_->AddSceneNode(std::move(node));
+    }
+    return level_->GetIdFromName("node_0");
+}
+
+std::size_t LevelTest::CountTree(frame::EntityId root_id) const
+{
+    std::size_t count = 0;
+    std::vector<frame::EntityId> stack = {root_id};
+    while (!stack.empty())
+    {
+        auto id = stack.back();
+        stack.pop_back();
+        ++count;
+        auto maybe_children = level_->GetChildList(id);
+        EXPECT_TRUE(maybe_children);
+        stack.insert(
+            stack.end(), maybe_children->begin(), maybe_children->end());
+    }
+    return count;
+}
+
+double LevelTest::BenchmarkLookup(
+    const std::vector<frame::EntityId>& ids, std::size_t passes) const
+{
+    // Accumulate the addresses so the lookups can't be optimized away.
+    std::uintptr_t accumulator = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t pass = 0; pass < passes; ++pass)
+    {
+        for (const auto id : ids)
+        {
+            const auto& node = level_->GetSceneNodeFromId(id);
+            accumulator += reinterpret_cast<std::uintptr_t>(&node);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    EXPECT_NE(0, accumulator);
+    std::chrono::duration<double, std::nano> elapsed = end - start;
+    return elapsed.count() / static_cast<double>(ids.size() * passes);
+}
+
+TEST_F(LevelTest, CreateLevelTest)
+{
+    EXPECT_TRUE(level_);
+}
+
+TEST_F(LevelTest, AddGetSceneNodeLevelTest)
+{
+    auto ids = FillLevel(16);
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        EXPECT_EQ(
+            frame::EntityTypeEnum::NODE, level_->GetEnumTypeFromId(ids[i]));
+        EXPECT_EQ(
+            fmt::format("node_{}", i),
+            level_->GetSceneNodeFromId(ids[i]).GetName());
+        EXPECT_EQ(ids[i], level_->GetIdFromName(fmt::format("node_{}", i)));
+    }
+}
+
+TEST_F(LevelTest, TryGetIdFromNameLevelTest)
+{
+    auto ids = FillLevel(4);
+    auto maybe_id = level_->TryGetIdFromName("node_2");
+    ASSERT_TRUE(maybe_id);
+    EXPECT_EQ(ids[2], maybe_id.value());
+    EXPECT_FALSE(level_->TryGetIdFromName("node_4"));
+    EXPECT_FALSE(level_->TryGetIdFromName(""));
+    EXPECT_EQ(frame::NullId, level_->GetIdFromName("node_4"));
+    EXPECT_EQ("node_1", level_->GetNameFromId(ids[1]).value());
+}
+
+TEST_F(LevelTest, DuplicateNameLevelTest)
+{
+    FillLevel(1);
+    auto node = std::make_unique<frame::NodeMatrix>(glm::mat4(1.0f));
+    node->SetName("node_0");
+    EXPECT_THROW(level_->AddSceneNode(std::move(node)), std::runtime_error);
+}
+
+TEST_F(LevelTest, ChildListLevelTest)
+{
+    auto root_id = FillTree(13, 3);
+    auto maybe_children = level_->GetChildList(root_id);
+    ASSERT_TRUE(maybe_children);
+    EXPECT_EQ(3, maybe_children->size());
+    auto node_1_id = level_->GetIdFromName("node_1");
+    EXPECT_EQ(root_id, level_->GetParentId(node_1_id));
+    EXPECT_EQ(frame::NullId, level_->GetParentId(root_id));
+    EXPECT_EQ(13, CountTree(root_id));
+}
+
+TEST_F(LevelTest, ChildListOutOfOrderLevelTest)
+{
+    // Children are added before their parents.
+    auto root_id = FillTree(13, 3, true);
+    EXPECT_EQ(3, level_->GetChildList(root_id)->size());
+    EXPECT_EQ(13, CountTree(root_id));
+}
+
+TEST_F(LevelTest, ReparentLevelTest)
+{
+    auto root_id = FillTree(4, 3);
+    auto node_1_id = level_->GetIdFromName("node_1");
+    auto node_3_id = level_->GetIdFromName("node_3");
+    level_->SetParentName(node_3_id, "node_1");
+    EXPECT_EQ(2, level_->GetChildList(root_id)->size());
+    EXPECT_EQ(std::vector{node_3_id}, level_->GetChildList(node_1_id));
+    EXPECT_EQ(node_1_id, level_->GetParentId(node_3_id));
+    EXPECT_EQ(
+        "node_1", level_->GetSceneNodeFromId(node_3_id).GetParentName());
+    // Reparent to a node that doesn't exist yet.
+    level_->SetParentName(node_3_id, "node_4");
+    EXPECT_TRUE(level_->GetChildList(node_1_id)->empty());
+    EXPECT_EQ(frame::NullId, level_->GetParentId(node_3_id));
+    auto node_4 = std::make_unique<frame::NodeMatrix>(glm::mat4(1.0f));
+    node_4->SetName("node_4");
+    auto node_4_id = level_->AddSceneNode(std::move(node_4));
+    EXPECT_EQ(node_4_id, level_->GetParentId(node_3_id));
+    EXPECT_EQ(4, CountTree(root_id) + CountTree(node_4_id) - 1);
+}
+
+TEST_F(LevelTest, TraversalScalingLevelTest)
+{
+    auto time_traversal = [this](std::size_t count) {
+        level_ = std::make_unique<frame::Level>();
+        auto root_id = FillTree(count, 4);
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(count, CountTree(root_id));
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::micro> elapsed = end - start;
+        return elapsed.count();
+    };
+    double small_us = time_traversal(5'000);
+    double large_us = time_traversal(50'000);
+    RecordProperty("traversal_5k_us", fmt::format("{:.1f}", small_us).c_str());
+    RecordProperty(
+        "traversal_50k_us", fmt::format("{:.1f}", large_us).c_str());
+    // Linear should be around 10 times, quadratic around 100 times.
+    EXPECT_LT(large_us, small_us * 40.0 + 1000.0);
+}
+
+TEST_F(LevelTest, WorldTransformLevelTest)
+{
+    const glm::mat4 root_matrix =
+        glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::mat4 child_matrix =
+        glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.0f, 0.0f));
+    auto root = std::make_unique<frame::NodeMatrix>(root_matrix);
+    root->SetName("root");
+    auto* root_ptr = root.get();
+    auto root_id = level_->AddSceneNode(std::move(root));
+    auto child = std::make_unique<frame::NodeMatrix>(child_matrix);
+    child->SetName("child");
+    child->SetParentName("root");
+    auto child_id = level_->AddSceneNode(std::move(child));
+    level_->UpdateTransforms(0.0);
+    EXPECT_EQ(root_matrix, level_->GetWorldTransform(root_id));
+    EXPECT_EQ(root_matrix * child_matrix, level_->GetWorldTransform(child_id));
+    // Moving the root should move the child at the next update.
+    const glm::mat4 new_root_matrix =
+        glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 3.0f));
+    root_ptr->SetMatrix(new_root_matrix);
+    EXPECT_EQ(root_matrix, level_->GetWorldTransform(root_id));
+    level_->UpdateTransforms(0.0);
+    EXPECT_EQ(new_root_matrix, level_->GetWorldTransform(root_id));
+    EXPECT_EQ(
+        new_root_matrix * child_matrix, level_->GetWorldTransform(child_id));
+    // Reparenting the child to nothing make it a root.
+    level_->SetParentName(child_id, "");
+    level_->UpdateTransforms(0.0);
+    EXPECT_EQ(child_matrix, level_->GetWorldTransform(child_id));
+}
+
+TEST_F(LevelTest, WorldTransformDeepTreeLevelTest)
+{
+    auto root_id = FillTree(1'000, 2);
+    level_->UpdateTransforms(0.0);
+    auto leaf_id = level_->GetIdFromName("node_999");
+    EXPECT_EQ(glm::mat4(1.0f), level_->GetWorldTransform(leaf_id));
+    EXPECT_EQ(glm::mat4(1.0f), level_->GetWorldTransform(root_id));
+    EXPECT_THROW(
+        level_->GetWorldTransform(frame::NullId), std::out_of_range);
+}
+
+TEST_F(LevelTest, SceneStateLevelTest)
+{
+    EXPECT_FALSE(level_->GetSceneState());
+    const glm::mat4 matrix =
+        glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    auto node = std::make_unique<frame::NodeMatrix>(matrix);
+    node->SetName("node");
+    auto* node_ptr = node.get();
+    auto node_id = level_->AddSceneNode(std::move(node));
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    auto first_state = level_->GetSceneState();
+    ASSERT_TRUE(first_state);
+    EXPECT_EQ(matrix, first_state->GetWorldTransform(node_id));
+    EXPECT_EQ(frame::NullId, first_state->camera_id);
+    EXPECT_THROW(
+        first_state->GetWorldTransform(frame::NullId), std::out_of_range);
+    // Updating the level doesn't change a published snapshot.
+    node_ptr->SetMatrix(glm::mat4(1.0f));
+    level_->UpdateTransforms(1.0);
+    level_->PublishSceneState(1.0);
+    level_->UpdateTransforms(2.0);
+    level_->PublishSceneState(2.0);
+    EXPECT_EQ(matrix, first_state->GetWorldTransform(node_id));
+    EXPECT_DOUBLE_EQ(0.0, first_state->time);
+    auto last_state = level_->GetSceneState();
+    EXPECT_NE(first_state, last_state);
+    EXPECT_EQ(glm::mat4(1.0f), last_state->GetWorldTransform(node_id));
+    EXPECT_EQ(first_state->frame + 2, last_state->frame);
+    // A removed node is not in the next snapshot.
+    level_->RemoveSceneNode(node_id);
+    level_->PublishSceneState(3.0);
+    EXPECT_FALSE(level_->GetSceneState()->FindWorldTransform(node_id));
+}
+
+TEST_F(LevelTest, SceneStateConcurrentReaderLevelTest)
+{
+    auto ids = FillLevel(100);
+    auto* node_ptr = dynamic_cast<frame::NodeMatrix*>(
+        &level_->GetSceneNodeFromId(ids.front()));
+    ASSERT_TRUE(node_ptr);
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    // The reader check that every snapshot is consistent (the position of
+    // the node match the frame it was published at).
+    std::thread reader([this, &ids] {
+        std::uint64_t last_frame = 0;
+        while (last_frame < 100)
+        {
+            auto state = level_->GetSceneState();
+            EXPECT_GE(state->frame, last_frame);
+            last_frame = state->frame;
+            const auto& world = state->GetWorldTransform(ids.front());
+            EXPECT_FLOAT_EQ(
+                static_cast<float>(state->frame - 1), world[3][0]);
+        }
+    });
+    for (int i = 1; i < 100; ++i)
+    {
+        glm::mat4 matrix(1.0f);
+        matrix[3][0] = static_cast<float>(i);
+        node_ptr->SetMatrix(matrix);
+        level_->UpdateTransforms(0.0);
+        level_->PublishSceneState(0.0);
+    }
+    reader.join();
+}
+
+TEST_F(LevelTest, SceneStateRecycleLevelTest)
+{
+    FillLevel(10);
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    level_->PublishSceneState(0.0);
+    // Without readers the level alternate between two states.
+    const auto* state = level_->GetSceneState().get();
+    level_->PublishSceneState(0.0);
+    EXPECT_NE(state, level_->GetSceneState().get());
+    level_->PublishSceneState(0.0);
+    EXPECT_EQ(state, level_->GetSceneState().get());
+    // A state held by a reader is not reused while it is held.
+    auto held_state = level_->GetSceneState();
+    const auto held_frame = held_state->frame;
+    for (int i = 0; i < 4; ++i)
+    {
+        level_->PublishSceneState(0.0);
+        EXPECT_NE(held_state, level_->GetSceneState());
+    }
+    EXPECT_EQ(held_frame, held_state->frame);
+}
+
+TEST_F(LevelTest, ProgramUniformLevelTest)
+{
+    // Uniforms are only set to programs of the level.
+    EXPECT_THROW(
+        level_->SetProgramUniform(
+            frame::NullId, "value", std::vector<float>{1.0f}),
+        std::runtime_error);
+    level_->PublishSceneState(0.0);
+    EXPECT_TRUE(level_->GetSceneState()->FindUniforms(frame::NullId).empty());
+    EXPECT_EQ(nullptr, level_->GetSceneState()->FindMaterial(frame::NullId));
+}
+
+TEST_F(LevelTest, StaleIdLevelTest)
+{
+    auto ids = FillLevel(1);
+    // Same slot but a newer generation, this should not be found.
+    frame::EntityId stale_id = frame::MakeEntityId(
+        frame::EntityTypeEnum::NODE,
+        frame::GetEntityGenerationFromId(ids[0]) + 1,
+        frame::GetEntityIndexFromId(ids[0]));
+    EXPECT_THROW(level_->GetSceneNodeFromId(stale_id), std::out_of_range);
+    // A node id is not a texture id.
+    EXPECT_THROW(level_->GetTextureFromId(ids[0]), std::out_of_range);
+}
+
+TEST_F(LevelTest, VersionLevelTest)
+{
+    auto version = level_->GetVersion();
+    auto ids = FillLevel(2);
+    EXPECT_LT(version, level_->GetVersion());
+    version = level_->GetVersion();
+    level_->AddMeshMaterialId(ids[0], frame::NullId);
+    EXPECT_LT(version, level_->GetVersion());
+    version = level_->GetVersion();
+    // Lookups don't change the level.
+    level_->GetSceneNodeFromId(ids[1]);
+    level_->GetStaticMeshMaterialIds();
+    EXPECT_EQ(version, level_->GetVersion());
+}
+
+TEST_F(LevelTest, RemoveSceneNodeLevelTest)
+{
+    auto root_id = FillTree(13, 3);
+    auto node_1_id = level_->GetIdFromName("node_1");
+    auto node_4_id = level_->GetIdFromName("node_4");
+    level_->AddMeshMaterialId(node_1_id, frame::NullId);
+    level_->UpdateTransforms(0.0);
+    auto version = level_->GetVersion();
+    level_->RemoveSceneNodeKeepChildren(node_1_id);
+    EXPECT_LT(version, level_->GetVersion());
+    EXPECT_FALSE(level_->TryGetIdFromName("node_1"));
+    EXPECT_THROW(level_->GetSceneNodeFromId(node_1_id), std::out_of_range);
+    EXPECT_THROW(level_->GetWorldTransform(node_1_id), std::out_of_range);
+    EXPECT_TRUE(level_->GetStaticMeshMaterialIds().empty());
+    EXPECT_EQ(2, level_->GetChildList(root_id)->size());
+    // Children of the removed node wait for it to come back.
+    EXPECT_EQ(frame::NullId, level_->GetParentId(node_4_id));
+    EXPECT_EQ(9, CountTree(root_id));
+    level_->UpdateTransforms(0.0);
+    auto node_1 = std::make_unique<frame::NodeMatrix>(glm::mat4(1.0f));
+    node_1->SetName("node_1");
+    node_1->SetParentName("node_0");
+    auto new_node_1_id = level_->AddSceneNode(std::move(node_1));
+    EXPECT_NE(node_1_id, new_node_1_id);
+    EXPECT_EQ(new_node_1_id, level_->GetParentId(node_4_id));
+    EXPECT_EQ(13, CountTree(root_id));
+    EXPECT_THROW(level_->RemoveSceneNode(node_1_id), std::runtime_error);
+}
+
+TEST_F(LevelTest, RemoveSceneNodeSubtreeLevelTest)
+{
+    auto root_id = FillTree(13, 3);
+    auto node_1_id = level_->GetIdFromName("node_1");
+    auto node_4_id = level_->GetIdFromName("node_4");
+    level_->AddMeshMaterialId(node_4_id, frame::NullId);
+    level_->UpdateTransforms(0.0);
+    // The children go with their parent (nothing is left waiting).
+    level_->RemoveSceneNode(node_1_id);
+    EXPECT_THROW(level_->GetSceneNodeFromId(node_4_id), std::out_of_range);
+    EXPECT_FALSE(level_->TryGetIdFromName("node_6"));
+    EXPECT_TRUE(level_->GetStaticMeshMaterialIds().empty());
+    EXPECT_EQ(9, CountTree(root_id));
+    auto node_1 = std::make_unique<frame::NodeMatrix>(glm::mat4(1.0f));
+    node_1->SetName("node_1");
+    node_1->SetParentName("node_0");
+    auto new_node_1_id = level_->AddSceneNode(std::move(node_1));
+    EXPECT_TRUE(level_->GetChildList(new_node_1_id)->empty());
+    EXPECT_EQ(10, CountTree(root_id));
+    // The whole tree.
+    level_->RemoveSceneNode(root_id);
+    EXPECT_FALSE(level_->TryGetIdFromName("node_12"));
+    EXPECT_FALSE(level_->TryGetIdFromName("node_1"));
+}
+
+TEST_F(LevelTest, DeferredDestructionLevelTest)
+{
+    // Node that flag its destruction.
+    class NodeFlag : public frame::NodeMatrix
+    {
+      public:
+        explicit NodeFlag(bool& destroyed)
+            : frame::NodeMatrix(glm::mat4(1.0f)), destroyed_(destroyed)
+        {
+        }
+        ~NodeFlag() override
+        {
+            destroyed_ = true;
+        }
+
+      private:
+        bool& destroyed_;
+    };
+    bool destroyed = false;
+    auto node = std::make_unique<NodeFlag>(destroyed);
+    node->SetName("flag");
+    auto* node_ptr = node.get();
+    auto id = level_->AddSceneNode(std::move(node));
+    level_->RemoveSceneNode(id);
+    // Removed from the level but still alive until the end of the frame.
+    EXPECT_THROW(level_->GetSceneNodeFromId(id), std::out_of_range);
+    EXPECT_FALSE(destroyed);
+    EXPECT_EQ("flag", node_ptr->GetName());
+    level_->DestroyRemovedEntities();
+    EXPECT_TRUE(destroyed);
+}
+
+TEST_F(LevelTest, RecycleIdLevelTest)
+{
+    auto ids = FillLevel(3);
+    level_->RemoveSceneNode(ids[1]);
+    level_->DestroyRemovedEntities();
+    auto node = std::make_unique<frame::NodeMatrix>(glm::mat4(1.0f));
+    node->SetName("node_1");
+    auto new_id = level_->AddSceneNode(std::move(node));
+    // Same slot with a new generation, the old id is stale.
+    EXPECT_NE(ids[1], new_id);
+    EXPECT_EQ(
+        frame::GetEntityIndexFromId(ids[1]),
+        frame::GetEntityIndexFromId(new_id));
+    EXPECT_THROW(level_->GetSceneNodeFromId(ids[1]), std::out_of_range);
+    EXPECT_EQ(new_id, level_->GetIdFromName("node_1"));
+    // Removing and adding many times doesn't grow the storage.
+    for (int i = 0; i < 1'000; ++i)
+    {
+        level_->RemoveSceneNode(level_->GetIdFromName("node_1"));
+        auto loop_node = std::make_unique<frame::NodeMatrix>(glm::mat4(1.0f));
+        loop_node->SetName("node_1");
+        auto loop_id = level_->AddSceneNode(std::move(loop_node));
+        EXPECT_EQ(
+            frame::GetEntityIndexFromId(ids[1]),
+            frame::GetEntityIndexFromId(loop_id));
+        level_->DestroyRemovedEntities();
+    }
+}
+
+TEST_F(LevelTest, LookupBenchmark10kLevelTest)
+{
+    auto ids = FillLevel(10'000);
+    RecordProperty(
+        "ns_per_lookup",
+        fmt::format("{:.2f}", BenchmarkLookup(ids, 100)).c_str());
+}
+
+TEST_F(LevelTest, LookupBenchmark100kLevelTest)
+{
+    auto ids = FillLevel(100'000);
+    RecordProperty(
+        "ns_per_lookup",
+        fmt::format("{:.2f}", BenchmarkLookup(ids, 10)).c_str());
+}
+
+} // End namespace test.
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/level.h"
+
+namespace test
+{
+
+class LevelTest : public testing::Test
+{
+  public:
+    LevelTest() : level_(std::make_unique<frame::Level>())
+    {
+    }
+
+  public:
+    /**
+     * @brief Fill the level with matrix nodes (node_0 to node_{count - 1}).
+     * @param count: Number of nodes to be added.
+     * @return The ids of the nodes in insertion order.
+     */
+    std::vector<frame::EntityId> FillLevel(std::size_t count);
+    /**
+     * @brief Fill the level with a tree of matrix nodes, node_0 is the root
+     *        and the parent of node_i is node_{(i - 1) / arity}.
+     * @param count: Number of nodes to be added.
+     * @param arity: Number of children per node.
+     * @param reverse: Insert the nodes from the leaves to the root.
+     * @return The id of the root node.
+     */
+    frame::EntityId FillTree(
+        std::size_t count, std::size_t arity, bool reverse = false);
+    /**
+     * @brief Depth first traversal of the tree using the child list.
+     * @param root_id: The id of the root node.
+     * @return The number of nodes visited.
+     */
+    std::size_t CountTree(frame::EntityId root_id) const;
+    /**
+     * @brief Time lookups by id of every node in the level.
+     * @param ids: The ids to look for.
+     * @param passes: Number of passes over the ids.
+     * @return Average time per lookup in nanoseconds.
+     */
+    double BenchmarkLookup(
+        const std::vector<frame::EntityId>& ids, std::size_t passes) const;
+
+  protected:
+    std::unique_ptr<frame::Level> level_ = nullptr;
+};
+
+} // End namespace test.
@@ -0,0 +1,84 @@
+#include "frame/opengl/batch_renderer_test.h"
+
+#include <fstream>
+#include <google/protobuf/util/json_util.h>
+
+namespace test
+{
+
+TEST_F(BatchRendererTest, RenderJobsBatchRendererTest)
+{
+    frame::proto::RenderJobs jobs;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto job = CreateJob("image_" + std::to_string(i) + ".png");
+        job.set_time_s(i * 0.1);
+        *jobs.add_jobs() = job;
+    }
+    // A camera for a single job.
+    auto& camera = *jobs.mutable_jobs(1)->mutable_camera();
+    camera.mutable_position()->set_z(-1.0f);
+    camera.mutable_target()->set_z(1.0f);
+    camera.mutable_up()->set_y(1.0f);
+    camera.set_fov_degrees(45.0f);
+    camera.set_near_clip(0.1f);
+    camera.set_far_clip(100.0f);
+    batch_renderer_.Render(jobs);
+    batch_renderer_.Finish();
+    const auto stats = batch_renderer_.GetStats();
+    EXPECT_EQ(4, stats.rendered);
+    EXPECT_EQ(4, stats.written);
+    EXPECT_EQ(0, stats.failed);
+    // The level is kept between the jobs.
+    EXPECT_EQ(1, stats.level_loaded);
+    EXPECT_LE(0.0, stats.GetImagesPerSecond());
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(std::filesystem::exists(
+            directory_ / ("image_" + std::to_string(i) + ".png")));
+    }
+}
+
+TEST_F(BatchRendererTest, FailedJobBatchRendererTest)
+{
+    frame::proto::RenderJobs jobs;
+    auto job = CreateJob("no_level.png");
+    job.set_level_file((directory_ / "no_level.json").string());
+    *jobs.add_jobs() = job;
+    job = CreateJob("no_program.png");
+    job.add_program_overrides()->set_program_name("NoProgram");
+    *jobs.add_jobs() = job;
+    *jobs.add_jobs() = CreateJob("image.png");
+    // The failed jobs are skipped.
+    batch_renderer_.Render(jobs);
+    batch_renderer_.Finish();
+    const auto stats = batch_renderer_.GetStats();
+    EXPECT_EQ(1, stats.rendered);
+    EXPECT_EQ(1, stats.written);
+    EXPECT_EQ(2, stats.failed);
+    EXPECT_TRUE(std::filesystem::exists(directory_ / "image.png"));
+    EXPECT_FALSE(std::filesystem::exists(directory_ / "no_level.png"));
+}
+
+TEST_F(BatchRendererTest, RenderFileBatchRendererTest)
+{
+    const auto job_file = directory_ / "jobs.json";
+    {
+        frame::proto::RenderJobs jobs;
+        *jobs.add_jobs() = CreateJob("image.png");
+        std::string json;
+        ASSERT_TRUE(
+            google::protobuf::util::MessageToJsonString(jobs, &json).ok());
+        std::ofstream ofs(job_file);
+        ofs << json;
+    }
+    batch_renderer_.RenderFile(job_file);
+    batch_renderer_.Finish();
+    EXPECT_EQ(1, batch_renderer_.GetStats().written);
+    EXPECT_TRUE(std::filesystem::exists(directory_ / "image.png"));
+    EXPECT_THROW(
+        batch_renderer_.RenderFile(directory_ / "no_jobs.json"),
+        std::runtime_error);
+}
+
+} // End namespace test.
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "frame/file/file_system.h"
+#include "frame/opengl/batch_renderer.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class BatchRendererTest : public testing::Test
+{
+  public:
+    BatchRendererTest()
+        : batch_renderer_(
+              frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+        std::filesystem::create_directories(directory_);
+    }
+    ~BatchRendererTest() override
+    {
+        std::filesystem::remove_all(directory_);
+    }
+
+  protected:
+    frame::proto::RenderJob CreateJob(const std::string& name) const
+    {
+        frame::proto::RenderJob job;
+        job.set_level_file(level_file_.string());
+        job.set_output_file((directory_ / name).string());
+        return job;
+    }
+
+  protected:
+    const std::filesystem::path directory_ =
+        std::filesystem::temp_directory_path() / "frame_batch_renderer";
+    const std::filesystem::path level_file_ =
+        frame::file::FindFile("asset/json/device_test.json");
+    frame::opengl::BatchRenderer batch_renderer_;
+};
+
+} // End namespace test.
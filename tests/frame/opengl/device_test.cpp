@@ -1,5 +1,7 @@
 #include "frame/opengl/device_test.h"
 
+#include <filesystem>
+
 #include "frame/file/file_system.h"
 #include "frame/json/parse_level.h"
 #include "frame/plugin_mock.h"
@@ -87,4 +89,26 @@ TEST_F(DeviceTest, AddManyDifferentPluginTest)
     EXPECT_EQ(0, device.GetPluginPtrs().size());
 }
 
+TEST_F(DeviceTest, CaptureDeviceTest)
+{
+    EXPECT_TRUE(window_);
+    window_->GetDevice().Startup(std::move(level_));
+    auto& device = window_->GetDevice();
+    const auto directory =
+        std::filesystem::temp_directory_path() / "frame_capture";
+    std::filesystem::create_directories(directory);
+    EXPECT_FALSE(device.IsCapturing());
+    // Every other frame for 0.1 second.
+    device.StartCapture(directory / "capture", 2, 0.1);
+    EXPECT_TRUE(device.IsCapturing());
+    for (int i = 0; i < 10; ++i)
+        device.Display(i * 0.02);
+    EXPECT_FALSE(device.IsCapturing());
+    const auto capture_stats = device.GetCaptureStats();
+    EXPECT_EQ(3, capture_stats.captured);
+    EXPECT_EQ(3, capture_stats.written + capture_stats.dropped);
+    EXPECT_TRUE(std::filesystem::exists(directory / "capture_000000.png"));
+    std::filesystem::remove_all(directory);
+}
+
 } // End namespace test.
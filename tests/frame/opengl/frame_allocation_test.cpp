@@ -0,0 +1,109 @@
+#include "frame/opengl/frame_allocation_test.h"
+
+#include <functional>
+
+#include "frame/common/application.h"
+#include "frame/file/file_system.h"
+#include "frame/gui/input_factory.h"
+#include "frame/json/parse_level.h"
+
+namespace test
+{
+
+frame::AllocationStats FrameAllocationTest::CountSteadyStateFrame(
+    const std::string& json_file)
+{
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/" + json_file));
+    if (!level)
+        throw std::runtime_error("Couldn't create level.");
+    auto& device = window_->GetDevice();
+    device.Startup(std::move(level));
+    // First frames compile the render queue and fill the caches.
+    for (int i = 0; i < 3; ++i)
+    {
+        device.Display(0.1 * i);
+    }
+    allocation_tracker_.BeginFrame();
+    device.Display(0.5);
+    allocation_tracker_.EndFrame();
+    return allocation_tracker_.GetFrameStats();
+}
+
+frame::AllocationStats FrameAllocationTest::CountSteadyStateRun(
+    const std::string& json_file)
+{
+    auto input = frame::gui::CreateInputWasd(window_->GetDevice(), 1.0f, 1.0f);
+    frame::InputInterface& input_interface = *input;
+    window_->SetInputInterface(std::move(input));
+    // The application own the window (as in the examples).
+    frame::common::Application app(std::move(window_));
+    app.Startup(frame::file::FindFile("asset/json/" + json_file));
+    // Constructed outside of the counted run.
+    std::function<void()> lambda = [&input_interface] {
+        input_interface.KeyPressed('w', 0.01);
+        input_interface.MouseMoved({1.0f, 1.0f}, {1.0f, 0.0f}, 0.01);
+        input_interface.KeyReleased('w', 0.01);
+    };
+    // First runs load the level (plugin startup) and fill the caches.
+    for (int i = 0; i < 3; ++i)
+    {
+        app.Run(lambda);
+    }
+    allocation_tracker_.BeginFrame();
+    app.Run(lambda);
+    allocation_tracker_.EndFrame();
+    return allocation_tracker_.GetFrameStats();
+}
+
+TEST_F(FrameAllocationTest, EnabledFrameAllocationTest)
+{
+    EXPECT_TRUE(allocation_tracker_.IsEnabled());
+}
+
+TEST_F(FrameAllocationTest, JapaneseFlagFrameAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateFrame("japanese_flag.json").count);
+}
+
+TEST_F(FrameAllocationTest, RayMarchingFrameAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateFrame("ray_marching.json").count);
+}
+
+TEST_F(FrameAllocationTest, SceneSimpleFrameAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateFrame("scene_simple.json").count);
+}
+
+TEST_F(FrameAllocationTest, DepthNormalFrameAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateFrame("depth_normal.json").count);
+}
+
+TEST_F(FrameAllocationTest, PointCloudFrameAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateFrame("point_cloud.json").count);
+}
+
+TEST_F(FrameAllocationTest, ImageBasedLightingFrameAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateFrame("image_based_lighting.json").count);
+}
+
+TEST_F(FrameAllocationTest, JapaneseFlagRunAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateRun("japanese_flag.json").count);
+}
+
+TEST_F(FrameAllocationTest, SceneSimpleRunAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateRun("scene_simple.json").count);
+}
+
+TEST_F(FrameAllocationTest, ImageBasedLightingRunAllocationTest)
+{
+    EXPECT_EQ(0, CountSteadyStateRun("image_based_lighting.json").count);
+}
+
+} // End namespace test.
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/allocation_tracker.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class FrameAllocationTest : public testing::Test
+{
+  public:
+    FrameAllocationTest()
+        : window_(frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+    }
+
+  public:
+    /**
+     * @brief Load a level, render a few frames to warm up and then count the
+     *        allocations of a single frame.
+     * @param json_file: The level (in asset/json).
+     * @return The allocation stats of the steady state frame.
+     */
+    frame::AllocationStats CountSteadyStateFrame(const std::string& json_file);
+    /**
+     * @brief Same as above but through the loop of the examples (application
+     *        draw plugin, window run, input and removed entities), the input
+     *        is fed from the lambda of the loop as the events would.
+     * @param json_file: The level (in asset/json).
+     * @return The allocation stats of the steady state run.
+     */
+    frame::AllocationStats CountSteadyStateRun(const std::string& json_file);
+
+  protected:
+    const glm::uvec2 size_ = {320, 200};
+    std::unique_ptr<frame::WindowInterface> window_ = nullptr;
+    frame::AllocationTracker& allocation_tracker_ =
+        frame::AllocationTracker::GetInstance();
+};
+
+} // End namespace test.
@@ -0,0 +1,66 @@
+#include "frame/opengl/frame_buffer_cache_test.h"
+
+#include "frame/opengl/texture.h"
+
+namespace test
+{
+
+TEST_F(FrameBufferCacheTest, SameKeyFrameBufferCacheTest)
+{
+    frame::TextureParameter texture_parameter = {};
+    texture_parameter.size = size_;
+    frame::opengl::Texture texture(texture_parameter);
+    frame::opengl::FrameBufferKey key = {};
+    key.depth_render_buffer = render_buffer_.GetId();
+    key.AddColorAttachment(
+        texture.GetId(), frame::opengl::FrameTextureType::TEXTURE_2D);
+    state_cache_.BeginFrame();
+    auto& frame_buffer =
+        frame_buffer_cache_.GetFrameBuffer(key, render_buffer_);
+    state_cache_.EndFrame();
+    // Depth and color attachments are made when the frame buffer is built.
+    EXPECT_EQ(2, state_cache_.GetFrameStats().attachments);
+    state_cache_.BeginFrame();
+    auto& same_frame_buffer =
+        frame_buffer_cache_.GetFrameBuffer(key, render_buffer_);
+    state_cache_.EndFrame();
+    EXPECT_EQ(0, state_cache_.GetFrameStats().attachments);
+    EXPECT_EQ(frame_buffer.GetId(), same_frame_buffer.GetId());
+    EXPECT_EQ(1, frame_buffer_cache_.GetSize());
+}
+
+TEST_F(FrameBufferCacheTest, DifferentKeyFrameBufferCacheTest)
+{
+    frame::TextureParameter texture_parameter = {};
+    texture_parameter.size = size_;
+    frame::opengl::Texture texture_a(texture_parameter);
+    frame::opengl::Texture texture_b(texture_parameter);
+    frame::opengl::FrameBufferKey key_a = {};
+    key_a.depth_render_buffer = render_buffer_.GetId();
+    key_a.AddColorAttachment(
+        texture_a.GetId(), frame::opengl::FrameTextureType::TEXTURE_2D);
+    frame::opengl::FrameBufferKey key_ab = key_a;
+    key_ab.AddColorAttachment(
+        texture_b.GetId(), frame::opengl::FrameTextureType::TEXTURE_2D);
+    EXPECT_NE(
+        frame_buffer_cache_.GetFrameBuffer(key_a, render_buffer_).GetId(),
+        frame_buffer_cache_.GetFrameBuffer(key_ab, render_buffer_).GetId());
+    EXPECT_EQ(2, frame_buffer_cache_.GetSize());
+    frame_buffer_cache_.Clear();
+    EXPECT_EQ(0, frame_buffer_cache_.GetSize());
+}
+
+TEST_F(FrameBufferCacheTest, TooManyAttachmentFrameBufferCacheTest)
+{
+    frame::opengl::FrameBufferKey key = {};
+    for (std::size_t i = 0; i < key.max_color_attachments; ++i)
+    {
+        key.AddColorAttachment(1, frame::opengl::FrameTextureType::TEXTURE_2D);
+    }
+    EXPECT_THROW(
+        key.AddColorAttachment(
+            1, frame::opengl::FrameTextureType::TEXTURE_2D),
+        std::exception);
+}
+
+} // End namespace test.
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/opengl/frame_buffer_cache.h"
+#include "frame/opengl/state_cache.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class FrameBufferCacheTest : public testing::Test
+{
+  public:
+    FrameBufferCacheTest()
+        : window_(frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+        render_buffer_.CreateStorage(size_);
+    }
+
+  protected:
+    const glm::uvec2 size_ = {8, 8};
+    std::unique_ptr<frame::WindowInterface> window_ = nullptr;
+    frame::opengl::RenderBuffer render_buffer_{};
+    frame::opengl::FrameBufferCache frame_buffer_cache_{};
+    frame::opengl::StateCache& state_cache_ =
+        frame::opengl::StateCache::GetInstance();
+};
+
+} // End namespace test.
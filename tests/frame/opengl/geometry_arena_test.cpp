@@ -0,0 +1,66 @@
+#include "frame/opengl/geometry_arena_test.h"
+
+#include "frame/opengl/buffer.h"
+#include "frame/opengl/static_mesh.h"
+
+namespace test
+{
+
+TEST_F(GeometryArenaTest, BuildGeometryArenaTest)
+{
+    auto cube_id = frame::opengl::CreateCubeStaticMesh(level_);
+    auto quad_id = frame::opengl::CreateQuadStaticMesh(level_);
+    ASSERT_TRUE(cube_id);
+    ASSERT_TRUE(quad_id);
+    // Duplicates are only copied once.
+    const std::vector<frame::EntityId> static_mesh_ids = {
+        cube_id, quad_id, cube_id};
+    geometry_arena_.Build(level_, static_mesh_ids);
+    EXPECT_EQ(2, geometry_arena_.GetMeshCount());
+    EXPECT_LE(1, geometry_arena_.GetPoolCount());
+    const auto* cube_range = geometry_arena_.FindRange(cube_id);
+    const auto* quad_range = geometry_arena_.FindRange(quad_id);
+    ASSERT_TRUE(cube_range);
+    ASSERT_TRUE(quad_range);
+    EXPECT_EQ(
+        level_.GetStaticMeshFromId(cube_id).GetIndexSize() /
+            sizeof(std::uint32_t),
+        cube_range->index_count);
+    EXPECT_EQ(
+        level_.GetStaticMeshFromId(quad_id).GetIndexSize() /
+            sizeof(std::uint32_t),
+        quad_range->index_count);
+    // Meshes of a pool follow each other.
+    if (cube_range->pool == quad_range->pool)
+    {
+        EXPECT_EQ(cube_range->index_count, quad_range->first_index);
+        EXPECT_LT(0, quad_range->base_vertex);
+    }
+    EXPECT_NE(0, geometry_arena_.GetVertexArray(cube_range->pool));
+    geometry_arena_.Clear();
+    EXPECT_EQ(0, geometry_arena_.GetMeshCount());
+    EXPECT_FALSE(geometry_arena_.FindRange(cube_id));
+}
+
+TEST_F(GeometryArenaTest, StreamedGeometryArenaTest)
+{
+    auto point_buffer = std::make_unique<frame::opengl::Buffer>(
+        frame::opengl::BufferTypeEnum::ARRAY_BUFFER,
+        frame::opengl::BufferUsageEnum::STREAM_DRAW);
+    point_buffer->Copy(std::vector<float>{0.f, 0.f, 0.f, 1.f, 0.f, 0.f});
+    frame::StaticMeshParameter parameter = {};
+    parameter.point_buffer_id = level_.AddBuffer(std::move(point_buffer));
+    parameter.render_primitive_enum = frame::proto::SceneStaticMesh::POINT;
+    parameter.generate_list = {frame::StaticMeshParameter::
+                                   StaticMeshParameterEnum::GENERATE_INDEX};
+    auto static_mesh_id = level_.AddStaticMesh(
+        std::make_unique<frame::opengl::StaticMesh>(level_, parameter));
+    ASSERT_TRUE(static_mesh_id);
+    // A streamed mesh change every frame so it keeps its buffers.
+    const std::vector<frame::EntityId> static_mesh_ids = {static_mesh_id};
+    geometry_arena_.Build(level_, static_mesh_ids);
+    EXPECT_EQ(0, geometry_arena_.GetMeshCount());
+    EXPECT_FALSE(geometry_arena_.FindRange(static_mesh_id));
+}
+
+} // End namespace test.
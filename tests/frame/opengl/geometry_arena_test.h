@@ -0,0 +1,27 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/level.h"
+#include "frame/opengl/geometry_arena.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class GeometryArenaTest : public testing::Test
+{
+  public:
+    GeometryArenaTest()
+        : window_(frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+    }
+
+  protected:
+    const glm::uvec2 size_ = {8, 8};
+    std::unique_ptr<frame::WindowInterface> window_ = nullptr;
+    frame::Level level_{};
+    frame::opengl::GeometryArena geometry_arena_{};
+};
+
+} // End namespace test.
@@ -51,4 +51,31 @@ TEST_F(MaterialTest, CheckAddRemoveTextureTest)
     EXPECT_EQ(2, material_->GetIds().size());
 }
 
+TEST_F(MaterialTest, RemoveFromLevelMaterialTest)
+{
+    auto level = std::make_unique<frame::Level>();
+    auto texture = frame::opengl::file::LoadTextureFromFile(
+        frame::file::FindDirectory("asset") /
+        std::filesystem::path("cubemap/positive_x.png"));
+    ASSERT_TRUE(texture);
+    texture->SetName("PositiveX");
+    auto texture_id = level->AddTexture(std::move(texture));
+    auto material = std::make_unique<frame::opengl::Material>();
+    material->SetName("Material");
+    EXPECT_TRUE(material->AddTextureId(texture_id, "PositiveX"));
+    auto material_id = level->AddMaterial(std::move(material));
+    auto& material_ref = level->GetMaterialFromId(material_id);
+    // Removing a texture remove it from the materials.
+    level->RemoveTexture(texture_id);
+    EXPECT_FALSE(material_ref.HasTextureId(texture_id));
+    EXPECT_TRUE(material_ref.GetIds().empty());
+    // Removing a material remove the meshes that use it from rendering.
+    level->AddMeshMaterialId(frame::NullId, material_id);
+    EXPECT_EQ(1, level->GetStaticMeshMaterialIds().size());
+    level->RemoveMaterial(material_id);
+    EXPECT_TRUE(level->GetStaticMeshMaterialIds().empty());
+    EXPECT_FALSE(level->TryGetIdFromName("Material"));
+    level->DestroyRemovedEntities();
+}
+
 } // End namespace test.
@@ -0,0 +1,82 @@
+#include "frame/opengl/pre_render_cache_test.h"
+
+#include "frame/camera.h"
+#include "frame/file/file_system.h"
+#include "frame/json/parse_level.h"
+#include "frame/opengl/renderer.h"
+#include "frame/opengl/texture.h"
+
+namespace test
+{
+
+TEST_F(PreRenderCacheTest, HashPreRenderCacheTest)
+{
+    const auto hash = frame::opengl::CombineContentHash(0, "skybox");
+    EXPECT_NE(0, hash);
+    EXPECT_EQ(hash, frame::opengl::CombineContentHash(0, "skybox"));
+    EXPECT_NE(hash, frame::opengl::CombineContentHash(0, "irradiance"));
+    EXPECT_NE(hash, frame::opengl::CombineContentHash(hash, "skybox"));
+}
+
+TEST_F(PreRenderCacheTest, StoreRestorePreRenderCacheTest)
+{
+    if (!frame::opengl::PreRenderCache::IsCopySupported())
+        GTEST_SKIP() << "No glCopyImageSubData.";
+    std::vector<std::uint8_t> data = {
+        255, 0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255};
+    frame::TextureParameter texture_parameter = {};
+    texture_parameter.size = {2, 2};
+    texture_parameter.data_ptr = data.data();
+    frame::opengl::Texture source(texture_parameter);
+    source.SetContentHash(42);
+    texture_parameter.data_ptr = nullptr;
+    frame::opengl::Texture destination(texture_parameter);
+    std::vector<frame::TextureInterface*> sources = {&source};
+    pre_render_cache_.Store(1, sources);
+    EXPECT_EQ(1, pre_render_cache_.GetEntryCount());
+    std::vector<frame::TextureInterface*> destinations = {&destination};
+    EXPECT_FALSE(pre_render_cache_.Restore(2, destinations));
+    ASSERT_TRUE(pre_render_cache_.Restore(1, destinations));
+    EXPECT_EQ(42, destination.GetContentHash());
+    EXPECT_EQ(source.GetTextureByte(), destination.GetTextureByte());
+    // A texture of another size can't be restored.
+    texture_parameter.size = {4, 4};
+    frame::opengl::Texture other(texture_parameter);
+    std::vector<frame::TextureInterface*> others = {&other};
+    EXPECT_FALSE(pre_render_cache_.Restore(1, others));
+}
+
+TEST_F(PreRenderCacheTest, RendererPreRenderCacheTest)
+{
+    frame::Camera camera(glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.f, 0.f, -1.f));
+    auto load_level = [this] {
+        auto level = frame::proto::ParseLevel(
+            size_,
+            frame::file::FindFile("asset/json/image_based_lighting.json"));
+        level->UpdateTransforms(0.0);
+        level->PublishSceneState(0.0);
+        return level;
+    };
+    auto render = [this, &camera](frame::LevelInterface& level) {
+        frame::opengl::Renderer renderer(
+            level, glm::uvec4(0, 0, size_.x, size_.y));
+        renderer.SetPreRenderCache(&pre_render_cache_);
+        renderer.RenderAllMeshes(
+            camera.ComputeProjection(), camera.ComputeView());
+        return renderer.GetPreRenderCachedCount();
+    };
+    auto level = load_level();
+    ASSERT_TRUE(level);
+    // First time the irradiance is computed.
+    EXPECT_EQ(0, render(*level));
+    // Resize, same level the irradiance is still there.
+    EXPECT_EQ(1, render(*level));
+    // Reload, the irradiance is copied from the cache (if supported).
+    level = load_level();
+    ASSERT_TRUE(level);
+    EXPECT_EQ(
+        frame::opengl::PreRenderCache::IsCopySupported() ? 1 : 0,
+        render(*level));
+}
+
+} // End namespace test.
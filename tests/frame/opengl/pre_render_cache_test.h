@@ -0,0 +1,25 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/opengl/pre_render_cache.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class PreRenderCacheTest : public testing::Test
+{
+  public:
+    PreRenderCacheTest()
+        : window_(frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+    }
+
+  protected:
+    const glm::uvec2 size_ = {320, 200};
+    std::unique_ptr<frame::WindowInterface> window_ = nullptr;
+    frame::opengl::PreRenderCache pre_render_cache_ = {};
+};
+
+} // End namespace test.
@@ -56,6 +56,47 @@ TEST_F(ProgramTest, CreateSimpleProgramProgramTest)
     ASSERT_TRUE(program);
 }
 
+TEST_F(ProgramTest, CreateDepthOnlyProgramTest)
+{
+    EXPECT_FALSE(program_);
+    std::istringstream iss_vertex(GetVertexSource());
+    std::istringstream iss_fragment(GetFragmentSource());
+    program_ = frame::opengl::CreateProgram("test", iss_vertex, iss_fragment);
+    auto program_ptr = dynamic_cast<frame::opengl::Program*>(program_.get());
+    ASSERT_TRUE(program_ptr);
+    EXPECT_EQ(GetVertexSource(), program_ptr->GetVertexSource());
+    auto depth_only_program =
+        frame::opengl::CreateDepthOnlyProgram(*program_ptr);
+    ASSERT_TRUE(depth_only_program);
+    EXPECT_EQ("testDepthOnly", depth_only_program->GetName());
+    // Same vertex shader so the same uniforms are used to place the mesh.
+    EXPECT_EQ(
+        program_->HasUniform("model"),
+        depth_only_program->HasUniform("model"));
+}
+
+TEST_F(ProgramTest, CreateMultiViewProgramTest)
+{
+    if (!frame::opengl::Program::IsMultiViewSupported())
+        GTEST_SKIP() << "No GL_ARB_shader_viewport_layer_array.";
+    EXPECT_FALSE(program_);
+    std::istringstream iss_vertex(GetVertexSource());
+    std::istringstream iss_fragment(GetFragmentSource());
+    program_ = frame::opengl::CreateProgram("test", iss_vertex, iss_fragment);
+    auto program_ptr = dynamic_cast<frame::opengl::Program*>(program_.get());
+    ASSERT_TRUE(program_ptr);
+    EXPECT_EQ(GetFragmentSource(), program_ptr->GetPixelSource());
+    auto multi_view_program =
+        frame::opengl::CreateMultiViewProgram(*program_ptr);
+    ASSERT_TRUE(multi_view_program);
+    EXPECT_EQ("testMultiView", multi_view_program->GetName());
+    // The projection and view come from the uniform block of the views.
+    EXPECT_FALSE(multi_view_program->HasUniform("projection"));
+    EXPECT_FALSE(multi_view_program->HasUniform("view"));
+    EXPECT_TRUE(multi_view_program->HasUniform("model"));
+    EXPECT_TRUE(multi_view_program->HasUniform("frame_view_count"));
+}
+
 TEST_F(ProgramTest, UniformTest)
 {
     EXPECT_FALSE(program_);
@@ -0,0 +1,57 @@
+#include "frame/opengl/readback_queue_test.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "frame/json/parse_pixel.h"
+
+namespace test
+{
+
+TEST_F(ReadbackQueueTest, ReadTextureReadbackQueueTest)
+{
+    std::vector<std::uint8_t> data = {
+        255, 0, 0, 0, 255, 0, 0, 0, 255, 1, 2, 3,
+        4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    frame::TextureParameter texture_parameter = {};
+    texture_parameter.size = {4, 2};
+    texture_parameter.data_ptr = data.data();
+    frame::opengl::Texture texture(texture_parameter);
+    auto pixels = readback_queue_.ReadTexture(texture);
+    EXPECT_EQ(1, readback_queue_.GetPendingCount());
+    readback_queue_.Flush();
+    EXPECT_EQ(0, readback_queue_.GetPendingCount());
+    ASSERT_EQ(
+        std::future_status::ready,
+        pixels.wait_for(std::chrono::seconds(0)));
+    EXPECT_EQ(data, pixels.get());
+    EXPECT_EQ(0, readback_queue_.Poll());
+}
+
+TEST_F(ReadbackQueueTest, RingReadbackQueueTest)
+{
+    std::vector<float> data = {0.5f, 1.0f, 1.5f, 2.0f};
+    frame::TextureParameter texture_parameter = {};
+    texture_parameter.size = {2, 2};
+    texture_parameter.pixel_element_size =
+        frame::proto::PixelElementSize_FLOAT();
+    texture_parameter.pixel_structure = frame::proto::PixelStructure_GREY();
+    texture_parameter.data_ptr = data.data();
+    frame::opengl::Texture texture(texture_parameter);
+    // More reads than slots, the oldest ones are completed in order.
+    std::vector<int> order;
+    for (int i = 0; i < 5; ++i)
+    {
+        readback_queue_.ReadTexture(
+            texture, [&order, &data, i](std::span<const std::uint8_t> pixels) {
+                ASSERT_EQ(data.size() * sizeof(float), pixels.size());
+                EXPECT_EQ(0, std::memcmp(data.data(), pixels.data(), 16));
+                order.push_back(i);
+            });
+        EXPECT_GE(3, readback_queue_.GetPendingCount());
+    }
+    readback_queue_.Flush();
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4}), order);
+}
+
+} // End namespace test.
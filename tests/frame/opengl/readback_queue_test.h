@@ -0,0 +1,24 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/opengl/readback_queue.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class ReadbackQueueTest : public testing::Test
+{
+  public:
+    ReadbackQueueTest()
+        : window_(frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+    }
+
+  protected:
+    std::unique_ptr<frame::WindowInterface> window_ = nullptr;
+    frame::opengl::ReadbackQueue readback_queue_ = {};
+};
+
+} // End namespace test.
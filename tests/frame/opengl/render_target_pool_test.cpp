@@ -0,0 +1,78 @@
+#include "frame/opengl/render_target_pool_test.h"
+
+#include "frame/camera.h"
+#include "frame/file/file_system.h"
+#include "frame/json/parse_level.h"
+#include "frame/opengl/renderer.h"
+
+namespace test
+{
+
+TEST_F(RenderTargetPoolTest, AliasRenderTargetPoolTest)
+{
+    // A chain of passes, a texture is free once the pass after the one
+    // reading it starts.
+    const std::vector<frame::opengl::RenderTargetUse> uses = {
+        MakeUse(size_, 0, 1),
+        MakeUse(size_, 1, 2),
+        MakeUse(size_, 2, 3),
+        MakeUse(size_, 3, 4),
+    };
+    const auto storage_indices =
+        frame::opengl::RenderTargetPool::AssignStorages(uses);
+    ASSERT_EQ(4, storage_indices.size());
+    EXPECT_NE(storage_indices[0], storage_indices[1]);
+    EXPECT_EQ(storage_indices[0], storage_indices[2]);
+    EXPECT_EQ(storage_indices[1], storage_indices[3]);
+}
+
+TEST_F(RenderTargetPoolTest, KeyRenderTargetPoolTest)
+{
+    // Different sizes never share a storage.
+    const std::vector<frame::opengl::RenderTargetUse> uses = {
+        MakeUse(size_, 0, 0),
+        MakeUse(size_ / 2u, 1, 1),
+        MakeUse(size_, 2, 2),
+    };
+    const auto storage_indices =
+        frame::opengl::RenderTargetPool::AssignStorages(uses);
+    ASSERT_EQ(3, storage_indices.size());
+    EXPECT_NE(storage_indices[0], storage_indices[1]);
+    EXPECT_EQ(storage_indices[0], storage_indices[2]);
+}
+
+TEST_F(RenderTargetPoolTest, RendererRenderTargetPoolTest)
+{
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/instancing.json"));
+    ASSERT_TRUE(level);
+    {
+        frame::opengl::Renderer renderer(
+            *level.get(), glm::uvec4(0, 0, size_.x, size_.y));
+        level->UpdateTransforms(0.0);
+        level->PublishSceneState(0.0);
+        frame::Camera camera(
+            glm::vec3(0.f, 0.f, 6.f), glm::vec3(0.f, 0.f, -1.f));
+        renderer.RenderAllMeshes(
+            camera.ComputeProjection(), camera.ComputeView());
+        // The z buffer is transient, the display texture is not.
+        const auto stats = renderer.GetRenderTargetPoolStats();
+        EXPECT_EQ(1, stats.texture_count);
+        EXPECT_EQ(1, stats.storage_count);
+        EXPECT_EQ(size_.x * size_.y * 3, stats.naive_bytes);
+        EXPECT_EQ(stats.naive_bytes, stats.peak_bytes);
+        auto& zbuffer = dynamic_cast<frame::opengl::Texture&>(
+            level->GetTextureFromId(level->GetIdFromName("zbuffer")));
+        EXPECT_TRUE(zbuffer.IsPooled());
+        auto& albedo = dynamic_cast<frame::opengl::Texture&>(
+            level->GetTextureFromId(level->GetDefaultOutputTextureId()));
+        EXPECT_FALSE(albedo.IsPooled());
+    }
+    // The storage is given back with the renderer.
+    auto& zbuffer = dynamic_cast<frame::opengl::Texture&>(
+        level->GetTextureFromId(level->GetIdFromName("zbuffer")));
+    EXPECT_FALSE(zbuffer.IsPooled());
+    EXPECT_NE(0, zbuffer.GetId());
+}
+
+} // End namespace test.
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/opengl/render_target_pool.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class RenderTargetPoolTest : public testing::Test
+{
+  public:
+    RenderTargetPoolTest()
+        : window_(frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+    }
+
+  protected:
+    /**
+     * @brief Make a use of a RGB byte texture.
+     * @param size: Size of the texture.
+     * @param first_step: First step it is used in.
+     * @param last_step: Last step it is used in.
+     * @return The use.
+     */
+    frame::opengl::RenderTargetUse MakeUse(
+        glm::uvec2 size, std::uint32_t first_step, std::uint32_t last_step)
+        const
+    {
+        frame::opengl::RenderTargetUse use = {};
+        use.key.size = size;
+        use.key.pixel_element_size = frame::proto::PixelElementSize::BYTE;
+        use.key.pixel_structure = frame::proto::PixelStructure::RGB;
+        use.first_step = first_step;
+        use.last_step = last_step;
+        return use;
+    }
+
+  protected:
+    const glm::uvec2 size_ = {320, 200};
+    std::unique_ptr<frame::WindowInterface> window_ = nullptr;
+};
+
+} // End namespace test.
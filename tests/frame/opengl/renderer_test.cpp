@@ -1,6 +1,7 @@
 #include "frame/opengl/renderer_test.h"
 
 #include "frame/level.h"
+#include "frame/opengl/texture.h"
 
 namespace test
 {
@@ -26,4 +27,333 @@ TEST_F(RendererTest, RenderingDisplayTest)
     renderer_->Display();
 }
 
+TEST_F(RendererTest, FrustumCullingRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/scene_simple.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.f, 0.f, -1.f));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    const auto facing_stats = renderer_->GetCullingStats();
+    EXPECT_EQ(0, facing_stats.culled);
+    // Looking away, the apple is culled (the skybox opted out).
+    camera.SetFront(glm::vec3(0.f, 0.f, 1.f));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    const auto away_stats = renderer_->GetCullingStats();
+    EXPECT_LT(0, away_stats.culled);
+    EXPECT_LT(0, away_stats.drawn);
+    EXPECT_EQ(facing_stats.drawn, away_stats.drawn + away_stats.culled);
+}
+
+TEST_F(RendererTest, InstancingRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/instancing.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    // Clear buffer and the 9 cubes.
+    EXPECT_EQ(10, level_->GetStaticMeshMaterialIds().size());
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 6.f), glm::vec3(0.f, 0.f, -1.f));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    // The cubes share a mesh and a material so they are a single draw.
+    const auto facing_stats = renderer_->GetCullingStats();
+    EXPECT_EQ(9, facing_stats.drawn);
+    EXPECT_EQ(0, facing_stats.culled);
+    EXPECT_EQ(1, facing_stats.draw_calls);
+    // Looking away every instance is culled.
+    camera.SetFront(glm::vec3(0.f, 0.f, 1.f));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    const auto away_stats = renderer_->GetCullingStats();
+    EXPECT_EQ(0, away_stats.drawn);
+    EXPECT_EQ(9, away_stats.culled);
+    EXPECT_EQ(0, away_stats.draw_calls);
+}
+
+TEST_F(RendererTest, MixedInstancingRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    // The 9 cubes (instanced, first in the queue) and a quad far behind.
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/instancing_mixed.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 6.f), glm::vec3(0.f, 0.f, -1.f));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    // Only the cubes are in the frustum.
+    const auto facing_stats = renderer_->GetCullingStats();
+    EXPECT_EQ(9, facing_stats.drawn);
+    EXPECT_EQ(1, facing_stats.culled);
+    EXPECT_EQ(1, facing_stats.draw_calls);
+    // Looking away only the quad is in the frustum.
+    camera.SetFront(glm::vec3(0.f, 0.f, 1.f));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    const auto away_stats = renderer_->GetCullingStats();
+    EXPECT_EQ(1, away_stats.drawn);
+    EXPECT_EQ(9, away_stats.culled);
+    EXPECT_EQ(1, away_stats.draw_calls);
+}
+
+TEST_F(RendererTest, RenderGraphRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/instancing.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    renderer_->SetPassTiming(true);
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 6.f), glm::vec3(0.f, 0.f, -1.f));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    // The scene program write the display texture so it is not pruned.
+    const auto& passes = renderer_->GetRenderGraph().GetPasses();
+    ASSERT_EQ(1, passes.size());
+    EXPECT_EQ("SceneSimpleProgram", passes[0].name);
+    EXPECT_TRUE(passes[0].live);
+    // The timing of the first frame is read at the second one.
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    const auto dot = renderer_->DumpRenderGraph();
+    EXPECT_NE(std::string::npos, dot.find("SceneSimpleProgram"));
+    EXPECT_NE(std::string::npos, dot.find("\"albedo\""));
+}
+
+TEST_F(RendererTest, OcclusionCullingRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/scene_simple.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    level_->SetOcclusionCulling(true);
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.f, 0.f, -1.f));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    const auto first_stats = renderer_->GetCullingStats();
+    EXPECT_EQ(0, first_stats.occlusion_visible);
+    EXPECT_EQ(0, first_stats.occlusion_occluded);
+    // The queries of the first frame are read at the second one.
+    glFinish();
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    const auto second_stats = renderer_->GetCullingStats();
+    // Nothing is in front of the apple.
+    EXPECT_LT(0, second_stats.occlusion_visible);
+    EXPECT_EQ(0, second_stats.occlusion_occluded);
+    EXPECT_DOUBLE_EQ(1.0, second_stats.occlusion_latency);
+}
+
+TEST_F(RendererTest, DepthPrepassRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/scene_simple.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.f, 0.f, -1.f));
+    auto render = [this, &camera] {
+        renderer_ = std::make_unique<frame::opengl::Renderer>(
+            *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+        renderer_->SetOverdrawCounting(true);
+        renderer_->RenderAllMeshes(
+            camera.ComputeProjection(), camera.ComputeView());
+        return renderer_->GetCullingStats();
+    };
+    const auto shaded_stats = render();
+    EXPECT_EQ(0, shaded_stats.depth_prepass_draw_calls);
+    EXPECT_LT(0, shaded_stats.shaded_samples);
+    // Same level with a depth prepass for the scene program (the queue is
+    // compiled by the new renderer).
+    auto& program = dynamic_cast<frame::opengl::Program&>(
+        level_->GetProgramFromId(
+            level_->GetIdFromName("SceneSimpleProgram")));
+    program.SetDepthOnlyProgram(frame::opengl::CreateDepthOnlyProgram(program));
+    renderer_.reset();
+    const auto prepass_stats = render();
+    EXPECT_LT(0, prepass_stats.depth_prepass_draw_calls);
+    EXPECT_EQ(shaded_stats.draw_calls, prepass_stats.draw_calls);
+    // Every pixel of the apple is shaded once.
+    EXPECT_LT(0, prepass_stats.shaded_samples);
+    EXPECT_LE(prepass_stats.shaded_samples, shaded_stats.shaded_samples);
+}
+
+TEST_F(RendererTest, ResizeRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/image_based_lighting.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.f, 0.f, -1.f));
+    frame::opengl::PreRenderCache pre_render_cache;
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    renderer_->SetPreRenderCache(&pre_render_cache);
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    auto& albedo = dynamic_cast<frame::opengl::Texture&>(
+        level_->GetTextureFromId(level_->GetIdFromName("albedo")));
+    auto& apple = dynamic_cast<frame::opengl::Texture&>(
+        level_->GetTextureFromId(level_->GetIdFromName("apple_texture")));
+    EXPECT_EQ(size_, albedo.GetSize());
+    const auto apple_size = apple.GetSize();
+    const auto apple_id = apple.GetId();
+    // Only the textures relative to the window follow the new size.
+    const glm::uvec2 new_size = {640, 400};
+    renderer_->Resize(new_size);
+    EXPECT_EQ(new_size, albedo.GetSize());
+    EXPECT_EQ(apple_size, apple.GetSize());
+    EXPECT_EQ(apple_id, apple.GetId());
+    // The irradiance (fixed size) is not computed again.
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    EXPECT_EQ(1, renderer_->GetPreRenderCachedCount());
+}
+
+TEST_F(RendererTest, PreRenderProgramChangeRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/image_based_lighting.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.f, 0.f, -1.f));
+    frame::opengl::PreRenderCache pre_render_cache;
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    renderer_->SetPreRenderCache(&pre_render_cache);
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    EXPECT_EQ(0, renderer_->GetPreRenderCachedCount());
+    // The content of the irradiance program changed (as overridden
+    // parameters), the irradiance is computed again.
+    auto& program = dynamic_cast<frame::opengl::Program&>(
+        level_->GetProgramFromId(level_->GetIdFromName("IrradianceProgram")));
+    const auto content_hash = program.GetContentHash();
+    program.SetContentHash(frame::opengl::CombineContentHash(
+        content_hash, "overridden"));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    EXPECT_EQ(0, renderer_->GetPreRenderCachedCount());
+    // Back to the parameters of the level, restored from the cache.
+    program.SetContentHash(content_hash);
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    EXPECT_EQ(1, renderer_->GetPreRenderCachedCount());
+    // Unchanged, nothing is done.
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    EXPECT_EQ(1, renderer_->GetPreRenderCachedCount());
+}
+
+TEST_F(RendererTest, ResolutionScaleRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/image_based_lighting.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.f, 0.f, -1.f));
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    auto& albedo = dynamic_cast<frame::opengl::Texture&>(
+        level_->GetTextureFromId(level_->GetIdFromName("albedo")));
+    EXPECT_THROW(renderer_->SetResolutionScale(0.0f), std::exception);
+    // Render at half the size and upscale to the window.
+    renderer_->SetResolutionScale(0.5f);
+    const glm::uvec2 half_size = {size_.x / 2, size_.y / 2};
+    EXPECT_EQ(half_size, renderer_->GetRenderSize());
+    EXPECT_EQ(half_size, albedo.GetSize());
+    renderer_->SetViewport(glm::uvec4(0, 0, half_size.x, half_size.y));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    renderer_->SetViewport(glm::uvec4(0, 0, size_.x, size_.y));
+    renderer_->SetUpscaleFilter(frame::UpscaleFilterEnum::EDGE_AWARE);
+    renderer_->Display();
+    // A resize keep the scale.
+    const glm::uvec2 new_size = {640, 400};
+    renderer_->Resize(new_size);
+    EXPECT_EQ(glm::uvec2(320, 200), albedo.GetSize());
+    renderer_->SetResolutionScale(1.0f);
+    EXPECT_EQ(new_size, albedo.GetSize());
+}
+
+TEST_F(RendererTest, MultiViewRenderingTest)
+{
+    ASSERT_FALSE(renderer_);
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/scene_simple.json"));
+    ASSERT_TRUE(level);
+    level_ = std::move(level);
+    level_->UpdateTransforms(0.0);
+    level_->PublishSceneState(0.0);
+    frame::Camera camera(glm::vec3(0.f, 0.f, 3.f), glm::vec3(0.f, 0.f, -1.f));
+    renderer_ = std::make_unique<frame::opengl::Renderer>(
+        *level_.get(), glm::uvec4(0, 0, size_.x, size_.y));
+    renderer_->RenderAllMeshes(
+        camera.ComputeProjection(), camera.ComputeView());
+    const auto single_stats = renderer_->GetCullingStats();
+    EXPECT_EQ(0, single_stats.multi_view_draw_calls);
+    // Same camera side by side.
+    const std::array<frame::opengl::RenderView, 2> views = {
+        frame::opengl::RenderView{
+            camera.ComputeProjection(),
+            camera.ComputeView(),
+            glm::uvec4(0, 0, size_.x / 2, size_.y)},
+        frame::opengl::RenderView{
+            camera.ComputeProjection(),
+            camera.ComputeView(),
+            glm::uvec4(size_.x / 2, 0, size_.x / 2, size_.y)}};
+    renderer_->RenderAllMeshes(views);
+    const auto multi_stats = renderer_->GetCullingStats();
+    EXPECT_EQ(single_stats.drawn, multi_stats.drawn);
+    if (frame::opengl::Program::IsMultiViewSupported())
+    {
+        // Every program of the level has a multi view variant.
+        EXPECT_EQ(single_stats.draw_calls, multi_stats.draw_calls);
+        EXPECT_EQ(multi_stats.draw_calls, multi_stats.multi_view_draw_calls);
+    }
+    else
+    {
+        EXPECT_EQ(single_stats.draw_calls * 2, multi_stats.draw_calls);
+        EXPECT_EQ(0, multi_stats.multi_view_draw_calls);
+    }
+}
+
 } // End namespace test.
@@ -0,0 +1,105 @@
+#include "frame/opengl/state_cache_test.h"
+
+#include "frame/file/file_system.h"
+#include "frame/json/parse_level.h"
+#include "frame/opengl/buffer.h"
+
+namespace test
+{
+
+frame::opengl::StateCacheStats StateCacheTest::CountSteadyStateFrame(
+    const std::string& json_file)
+{
+    auto level = frame::proto::ParseLevel(
+        size_, frame::file::FindFile("asset/json/" + json_file));
+    if (!level)
+        throw std::runtime_error("Couldn't create level.");
+    auto& device = window_->GetDevice();
+    device.Startup(std::move(level));
+    for (int i = 0; i < 3; ++i)
+    {
+        device.Display(0.1 * i);
+    }
+    state_cache_.BeginFrame();
+    device.Display(0.5);
+    state_cache_.EndFrame();
+    return state_cache_.GetFrameStats();
+}
+
+TEST_F(StateCacheTest, RedundantBindStateCacheTest)
+{
+    frame::opengl::Buffer buffer;
+    buffer.Bind();
+    state_cache_.BeginFrame();
+    buffer.Bind();
+    buffer.UnBind();
+    buffer.Bind();
+    state_cache_.EndFrame();
+    // Already bound and unbinding an array buffer is lazy.
+    EXPECT_EQ(0, state_cache_.GetFrameStats().issued);
+    EXPECT_EQ(3, state_cache_.GetFrameStats().filtered);
+}
+
+TEST_F(StateCacheTest, ElementArrayStateCacheTest)
+{
+    frame::opengl::Buffer buffer(
+        frame::opengl::BufferTypeEnum::ELEMENT_ARRAY_BUFFER);
+    buffer.Bind();
+    state_cache_.BeginFrame();
+    buffer.Bind();
+    // Unbinding an element array buffer is never lazy.
+    buffer.UnBind();
+    state_cache_.EndFrame();
+    EXPECT_EQ(1, state_cache_.GetFrameStats().issued);
+    EXPECT_EQ(1, state_cache_.GetFrameStats().filtered);
+    // The element array buffer is part of the vertex array state.
+    GLuint vertex_array = 0;
+    glGenVertexArrays(1, &vertex_array);
+    buffer.Bind();
+    state_cache_.BindVertexArray(vertex_array);
+    state_cache_.BeginFrame();
+    buffer.Bind();
+    state_cache_.EndFrame();
+    EXPECT_EQ(1, state_cache_.GetFrameStats().issued);
+    state_cache_.DeleteVertexArray(vertex_array);
+}
+
+TEST_F(StateCacheTest, DeleteStateCacheTest)
+{
+    {
+        frame::opengl::Buffer buffer;
+        buffer.Bind();
+    }
+    // The new buffer can reuse the id of the deleted one.
+    frame::opengl::Buffer buffer;
+    state_cache_.BeginFrame();
+    buffer.Bind();
+    state_cache_.EndFrame();
+    EXPECT_EQ(1, state_cache_.GetFrameStats().issued);
+}
+
+TEST_F(StateCacheTest, InvalidateStateCacheTest)
+{
+    const glm::ivec4 viewport(0, 0, size_.x, size_.y);
+    state_cache_.Viewport(viewport);
+    state_cache_.BeginFrame();
+    state_cache_.Viewport(viewport);
+    state_cache_.EndFrame();
+    EXPECT_EQ(0, state_cache_.GetFrameStats().issued);
+    state_cache_.Invalidate();
+    state_cache_.BeginFrame();
+    state_cache_.Viewport(viewport);
+    state_cache_.EndFrame();
+    EXPECT_EQ(1, state_cache_.GetFrameStats().issued);
+}
+
+TEST_F(StateCacheTest, SceneSimpleStateCacheTest)
+{
+    auto stats = CountSteadyStateFrame("scene_simple.json");
+    EXPECT_LT(0, stats.issued);
+    EXPECT_LT(0, stats.filtered);
+    // Frame buffers are built with their attachments when the level loads.
+    EXPECT_EQ(0, stats.attachments);
+}
+
+} // End namespace test.
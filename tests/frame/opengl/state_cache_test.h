@@ -0,0 +1,36 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/opengl/state_cache.h"
+#include "frame/window_factory.h"
+
+namespace test
+{
+
+class StateCacheTest : public testing::Test
+{
+  public:
+    StateCacheTest()
+        : window_(frame::CreateNewWindow(frame::DrawingTargetEnum::NONE))
+    {
+    }
+
+  public:
+    /**
+     * @brief Load a level and count the state changes of a frame after a few
+     *        frames to warm up.
+     * @param json_file: The level (in asset/json).
+     * @return The state cache stats of the steady state frame.
+     */
+    frame::opengl::StateCacheStats CountSteadyStateFrame(
+        const std::string& json_file);
+
+  protected:
+    const glm::uvec2 size_ = {320, 200};
+    std::unique_ptr<frame::WindowInterface> window_ = nullptr;
+    frame::opengl::StateCache& state_cache_ =
+        frame::opengl::StateCache::GetInstance();
+};
+
+} // End namespace test.
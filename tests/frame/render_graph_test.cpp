@@ -0,0 +1,72 @@
+#include "frame/render_graph_test.h"
+
+namespace test
+{
+
+TEST_F(RenderGraphTest, PruneRenderGraphTest)
+{
+    MakeDeferredGraph();
+    const std::vector<frame::EntityId> external = {Texture(3)};
+    EXPECT_EQ(1, render_graph_.Compile(external));
+    EXPECT_TRUE(render_graph_.IsLive(Program(1)));
+    EXPECT_FALSE(render_graph_.IsLive(Program(2)));
+    EXPECT_TRUE(render_graph_.IsLive(Program(3)));
+    // Programs that are not in the graph are never pruned.
+    EXPECT_TRUE(render_graph_.IsLive(Program(4)));
+}
+
+TEST_F(RenderGraphTest, NoExternalRenderGraphTest)
+{
+    MakeDeferredGraph();
+    EXPECT_EQ(0, render_graph_.Compile({}));
+    EXPECT_TRUE(render_graph_.IsLive(Program(2)));
+}
+
+TEST_F(RenderGraphTest, DependencyRenderGraphTest)
+{
+    MakeDeferredGraph();
+    // A second use of the scene program is the same pass.
+    const std::vector<frame::EntityId> albedo = {Texture(1)};
+    EXPECT_EQ(0, render_graph_.AddPass(Program(1), "Scene", {}, albedo));
+    const std::vector<frame::EntityId> external = {Texture(3)};
+    render_graph_.Compile(external);
+    const auto& passes = render_graph_.GetPasses();
+    ASSERT_EQ(3, passes.size());
+    EXPECT_EQ(1, passes[0].outputs.size());
+    EXPECT_TRUE(passes[0].dependencies.empty());
+    ASSERT_EQ(1, passes[2].dependencies.size());
+    EXPECT_EQ(0, passes[2].dependencies[0]);
+    ASSERT_TRUE(render_graph_.FindPass(Program(3)));
+    EXPECT_EQ(2, *render_graph_.FindPass(Program(3)));
+    EXPECT_FALSE(render_graph_.FindPass(Program(4)));
+}
+
+TEST_F(RenderGraphTest, DotRenderGraphTest)
+{
+    MakeDeferredGraph();
+    const std::vector<frame::EntityId> external = {Texture(3)};
+    render_graph_.Compile(external);
+    render_graph_.SetPassTime(2, 1.5);
+    const auto dot = render_graph_.ToDot();
+    EXPECT_NE(std::string::npos, dot.find("digraph"));
+    EXPECT_NE(std::string::npos, dot.find("Lighting"));
+    EXPECT_NE(std::string::npos, dot.find("1.500 ms"));
+    EXPECT_NE(std::string::npos, dot.find("\"albedo\" -> pass2"));
+    EXPECT_NE(std::string::npos, dot.find("style=dashed"));
+    EXPECT_THROW(render_graph_.SetPassTime(3, 1.0), std::exception);
+}
+
+TEST_F(RenderGraphTest, GpuTimeRenderGraphTest)
+{
+    MakeDeferredGraph();
+    EXPECT_DOUBLE_EQ(0.0, render_graph_.GetGpuTime());
+    const std::vector<frame::EntityId> external = {Texture(3)};
+    render_graph_.Compile(external);
+    render_graph_.SetPassTime(0, 1.0);
+    // The debug pass is pruned and not counted.
+    render_graph_.SetPassTime(1, 4.0);
+    render_graph_.SetPassTime(2, 2.5);
+    EXPECT_DOUBLE_EQ(3.5, render_graph_.GetGpuTime());
+}
+
+} // End namespace test.
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/render_graph.h"
+
+namespace test
+{
+
+class RenderGraphTest : public testing::Test
+{
+  public:
+    RenderGraphTest() = default;
+
+  protected:
+    //! @brief Make a program id.
+    static frame::EntityId Program(std::uint32_t index)
+    {
+        return frame::MakeEntityId(frame::EntityTypeEnum::PROGRAM, 1, index);
+    }
+    //! @brief Make a texture id.
+    static frame::EntityId Texture(std::uint32_t index)
+    {
+        return frame::MakeEntityId(frame::EntityTypeEnum::TEXTURE, 1, index);
+    }
+    /**
+     * @brief Fill the graph with a scene pass (write albedo), a debug pass
+     *        (write debug) and a lighting pass (read albedo write display).
+     */
+    void MakeDeferredGraph()
+    {
+        const std::vector<frame::EntityId> albedo = {Texture(1)};
+        const std::vector<frame::EntityId> debug = {Texture(2)};
+        const std::vector<frame::EntityId> display = {Texture(3)};
+        render_graph_.AddPass(Program(1), "Scene", {}, albedo);
+        render_graph_.AddPass(Program(2), "Debug", {}, debug);
+        render_graph_.AddPass(Program(3), "Lighting", albedo, display);
+        render_graph_.SetTextureName(Texture(1), "albedo");
+        render_graph_.SetTextureName(Texture(3), "display");
+    }
+
+  protected:
+    frame::RenderGraph render_graph_ = {};
+};
+
+} // End namespace test.
@@ -0,0 +1,82 @@
+#include "frame/slot_map_test.h"
+
+namespace test
+{
+
+TEST_F(SlotMapTest, CreateSlotMapTest)
+{
+    EXPECT_TRUE(slot_map_.Empty());
+    EXPECT_EQ(0, slot_map_.Size());
+}
+
+TEST_F(SlotMapTest, InsertFindSlotMapTest)
+{
+    auto handle = slot_map_.Insert(std::make_unique<int>(42));
+    EXPECT_TRUE(handle);
+    EXPECT_NE(frame::NullId, handle.GetId());
+    EXPECT_EQ(frame::EntityTypeEnum::TEXTURE, handle.GetEntityType());
+    EXPECT_EQ(1, slot_map_.Size());
+    ASSERT_NE(nullptr, slot_map_.Find(handle));
+    EXPECT_EQ(42, slot_map_.At(handle));
+}
+
+TEST_F(SlotMapTest, StaleHandleSlotMapTest)
+{
+    auto first = slot_map_.Insert(std::make_unique<int>(1));
+    slot_map_.Erase(first);
+    EXPECT_FALSE(slot_map_.Contains(first));
+    EXPECT_EQ(nullptr, slot_map_.Find(first));
+    EXPECT_THROW(slot_map_.At(first), std::out_of_range);
+    // The slot is recycled with a new generation.
+    auto second = slot_map_.Insert(std::make_unique<int>(2));
+    EXPECT_EQ(first.GetIndex(), second.GetIndex());
+    EXPECT_NE(first.GetGeneration(), second.GetGeneration());
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(slot_map_.Contains(first));
+    EXPECT_EQ(2, slot_map_.At(second));
+}
+
+TEST_F(SlotMapTest, WrongTypeHandleSlotMapTest)
+{
+    auto handle = slot_map_.Insert(std::make_unique<int>(1));
+    frame::Handle<int> wrong(frame::MakeEntityId(
+        frame::EntityTypeEnum::PROGRAM,
+        handle.GetGeneration(),
+        handle.GetIndex()));
+    EXPECT_FALSE(slot_map_.Contains(wrong));
+    EXPECT_FALSE(slot_map_.Contains(frame::Handle<int>()));
+}
+
+TEST_F(SlotMapTest, ExtractReplaceSlotMapTest)
+{
+    auto handle = slot_map_.Insert(std::make_unique<int>(1));
+    slot_map_.Replace(handle, std::make_unique<int>(3));
+    EXPECT_EQ(3, slot_map_.At(handle));
+    auto value = slot_map_.Extract(handle);
+    ASSERT_TRUE(value);
+    EXPECT_EQ(3, *value);
+    EXPECT_TRUE(slot_map_.Empty());
+    EXPECT_THROW(slot_map_.Extract(handle), std::out_of_range);
+}
+
+TEST_F(SlotMapTest, ForEachSlotMapTest)
+{
+    std::vector<frame::Handle<int>> handles;
+    for (int i = 0; i < 8; ++i)
+    {
+        handles.push_back(slot_map_.Insert(std::make_unique<int>(i)));
+    }
+    slot_map_.Erase(handles[3]);
+    int count = 0;
+    slot_map_.ForEach([&count, &handles](frame::Handle<int> handle, int& i) {
+        EXPECT_EQ(handles[i], handle);
+        EXPECT_NE(3, i);
+        ++count;
+    });
+    EXPECT_EQ(7, count);
+    slot_map_.Clear();
+    EXPECT_TRUE(slot_map_.Empty());
+    EXPECT_FALSE(slot_map_.Contains(handles[0]));
+}
+
+} // End namespace test.
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "frame/slot_map.h"
+
+namespace test
+{
+
+class SlotMapTest : public testing::Test
+{
+  public:
+    SlotMapTest() = default;
+
+  protected:
+    frame::SlotMap<int> slot_map_{frame::EntityTypeEnum::TEXTURE};
+};
+
+} // End namespace test.